@@ -2,6 +2,7 @@
 #define KATANA_LIBGALOIS_KATANA_ANALYTICS_H_
 
 #include "katana/analytics/betweenness_centrality/betweenness_centrality.h"
+#include "katana/analytics/Planner.h"
 #include "katana/analytics/bfs/bfs.h"
 #include "katana/analytics/connected_components/connected_components.h"
 #include "katana/analytics/jaccard/jaccard.h"
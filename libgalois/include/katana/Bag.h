@@ -21,13 +21,19 @@
 #define KATANA_LIBGALOIS_KATANA_BAG_H_
 
 #include <algorithm>
+#include <atomic>
+#include <limits>
+#include <mutex>
 #include <stdexcept>
+#include <string>
 
 #include <boost/iterator/iterator_facade.hpp>
 
 #include "katana/Executor_OnEach.h"
 #include "katana/Mem.h"
 #include "katana/PerThreadStorage.h"
+#include "katana/SimpleLock.h"
+#include "katana/Statistics.h"
 #include "katana/config.h"
 #include "katana/gIO.h"
 #include "katana/gstl.h"
@@ -37,6 +43,11 @@ namespace katana {
 /**
  * Unordered collection of elements. This data structure supports scalable
  * concurrent pushes but reading the bag can only be done serially.
+ *
+ * By default, clearing the bag returns its blocks to the allocator. With
+ * set_block_recycling, cleared blocks are instead kept on per-thread free
+ * lists and reused by later pushes from threads on the same socket, which
+ * suits round-based algorithms that clear and refill a bag every round.
  */
 template <typename T, unsigned int BlockSize = 0>
 class InsertBag {
@@ -49,6 +60,16 @@ class InsertBag {
 
   typedef std::pair<header*, header*> PerThread;
 
+  //! Blocks released by one thread, waiting to be reused
+  struct FreeList {
+    katana::SimpleLock lock;
+    header* head{nullptr};
+    std::atomic<size_t> size{0};
+    //! Blocks holding elements pushed by this thread, and its maximum
+    size_t live{0};
+    size_t peak{0};
+  };
+
 public:
   template <typename U>
   class Iterator : public boost::iterator_facade<
@@ -124,6 +145,9 @@ public:
 private:
   katana::FixedSizeHeap heap;
   katana::PerThreadStorage<PerThread> heads;
+  katana::PerThreadStorage<FreeList> free_lists;
+  //! Maximum number of free blocks kept per thread; 0 disables recycling
+  size_t max_free_blocks{0};
 
   void insHeader(header* h) {
     PerThread& hpair = *heads.getLocal();
@@ -148,71 +172,133 @@ private:
     return H;
   }
 
+  static size_t blockBytes() {
+    return BlockSize ? BlockSize : katana::allocSize();
+  }
+
+  void* allocBlock() {
+    return BlockSize ? heap.allocate(BlockSize) : katana::pagePoolAlloc();
+  }
+
+  void releaseBlock(void* m) {
+    if (BlockSize)
+      heap.deallocate(m);
+    else
+      katana::pagePoolFree(m);
+  }
+
+  static header* popFree(FreeList& fl) {
+    std::lock_guard<katana::SimpleLock> lg(fl.lock);
+    header* h = fl.head;
+    if (h) {
+      fl.head = h->next;
+      fl.size.store(fl.size.load(std::memory_order_relaxed) - 1);
+    }
+    return h;
+  }
+
+  void pushFree(FreeList& fl, header* h) {
+    if (fl.size.load(std::memory_order_relaxed) >= max_free_blocks) {
+      releaseBlock(h);
+      return;
+    }
+    std::lock_guard<katana::SimpleLock> lg(fl.lock);
+    h->next = fl.head;
+    fl.head = h;
+    fl.size.store(fl.size.load(std::memory_order_relaxed) + 1);
+  }
+
+  //! Reuse a free block of this thread, or else of a thread on the same
+  //! socket, so that recycled memory stays NUMA local
+  header* recycledBlock() {
+    unsigned tid = katana::ThreadPool::getTID();
+    if (header* h = popFree(*free_lists.getLocal())) {
+      return h;
+    }
+    auto& tp = katana::GetThreadPool();
+    unsigned socket = tp.getSocket(tid);
+    for (unsigned x = 0; x < free_lists.size(); ++x) {
+      FreeList& fl = *free_lists.getRemote(x);
+      if (x == tid || tp.getSocket(x) != socket ||
+          fl.size.load(std::memory_order_relaxed) == 0) {
+        continue;
+      }
+      if (header* h = popFree(fl)) {
+        return h;
+      }
+    }
+    return nullptr;
+  }
+
   header* newHeader() {
-    if (BlockSize) {
-      return newHeaderFromHeap(heap.allocate(BlockSize), BlockSize);
-    } else {
-      return newHeaderFromHeap(katana::pagePoolAlloc(), katana::allocSize());
+    FreeList& fl = *free_lists.getLocal();
+    fl.peak = std::max(fl.peak, ++fl.live);
+    void* m = max_free_blocks ? recycledBlock() : nullptr;
+    return newHeaderFromHeap(m ? m : allocBlock(), blockBytes());
+  }
+
+  void destruct_thread(unsigned tid) {
+    PerThread& hpair = *heads.getRemote(tid);
+    FreeList& fl = *free_lists.getRemote(tid);
+    header*& h = hpair.first;
+    while (h) {
+      uninitialized_destroy(h->dbegin, h->dend);
+      header* h2 = h;
+      h = h->next;
+      --fl.live;
+      if (max_free_blocks)
+        pushFree(fl, h2);
+      else
+        releaseBlock(h2);
     }
+    hpair.second = 0;
   }
 
   void destruct_serial() {
     for (unsigned x = 0; x < heads.size(); ++x) {
-      PerThread& hpair = *heads.getRemote(x);
-      header*& h = hpair.first;
-      while (h) {
-        uninitialized_destroy(h->dbegin, h->dend);
-        header* h2 = h;
-        h = h->next;
-        if (BlockSize)
-          heap.deallocate(h2);
-        else
-          katana::pagePoolFree(h2);
-      }
-      hpair.second = 0;
+      destruct_thread(x);
     }
   }
 
   void destruct_parallel(void) {
     katana::on_each_gen(
         [this](const unsigned int tid, const unsigned int) {
-          PerThread& hpair = *heads.getLocal(tid);
-          header*& h = hpair.first;
-          while (h) {
-            uninitialized_destroy(h->dbegin, h->dend);
-            header* h2 = h;
-            h = h->next;
-            if (BlockSize)
-              heap.deallocate(h2);
-            else
-              katana::pagePoolFree(h2);
-          }
-          hpair.second = 0;
+          destruct_thread(tid);
         },
         std::make_tuple(katana::no_stats()));
   }
 
+  //! Release free blocks beyond max_free_blocks per thread
+  void trim_free_lists() {
+    for (unsigned x = 0; x < free_lists.size(); ++x) {
+      FreeList& fl = *free_lists.getRemote(x);
+      while (fl.size.load(std::memory_order_relaxed) > max_free_blocks) {
+        releaseBlock(popFree(fl));
+      }
+    }
+  }
+
 public:
   // static_assert(BlockSize == 0 || BlockSize >= (2 * sizeof(T) +
   // sizeof(header)),
   //     "BlockSize should larger than sizeof(T) + O(1)");
 
   InsertBag() : heap(BlockSize) {}
-  InsertBag(InsertBag&& o) : heap(BlockSize) {
-    std::swap(heap, o.heap);
-    std::swap(heads, o.heads);
-  }
+  InsertBag(InsertBag&& o) : heap(BlockSize) { swap(o); }
 
   InsertBag& operator=(InsertBag&& o) {
-    std::swap(heap, o.heap);
-    std::swap(heads, o.heads);
+    swap(o);
     return *this;
   }
 
   InsertBag(const InsertBag&) = delete;
   InsertBag& operator=(const InsertBag&) = delete;
 
-  ~InsertBag() { destruct_parallel(); }
+  ~InsertBag() {
+    destruct_parallel();
+    max_free_blocks = 0;
+    trim_free_lists();
+  }
 
   void clear() { destruct_parallel(); }
 
@@ -221,6 +307,74 @@ public:
   void swap(InsertBag& o) {
     std::swap(heap, o.heap);
     std::swap(heads, o.heads);
+    std::swap(free_lists, o.free_lists);
+    std::swap(max_free_blocks, o.max_free_blocks);
+  }
+
+  /**
+   * Keep up to max_blocks blocks per thread released by clear() for reuse by
+   * later pushes instead of returning them to the allocator. Round-based
+   * algorithms that clear and refill a bag every round then stop allocating
+   * (and faulting in) fresh memory after the first rounds. Blocks are reused
+   * by the releasing thread or a thread on the same socket. 0 disables
+   * recycling and releases all free blocks. Not thread safe.
+   */
+  void set_block_recycling(
+      size_t max_blocks = std::numeric_limits<size_t>::max()) {
+    max_free_blocks = max_blocks;
+    trim_free_lists();
+  }
+
+  /**
+   * Allocate enough free blocks for num_elements elements pushed evenly by
+   * the active threads, each on the thread that will use it. Like
+   * katana::Prealloc, this moves allocation out of the first rounds of an
+   * algorithm. Only has an effect when block recycling is enabled.
+   */
+  void reserve(size_t num_elements) {
+    size_t per_block = blockBytes() / sizeof(T) - 1;
+    if (sizeof(T) < sizeof(header))
+      per_block -= sizeof(header) / sizeof(T);
+    per_block = std::max<size_t>(per_block, 1);
+    size_t per_thread = (num_elements + katana::getActiveThreads() - 1) /
+                        katana::getActiveThreads();
+    size_t blocks = (per_thread + per_block - 1) / per_block;
+    katana::on_each_gen(
+        [&](const unsigned int, const unsigned int) {
+          FreeList& fl = *free_lists.getLocal();
+          while (fl.size.load(std::memory_order_relaxed) < blocks &&
+                 fl.size.load(std::memory_order_relaxed) < max_free_blocks) {
+            pushFree(fl, reinterpret_cast<header*>(allocBlock()));
+          }
+        },
+        std::make_tuple(katana::no_stats()));
+  }
+
+  //! Most blocks holding elements at once, summed over the threads that
+  //! pushed them
+  size_t peak_blocks() const {
+    size_t peak = 0;
+    for (unsigned x = 0; x < free_lists.size(); ++x) {
+      peak += free_lists.getRemote(x)->peak;
+    }
+    return peak;
+  }
+
+  //! Blocks currently kept for recycling
+  size_t free_blocks() const {
+    size_t free = 0;
+    for (unsigned x = 0; x < free_lists.size(); ++x) {
+      free += free_lists.getRemote(x)->size.load(std::memory_order_relaxed);
+    }
+    return free;
+  }
+
+  //! Report the block high-water mark and free blocks of this bag and the
+  //! pages allocated by the page pool under region
+  void report_stats(const std::string& region) const {
+    katana::ReportStatSingle(region, "BagPeakBlocks", peak_blocks());
+    katana::ReportStatSingle(region, "BagFreeBlocks", free_blocks());
+    katana::reportPageAlloc(region.c_str());
   }
 
   typedef T value_type;
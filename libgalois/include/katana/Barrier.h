@@ -20,8 +20,11 @@
 #ifndef KATANA_LIBGALOIS_KATANA_BARRIER_H_
 #define KATANA_LIBGALOIS_KATANA_BARRIER_H_
 
+#include <atomic>
+#include <cstdint>
 #include <memory>
 
+#include "katana/CacheLineStorage.h"
 #include "katana/config.h"
 
 namespace katana {
@@ -43,6 +46,23 @@ public:
 
   // barrier type.
   virtual const char* name() const = 0;
+
+  /// Wait at this barrier and return the sum of the values passed by the
+  /// waiting threads, e.g., the number of items pushed for the next round of
+  /// a bulk-synchronous loop.
+  ///
+  /// The default implementation waits twice; barriers that gather all
+  /// threads at one place, like the hierarchical barrier, override it to sum
+  /// on the way there.
+  virtual uint64_t WaitAndSum(uint64_t value);
+
+  /// Wait at this barrier and return whether any waiting thread passed true,
+  /// e.g., whether there is work left.
+  bool WaitAndAny(bool value) { return WaitAndSum(value ? 1 : 0) != 0; }
+
+private:
+  CacheLineStorage<std::atomic<uint64_t>> sums_[2];
+  std::atomic<unsigned> phase_{0};
 };
 
 /**
@@ -70,6 +90,15 @@ KATANA_EXPORT std::unique_ptr<Barrier> CreateTopoBarrier(unsigned);
 KATANA_EXPORT std::unique_ptr<Barrier> CreateCountingBarrier(unsigned);
 KATANA_EXPORT std::unique_ptr<Barrier> CreateDisseminationBarrier(unsigned);
 
+/**
+ * Creates a two-level barrier: threads arrive at and spin on a counter of
+ * their socket, and only the last thread of each socket goes on to the
+ * global counter. WaitAndSum() adds up the values along the way, so a
+ * barrier with a reduction costs the same as a plain one. This is the
+ * barrier returned by GetBarrier().
+ */
+KATANA_EXPORT std::unique_ptr<Barrier> CreateHierarchicalBarrier(unsigned);
+
 /**
  * Creates a new simple barrier. This barrier is not designed to be fast but
  * does guarantee that all threads have left the barrier before returning
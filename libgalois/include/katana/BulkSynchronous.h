@@ -20,8 +20,6 @@
 #ifndef KATANA_LIBGALOIS_KATANA_BULKSYNCHRONOUS_H_
 #define KATANA_LIBGALOIS_KATANA_BULKSYNCHRONOUS_H_
 
-#include <atomic>
-
 #include "katana/Barrier.h"
 #include "katana/Chunk.h"
 #include "katana/WLCompileCheck.h"
@@ -54,23 +52,25 @@ private:
 
   struct TLD {
     unsigned round;
-    TLD() : round(0) {}
+    // Whether this thread pushed work for the next round
+    bool pushed;
+    bool empty;
+    TLD() : round(0), pushed(false), empty(false) {}
   };
 
   CTy wls[2];
   PerThreadStorage<TLD> tlds;
   Barrier& barrier;
-  CacheLineStorage<std::atomic<bool>> some;
-  std::atomic<bool> isEmpty;
 
 public:
   typedef T value_type;
 
-  BulkSynchronous()
-      : barrier(GetBarrier(activeThreads)), some(false), isEmpty(false) {}
+  BulkSynchronous() : barrier(GetBarrier(activeThreads)) {}
 
   void push(const value_type& val) {
-    wls[(tlds.getLocal()->round + 1) & 1].push(val);
+    TLD& tld = *tlds.getLocal();
+    wls[(tld.round + 1) & 1].push(val);
+    tld.pushed = true;
   }
 
   template <typename ItTy>
@@ -82,37 +82,28 @@ public:
   template <typename RangeTy>
   void push_initial(const RangeTy& range) {
     push(range.local_begin(), range.local_end());
-    tlds.getLocal()->round = 1;
-    some.get() = true;
+    TLD& tld = *tlds.getLocal();
+    tld.round = 1;
+    tld.pushed = false;
   }
 
   katana::optional<value_type> pop() {
     TLD& tld = *tlds.getLocal();
     katana::optional<value_type> r;
 
-    while (true) {
-      if (isEmpty)
-        return r;  // empty
-
+    while (!tld.empty) {
       r = wls[tld.round].pop();
       if (r)
         return r;
 
-      barrier.Wait();
-      if (ThreadPool::getTID() == 0) {
-        if (!some.get())
-          isEmpty = true;
-        some.get() = false;
-      }
+      // One barrier ends the round and tells every thread whether there is
+      // a next one
+      bool more = barrier.WaitAndAny(tld.pushed);
+      tld.pushed = false;
       tld.round = (tld.round + 1) & 1;
-      barrier.Wait();
-
-      r = wls[tld.round].pop();
-      if (r) {
-        some.get() = true;
-        return r;
-      }
+      tld.empty = !more;
     }
+    return r;
   }
 };
 KATANA_WLCOMPILECHECK(BulkSynchronous)
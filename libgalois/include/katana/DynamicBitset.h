@@ -26,6 +26,7 @@
 #ifndef KATANA_LIBGALOIS_KATANA_DYNAMICBITSET_H_
 #define KATANA_LIBGALOIS_KATANA_DYNAMICBITSET_H_
 
+#include <algorithm>
 #include <cassert>
 #include <climits>
 #include <vector>
@@ -241,9 +242,22 @@ public:
     return (old_val & bit_offset);
   }
 
+  // The bulk operations below assume bit_vector is not updated (set) in
+  // parallel. They work a block of words at a time, with AVX2 when the CPU
+  // supports it, rather than one atomic read-modify-write per word.
+
   // assumes bit_vector is not updated (set) in parallel
   void bitwise_or(const DynamicBitset& other);
 
+  /**
+   * Does an IN-PLACE bitwise or of 2 passed in bitsets and saves to this
+   * bitset
+   *
+   * @param other1 Bitset to or with other 2
+   * @param other2 Bitset to or with other 1
+   */
+  void bitwise_or(const DynamicBitset& other1, const DynamicBitset& other2);
+
   // assumes bit_vector is not updated (set) in parallel
   void bitwise_not();
 
@@ -281,6 +295,23 @@ public:
    */
   void bitwise_xor(const DynamicBitset& other1, const DynamicBitset& other2);
 
+  /**
+   * Does an IN-PLACE bitwise and of this bitset and the complement of another
+   * bitset, i.e., unsets the bits set in other
+   *
+   * @param other Bitset whose set bits are unset in this bitset
+   */
+  void bitwise_andnot(const DynamicBitset& other);
+
+  /**
+   * Saves the bitwise and of other1 and the complement of other2 to this
+   * bitset
+   *
+   * @param other1 Bitset to and with the complement of other 2
+   * @param other2 Bitset whose complement is and-ed with other 1
+   */
+  void bitwise_andnot(const DynamicBitset& other1, const DynamicBitset& other2);
+
   /**
    * Count how many bits are set in the bitset
    *
@@ -298,6 +329,48 @@ public:
   template <typename integer>
   std::vector<integer> getOffsets() const;
 
+  /**
+   * Calls fn(index) in parallel for every set bit of the bitset. Whole words
+   * are skipped when empty and set bits are found with count trailing zeros,
+   * so the cost is proportional to the number of words plus the number of
+   * set bits. Do NOT call in a parallel region.
+   *
+   * @param fn Function to call on the index of each set bit
+   * @param args Optional arguments to the underlying do_all, e.g., loopname
+   */
+  template <typename Fn, typename... Args>
+  void for_each_set_bit(const Fn& fn, const Args&... args) const {
+    const size_t num_words = bitvec.size();
+    constexpr size_t kWordsPerBlock = 64;
+    katana::do_all(
+        katana::iterate(
+            size_t{0}, (num_words + kWordsPerBlock - 1) / kWordsPerBlock),
+        [&](size_t block) {
+          size_t end = std::min(num_words, (block + 1) * kWordsPerBlock);
+          for (size_t w = block * kWordsPerBlock; w < end; ++w) {
+            uint64_t word = word_at(w);
+            while (word != 0) {
+              fn(w * bits_uint64 + __builtin_ctzll(word));
+              word &= word - 1;
+            }
+          }
+        },
+        katana::steal(), args...);
+  }
+
+  /**
+   * Returns word w of the bitset without the bits past the end of the bitset
+   *
+   * @param w Index of the word
+   */
+  uint64_t word_at(size_t w) const {
+    uint64_t word = bitvec[w].load(std::memory_order_relaxed);
+    if (w == bitvec.size() - 1 && num_bits % bits_uint64 != 0) {
+      word &= (uint64_t{1} << (num_bits % bits_uint64)) - 1;
+    }
+    return word;
+  }
+
   //! this is defined to
   using tt_is_copyable = int;
 };
@@ -0,0 +1,102 @@
+#ifndef KATANA_LIBGALOIS_KATANA_EDGETILES_H_
+#define KATANA_LIBGALOIS_KATANA_EDGETILES_H_
+
+#include <cstddef>
+
+#include "katana/Bag.h"
+#include "katana/Loops.h"
+#include "katana/PropertyFileGraph.h"
+
+namespace katana {
+
+/// Edge tile size that asks for AdaptiveEdgeTileSize
+constexpr ptrdiff_t kAdaptiveEdgeTileSize = 0;
+
+/// Pick the number of edges per tile for splitting the adjacency lists of
+/// topology among the active threads.
+///
+/// Tiles are sized so that every thread gets many tiles to steal from, which
+/// is what balances power-law graphs whose hubs would otherwise be a single
+/// work item, but never smaller than a couple of average adjacency lists, so
+/// that most nodes are processed whole, nor so small that per-tile overhead
+/// dominates.
+KATANA_EXPORT ptrdiff_t AdaptiveEdgeTileSize(const GraphTopology& topology);
+
+/// Return tile_size, or AdaptiveEdgeTileSize(topology) if it is
+/// kAdaptiveEdgeTileSize. Plans keep an edge tile size only as an override.
+inline ptrdiff_t
+ChooseEdgeTileSize(ptrdiff_t tile_size, const GraphTopology& topology) {
+  return tile_size > 0 ? tile_size : AdaptiveEdgeTileSize(topology);
+}
+
+/// Call fn(tile_begin, tile_end) for consecutive tiles of at most tile_size
+/// elements covering [begin, end).
+template <typename Iterator, typename Fn>
+void
+ForEachEdgeTile(Iterator begin, Iterator end, ptrdiff_t tile_size, Fn&& fn) {
+  KATANA_LOG_DEBUG_ASSERT(tile_size > 0);
+  // Edge ids are unsigned; compare distances as signed values
+  while (static_cast<ptrdiff_t>(end - begin) > tile_size) {
+    Iterator tile_end = begin + tile_size;
+    fn(begin, tile_end);
+    begin = tile_end;
+  }
+  if (static_cast<ptrdiff_t>(end - begin) > 0) {
+    fn(begin, end);
+  }
+}
+
+/// Apply fn(src, edge) to every edge of topology in parallel, balanced by
+/// edges rather than by nodes.
+///
+/// Nodes with at most tile_size edges are processed whole; the adjacency
+/// lists of larger nodes are split into tiles of tile_size edges that are
+/// processed as separate work items once the small nodes are done. A
+/// tile_size of kAdaptiveEdgeTileSize picks AdaptiveEdgeTileSize(topology).
+/// args are passed on to both underlying do_all loops.
+template <typename Fn, typename... Args>
+void
+do_all_edges(
+    const GraphTopology& topology, const Fn& fn, ptrdiff_t tile_size,
+    const Args&... args) {
+  using Node = GraphTopology::Node;
+  using Edge = GraphTopology::Edge;
+  struct Tile {
+    Node src;
+    Edge begin;
+    Edge end;
+  };
+
+  tile_size = ChooseEdgeTileSize(tile_size, topology);
+  katana::InsertBag<Tile> tiles;
+  katana::do_all(
+      katana::iterate(topology),
+      [&](const Node& src) {
+        auto edges = topology.edges(src);
+        if (static_cast<ptrdiff_t>(edges.size()) <= tile_size) {
+          for (Edge e : edges) {
+            fn(src, e);
+          }
+          return;
+        }
+        ForEachEdgeTile(
+            *edges.begin(), *edges.end(), tile_size,
+            [&](Edge tile_begin, Edge tile_end) {
+              tiles.push(Tile{src, tile_begin, tile_end});
+            });
+      },
+      args...);
+
+  katana::do_all(
+      katana::iterate(tiles),
+      [&](const Tile& tile) {
+        for (Edge e = tile.begin; e != tile.end; ++e) {
+          fn(tile.src, e);
+        }
+      },
+      args...);
+}
+
+}  // namespace katana
+
+#endif
@@ -0,0 +1,89 @@
+#ifndef KATANA_LIBGALOIS_KATANA_GRAPHSTATS_H_
+#define KATANA_LIBGALOIS_KATANA_GRAPHSTATS_H_
+
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "katana/PropertyFileGraph.h"
+#include "katana/Result.h"
+#include "katana/config.h"
+
+namespace katana {
+
+/// The distribution of the out or in degrees of the nodes of a graph
+struct KATANA_EXPORT DegreeStats {
+  uint64_t max{0};
+  /// Mean degree of the nodes with at least one edge
+  double mean{0};
+  /// Median degree of the nodes with at least one edge
+  uint64_t median{0};
+  /// Nodes with no edges
+  uint64_t num_isolated{0};
+  /// Gini coefficient of the degrees: 0 if all nodes have the same degree,
+  /// approaching 1 as the edges concentrate on a single node
+  double gini{0};
+  /// Fraction of the edges on the 1% of nodes with the highest degree
+  double top_percent_edge_share{0};
+  /// log2_histogram[0] counts the nodes of degree 0 and log2_histogram[i]
+  /// the nodes with degree in [2^(i-1), 2^i)
+  std::vector<uint64_t> log2_histogram;
+
+  /// Whether the degrees look like a power law: the mean is well above the
+  /// median, the criterion of \ref
+  /// analytics::IsApproximateDegreeDistributionPowerLaw
+  bool IsPowerLaw() const;
+};
+
+/// Summary of one node or edge property column
+struct KATANA_EXPORT PropertyStats {
+  std::string name;
+  /// The Arrow type of the column
+  std::string type;
+  uint64_t null_count{0};
+  /// HyperLogLog estimate of the number of distinct non-null values; 0 for
+  /// types that are not hashed (nested and temporal types)
+  uint64_t distinct_estimate{0};
+  /// Whether min and max are set, which is the case for non-empty numeric
+  /// and boolean columns
+  bool has_range{false};
+  double min{0};
+  double max{0};
+};
+
+/// Statistics of a graph for choosing algorithms and parameters without
+/// sampling the graph on every call. They are computed in parallel in a few
+/// passes over the topology and the properties, and can be cached with the
+/// graph (\ref Store) so that later loads of the RDG get them for free
+/// (\ref Load).
+struct KATANA_EXPORT GraphStats {
+  uint64_t num_nodes{0};
+  uint64_t num_edges{0};
+  DegreeStats out_degree;
+  DegreeStats in_degree;
+  std::vector<PropertyStats> node_properties;
+  std::vector<PropertyStats> edge_properties;
+
+  static Result<GraphStats> Compute(const PropertyFileGraph& pfg);
+
+  /// The statistics cached in pfg. Returns ErrorCode::NotFound if there are
+  /// none or they were computed for a graph with a different number of nodes
+  /// or edges. The statistics of properties that were since removed or
+  /// changed type are dropped; properties added since have none.
+  static Result<GraphStats> Load(const PropertyFileGraph& pfg);
+
+  /// Cache the statistics in pfg. They are stored with the RDG by the next
+  /// PropertyFileGraph::Write or PropertyFileGraph::Commit.
+  Result<void> Store(PropertyFileGraph* pfg) const;
+
+  Result<std::string> ToJson() const;
+  static Result<GraphStats> FromJson(const std::string& json);
+
+  /// Print the statistics in a human readable form.
+  void Print(std::ostream& os = std::cout) const;
+};
+
+}  // namespace katana
+
+#endif
@@ -0,0 +1,82 @@
+#ifndef KATANA_LIBGALOIS_KATANA_HYPERLOGLOG_H_
+#define KATANA_LIBGALOIS_KATANA_HYPERLOGLOG_H_
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <string_view>
+
+namespace katana {
+
+/// Estimates the number of distinct values in a stream in constant space.
+/// Values are added as 64-bit hashes (\ref HashValue) and the estimate has a
+/// relative standard error of about 1.04 / sqrt(2^kPrecision), i.e., 1.6%.
+/// Sketches of disjoint parts of a stream merge into the sketch of the whole
+/// stream, so one sketch per thread followed by a merge gives a parallel
+/// estimate.
+///
+/// FLAJOLET, Philippe, et al. HyperLogLog: the analysis of a near-optimal
+/// cardinality estimation algorithm. AofA 2007.
+class HyperLogLog {
+public:
+  static constexpr uint32_t kPrecision = 12;
+  static constexpr uint32_t kNumRegisters = uint32_t{1} << kPrecision;
+
+  /// Mix the bits of value, so that nearby integers get unrelated hashes
+  static uint64_t HashValue(uint64_t value) {
+    // splitmix64 finalizer
+    value ^= value >> 30;
+    value *= 0xbf58476d1ce4e5b9ULL;
+    value ^= value >> 27;
+    value *= 0x94d049bb133111ebULL;
+    return value ^ (value >> 31);
+  }
+
+  static uint64_t HashValue(std::string_view value) {
+    // FNV-1a, then mixed since FNV leaves the high bits weak
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    for (char c : value) {
+      hash = (hash ^ static_cast<uint8_t>(c)) * 0x100000001b3ULL;
+    }
+    return HashValue(hash);
+  }
+
+  void Add(uint64_t hash) {
+    uint32_t index = hash >> (64 - kPrecision);
+    // Position of the first set bit of the remaining bits, counting from 1
+    uint64_t rest = (hash << kPrecision) | (uint64_t{1} << (kPrecision - 1));
+    auto rank = static_cast<uint8_t>(__builtin_clzll(rest) + 1);
+    registers_[index] = std::max(registers_[index], rank);
+  }
+
+  void Merge(const HyperLogLog& other) {
+    for (uint32_t i = 0; i < kNumRegisters; ++i) {
+      registers_[i] = std::max(registers_[i], other.registers_[i]);
+    }
+  }
+
+  uint64_t Estimate() const {
+    double sum = 0;
+    uint32_t zeros = 0;
+    for (uint8_t r : registers_) {
+      sum += std::ldexp(1.0, -r);
+      zeros += r == 0;
+    }
+    double m = kNumRegisters;
+    double estimate = (0.7213 / (1 + 1.079 / m)) * m * m / sum;
+    // Small cardinalities leave registers empty; linear counting is more
+    // accurate there
+    if (estimate <= 2.5 * m && zeros > 0) {
+      estimate = m * std::log(m / zeros);
+    }
+    return std::llround(estimate);
+  }
+
+private:
+  std::array<uint8_t, kNumRegisters> registers_{};
+};
+
+}  // namespace katana
+
+#endif
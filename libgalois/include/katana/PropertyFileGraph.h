@@ -1,7 +1,10 @@
 #ifndef KATANA_LIBGALOIS_KATANA_PROPERTYFILEGRAPH_H_
 #define KATANA_LIBGALOIS_KATANA_PROPERTYFILEGRAPH_H_
 
+#include <memory>
+#include <mutex>
 #include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -79,6 +82,32 @@ struct KATANA_EXPORT GraphTopology {
   bool empty() const { return num_nodes() == 0; }
 };
 
+/// A topology derived from the topology of a PropertyFileGraph by a fixed
+/// transformation. See PropertyFileGraph::GetDerivedTopology.
+struct KATANA_EXPORT DerivedTopology {
+  /// Transformations, combined with bitwise or. The edges of a derived
+  /// topology are always sorted by destination, so kEdgesSorted on its own
+  /// only sorts edges.
+  enum Transform : uint32_t {
+    kEdgesSorted = 0,
+    /// Reverse every edge
+    kTransposed = 1U << 0,
+    /// Add the reverse of every edge and drop duplicate edges; subsumes
+    /// kTransposed
+    kSymmetric = 1U << 1,
+    /// Relabel nodes in descending order of degree like SortNodesByDegree,
+    /// after any of the other transformations
+    kDegreeRelabeled = 1U << 2,
+  };
+
+  GraphTopology topology;
+
+  /// For kDegreeRelabeled, the node of topology for each node of the
+  /// original graph and the reverse mapping; null otherwise
+  std::shared_ptr<arrow::UInt32Array> original_to_derived;
+  std::shared_ptr<arrow::UInt32Array> derived_to_original;
+};
+
 /// A property graph is a graph that has properties associated with its nodes
 /// and edges. A property has a name and value. Its value may be a primitive
 /// type, a list of values or a composition of properties.
@@ -109,6 +138,15 @@ class KATANA_EXPORT PropertyFileGraph {
   // caller of SetTopology.
   GraphTopology topology_;
 
+  struct DerivedTopologyCache {
+    std::mutex mutex;
+    std::unordered_map<uint32_t, std::shared_ptr<const DerivedTopology>>
+        topologies;
+  };
+  // Behind a pointer so that PropertyFileGraph stays movable
+  std::unique_ptr<DerivedTopologyCache> derived_topologies_ =
+      std::make_unique<DerivedTopologyCache>();
+
 public:
   /// PropertyView provides a uniform interface when you don't need to
   /// distinguish operating on edge or node properties
@@ -193,6 +231,16 @@ public:
     rdg_.set_part_metadata(meta);
   }
 
+  /// Statistics cached with the graph as a JSON document, see
+  /// \ref GraphStats; empty if none were stored. They are persisted by the
+  /// next Write or Commit.
+  const std::string& graph_stats() const { return rdg_.graph_stats(); }
+  /// Fails with ErrorCode::JsonParseFailed unless graph_stats is empty or a
+  /// JSON document
+  Result<void> set_graph_stats(std::string graph_stats) {
+    return rdg_.set_graph_stats(std::move(graph_stats));
+  }
+
   const std::shared_ptr<arrow::ChunkedArray>& local_to_global_vector() {
     return rdg_.local_to_global_vector();
   }
@@ -405,6 +453,22 @@ public:
 
   Result<void> SetTopology(const GraphTopology& topology);
 
+  /// Return the topology of this graph transformed by transforms, a
+  /// combination of DerivedTopology::Transform values. The derived topology
+  /// is built in parallel the first time it is requested and then cached, so
+  /// analytics run back to back on the same graph share it instead of each
+  /// rebuilding it.
+  ///
+  /// Derived topologies are immutable. The cache is dropped when the
+  /// topology of this graph changes through SetTopology, SortAllEdgesByDest
+  /// or SortNodesByDegree, but topologies already returned stay valid.
+  Result<std::shared_ptr<const DerivedTopology>> GetDerivedTopology(
+      uint32_t transforms);
+
+  /// Drop all cached derived topologies. Only needed by code that modifies
+  /// the topology of this graph in place.
+  void DropDerivedTopologies();
+
   const std::shared_ptr<arrow::Table>& node_table() const {
     return rdg_.node_table();
   }
@@ -0,0 +1,135 @@
+#ifndef KATANA_LIBGALOIS_KATANA_ROARINGBITSET_H_
+#define KATANA_LIBGALOIS_KATANA_ROARINGBITSET_H_
+
+#include <cstdint>
+#include <vector>
+
+#include "katana/DynamicBitset.h"
+#include "katana/Loops.h"
+#include "katana/config.h"
+
+namespace katana {
+
+/// A compressed bitset for sparse sets of large indices, e.g., the frontiers
+/// of graphs with billions of nodes.
+///
+/// Indices are split into containers of 2^16 consecutive indices. Only
+/// non-empty containers are stored; a container holds the sorted low 16 bits
+/// of its indices when it has at most kMaxArraySize of them and a 2^16 bit
+/// bitmap otherwise, so a set takes space proportional to its size rather
+/// than to the largest index. This is the layout of roaring bitmaps:
+///
+/// LEMIRE, Daniel, et al. Roaring bitmaps: Implementation of an optimized
+/// software library. Software: Practice and Experience, 2018.
+///
+/// set() and reset() are not thread safe; the bulk operations, conversions
+/// and for_each_set_bit run in parallel over containers and must not be
+/// called from a parallel region.
+class KATANA_EXPORT RoaringBitset {
+public:
+  static constexpr uint32_t kContainerBits = 16;
+  static constexpr uint64_t kContainerSize = uint64_t{1} << kContainerBits;
+  /// Containers with more indices than this are stored as bitmaps
+  static constexpr uint32_t kMaxArraySize = 4096;
+  static constexpr uint32_t kBitmapWords = kContainerSize / 64;
+
+  RoaringBitset() = default;
+
+  /// Build a compressed copy of bitset
+  static RoaringBitset FromBitset(const DynamicBitset& bitset);
+
+  /// Build a set from indices sorted in increasing order
+  static RoaringBitset FromSortedOffsets(const uint64_t* offsets, size_t size);
+
+  /// Set the bits of this set in bitset, which must have more bits than the
+  /// largest index of this set
+  void ToBitset(DynamicBitset* bitset) const;
+
+  /// @returns true if index was already set
+  bool set(uint64_t index);
+  /// @returns true if index was set
+  bool reset(uint64_t index);
+  bool test(uint64_t index) const;
+
+  /// The number of indices in the set
+  uint64_t count() const;
+  bool empty() const { return containers_.empty(); }
+  void clear() { containers_.clear(); }
+
+  /// The space in bytes taken by the containers
+  size_t alloc_size() const;
+
+  void bitwise_or(const RoaringBitset& other);
+  void bitwise_and(const RoaringBitset& other);
+  /// Unset the indices that are set in other
+  void bitwise_andnot(const RoaringBitset& other);
+
+  /// Returns a vector containing the indices of the set in increasing order
+  template <typename integer>
+  std::vector<integer> getOffsets() const;
+
+  /// Call fn(index) in parallel for every index in the set. args are passed
+  /// on to the underlying do_all.
+  template <typename Fn, typename... Args>
+  void for_each_set_bit(const Fn& fn, const Args&... args) const {
+    katana::do_all(
+        katana::iterate(containers_.begin(), containers_.end()),
+        [&](const Container& c) { c.ForEach(fn); }, katana::steal(),
+        args...);
+  }
+
+private:
+  struct Container {
+    /// The index bits above kContainerBits shared by all indices in the
+    /// container
+    uint64_t key{0};
+    uint32_t cardinality{0};
+    /// Sorted low bits of the indices, if bitmap is empty
+    std::vector<uint16_t> array;
+    /// kBitmapWords words, if the container has more than kMaxArraySize
+    /// indices
+    std::vector<uint64_t> bitmap;
+
+    bool is_bitmap() const { return !bitmap.empty(); }
+    bool Test(uint16_t low) const;
+
+    /// Switch to the representation that fits cardinality
+    void Normalize();
+
+    template <typename Fn>
+    void ForEach(const Fn& fn) const {
+      uint64_t base = key << kContainerBits;
+      if (!is_bitmap()) {
+        for (uint16_t low : array) {
+          fn(base + low);
+        }
+        return;
+      }
+      for (uint32_t w = 0; w < kBitmapWords; ++w) {
+        uint64_t word = bitmap[w];
+        while (word != 0) {
+          fn(base + w * 64 + __builtin_ctzll(word));
+          word &= word - 1;
+        }
+      }
+    }
+  };
+
+  enum class Op { kOr, kAnd, kAndNot };
+
+  static Container Combine(const Container& a, const Container& b, Op op);
+  void Apply(const RoaringBitset& other, Op op);
+
+  /// Containers sorted by key
+  std::vector<Container> containers_;
+};
+
+template <>
+std::vector<uint32_t> RoaringBitset::getOffsets() const;
+
+template <>
+std::vector<uint64_t> RoaringBitset::getOffsets() const;
+
+}  // namespace katana
+
+#endif
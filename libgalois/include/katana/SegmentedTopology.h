@@ -0,0 +1,95 @@
+#ifndef KATANA_LIBGALOIS_KATANA_SEGMENTEDTOPOLOGY_H_
+#define KATANA_LIBGALOIS_KATANA_SEGMENTEDTOPOLOGY_H_
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "katana/PropertyFileGraph.h"
+#include "katana/Result.h"
+#include "katana/config.h"
+#include "tsuba/RDGPrefix.h"
+#include "tsuba/RDGSlice.h"
+#include "tsuba/tsuba.h"
+
+namespace katana {
+
+/// The out edges of a range of consecutive nodes of a \ref SegmentedTopology
+struct TopologySegment {
+  /// Global id of the first node of the segment
+  GraphTopology::Node node_begin;
+  GraphTopology::Node node_end;
+  /// Global id of the first edge of the segment
+  GraphTopology::Edge edge_begin;
+  GraphTopology::Edge edge_end;
+  /// Node n of topology is global node node_begin + n and edge e of topology
+  /// is global edge edge_begin + e. Edge destinations are global node ids.
+  GraphTopology topology;
+};
+
+/// Out-of-core access to the topology of a stored RDG, for edge-centric
+/// analytics over graphs whose edges do not fit in memory.
+///
+/// Only the out indices of the topology (8 bytes per node) are kept in
+/// memory. The edges are streamed in segments of consecutive nodes that take
+/// at most segment_bytes each, and while one segment is processed the next
+/// one is loaded in the background, so a pass over the graph overlaps I/O
+/// with computation and holds at most two segments at a time. This is the
+/// streaming model of X-Stream and GridGraph:
+///
+/// ROY, Amitabha; MIHAILOVIC, Ivo; ZWAENEPOEL, Willy. X-Stream: Edge-centric
+/// graph processing using streaming partitions. SOSP 2013.
+class KATANA_EXPORT SegmentedTopology {
+public:
+  static constexpr uint64_t kDefaultSegmentBytes = uint64_t{1} << 30;
+
+  /// Open the RDG stored at rdg_name and split its nodes into segments whose
+  /// out indices and edges take at most segment_bytes, unless a single node
+  /// needs more.
+  static Result<SegmentedTopology> Make(
+      const std::string& rdg_name,
+      uint64_t segment_bytes = kDefaultSegmentBytes);
+
+  uint64_t num_nodes() const { return prefix_.num_nodes(); }
+  uint64_t num_edges() const { return prefix_.num_edges(); }
+  size_t num_segments() const { return segment_nodes_.size() - 1; }
+
+  /// The out degree of node; does not load any edges
+  uint64_t degree(GraphTopology::Node node) const {
+    uint64_t begin = node > 0 ? prefix_[node - 1] : 0;
+    return prefix_[node] - begin;
+  }
+
+  /// Call fn on each segment in node order. The segment is only valid during
+  /// the call. The pass stops at the first error, from loading a segment or
+  /// returned by fn.
+  Result<void> ForEachSegment(
+      const std::function<Result<void>(const TopologySegment&)>& fn);
+
+private:
+  /// A segment and the slice of the RDG backing its edges
+  struct LoadedSegment {
+    tsuba::RDGSlice slice;
+    TopologySegment segment;
+  };
+
+  SegmentedTopology(
+      std::unique_ptr<tsuba::RDGFile> rdg_file, tsuba::RDGPrefix&& prefix,
+      std::vector<GraphTopology::Node>&& segment_nodes)
+      : rdg_file_(std::move(rdg_file)),
+        prefix_(std::move(prefix)),
+        segment_nodes_(std::move(segment_nodes)) {}
+
+  Result<LoadedSegment> LoadSegment(size_t segment);
+
+  std::unique_ptr<tsuba::RDGFile> rdg_file_;
+  tsuba::RDGPrefix prefix_;
+  /// Segment i holds nodes [segment_nodes_[i], segment_nodes_[i + 1])
+  std::vector<GraphTopology::Node> segment_nodes_;
+};
+
+}  // namespace katana
+
+#endif
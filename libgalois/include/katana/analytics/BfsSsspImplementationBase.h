@@ -24,12 +24,14 @@
 #include <cstdlib>
 #include <iostream>
 
+#include "katana/EdgeTiles.h"
 #include "katana/analytics/Utils.h"
 
 namespace katana::analytics {
 
 template <typename _Graph, typename _DistLabel, bool USE_EDGE_WT>
 struct BfsSsspImplementationBase {
+  /// Must be positive; resolve plan values with katana::ChooseEdgeTileSize
   const ptrdiff_t edge_tile_size;
 
   using Graph = _Graph;
@@ -95,18 +97,11 @@ struct BfsSsspImplementationBase {
   void PushEdgeTiles(WL& wl, EI beg, const EI end, const TileMaker& f) {
     KATANA_LOG_DEBUG_ASSERT(beg <= end);
 
-    if ((end - beg) > edge_tile_size) {
-      for (; beg + edge_tile_size < end;) {
-        auto ne = beg + edge_tile_size;
-        KATANA_LOG_DEBUG_ASSERT(ne < end);
-        wl.push(f(beg, ne));
-        beg = ne;
-      }
-    }
-
-    if ((end - beg) > 0) {
-      wl.push(f(beg, end));
-    }
+    katana::ForEachEdgeTile(
+        beg, end, edge_tile_size,
+        [&](const EI& tile_beg, const EI& tile_end) {
+          wl.push(f(tile_beg, tile_end));
+        });
   }
 
   template <typename WL, typename TileMaker>
@@ -0,0 +1,68 @@
+#ifndef KATANA_LIBGALOIS_KATANA_ANALYTICS_INTERSECTION_H_
+#define KATANA_LIBGALOIS_KATANA_ANALYTICS_INTERSECTION_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "katana/config.h"
+
+namespace katana::analytics {
+
+// Intersection of sorted sets of node ids, e.g., of sorted adjacency lists.
+// This is the inner loop of triangle counting, k-truss and Jaccard
+// similarity. All sets must be sorted in increasing order and free of
+// duplicates.
+
+/// Instruction sets the block merge can be implemented with
+enum class IntersectionKernel { kScalar, kSSE, kAVX2, kAVX512 };
+
+/// The widest kernel supported by the CPU we are running on
+KATANA_EXPORT IntersectionKernel BestIntersectionKernel();
+
+/// Number of elements common to a and b.
+///
+/// When one set is much smaller than the other, each of its elements is
+/// galloped to in the larger set; otherwise the sets are merged a block of
+/// elements at a time with the best kernel for this CPU.
+KATANA_EXPORT uint64_t IntersectCount(
+    const uint32_t* a, size_t a_size, const uint32_t* b, size_t b_size);
+
+/// Like IntersectCount but always merges with the given kernel, which must be
+/// supported by the CPU. For testing and benchmarking.
+KATANA_EXPORT uint64_t IntersectCountMerge(
+    const uint32_t* a, size_t a_size, const uint32_t* b, size_t b_size,
+    IntersectionKernel kernel);
+
+/// Like IntersectCount but always gallops from the elements of small into
+/// large. For testing and benchmarking.
+KATANA_EXPORT uint64_t IntersectCountGallop(
+    const uint32_t* small, size_t small_size, const uint32_t* large,
+    size_t large_size);
+
+/// Degree at which a neighborhood that is intersected with many other sets is
+/// worth loading into an IntersectionBitmap
+constexpr size_t kIntersectionHubDegree = 1024;
+
+/// A set of node ids stored as a bitmap. Intersecting with it costs one probe
+/// per element of the other set regardless of the size of this one, which
+/// pays off for the neighborhoods of hubs.
+class KATANA_EXPORT IntersectionBitmap {
+public:
+  /// Add the elements of set; the bitmap grows to hold the largest one
+  void Set(const uint32_t* set, size_t size);
+
+  /// Remove the elements of set. Cheaper than clearing the whole bitmap
+  /// when sets are small compared to the range of ids.
+  void Clear(const uint32_t* set, size_t size);
+
+  /// Number of elements of set that are in the bitmap
+  uint64_t Count(const uint32_t* set, size_t size) const;
+
+private:
+  std::vector<uint64_t> words_;
+};
+
+}  // namespace katana::analytics
+
+#endif
@@ -1,6 +1,8 @@
 #ifndef KATANA_LIBGALOIS_KATANA_ANALYTICS_PLAN_H_
 #define KATANA_LIBGALOIS_KATANA_ANALYTICS_PLAN_H_
 
+#include <type_traits>
+
 namespace katana::analytics {
 
 enum Architecture {
@@ -15,13 +17,36 @@ enum Architecture {
 class Plan {
 protected:
   Architecture architecture_;
+  bool deterministic_{false};
 
   Plan(Architecture architecture) : architecture_(architecture) {}
 
 public:
   Architecture architecture() const { return architecture_; }
+
+  /// Whether the analytic must produce the same output on every run,
+  /// independent of the number of threads and the schedule. See
+  /// \ref Deterministic.
+  bool deterministic() const { return deterministic_; }
+
+  template <typename PlanType>
+  friend PlanType Deterministic(PlanType plan);
 };
 
+/// Return plan set to run deterministically. Analytics whose output depends
+/// on the order in which concurrent updates land (the members of an
+/// IndependentSet, the labels of ConnectedComponents) then run in
+/// bulk-synchronous rounds or canonicalize their output, at a bounded extra
+/// cost described by each analytic. Analytics whose output is unique anyway,
+/// like KTruss, ignore the flag.
+template <typename PlanType>
+PlanType
+Deterministic(PlanType plan) {
+  static_assert(std::is_base_of_v<Plan, PlanType>);
+  plan.deterministic_ = true;
+  return plan;
+}
+
 }  // namespace katana::analytics
 
 #endif  //KATANA_PLAN_H_
@@ -0,0 +1,96 @@
+#ifndef KATANA_LIBGALOIS_KATANA_ANALYTICS_PLANNER_H_
+#define KATANA_LIBGALOIS_KATANA_ANALYTICS_PLANNER_H_
+
+#include <cstdint>
+#include <iostream>
+
+#include "katana/PropertyFileGraph.h"
+#include "katana/analytics/bfs/bfs.h"
+#include "katana/analytics/connected_components/connected_components.h"
+#include "katana/analytics/pagerank/pagerank.h"
+#include "katana/analytics/sssp/sssp.h"
+
+namespace katana::analytics {
+
+/// Features of a graph from which the automatic plans (kAutomatic) of the
+/// analytics choose an algorithm and its parameters.
+///
+/// Computing them takes a pass over the node indices and a BFS probe that
+/// stops after kProbeNodes nodes or kProbeEdges edges. Whether the degrees
+/// follow a power law is decided by the criterion of
+/// IsApproximateDegreeDistributionPowerLaw, either on the GraphStats cached
+/// with the graph or on kPowerLawSamples evenly spaced nodes rather than
+/// random ones. The result only depends on the graph and the number of active
+/// threads, so the same call gets the same plan on every run.
+struct KATANA_EXPORT GraphFeatures {
+  static constexpr uint64_t kProbeNodes = uint64_t{1} << 16;
+  static constexpr uint64_t kProbeEdges = uint64_t{1} << 22;
+  static constexpr uint64_t kPowerLawSamples = 1000;
+
+  uint64_t num_nodes{0};
+  uint64_t num_edges{0};
+  uint64_t max_degree{0};
+  bool power_law{false};
+  /// Levels reached by the probe: the eccentricity of its source if the
+  /// probe exhausted the component of the source, a lower bound on it (and
+  /// on half the diameter) otherwise
+  uint32_t probe_levels{0};
+  /// Nodes reached by the probe
+  uint64_t probe_nodes{0};
+  unsigned num_threads{1};
+  /// \ref AdaptiveEdgeTileSize of the graph for num_threads
+  ptrdiff_t edge_tile_size{0};
+
+  double average_degree() const;
+
+  /// Nodes per level of the probe, i.e., the parallel work in each round of
+  /// a bulk-synchronous traversal. High diameter graphs like road networks
+  /// have narrow frontiers and pay a barrier per level for little work.
+  double average_frontier() const;
+
+  /// Whether a bulk-synchronous round has too little work to keep the
+  /// threads busy, so that asynchronous algorithms win
+  bool narrow_frontier() const;
+
+  /// Whether some adjacency list spans several edge tiles, so that tiled
+  /// algorithms balance better than whole-node work items
+  bool has_hubs() const { return max_degree > uint64_t(edge_tile_size); }
+
+  static GraphFeatures Compute(const PropertyFileGraph& pfg);
+
+  /// Print the features in a human readable form.
+  void Print(std::ostream& os = std::cout) const;
+};
+
+/// Distribution of the edge weights of a graph, from which SSSP derives its
+/// delta
+struct KATANA_EXPORT WeightFeatures {
+  /// Largest of the sampled weights
+  double max{0};
+};
+
+/// Choose a BFS plan for a graph with the given features.
+KATANA_EXPORT BfsPlan ChooseBfsPlan(const GraphFeatures& features);
+
+/// Choose a ConnectedComponents plan for a graph with the given features.
+KATANA_EXPORT ConnectedComponentsPlan ChooseConnectedComponentsPlan(
+    const GraphFeatures& features);
+
+/// Choose a Pagerank algorithm for a graph with the given features, keeping
+/// the tolerance, alpha and iteration limit of params. Only push algorithms
+/// are chosen, since the pull algorithms need a transposed graph.
+KATANA_EXPORT PagerankPlan ChoosePagerankPlan(
+    const GraphFeatures& features, const PagerankPlan& params);
+
+/// Choose an SSSP plan for a graph with the given features and weights.
+/// The delta is log2 of max weight / average degree, the bucket width that
+/// delta stepping is work efficient for (Meyer and Sanders).
+///
+/// MEYER, Ulrich; SANDERS, Peter. Delta-stepping: a parallelizable shortest
+/// path algorithm. Journal of Algorithms, 2003, 49.1: 114-152.
+KATANA_EXPORT SsspPlan ChooseSsspPlan(
+    const GraphFeatures& features, const WeightFeatures& weights);
+
+}  // namespace katana::analytics
+
+#endif
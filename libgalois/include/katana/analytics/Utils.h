@@ -5,6 +5,7 @@
 #include <random>
 
 #include "katana/ErrorCode.h"
+#include "katana/LargeArray.h"
 #include "katana/PropertyGraph.h"
 #include "katana/Result.h"
 
@@ -32,6 +33,23 @@ public:
 KATANA_EXPORT bool IsApproximateDegreeDistributionPowerLaw(
     const PropertyFileGraph& graph);
 
+/// A batch of (source, destination) edges added to a graph after an analytics
+/// result was computed on it. The incremental analytics take the previous
+/// result and a batch and update the result in place.
+using EdgeBatch =
+    std::vector<std::pair<GraphTopology::Node, GraphTopology::Node>>;
+
+/// Check that every endpoint in edge_batch is a node of graph.
+KATANA_EXPORT Result<void> CheckEdgeBatch(
+    const PropertyFileGraph& graph, const EdgeBatch& edge_batch);
+
+/// Allocate *out with an entry per edge of graph and copy the edge property
+/// edge_weight_property_name into it, which may be of any integer or floating
+/// point type. If edge_weight_property_name is empty every weight is 1.
+KATANA_EXPORT Result<void> ReadEdgeWeights(
+    const PropertyFileGraph& graph,
+    const std::string& edge_weight_property_name, LargeArray<double>* out);
+
 template <typename Props>
 std::vector<std::string>
 DefaultPropertyNames() {
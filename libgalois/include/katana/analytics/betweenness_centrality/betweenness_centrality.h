@@ -18,6 +18,7 @@ public:
   enum Algorithm {
     kLevel,
     kOuter,
+    kSampling,
     // TODO(gill): Reinstate async and auto once we have bidirectional graphs.
     // kAsynchronous,
     // kAutomatic,
@@ -25,12 +26,20 @@ public:
 
 private:
   Algorithm algorithm_;
+  float epsilon_;
+  float delta_;
 
-  BetweennessCentralityPlan(Architecture architecture, Algorithm algorithm)
-      : Plan(architecture), algorithm_(algorithm) {}
+  BetweennessCentralityPlan(
+      Architecture architecture, Algorithm algorithm, float epsilon,
+      float delta)
+      : Plan(architecture),
+        algorithm_(algorithm),
+        epsilon_(epsilon),
+        delta_(delta) {}
 
 public:
-  BetweennessCentralityPlan() : BetweennessCentralityPlan{kCPU, kLevel} {}
+  BetweennessCentralityPlan()
+      : BetweennessCentralityPlan{kCPU, kLevel, 0.01, 0.1} {}
 
   BetweennessCentralityPlan(const katana::PropertyFileGraph* pfg
                             [[maybe_unused]])
@@ -51,13 +60,48 @@ public:
   }
 
   Algorithm algorithm() const { return algorithm_; }
+  /// The error bound of the sampling algorithm as a fraction of the number of
+  /// pairs of nodes, n * (n - 1)
+  float epsilon() const { return epsilon_; }
+  /// The probability that the sampling algorithm exceeds its error bound
+  float delta() const { return delta_; }
+
+  static BetweennessCentralityPlan Level() {
+    return {kCPU, kLevel, 0.01, 0.1};
+  }
 
-  static BetweennessCentralityPlan Level() { return {kCPU, kLevel}; }
+  static BetweennessCentralityPlan Outer() {
+    return {kCPU, kOuter, 0.01, 0.1};
+  }
 
-  static BetweennessCentralityPlan Outer() { return {kCPU, kOuter}; }
+  /// Approximate the centrality by sampling shortest paths between random
+  /// pairs of nodes until, with probability at least 1 - delta, every node's
+  /// centrality is within epsilon * n * (n - 1) of the exact one.
+  ///
+  /// The number of samples needed is bounded by the vertex diameter of the
+  /// graph, independently of its size, as in
+  ///
+  /// RIONDATO, Matteo; KORNAROPOULOS, Evgenios M. Fast approximation of
+  /// betweenness centrality through sampling. Data Mining and Knowledge
+  /// Discovery, 2016, 30.2: 438-475.
+  ///
+  /// The vertex diameter is estimated from BFS from a few random nodes. That
+  /// estimate is an upper bound on undirected graphs but only a heuristic on
+  /// directed ones, where it may fall short of the true diameter, so the
+  /// guarantee above only holds for undirected graphs.
+  ///
+  /// Sampling stops earlier once an empirical Bernstein bound on the samples
+  /// taken so far meets epsilon, which is usually much sooner when centrality
+  /// is concentrated on a few nodes.
+  ///
+  /// The sources argument of \ref BetweennessCentrality is ignored.
+  static BetweennessCentralityPlan Sampling(
+      float epsilon = 0.01, float delta = 0.1) {
+    return {kCPU, kSampling, epsilon, delta};
+  }
 
   static BetweennessCentralityPlan FromAlgorithm(Algorithm algo) {
-    return BetweennessCentralityPlan(kCPU, algo);
+    return BetweennessCentralityPlan(kCPU, algo, 0.01, 0.1);
   }
 };
 
@@ -99,6 +143,15 @@ struct KATANA_EXPORT BetweennessCentralityStatistics {
   float min_centrality;
   /// The average centrality across all nodes.
   float average_centrality;
+  /// With probability at least 1 - delta, the largest difference between the
+  /// computed and the exact centrality of any node. Only known for results of
+  /// the sampling algorithm; 0 otherwise. On directed graphs this relies
+  /// on the estimated vertex diameter, see
+  /// \ref BetweennessCentralityPlan::Sampling.
+  float error_bound;
+  /// The number of shortest paths sampled, or 0 if the result was not
+  /// computed by sampling.
+  uint64_t num_samples;
 
   /// Print the statistics in a human readable form.
   void Print(std::ostream& os = std::cout);
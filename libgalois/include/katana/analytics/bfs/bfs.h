@@ -3,6 +3,7 @@
 
 #include <iostream>
 
+#include "katana/EdgeTiles.h"
 #include "katana/analytics/Plan.h"
 #include "katana/analytics/Utils.h"
 
@@ -16,7 +17,8 @@ public:
     kAsynchronousTile = 0,
     kAsynchronous,
     kSynchronousTile,
-    kSynchronous
+    kSynchronous,
+    kAutomatic,
   };
 
 private:
@@ -30,23 +32,32 @@ private:
         edge_tile_size_(edge_tile_size) {}
 
 public:
-  BfsPlan() : BfsPlan{kCPU, kSynchronousTile, 256} {}
+  BfsPlan() : BfsPlan{kCPU, kAutomatic, kAdaptiveEdgeTileSize} {}
 
   Algorithm algorithm() const { return algorithm_; }
+  /// The number of edges per work item of the tiled algorithms, or
+  /// kAdaptiveEdgeTileSize to pick it from the degree distribution of the
+  /// graph
   ptrdiff_t edge_tile_size() const { return edge_tile_size_; }
 
-  static BfsPlan AsynchronousTile(ptrdiff_t edge_tile_size = 256) {
+  static BfsPlan AsynchronousTile(
+      ptrdiff_t edge_tile_size = kAdaptiveEdgeTileSize) {
     return {kCPU, kAsynchronousTile, edge_tile_size};
   }
 
   static BfsPlan Asynchronous() { return {kCPU, kAsynchronous, 0}; }
 
-  static BfsPlan SynchronousTile(ptrdiff_t edge_tile_size = 256) {
+  static BfsPlan SynchronousTile(
+      ptrdiff_t edge_tile_size = kAdaptiveEdgeTileSize) {
     return {kCPU, kSynchronousTile, edge_tile_size};
   }
 
   static BfsPlan Synchronous() { return {kCPU, kSynchronous, 0}; }
 
+  /// Choose the algorithm and edge tile size from the features of the graph
+  /// when it runs, see \ref ChooseBfsPlan
+  static BfsPlan Automatic() { return {kCPU, kAutomatic, 0}; }
+
   static BfsPlan FromAlgorithm(Algorithm algo) {
     switch (algo) {
     case kAsynchronous:
@@ -57,6 +68,8 @@ public:
       return Synchronous();
     case kSynchronousTile:
       return SynchronousTile();
+    case kAutomatic:
+      return Automatic();
     default:
       return {};
     }
@@ -0,0 +1,214 @@
+#ifndef KATANA_LIBGALOIS_KATANA_ANALYTICS_CLUSTERING_CLUSTERING_H_
+#define KATANA_LIBGALOIS_KATANA_ANALYTICS_CLUSTERING_CLUSTERING_H_
+
+#include <iostream>
+
+#include "katana/PropertyFileGraph.h"
+#include "katana/analytics/Plan.h"
+#include "katana/analytics/Utils.h"
+
+// API
+
+namespace katana::analytics {
+
+/// A computational plan to for Louvain clustering, specifying the algorithm
+/// and any parameters associated with it.
+class LouvainClusteringPlan : public Plan {
+public:
+  /// Algorithm selectors for Louvain clustering
+  enum Algorithm {
+    /// Every node picks its best community in parallel without locks; a
+    /// singleton only joins another singleton with a smaller id so that
+    /// pairs of nodes do not swap communities forever.
+    kDoAll,
+  };
+
+  // Don't allow people to directly construct these, so as to have only one
+  // consistent way to configure.
+private:
+  Algorithm algorithm_;
+  double modularity_threshold_per_round_;
+  double modularity_threshold_total_;
+  uint32_t max_iterations_;
+  uint32_t min_graph_size_;
+  double resolution_;
+
+  LouvainClusteringPlan(
+      Architecture architecture, Algorithm algorithm,
+      double modularity_threshold_per_round, double modularity_threshold_total,
+      uint32_t max_iterations, uint32_t min_graph_size, double resolution)
+      : Plan(architecture),
+        algorithm_(algorithm),
+        modularity_threshold_per_round_(modularity_threshold_per_round),
+        modularity_threshold_total_(modularity_threshold_total),
+        max_iterations_(max_iterations),
+        min_graph_size_(min_graph_size),
+        resolution_(resolution) {}
+
+public:
+  LouvainClusteringPlan() : LouvainClusteringPlan{DoAll()} {}
+
+  Algorithm algorithm() const { return algorithm_; }
+  /// A level stops moving nodes once a round improves modularity by less
+  /// than this
+  double modularity_threshold_per_round() const {
+    return modularity_threshold_per_round_;
+  }
+  /// Coarsening stops once a level improves modularity by less than this
+  double modularity_threshold_total() const {
+    return modularity_threshold_total_;
+  }
+  /// The maximum number of rounds of moves, summed over all levels
+  uint32_t max_iterations() const { return max_iterations_; }
+  /// Coarsening stops once the coarsened graph has no more nodes than this
+  uint32_t min_graph_size() const { return min_graph_size_; }
+  /// The resolution of modularity; larger values give smaller communities
+  double resolution() const { return resolution_; }
+
+  static LouvainClusteringPlan DoAll(
+      double modularity_threshold_per_round = 0.01,
+      double modularity_threshold_total = 0.01, uint32_t max_iterations = 10,
+      uint32_t min_graph_size = 100, double resolution = 1.0) {
+    return {kCPU,
+            kDoAll,
+            modularity_threshold_per_round,
+            modularity_threshold_total,
+            max_iterations,
+            min_graph_size,
+            resolution};
+  }
+};
+
+/// A computational plan to for Leiden clustering, specifying the algorithm
+/// and any parameters associated with it.
+class LeidenClusteringPlan : public Plan {
+public:
+  /// Algorithm selectors for Leiden clustering
+  enum Algorithm {
+    /// The local moves of \ref LouvainClusteringPlan::kDoAll; the communities
+    /// of different nodes are refined in parallel.
+    kDoAll,
+  };
+
+private:
+  Algorithm algorithm_;
+  double modularity_threshold_per_round_;
+  double modularity_threshold_total_;
+  uint32_t max_iterations_;
+  uint32_t min_graph_size_;
+  double resolution_;
+  double randomness_;
+
+  LeidenClusteringPlan(
+      Architecture architecture, Algorithm algorithm,
+      double modularity_threshold_per_round, double modularity_threshold_total,
+      uint32_t max_iterations, uint32_t min_graph_size, double resolution,
+      double randomness)
+      : Plan(architecture),
+        algorithm_(algorithm),
+        modularity_threshold_per_round_(modularity_threshold_per_round),
+        modularity_threshold_total_(modularity_threshold_total),
+        max_iterations_(max_iterations),
+        min_graph_size_(min_graph_size),
+        resolution_(resolution),
+        randomness_(randomness) {}
+
+public:
+  LeidenClusteringPlan() : LeidenClusteringPlan{DoAll()} {}
+
+  Algorithm algorithm() const { return algorithm_; }
+  /// \see LouvainClusteringPlan::modularity_threshold_per_round
+  double modularity_threshold_per_round() const {
+    return modularity_threshold_per_round_;
+  }
+  /// \see LouvainClusteringPlan::modularity_threshold_total
+  double modularity_threshold_total() const {
+    return modularity_threshold_total_;
+  }
+  /// \see LouvainClusteringPlan::max_iterations
+  uint32_t max_iterations() const { return max_iterations_; }
+  /// \see LouvainClusteringPlan::min_graph_size
+  uint32_t min_graph_size() const { return min_graph_size_; }
+  /// \see LouvainClusteringPlan::resolution
+  double resolution() const { return resolution_; }
+  /// How randomly refinement merges nodes into subcommunities; as it goes to
+  /// 0 each node joins the subcommunity with the largest gain
+  double randomness() const { return randomness_; }
+
+  static LeidenClusteringPlan DoAll(
+      double modularity_threshold_per_round = 0.01,
+      double modularity_threshold_total = 0.01, uint32_t max_iterations = 10,
+      uint32_t min_graph_size = 100, double resolution = 1.0,
+      double randomness = 0.01) {
+    return {kCPU,
+            kDoAll,
+            modularity_threshold_per_round,
+            modularity_threshold_total,
+            max_iterations,
+            min_graph_size,
+            resolution,
+            randomness};
+  }
+};
+
+/// Cluster the nodes of pfg into communities of high modularity with the
+/// Louvain method: nodes are moved between communities while that improves
+/// modularity, then each community is coarsened into a node and the process
+/// repeats on the coarsened graph.
+///
+/// BLONDEL, Vincent D., et al. Fast unfolding of communities in large
+/// networks. Journal of statistical mechanics: theory and experiment, 2008.
+///
+/// The pfg must be symmetric. Edge weights are taken from the property named
+/// edge_weight_property_name (which may be a 32- or 64-bit signed or unsigned
+/// int or a float or double); if it is empty every edge has weight 1.
+/// The community of each node, numbered contiguously from 0, is stored in the
+/// property named output_property_name (as uint64_t).
+/// The property named output_property_name is created by this function and may
+/// not exist before the call.
+KATANA_EXPORT Result<void> LouvainClustering(
+    PropertyFileGraph* pfg, const std::string& edge_weight_property_name,
+    const std::string& output_property_name, LouvainClusteringPlan plan = {});
+
+/// Cluster the nodes of pfg with the Leiden method, which refines every
+/// community into well-connected subcommunities before coarsening so that,
+/// unlike Louvain, communities are never internally disconnected.
+///
+/// TRAAG, Vincent A.; WALTMAN, Ludo; VAN ECK, Nees Jan. From Louvain to
+/// Leiden: guaranteeing well-connected communities. Scientific reports, 2019.
+///
+/// The arguments are as for \ref LouvainClustering.
+KATANA_EXPORT Result<void> LeidenClustering(
+    PropertyFileGraph* pfg, const std::string& edge_weight_property_name,
+    const std::string& output_property_name, LeidenClusteringPlan plan = {});
+
+/// Check that the communities in property_name are numbered contiguously
+/// from 0.
+KATANA_EXPORT Result<void> ClusteringAssertValid(
+    PropertyFileGraph* pfg, const std::string& property_name);
+
+struct KATANA_EXPORT ClusteringStatistics {
+  /// Total number of unique clusters in the graph.
+  uint64_t n_clusters;
+  /// Total number of clusters with more than 1 node.
+  uint64_t n_non_trivial_clusters;
+  /// The number of nodes present in the largest cluster.
+  uint64_t largest_cluster_size;
+  /// The proportion of nodes present in the largest cluster.
+  double largest_cluster_proportion;
+  /// The modularity of the clustering, with resolution 1.
+  double modularity;
+
+  /// Print the statistics in a human readable form.
+  void Print(std::ostream& os = std::cout) const;
+
+  /// Compute the statistics of the communities in property_name. Edge weights
+  /// are taken from edge_weight_property_name as for \ref LouvainClustering.
+  static katana::Result<ClusteringStatistics> Compute(
+      PropertyFileGraph* pfg, const std::string& edge_weight_property_name,
+      const std::string& property_name);
+};
+
+}  // namespace katana::analytics
+
+#endif
@@ -4,6 +4,8 @@
 #include <iostream>
 
 #include "katana/AtomicHelpers.h"
+#include "katana/EdgeTiles.h"
+#include "katana/SegmentedTopology.h"
 #include "katana/analytics/Plan.h"
 #include "katana/analytics/Utils.h"
 
@@ -26,10 +28,12 @@ public:
     kBlockedAsynchronous,
     kAfforest,
     kEdgeAfforest,
-    kEdgeTiledAfforest
+    kEdgeTiledAfforest,
+    kAutomatic,
   };
 
-  static const ptrdiff_t kDefaultEdgeTileSize = 512;
+  /// Pick the edge tile size from the degree distribution of the graph
+  static const ptrdiff_t kDefaultEdgeTileSize = katana::kAdaptiveEdgeTileSize;
   static const uint32_t kDefaultNeighborSampleSize = 2;
   static const uint32_t kDefaultComponentSampleFrequency = 1024;
 
@@ -56,7 +60,7 @@ public:
 
   ConnectedComponentsPlan()
       : ConnectedComponentsPlan{
-            kCPU, kAfforest, 0, kDefaultNeighborSampleSize,
+            kCPU, kAutomatic, 0, kDefaultNeighborSampleSize,
             kDefaultComponentSampleFrequency} {}
 
   Algorithm algorithm() const { return algorithm_; }
@@ -145,9 +149,17 @@ public:
       uint32_t neighbor_sample_size = kDefaultNeighborSampleSize,
       uint32_t component_sample_frequency = kDefaultComponentSampleFrequency) {
     return {
-        kCPU, kEdgeAfforest, edge_tile_size, neighbor_sample_size,
+        kCPU, kEdgeTiledAfforest, edge_tile_size, neighbor_sample_size,
         component_sample_frequency};
   }
+
+  /// Choose the algorithm from the features of the graph when it runs, see
+  /// \ref ChooseConnectedComponentsPlan
+  static ConnectedComponentsPlan Automatic() {
+    return {
+        kCPU, kAutomatic, 0, kDefaultNeighborSampleSize,
+        kDefaultComponentSampleFrequency};
+  }
 };
 
 /// Compute the Connected-components for pfg. The pfg is expected to be
@@ -157,10 +169,36 @@ public:
 /// are used by the algorithms.
 /// The property named output_property_name is created by this function and may
 /// not exist before the call.
+/// With a \ref Deterministic plan, each component is labeled with the
+/// smallest node id in it, at the cost of sorting the labels.
 KATANA_EXPORT Result<void> ConnectedComponents(
     PropertyFileGraph* pfg, const std::string& output_property_name,
     ConnectedComponentsPlan plan = ConnectedComponentsPlan());
 
+/// Update the Connected-components in property_name, previously computed by
+/// \ref ConnectedComponents, to account for the edges in edge_batch. Edges are
+/// treated as undirected and may or may not already be part of pfg.
+/// Components touched by the batch are merged with a union-find over their
+/// labels, so the work is proportional to the batch size plus one relabeling
+/// pass over the nodes; no edges of pfg are visited.
+/// The property named property_name is updated in place and must exist
+/// before the call.
+KATANA_EXPORT Result<void> ConnectedComponentsIncremental(
+    PropertyFileGraph* pfg, const std::string& property_name,
+    const EdgeBatch& edge_batch);
+
+/// Compute the Connected-components of the RDG stored at rdg_name without
+/// loading its edges into memory, for graphs larger than memory. The
+/// topology is streamed once through a \ref SegmentedTopology with segments
+/// of at most segment_bytes into a lock-free union-find over the nodes, so
+/// memory use is a pointer per node plus two segments. Edges are treated as
+/// undirected, so the graph need not be symmetric.
+/// Returns the component of each node, which is the smallest node id in it.
+KATANA_EXPORT Result<std::shared_ptr<arrow::UInt64Array>>
+ConnectedComponentsSegmented(
+    const std::string& rdg_name,
+    uint64_t segment_bytes = SegmentedTopology::kDefaultSegmentBytes);
+
 KATANA_EXPORT Result<void> ConnectedComponentsAssertValid(
     PropertyFileGraph* pfg, const std::string& property_name);
 
@@ -57,6 +57,8 @@ public:
 /// The graph must be symmetric.
 /// The property named output_property_name is created by this function and may
 /// not exist before the call. The created property has type uint8_t.
+/// With a \ref Deterministic plan, the priority algorithms decide nodes in
+/// bulk-synchronous rounds so that the set is the same on every run.
 KATANA_EXPORT Result<void> IndependentSet(
     PropertyFileGraph* pfg, const std::string& output_property_name,
     IndependentSetPlan plan = {});
@@ -16,8 +16,8 @@ class JaccardPlan : public Plan {
 public:
   enum EdgeSorting {
     /// The edges may be sorted, but may not.
-    /// Jaccard may optimistically use a sorted algorithm and fail over to an
-    /// unsorted one if unsorted edges are detected.
+    /// Jaccard uses the sorted algorithm on the edge-sorted derived topology
+    /// of the graph, which is built once and cached by the graph.
     kUnknown,
     /// The edges are known to be sorted by destination.
     /// Use faster sorted intersection algorithm.
@@ -27,27 +27,75 @@ public:
     kUnsorted,
   };
 
+  /// How the similarity of the neighborhoods A and B of two nodes is measured
+  enum SimilarityMetric {
+    /// |A & B| / |A | B|
+    kJaccard,
+    /// |A & B| / sqrt(|A| * |B|)
+    kCosine,
+  };
+
+  static const uint32_t kDefaultHubDegree = 1024;
+  static const uint32_t kDefaultNumHashes = 64;
+
 private:
   EdgeSorting edge_sorting_;
-
-  JaccardPlan(Architecture architecture, EdgeSorting edge_sorting)
-      : Plan(architecture), edge_sorting_(edge_sorting) {}
+  SimilarityMetric similarity_metric_;
+  uint32_t hub_degree_;
+  uint32_t num_hashes_;
+
+  JaccardPlan(
+      Architecture architecture, EdgeSorting edge_sorting,
+      SimilarityMetric similarity_metric, uint32_t hub_degree,
+      uint32_t num_hashes)
+      : Plan(architecture),
+        edge_sorting_(edge_sorting),
+        similarity_metric_(similarity_metric),
+        hub_degree_(hub_degree),
+        num_hashes_(num_hashes) {}
 
 public:
   /// Automatically choose an algorithm.
-  /// May either use the unsorted algorithm, or use an algorithm that attempts
-  /// the sorted algorithm, but checks for out of order edges.
-  JaccardPlan() : JaccardPlan(kCPU, kUnknown) {}
+  /// Uses the sorted algorithm on a cached edge-sorted derived topology.
+  JaccardPlan() : JaccardPlan(kCPU, kUnknown, kJaccard, 0, 0) {}
 
   JaccardPlan& operator=(const JaccardPlan&) = default;
 
   EdgeSorting edge_sorting() const { return edge_sorting_; }
+  SimilarityMetric similarity_metric() const { return similarity_metric_; }
+  /// Nodes of at least this degree are compared approximately; 0 if all
+  /// similarities are exact
+  uint32_t hub_degree() const { return hub_degree_; }
+  uint32_t num_hashes() const { return num_hashes_; }
 
   /// The graph's edge lists are not sorted; use an algorithm that handles that.
-  static JaccardPlan Unsorted() { return {kCPU, kUnsorted}; }
+  static JaccardPlan Unsorted() {
+    return {kCPU, kUnsorted, kJaccard, 0, 0};
+  }
 
   /// The graph's edge lists are sorted; optimize based on this.
-  static JaccardPlan Sorted() { return {kCPU, kSorted}; }
+  static JaccardPlan Sorted() { return {kCPU, kSorted, kJaccard, 0, 0}; }
+
+  /// Measure exact cosine similarity instead of Jaccard similarity.
+  static JaccardPlan Cosine(EdgeSorting edge_sorting = kUnknown) {
+    return {kCPU, edge_sorting, kCosine, 0, 0};
+  }
+
+  /// Estimate the similarity of pairs involving a hub, a node of out-degree
+  /// at least hub_degree, from MinHash sketches of num_hashes values per node
+  /// instead of intersecting the neighborhoods; other pairs are exact.
+  /// JaccardTopK only estimates pairs of two hubs, and does not look for
+  /// candidates through nodes with at least hub_degree in-edges. Only used
+  /// by JaccardAllEdges and JaccardTopK, which reject a num_hashes of 0.
+  ///
+  /// A. Z. Broder, "On the resemblance and containment of documents,"
+  /// Compression and Complexity of Sequences, 1997.
+  static JaccardPlan MinHash(
+      SimilarityMetric similarity_metric = kJaccard,
+      uint32_t hub_degree = kDefaultHubDegree,
+      uint32_t num_hashes = kDefaultNumHashes) {
+    return {kCPU, kUnknown, similarity_metric, hub_degree, num_hashes};
+  }
 };
 
 /// The tag for the output property of Jaccard in PropertyGraphs.
@@ -55,13 +103,42 @@ using JaccardSimilarity = katana::PODProperty<double>;
 
 /// Compute the Jaccard similarity between each node and compare_node. The
 /// result is stored in a property named by output_property_name. The plan
-/// controls the assumptions made about edge list ordering.
+/// controls the assumptions made about edge list ordering and the similarity
+/// metric.
 /// The property named output_property_name is created by this function and may
 /// not exist before the call.
 KATANA_EXPORT Result<void> Jaccard(
     PropertyFileGraph* pfg, uint32_t compare_node,
     const std::string& output_property_name, JaccardPlan plan = {});
 
+/// Compute the similarity of the endpoints of every edge of pfg. The result
+/// is stored in an edge property (double) named by output_property_name.
+/// Neighborhoods are intersected on the sorted derived topology of pfg
+/// unless the plan says the edges are sorted.
+/// The property named output_property_name is created by this function and may
+/// not exist before the call.
+KATANA_EXPORT Result<void> JaccardAllEdges(
+    PropertyFileGraph* pfg, const std::string& output_property_name,
+    JaccardPlan plan = {});
+
+/// Find, for each node, the k most similar nodes among those that share an
+/// out-neighbor with it, i.e., the in-neighbors of its out-neighbors, or the
+/// neighbors of its neighbors on a symmetric graph (link prediction).
+/// Similarities are those of the out-neighborhoods, as for Jaccard, and the
+/// transposed topology of pfg is derived and cached to find the
+/// candidates. The results are stored in two node properties
+/// of fixed size lists of length k, sorted by decreasing similarity: the ids
+/// of the similar nodes (uint32) in output_nodes_property_name and their
+/// similarities (double) in output_similarities_property_name. Nodes with
+/// fewer than k candidates have null entries at the end of their lists.
+/// The properties are created by this function and may not exist before the
+/// call.
+KATANA_EXPORT Result<void> JaccardTopK(
+    PropertyFileGraph* pfg, uint32_t k,
+    const std::string& output_nodes_property_name,
+    const std::string& output_similarities_property_name,
+    JaccardPlan plan = {});
+
 KATANA_EXPORT Result<void> JaccardAssertValid(
     PropertyFileGraph* pfg, uint32_t compare_node,
     const std::string& property_name);
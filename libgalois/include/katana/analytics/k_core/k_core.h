@@ -2,6 +2,7 @@
 #define KATANA_LIBGALOIS_KATANA_ANALYTICS_KCORE_KCORE_H_
 
 #include <iostream>
+#include <vector>
 
 #include <katana/analytics/Plan.h>
 
@@ -56,9 +57,31 @@ KATANA_EXPORT Result<void> KCoreAssertValid(
     PropertyFileGraph* pfg, uint32_t k_core_number,
     const std::string& property_name);
 
+/// Compute the core number of every node of pfg, i.e., the largest k such
+/// that the node belongs to the k-core. The pfg must be symmetric.
+/// Nodes are peeled in order of degree with a bucketed scheduler: degree
+/// buckets are processed in increasing order and the degree decrements of
+/// each peeling round are batched so that every affected node is moved to
+/// its new bucket once per round. This replaces one call to \ref KCore per
+/// value of k.
+/// The property named output_property_name is created by this function and may
+/// not exist before the call.
+KATANA_EXPORT Result<void> KCoreDecomposition(
+    PropertyFileGraph* pfg, const std::string& output_property_name);
+
+/// Check that the core numbers in property_name are locally consistent: every
+/// node with core number k has at least k neighbors with core number at least
+/// k, and at most k neighbors with core number greater than k.
+KATANA_EXPORT Result<void> KCoreDecompositionAssertValid(
+    PropertyFileGraph* pfg, const std::string& property_name);
+
 struct KATANA_EXPORT KCoreStatistics {
-  /// Total number of node left in the core.
+  /// Total number of node left in the core. For a decomposition, the number
+  /// of nodes in the innermost (maximum) core.
   uint64_t number_of_nodes_in_kcore;
+  /// The number of nodes with each core number; only computed for a
+  /// decomposition.
+  std::vector<uint64_t> core_number_histogram;
 
   /// Print the statistics in a human readable form.
   void Print(std::ostream& os = std::cout) const;
@@ -66,6 +89,11 @@ struct KATANA_EXPORT KCoreStatistics {
   static katana::Result<KCoreStatistics> Compute(
       katana::PropertyFileGraph* pfg, uint32_t k_core_number,
       const std::string& property_name);
+
+  /// Compute the statistics of the core numbers computed by
+  /// \ref KCoreDecomposition.
+  static katana::Result<KCoreStatistics> Compute(
+      katana::PropertyFileGraph* pfg, const std::string& property_name);
 };
 
 }  // namespace katana::analytics
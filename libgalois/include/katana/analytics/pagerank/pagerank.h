@@ -5,7 +5,9 @@
 
 #include "katana/Properties.h"
 #include "katana/PropertyFileGraph.h"
+#include "katana/SegmentedTopology.h"
 #include "katana/analytics/Plan.h"
+#include "katana/analytics/Utils.h"
 
 namespace katana::analytics {
 
@@ -18,6 +20,8 @@ public:
     kPullResidual,
     kPushSynchronous,
     kPushAsynchronous,
+    kPushLocal,
+    kAutomatic,
   };
 
 private:
@@ -38,8 +42,8 @@ public:
 
   constexpr static const unsigned kChunkSize = 16U;
 
-  /// Automatically choose an algorithm.
-  PagerankPlan() : PagerankPlan(kCPU, kPushAsynchronous, 1.0e-3, 0, 0.85) {}
+  /// Automatically choose an algorithm, see \ref ChoosePagerankPlan.
+  PagerankPlan() : PagerankPlan(kCPU, kAutomatic, 1.0e-3, 0, 0.85) {}
 
   PagerankPlan& operator=(const PagerankPlan&) = default;
 
@@ -93,6 +97,29 @@ public:
       float alpha = 0.85) {
     return {kCPU, kPushSynchronous, tolerance, max_iterations, alpha};
   }
+
+  /// Local push algorithm for personalized Page Rank
+  ///
+  /// Like the asynchronous push algorithm, but a node only pushes once its
+  /// residual reaches tolerance times its out degree, so the work is
+  /// proportional to the neighborhood of the seeds rather than to the graph.
+  /// Only supported by \ref PagerankPersonalized and its variants.
+  ///
+  /// ANDERSEN, Reid; CHUNG, Fan; LANG, Kevin. Local graph partitioning using
+  /// pagerank vectors. In: 47th Annual IEEE Symposium on Foundations of
+  /// Computer Science (FOCS'06). IEEE, 2006. p. 475-486.
+  static PagerankPlan PushLocal(float tolerance = 1.0e-6, float alpha = 0.85) {
+    return {kCPU, kPushLocal, tolerance, 0, alpha};
+  }
+
+  /// Choose a push algorithm from the features of the graph when it runs,
+  /// see \ref ChoosePagerankPlan. Personalized Page Rank takes it as
+  /// kPushAsynchronous.
+  static PagerankPlan Automatic(
+      float tolerance = 1.0e-3, unsigned int max_iterations = 1000,
+      float alpha = 0.85) {
+    return {kCPU, kAutomatic, tolerance, max_iterations, alpha};
+  }
 };
 
 /// Compute the Page Rank of each node in the graph.
@@ -102,6 +129,61 @@ KATANA_EXPORT Result<void> Pagerank(
     PropertyFileGraph* pfg, const std::string& output_property_name,
     PagerankPlan plan = {});
 
+/// Update the Page Rank in property_name, previously computed by \ref Pagerank
+/// with one of the push algorithms on pfg without the edges in edge_batch, to
+/// account for those edges. pfg must already contain the batch and, like for
+/// the push algorithms, must not be transposed.
+/// The residual introduced by the batch is pushed from the sources of the
+/// batch edges until it falls below the plan tolerance, so the work is
+/// proportional to the part of the graph the change reaches. The alpha of the
+/// plan should match the one used for the previous result.
+/// The property named property_name is updated in place and must exist
+/// before the call.
+KATANA_EXPORT Result<void> PagerankIncremental(
+    PropertyFileGraph* pfg, const std::string& property_name,
+    const EdgeBatch& edge_batch, PagerankPlan plan = {});
+
+/// Compute the Page Rank of each node personalized to seeds: the random surfer
+/// teleports to a uniformly chosen seed instead of to any node. The ranks sum
+/// to at most 1; mass reaching nodes without out edges is dropped.
+/// Only the push algorithms kPushAsynchronous and kPushLocal, and kAutomatic,
+/// are supported.
+/// Pushing starts at the seeds, so only nodes reached from them do any work.
+/// The property named output_property_name is created by this function and may
+/// not exist before the call.
+KATANA_EXPORT Result<void> PagerankPersonalized(
+    PropertyFileGraph* pfg, const std::vector<uint32_t>& seeds,
+    const std::string& output_property_name, PagerankPlan plan = {});
+
+/// Like \ref PagerankPersonalized, but the surfer teleports to each node with
+/// probability proportional to the float property seed_weight_property_name.
+/// Weights must be non-negative and not all zero.
+KATANA_EXPORT Result<void> PagerankPersonalizedWeighted(
+    PropertyFileGraph* pfg, const std::string& seed_weight_property_name,
+    const std::string& output_property_name, PagerankPlan plan = {});
+
+/// Compute \ref PagerankPersonalized for each seed on its own, storing the
+/// ranks for seeds[i] in output_property_names[i]. All seeds are pushed in the
+/// same pass over the graph, which is much cheaper than one call per seed
+/// since each edge traversal serves every seed. Memory is proportional to the
+/// number of nodes times the number of seeds.
+KATANA_EXPORT Result<void> PagerankMultiSeed(
+    PropertyFileGraph* pfg, const std::vector<uint32_t>& seeds,
+    const std::vector<std::string>& output_property_names,
+    PagerankPlan plan = {});
+
+/// Compute the Page Rank of each node of the RDG stored at rdg_name without
+/// loading its edges into memory, for graphs larger than memory. Each round
+/// of the synchronous push algorithm streams the topology once through a
+/// \ref SegmentedTopology with segments of at most segment_bytes; memory use
+/// is a few words per node plus two segments. plan must be a
+/// \ref PagerankPlan::PushSynchronous plan.
+/// Returns the rank of each node.
+KATANA_EXPORT Result<std::shared_ptr<arrow::FloatArray>> PagerankSegmented(
+    const std::string& rdg_name,
+    PagerankPlan plan = PagerankPlan::PushSynchronous(),
+    uint64_t segment_bytes = SegmentedTopology::kDefaultSegmentBytes);
+
 KATANA_EXPORT Result<void> PagerankAssertValid(
     PropertyFileGraph* pfg, const std::string& property_name);
 
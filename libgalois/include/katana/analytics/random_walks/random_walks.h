@@ -0,0 +1,147 @@
+#ifndef KATANA_LIBGALOIS_KATANA_ANALYTICS_RANDOMWALKS_RANDOMWALKS_H_
+#define KATANA_LIBGALOIS_KATANA_ANALYTICS_RANDOMWALKS_RANDOMWALKS_H_
+
+#include <iostream>
+
+#include <arrow/api.h>
+
+#include "katana/PropertyFileGraph.h"
+#include "katana/analytics/Plan.h"
+#include "katana/analytics/Utils.h"
+
+// API
+
+namespace katana::analytics {
+
+/// A computational plan to for random walks, specifying the algorithm and any
+/// parameters associated with it.
+class RandomWalksPlan : public Plan {
+public:
+  /// Algorithm selectors for random walks
+  enum Algorithm {
+    /// Second order walks biased by the return and in-out parameters
+    kNode2vec,
+    /// node2vec walks further biased by a transition matrix between edge
+    /// types, which is learned from the walks themselves
+    kEdge2vec,
+  };
+
+  // Don't allow people to directly construct these, so as to have only one
+  // consistent way to configure.
+private:
+  Algorithm algorithm_;
+  uint32_t walk_length_;
+  uint32_t number_of_walks_;
+  double backward_probability_;
+  double forward_probability_;
+  uint32_t max_iterations_;
+  uint32_t number_of_edge_types_;
+  uint32_t max_degree_for_edge_tables_;
+
+  RandomWalksPlan(
+      Architecture architecture, Algorithm algorithm, uint32_t walk_length,
+      uint32_t number_of_walks, double backward_probability,
+      double forward_probability, uint32_t max_iterations,
+      uint32_t number_of_edge_types, uint32_t max_degree_for_edge_tables)
+      : Plan(architecture),
+        algorithm_(algorithm),
+        walk_length_(walk_length),
+        number_of_walks_(number_of_walks),
+        backward_probability_(backward_probability),
+        forward_probability_(forward_probability),
+        max_iterations_(max_iterations),
+        number_of_edge_types_(number_of_edge_types),
+        max_degree_for_edge_tables_(max_degree_for_edge_tables) {}
+
+public:
+  RandomWalksPlan() : RandomWalksPlan{Node2vec()} {}
+
+  Algorithm algorithm() const { return algorithm_; }
+  /// The number of edges each walk takes
+  uint32_t walk_length() const { return walk_length_; }
+  /// The number of walks started from each node
+  uint32_t number_of_walks() const { return number_of_walks_; }
+  /// The return parameter p of node2vec; the walk steps back to the node it
+  /// came from with weight 1 / p
+  double backward_probability() const { return backward_probability_; }
+  /// The in-out parameter q of node2vec; the walk steps to nodes that are
+  /// not neighbors of the node it came from with weight 1 / q
+  double forward_probability() const { return forward_probability_; }
+  /// The number of rounds of walks used to learn the edge type transition
+  /// matrix of edge2vec before the walks that are returned
+  uint32_t max_iterations() const { return max_iterations_; }
+  /// The edge types of edge2vec are 0, ..., number_of_edge_types
+  uint32_t number_of_edge_types() const { return number_of_edge_types_; }
+  /// Transition tables of the second order walk are precomputed for the
+  /// edges into nodes of at most this degree; steps out of nodes of larger
+  /// degree use rejection sampling instead. The tables take memory
+  /// proportional to the sum of the degrees of the destinations of those
+  /// edges.
+  uint32_t max_degree_for_edge_tables() const {
+    return max_degree_for_edge_tables_;
+  }
+
+  /// node2vec walks.
+  ///
+  /// GROVER, Aditya; LESKOVEC, Jure. node2vec: Scalable feature learning for
+  /// networks. KDD 2016.
+  static RandomWalksPlan Node2vec(
+      uint32_t walk_length = 10, uint32_t number_of_walks = 1,
+      double backward_probability = 1.0, double forward_probability = 1.0,
+      uint32_t max_degree_for_edge_tables = 32) {
+    return {
+        kCPU,
+        kNode2vec,
+        walk_length,
+        number_of_walks,
+        backward_probability,
+        forward_probability,
+        0,
+        0,
+        max_degree_for_edge_tables};
+  }
+
+  /// edge2vec walks. Edge tables are never used since the transition matrix
+  /// changes between rounds.
+  ///
+  /// GAO, Zheng, et al. edge2vec: Representation learning using edge
+  /// semantics for biomedical knowledge discovery. BMC bioinformatics, 2019.
+  static RandomWalksPlan Edge2vec(
+      uint32_t walk_length = 10, uint32_t number_of_walks = 1,
+      double backward_probability = 1.0, double forward_probability = 1.0,
+      uint32_t max_iterations = 10, uint32_t number_of_edge_types = 1) {
+    return {
+        kCPU,
+        kEdge2vec,
+        walk_length,
+        number_of_walks,
+        backward_probability,
+        forward_probability,
+        max_iterations,
+        number_of_edge_types,
+        0};
+  }
+};
+
+/// Generate random walks on pfg. The pfg must be symmetric.
+///
+/// Edge weights are taken from the property named edge_weight_property_name
+/// (which may be a 32- or 64-bit signed or unsigned int or a float or double)
+/// and must be non-negative; if it is empty every edge has weight 1. For
+/// kEdge2vec the edge types are taken from the uint32_t property named
+/// edge_type_property_name, which is ignored by kNode2vec.
+///
+/// Walk i starts from node i mod num_nodes. A walk stops early at a node
+/// without edges. The walks are returned as a list of node ids per walk.
+KATANA_EXPORT Result<std::shared_ptr<arrow::LargeListArray>> RandomWalks(
+    PropertyFileGraph* pfg, const std::string& edge_weight_property_name,
+    const std::string& edge_type_property_name, RandomWalksPlan plan = {});
+
+/// Check that every step of walks follows an edge of pfg.
+KATANA_EXPORT Result<void> RandomWalksAssertValid(
+    PropertyFileGraph* pfg,
+    const std::shared_ptr<arrow::LargeListArray>& walks);
+
+}  // namespace katana::analytics
+
+#endif
@@ -2,6 +2,7 @@
 #define KATANA_LIBGALOIS_KATANA_ANALYTICS_SSSP_SSSP_H_
 
 #include "katana/AtomicHelpers.h"
+#include "katana/EdgeTiles.h"
 #include "katana/analytics/BfsSsspImplementationBase.h"
 #include "katana/analytics/Plan.h"
 #include "katana/analytics/Utils.h"
@@ -65,10 +66,13 @@ public:
 
   Algorithm algorithm() const { return algorithm_; }
   unsigned delta() const { return delta_; }
+  /// The number of edges per work item of the tiled algorithms, or
+  /// kAdaptiveEdgeTileSize to pick it from the degree distribution of the
+  /// graph
   ptrdiff_t edge_tile_size() const { return edge_tile_size_; }
 
   static SsspPlan DeltaTile(
-      unsigned delta = 13, ptrdiff_t edge_tile_size = 512) {
+      unsigned delta = 13, ptrdiff_t edge_tile_size = kAdaptiveEdgeTileSize) {
     return {kCPU, kDeltaTile, delta, edge_tile_size};
   }
 
@@ -81,7 +85,7 @@ public:
   }
 
   static SsspPlan SerialDeltaTile(
-      unsigned delta = 13, ptrdiff_t edge_tile_size = 512) {
+      unsigned delta = 13, ptrdiff_t edge_tile_size = kAdaptiveEdgeTileSize) {
     return {kCPU, kSerialDeltaTile, delta, edge_tile_size};
   }
 
@@ -89,7 +93,8 @@ public:
     return {kCPU, kSerialDelta, delta, 0};
   }
 
-  static SsspPlan DijkstraTile(ptrdiff_t edge_tile_size = 512) {
+  static SsspPlan DijkstraTile(
+      ptrdiff_t edge_tile_size = kAdaptiveEdgeTileSize) {
     return {kCPU, kDijkstraTile, 0, edge_tile_size};
   }
 
@@ -98,7 +103,8 @@ public:
   // TODO: Should this be "Topological"
   static SsspPlan Topo() { return {kCPU, kTopo, 0, 0}; }
 
-  static SsspPlan TopoTile(ptrdiff_t edge_tile_size = 512) {
+  static SsspPlan TopoTile(
+      ptrdiff_t edge_tile_size = kAdaptiveEdgeTileSize) {
     return {kCPU, kTopoTile, 0, edge_tile_size};
   }
 };
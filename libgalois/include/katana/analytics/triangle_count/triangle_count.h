@@ -96,7 +96,9 @@ public:
  * Count the total number of triangles in the graph. The graph must be
  * symmetric!
  *
- * This algorithm copies the graph internally.
+ * Unless the plan says the edges are sorted and no relabeling is needed, this
+ * algorithm runs on a derived topology cached by pfg (see
+ * PropertyFileGraph::GetDerivedTopology), so pfg itself is not modified.
  *
  * @param pfg The graph to process.
  * @param plan
@@ -104,6 +106,30 @@ public:
 KATANA_EXPORT katana::Result<uint64_t> TriangleCount(
     PropertyFileGraph* pfg, TriangleCountPlan plan = {});
 
+/**
+ * Count the triangles each node is part of and its local clustering
+ * coefficient, the fraction of pairs of its neighbors that are themselves
+ * adjacent. The graph must be symmetric and free of self loops and multi-edges.
+ *
+ * Each edge is intersected once, so this costs a small multiple of
+ * TriangleCount. Nodes are never relabeled, since the results are reported
+ * per node, so only plan.edges_sorted() is used; if it is false the cached
+ * edge-sorted derived topology of pfg is used.
+ *
+ * The properties named triangle_count_property_name (uint64) and
+ * clustering_coefficient_property_name (double) are created by this function
+ * and may not exist before the call.
+ *
+ * @param pfg The graph to process.
+ * @param triangle_count_property_name
+ * @param clustering_coefficient_property_name
+ * @param plan
+ */
+KATANA_EXPORT katana::Result<void> LocalTriangleCount(
+    PropertyFileGraph* pfg, const std::string& triangle_count_property_name,
+    const std::string& clustering_coefficient_property_name,
+    TriangleCountPlan plan = {});
+
 }  // namespace katana::analytics
 
 #endif
@@ -25,6 +25,26 @@
 // anchor vtable
 katana::Barrier::~Barrier() = default;
 
+uint64_t
+katana::Barrier::WaitAndSum(uint64_t value) {
+  // phase_ only changes between the two waits, when every thread has read it
+  unsigned phase = phase_.load(std::memory_order_relaxed);
+  std::atomic<uint64_t>& sum = sums_[phase].get();
+  if (value) {
+    sum.fetch_add(value, std::memory_order_relaxed);
+  }
+  Wait();
+  uint64_t result = sum.load(std::memory_order_relaxed);
+  if (ThreadPool::getTID() == 0) {
+    // The other sum was last read before the second wait of the previous
+    // call
+    sums_[phase ^ 1].get().store(0, std::memory_order_relaxed);
+    phase_.store(phase ^ 1, std::memory_order_relaxed);
+  }
+  Wait();
+  return result;
+}
+
 static katana::Barrier* kBarrier = nullptr;
 static unsigned kBarrierThreads = 0;
 
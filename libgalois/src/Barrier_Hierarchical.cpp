@@ -0,0 +1,131 @@
+#include <atomic>
+
+#include "katana/Barrier.h"
+#include "katana/CacheLineStorage.h"
+#include "katana/CompilerSpecific.h"
+#include "katana/PerThreadStorage.h"
+#include "katana/ThreadPool.h"
+
+namespace {
+
+/// Sense-reversing barrier with one counter per socket and one global
+/// counter. Threads only touch the cache lines of their own socket except
+/// for the last one to arrive on each socket, so an episode moves a constant
+/// number of lines between sockets however many threads there are.
+class HierarchicalBarrier : public katana::Barrier {
+  struct Arrival {
+    std::atomic<unsigned> remaining{0};
+    unsigned expected{0};
+    std::atomic<uint64_t> sum{0};
+  };
+
+  struct Release {
+    std::atomic<unsigned> sense{0};
+    uint64_t result{0};
+  };
+
+  struct Node {
+    katana::CacheLineStorage<Arrival> arrival;
+    katana::CacheLineStorage<Release> release;
+  };
+
+  katana::PerSocketStorage<Node> sockets_;
+  Node global_;
+  katana::PerThreadStorage<unsigned> sense_;
+
+  /// Adds value to node and returns true if this was the last arrival, which
+  /// resets the node for the next episode
+  static bool Arrive(Node* node, uint64_t value, uint64_t* sum) {
+    Arrival& arrival = node->arrival.get();
+    if (value) {
+      arrival.sum.fetch_add(value, std::memory_order_relaxed);
+    }
+    if (arrival.remaining.fetch_sub(1, std::memory_order_acq_rel) != 1) {
+      return false;
+    }
+    *sum = arrival.sum.exchange(0, std::memory_order_relaxed);
+    arrival.remaining.store(arrival.expected, std::memory_order_relaxed);
+    return true;
+  }
+
+  static uint64_t Await(Node* node, unsigned sense) {
+    Release& release = node->release.get();
+    while (release.sense.load(std::memory_order_acquire) != sense) {
+      katana::asmPause();
+    }
+    return release.result;
+  }
+
+  static void Signal(Node* node, unsigned sense, uint64_t result) {
+    Release& release = node->release.get();
+    release.result = result;
+    release.sense.store(sense, std::memory_order_release);
+  }
+
+  void _reinit(unsigned P) {
+    auto& tp = katana::GetThreadPool();
+    unsigned pkgs = tp.getCumulativeMaxSocket(P - 1) + 1;
+    unsigned active_pkgs = 0;
+    for (unsigned i = 0; i < pkgs; ++i) {
+      Node& n = *sockets_.getRemoteByPkg(i);
+      unsigned expected = 0;
+      for (unsigned j = 0; j < P; ++j) {
+        if (tp.getSocket(j) == i) {
+          ++expected;
+        }
+      }
+      n.arrival.get().expected = expected;
+      n.arrival.get().remaining = expected;
+      n.arrival.get().sum = 0;
+      n.release.get().sense = 0;
+      if (expected) {
+        ++active_pkgs;
+      }
+    }
+    global_.arrival.get().expected = active_pkgs;
+    global_.arrival.get().remaining = active_pkgs;
+    global_.arrival.get().sum = 0;
+    global_.release.get().sense = 0;
+    for (unsigned i = 0; i < tp.getMaxUsableThreads(); ++i) {
+      *sense_.getRemote(i) = 0;
+    }
+  }
+
+public:
+  HierarchicalBarrier(unsigned v) { _reinit(v); }
+
+  // not safe if any thread is in wait
+  void Reinit(unsigned val) override { _reinit(val); }
+
+  void Wait() override { WaitAndSum(0); }
+
+  uint64_t WaitAndSum(uint64_t value) override {
+    unsigned& s = *sense_.getLocal();
+    s ^= 1;
+    Node* socket = sockets_.getLocal();
+
+    uint64_t socket_sum = 0;
+    if (!Arrive(socket, value, &socket_sum)) {
+      return Await(socket, s);
+    }
+
+    // Last on this socket: arrive for the whole socket at the global node
+    uint64_t result = 0;
+    if (Arrive(&global_, socket_sum, &result)) {
+      Signal(&global_, s, result);
+    } else {
+      result = Await(&global_, s);
+    }
+    Signal(socket, s, result);
+    return result;
+  }
+
+  const char* name() const override { return "HierarchicalBarrier"; }
+};
+
+}  // namespace
+
+std::unique_ptr<katana::Barrier>
+katana::CreateHierarchicalBarrier(unsigned active_threads) {
+  return std::make_unique<HierarchicalBarrier>(active_threads);
+}
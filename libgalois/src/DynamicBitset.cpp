@@ -25,31 +25,176 @@
 
 #include "katana/Galois.h"
 
+#if defined(__x86_64__)
+#include <immintrin.h>
+#define KATANA_BITSET_X86 1
+#else
+#define KATANA_BITSET_X86 0
+#endif
+
 KATANA_EXPORT katana::DynamicBitset katana::EmptyBitset;
 
+namespace {
+
+using Word = uint64_t;
+
+// Bulk operations run while no thread sets or resets bits, so they may treat
+// the atomic words as plain words, which lets them be vectorized.
+static_assert(sizeof(katana::CopyableAtomic<Word>) == sizeof(Word));
+static_assert(std::atomic<Word>::is_always_lock_free);
+
+/// Words per work item of the bulk operations
+constexpr size_t kWordsPerBlock = 1024;
+
+enum class BitOp { kAnd, kOr, kXor, kAndNot };
+
+template <BitOp op>
+Word
+Apply(Word a, Word b) {
+  switch (op) {
+  case BitOp::kAnd:
+    return a & b;
+  case BitOp::kOr:
+    return a | b;
+  case BitOp::kXor:
+    return a ^ b;
+  case BitOp::kAndNot:
+    return a & ~b;
+  }
+  return 0;
+}
+
+template <BitOp op>
+void
+ApplyScalar(Word* dst, const Word* a, const Word* b, size_t size) {
+  for (size_t i = 0; i < size; ++i) {
+    dst[i] = Apply<op>(a[i], b[i]);
+  }
+}
+
+#if KATANA_BITSET_X86
+
+template <BitOp op>
+__attribute__((target("avx2"))) void
+ApplyAVX2(Word* dst, const Word* a, const Word* b, size_t size) {
+  constexpr size_t kWidth = sizeof(__m256i) / sizeof(Word);
+  size_t i = 0;
+  for (; i + kWidth <= size; i += kWidth) {
+    __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+    __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+    __m256i vr;
+    switch (op) {
+    case BitOp::kAnd:
+      vr = _mm256_and_si256(va, vb);
+      break;
+    case BitOp::kOr:
+      vr = _mm256_or_si256(va, vb);
+      break;
+    case BitOp::kXor:
+      vr = _mm256_xor_si256(va, vb);
+      break;
+    case BitOp::kAndNot:
+      // _mm256_andnot_si256 complements its first argument
+      vr = _mm256_andnot_si256(vb, va);
+      break;
+    }
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), vr);
+  }
+  ApplyScalar<op>(dst + i, a + i, b + i, size - i);
+}
+
+bool
+DetectAVX2() {
+  __builtin_cpu_init();
+  return __builtin_cpu_supports("avx2");
+}
+
+#endif
+
+/// dst[i] = a[i] op b[i] for all words, in parallel blocks. dst may alias a
+/// or b.
+template <BitOp op>
+void
+ApplyBlocks(Word* dst, const Word* a, const Word* b, size_t size) {
+#if KATANA_BITSET_X86
+  static const bool has_avx2 = DetectAVX2();
+#endif
+  katana::do_all(
+      katana::iterate(size_t{0}, (size + kWordsPerBlock - 1) / kWordsPerBlock),
+      [&](size_t block) {
+        size_t begin = block * kWordsPerBlock;
+        size_t n = std::min(size - begin, kWordsPerBlock);
+#if KATANA_BITSET_X86
+        if (has_avx2) {
+          ApplyAVX2<op>(dst + begin, a + begin, b + begin, n);
+          return;
+        }
+#endif
+        ApplyScalar<op>(dst + begin, a + begin, b + begin, n);
+      },
+      katana::no_stats());
+}
+
+template <typename Vec>
+Word*
+Words(Vec& vec) {
+  return reinterpret_cast<Word*>(vec.data());
+}
+
+template <typename Vec>
+const Word*
+Words(const Vec& vec) {
+  return reinterpret_cast<const Word*>(vec.data());
+}
+
+uint64_t
+PopCount(Word n) {
+#ifdef __GNUC__
+  return __builtin_popcountll(n);
+#else
+  n = n - ((n >> 1) & 0x5555555555555555UL);
+  n = (n & 0x3333333333333333UL) + ((n >> 2) & 0x3333333333333333UL);
+  return (((n + (n >> 4)) & 0xF0F0F0F0F0F0F0FUL) * 0x101010101010101UL) >> 56;
+#endif
+}
+
+}  // namespace
+
 void
 katana::DynamicBitset::bitwise_or(const DynamicBitset& other) {
   KATANA_LOG_DEBUG_ASSERT(size() == other.size());
-  const auto& other_bitvec = other.get_vec();
-  katana::do_all(
-      katana::iterate(size_t{0}, bitvec.size()),
-      [&](size_t i) { bitvec[i] |= other_bitvec[i]; }, katana::no_stats());
+  ApplyBlocks<BitOp::kOr>(
+      Words(bitvec), Words(bitvec), Words(other.get_vec()), bitvec.size());
+}
+
+void
+katana::DynamicBitset::bitwise_or(
+    const DynamicBitset& other1, const DynamicBitset& other2) {
+  KATANA_LOG_DEBUG_ASSERT(size() == other1.size());
+  KATANA_LOG_DEBUG_ASSERT(size() == other2.size());
+  ApplyBlocks<BitOp::kOr>(
+      Words(bitvec), Words(other1.get_vec()), Words(other2.get_vec()),
+      bitvec.size());
 }
 
 void
 katana::DynamicBitset::bitwise_not() {
+  Word* words = Words(bitvec);
   katana::do_all(
       katana::iterate(size_t{0}, bitvec.size()),
-      [&](size_t i) { bitvec[i] = ~bitvec[i]; }, katana::no_stats());
+      [&](size_t i) { words[i] = ~words[i]; }, katana::no_stats());
+  // Keep the bits past the end unset so that count() and the offsets only
+  // see bits of the bitset
+  if (!bitvec.empty()) {
+    words[bitvec.size() - 1] = word_at(bitvec.size() - 1);
+  }
 }
 
 void
 katana::DynamicBitset::bitwise_and(const DynamicBitset& other) {
   KATANA_LOG_DEBUG_ASSERT(size() == other.size());
-  const auto& other_bitvec = other.get_vec();
-  katana::do_all(
-      katana::iterate(size_t{0}, bitvec.size()),
-      [&](size_t i) { bitvec[i] &= other_bitvec[i]; }, katana::no_stats());
+  ApplyBlocks<BitOp::kAnd>(
+      Words(bitvec), Words(bitvec), Words(other.get_vec()), bitvec.size());
 }
 
 void
@@ -57,22 +202,16 @@ katana::DynamicBitset::bitwise_and(
     const DynamicBitset& other1, const DynamicBitset& other2) {
   KATANA_LOG_DEBUG_ASSERT(size() == other1.size());
   KATANA_LOG_DEBUG_ASSERT(size() == other2.size());
-  const auto& other_bitvec1 = other1.get_vec();
-  const auto& other_bitvec2 = other2.get_vec();
-
-  katana::do_all(
-      katana::iterate(size_t{0}, bitvec.size()),
-      [&](size_t i) { bitvec[i] = other_bitvec1[i] & other_bitvec2[i]; },
-      katana::no_stats());
+  ApplyBlocks<BitOp::kAnd>(
+      Words(bitvec), Words(other1.get_vec()), Words(other2.get_vec()),
+      bitvec.size());
 }
 
 void
 katana::DynamicBitset::bitwise_xor(const DynamicBitset& other) {
   KATANA_LOG_DEBUG_ASSERT(size() == other.size());
-  const auto& other_bitvec = other.get_vec();
-  katana::do_all(
-      katana::iterate(size_t{0}, bitvec.size()),
-      [&](size_t i) { bitvec[i] ^= other_bitvec[i]; }, katana::no_stats());
+  ApplyBlocks<BitOp::kXor>(
+      Words(bitvec), Words(bitvec), Words(other.get_vec()), bitvec.size());
 }
 
 void
@@ -80,29 +219,41 @@ katana::DynamicBitset::bitwise_xor(
     const DynamicBitset& other1, const DynamicBitset& other2) {
   KATANA_LOG_DEBUG_ASSERT(size() == other1.size());
   KATANA_LOG_DEBUG_ASSERT(size() == other2.size());
-  const auto& other_bitvec1 = other1.get_vec();
-  const auto& other_bitvec2 = other2.get_vec();
+  ApplyBlocks<BitOp::kXor>(
+      Words(bitvec), Words(other1.get_vec()), Words(other2.get_vec()),
+      bitvec.size());
+}
 
-  katana::do_all(
-      katana::iterate(size_t{0}, bitvec.size()),
-      [&](size_t i) { bitvec[i] = other_bitvec1[i] ^ other_bitvec2[i]; },
-      katana::no_stats());
+void
+katana::DynamicBitset::bitwise_andnot(const DynamicBitset& other) {
+  KATANA_LOG_DEBUG_ASSERT(size() == other.size());
+  ApplyBlocks<BitOp::kAndNot>(
+      Words(bitvec), Words(bitvec), Words(other.get_vec()), bitvec.size());
+}
+
+void
+katana::DynamicBitset::bitwise_andnot(
+    const DynamicBitset& other1, const DynamicBitset& other2) {
+  KATANA_LOG_DEBUG_ASSERT(size() == other1.size());
+  KATANA_LOG_DEBUG_ASSERT(size() == other2.size());
+  ApplyBlocks<BitOp::kAndNot>(
+      Words(bitvec), Words(other1.get_vec()), Words(other2.get_vec()),
+      bitvec.size());
 }
 
 uint64_t
 katana::DynamicBitset::count() const {
   katana::GAccumulator<uint64_t> ret;
   katana::do_all(
-      katana::iterate(bitvec.begin(), bitvec.end()),
-      [&](uint64_t n) {
-#ifdef __GNUC__
-        ret += __builtin_popcountll(n);
-#else
-        n = n - ((n >> 1) & 0x5555555555555555UL);
-        n = (n & 0x3333333333333333UL) + ((n >> 2) & 0x3333333333333333UL);
-        ret += (((n + (n >> 4)) & 0xF0F0F0F0F0F0F0FUL) * 0x101010101010101UL) >>
-               56;
-#endif
+      katana::iterate(
+          size_t{0}, (bitvec.size() + kWordsPerBlock - 1) / kWordsPerBlock),
+      [&](size_t block) {
+        size_t end = std::min(bitvec.size(), (block + 1) * kWordsPerBlock);
+        uint64_t block_count = 0;
+        for (size_t w = block * kWordsPerBlock; w < end; ++w) {
+          block_count += PopCount(word_at(w));
+        }
+        ret += block_count;
       },
       katana::no_stats());
   return ret.reduce();
@@ -112,20 +263,21 @@ namespace {
 template <typename Integer>
 std::vector<Integer>
 GetOffsets(const katana::DynamicBitset& bitset) {
-  // TODO uint32_t is somewhat dangerous; change in the future
+  // Each thread counts the set bits of a block of words, the counts are
+  // prefix summed, and then each thread writes the indices of its set bits
+  // starting at its prefix. Both passes work a word at a time.
   uint32_t activeThreads = katana::getActiveThreads();
-  std::vector<Integer> tPrefixBitCounts(activeThreads);
+  std::vector<uint64_t> tPrefixBitCounts(activeThreads);
+  const size_t num_words = bitset.get_vec().size();
 
   // count how many bits are set on each thread
   katana::on_each([&](unsigned tid, unsigned nthreads) {
     auto [start, end] =
-        katana::block_range(size_t{0}, bitset.size(), tid, nthreads);
+        katana::block_range(size_t{0}, num_words, tid, nthreads);
 
-    Integer count = 0;
-    for (Integer i = start; i < end; ++i) {
-      if (bitset.test(i)) {
-        ++count;
-      }
+    uint64_t count = 0;
+    for (size_t w = start; w < end; ++w) {
+      count += PopCount(bitset.word_at(w));
     }
 
     tPrefixBitCounts[tid] = count;
@@ -137,7 +289,7 @@ GetOffsets(const katana::DynamicBitset& bitset) {
   }
 
   // total num of set bits
-  Integer bitsetCount = tPrefixBitCounts[activeThreads - 1];
+  uint64_t bitsetCount = tPrefixBitCounts[activeThreads - 1];
   std::vector<Integer> offsets;
 
   // calculate the indices of the set bits and save them to the offset
@@ -146,19 +298,18 @@ GetOffsets(const katana::DynamicBitset& bitset) {
     offsets.resize(bitsetCount);
     katana::on_each([&](unsigned tid, unsigned nthreads) {
       auto [start, end] =
-          katana::block_range(size_t{0}, bitset.size(), tid, nthreads);
-      Integer count = 0;
-      Integer tPrefixBitCount;
-      if (tid == 0) {
-        tPrefixBitCount = 0;
-      } else {
-        tPrefixBitCount = tPrefixBitCounts[tid - 1];
+          katana::block_range(size_t{0}, num_words, tid, nthreads);
+      Integer* out = offsets.data();
+      if (tid != 0) {
+        out += tPrefixBitCounts[tid - 1];
       }
 
-      for (Integer i = start; i < end; ++i) {
-        if (bitset.test(i)) {
-          offsets[tPrefixBitCount + count] = i;
-          ++count;
+      for (size_t w = start; w < end; ++w) {
+        Word word = bitset.word_at(w);
+        while (word != 0) {
+          *out++ = w * katana::DynamicBitset::bits_uint64 +
+                   __builtin_ctzll(word);
+          word &= word - 1;
         }
       }
     });
@@ -0,0 +1,33 @@
+#include "katana/EdgeTiles.h"
+
+#include <algorithm>
+
+#include "katana/Threads.h"
+
+namespace {
+
+/// Work items per thread; enough for work stealing to even out the tails
+constexpr ptrdiff_t kTilesPerThread = 64;
+constexpr ptrdiff_t kMinEdgeTileSize = 64;
+constexpr ptrdiff_t kMaxEdgeTileSize = 4096;
+
+}  // namespace
+
+ptrdiff_t
+katana::AdaptiveEdgeTileSize(const GraphTopology& topology) {
+  auto num_edges = static_cast<ptrdiff_t>(topology.num_edges());
+  auto num_nodes = static_cast<ptrdiff_t>(topology.num_nodes());
+  if (num_edges == 0 || num_nodes == 0) {
+    return kMinEdgeTileSize;
+  }
+
+  ptrdiff_t balanced =
+      num_edges / (static_cast<ptrdiff_t>(katana::getActiveThreads()) *
+                   kTilesPerThread);
+  // Twice the average degree so that typical nodes stay one work item
+  ptrdiff_t average_degree = (num_edges + num_nodes - 1) / num_nodes;
+  ptrdiff_t lo = std::clamp(
+      2 * average_degree, kMinEdgeTileSize, kMaxEdgeTileSize);
+
+  return std::clamp(balanced, lo, kMaxEdgeTileSize);
+}
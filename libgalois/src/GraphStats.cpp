@@ -0,0 +1,442 @@
+#include "katana/GraphStats.h"
+
+#include <algorithm>
+#include <cstring>
+#include <string_view>
+
+#include <arrow/api.h>
+
+#include "katana/Galois.h"
+#include "katana/HyperLogLog.h"
+#include "katana/JSON.h"
+#include "katana/LargeArray.h"
+#include "katana/ParallelSTL.h"
+#include "katana/PerThreadStorage.h"
+#include "katana/Reduction.h"
+
+namespace katana {
+
+void
+to_json(nlohmann::json& j, const DegreeStats& stats) {
+  j = nlohmann::json{
+      {"max", stats.max},
+      {"mean", stats.mean},
+      {"median", stats.median},
+      {"num_isolated", stats.num_isolated},
+      {"gini", stats.gini},
+      {"top_percent_edge_share", stats.top_percent_edge_share},
+      {"log2_histogram", stats.log2_histogram},
+  };
+}
+
+void
+from_json(const nlohmann::json& j, DegreeStats& stats) {
+  j.at("max").get_to(stats.max);
+  j.at("mean").get_to(stats.mean);
+  j.at("median").get_to(stats.median);
+  j.at("num_isolated").get_to(stats.num_isolated);
+  j.at("gini").get_to(stats.gini);
+  j.at("top_percent_edge_share").get_to(stats.top_percent_edge_share);
+  j.at("log2_histogram").get_to(stats.log2_histogram);
+}
+
+void
+to_json(nlohmann::json& j, const PropertyStats& stats) {
+  j = nlohmann::json{
+      {"name", stats.name},
+      {"type", stats.type},
+      {"null_count", stats.null_count},
+      {"distinct_estimate", stats.distinct_estimate},
+  };
+  if (stats.has_range) {
+    j["min"] = stats.min;
+    j["max"] = stats.max;
+  }
+}
+
+void
+from_json(const nlohmann::json& j, PropertyStats& stats) {
+  j.at("name").get_to(stats.name);
+  j.at("type").get_to(stats.type);
+  j.at("null_count").get_to(stats.null_count);
+  j.at("distinct_estimate").get_to(stats.distinct_estimate);
+  stats.has_range = j.contains("min");
+  if (stats.has_range) {
+    j.at("min").get_to(stats.min);
+    j.at("max").get_to(stats.max);
+  }
+}
+
+void
+to_json(nlohmann::json& j, const GraphStats& stats) {
+  j = nlohmann::json{
+      {"num_nodes", stats.num_nodes},
+      {"num_edges", stats.num_edges},
+      {"out_degree", stats.out_degree},
+      {"in_degree", stats.in_degree},
+      {"node_properties", stats.node_properties},
+      {"edge_properties", stats.edge_properties},
+  };
+}
+
+void
+from_json(const nlohmann::json& j, GraphStats& stats) {
+  j.at("num_nodes").get_to(stats.num_nodes);
+  j.at("num_edges").get_to(stats.num_edges);
+  j.at("out_degree").get_to(stats.out_degree);
+  j.at("in_degree").get_to(stats.in_degree);
+  j.at("node_properties").get_to(stats.node_properties);
+  j.at("edge_properties").get_to(stats.edge_properties);
+}
+
+}  // namespace katana
+
+namespace {
+
+/// Summarize degrees, which are sorted in place
+katana::DegreeStats
+ComputeDegreeStats(katana::LargeArray<uint64_t>* degrees, uint64_t num_edges) {
+  katana::DegreeStats stats;
+  uint64_t num_nodes = degrees->size();
+  if (num_nodes == 0) {
+    return stats;
+  }
+
+  katana::ParallelSTL::sort(degrees->begin(), degrees->end());
+  const uint64_t* begin = degrees->begin();
+  const uint64_t* end = degrees->end();
+
+  stats.max = end[-1];
+  stats.num_isolated = std::upper_bound(begin, end, uint64_t{0}) - begin;
+  if (stats.num_isolated < num_nodes) {
+    stats.mean =
+        static_cast<double>(num_edges) / (num_nodes - stats.num_isolated);
+    stats.median = begin[(stats.num_isolated + num_nodes) / 2];
+  }
+
+  // Bins are contiguous ranges of the sorted degrees
+  const uint64_t* bin_begin = begin;
+  for (uint64_t bound = 1; bin_begin != end; bound *= 2) {
+    const uint64_t* bin_end = std::lower_bound(bin_begin, end, bound);
+    stats.log2_histogram.emplace_back(bin_end - bin_begin);
+    bin_begin = bin_end;
+  }
+
+  if (num_edges == 0) {
+    return stats;
+  }
+
+  uint64_t top = (num_nodes + 99) / 100;
+  katana::GAccumulator<double> weighted_sum;
+  katana::GAccumulator<uint64_t> top_edges;
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_nodes),
+      [&](uint64_t i) {
+        weighted_sum += static_cast<double>(i + 1) * begin[i];
+        if (i >= num_nodes - top) {
+          top_edges += begin[i];
+        }
+      },
+      katana::no_stats(), katana::loopname("DegreeStats"));
+
+  double n = num_nodes;
+  stats.gini = 2 * weighted_sum.reduce() / (n * num_edges) - (n + 1) / n;
+  stats.top_percent_edge_share =
+      static_cast<double>(top_edges.reduce()) / num_edges;
+  return stats;
+}
+
+/// Running summary of the values of a column; one per thread
+struct ColumnSketch {
+  katana::HyperLogLog distinct;
+  bool has_range{false};
+  double min{0};
+  double max{0};
+
+  void AddValue(double value, uint64_t hash) {
+    distinct.Add(hash);
+    if (!has_range) {
+      min = max = value;
+      has_range = true;
+    } else {
+      min = std::min(min, value);
+      max = std::max(max, value);
+    }
+  }
+
+  void Merge(const ColumnSketch& other) {
+    distinct.Merge(other.distinct);
+    if (other.has_range) {
+      AddRange(other.min, other.max);
+    }
+  }
+
+private:
+  void AddRange(double lo, double hi) {
+    min = has_range ? std::min(min, lo) : lo;
+    max = has_range ? std::max(max, hi) : hi;
+    has_range = true;
+  }
+};
+
+template <typename T>
+uint64_t
+HashBits(T value) {
+  uint64_t bits = 0;
+  std::memcpy(&bits, &value, sizeof(value));
+  return katana::HyperLogLog::HashValue(bits);
+}
+
+template <typename ArrayType, typename Fn>
+void
+ForEachValid(
+    const arrow::ChunkedArray& column,
+    katana::PerThreadStorage<ColumnSketch>* sketches, Fn fn) {
+  for (const auto& chunk : column.chunks()) {
+    const auto& array = static_cast<const ArrayType&>(*chunk);
+    katana::do_all(
+        katana::iterate(int64_t{0}, array.length()),
+        [&](int64_t i) {
+          if (array.IsValid(i)) {
+            fn(array, i, sketches->getLocal());
+          }
+        },
+        katana::no_stats(), katana::loopname("PropertyStats"));
+  }
+}
+
+template <typename ArrowType>
+void
+SketchNumeric(
+    const arrow::ChunkedArray& column,
+    katana::PerThreadStorage<ColumnSketch>* sketches) {
+  ForEachValid<arrow::NumericArray<ArrowType>>(
+      column, sketches, [](const auto& array, int64_t i, ColumnSketch* s) {
+        auto value = array.Value(i);
+        s->AddValue(static_cast<double>(value), HashBits(value));
+      });
+}
+
+template <typename ArrayType>
+void
+SketchString(
+    const arrow::ChunkedArray& column,
+    katana::PerThreadStorage<ColumnSketch>* sketches) {
+  ForEachValid<ArrayType>(
+      column, sketches, [](const auto& array, int64_t i, ColumnSketch* s) {
+        auto view = array.GetView(i);
+        s->distinct.Add(katana::HyperLogLog::HashValue(
+            std::string_view(view.data(), view.size())));
+      });
+}
+
+katana::PropertyStats
+ComputePropertyStats(
+    const std::string& name, const arrow::ChunkedArray& column) {
+  katana::PropertyStats stats;
+  stats.name = name;
+  stats.type = column.type()->ToString();
+  stats.null_count = column.null_count();
+
+  katana::PerThreadStorage<ColumnSketch> sketches;
+  switch (column.type()->id()) {
+  case arrow::Type::INT8:
+    SketchNumeric<arrow::Int8Type>(column, &sketches);
+    break;
+  case arrow::Type::UINT8:
+    SketchNumeric<arrow::UInt8Type>(column, &sketches);
+    break;
+  case arrow::Type::INT16:
+    SketchNumeric<arrow::Int16Type>(column, &sketches);
+    break;
+  case arrow::Type::UINT16:
+    SketchNumeric<arrow::UInt16Type>(column, &sketches);
+    break;
+  case arrow::Type::INT32:
+    SketchNumeric<arrow::Int32Type>(column, &sketches);
+    break;
+  case arrow::Type::UINT32:
+    SketchNumeric<arrow::UInt32Type>(column, &sketches);
+    break;
+  case arrow::Type::INT64:
+    SketchNumeric<arrow::Int64Type>(column, &sketches);
+    break;
+  case arrow::Type::UINT64:
+    SketchNumeric<arrow::UInt64Type>(column, &sketches);
+    break;
+  case arrow::Type::FLOAT:
+    SketchNumeric<arrow::FloatType>(column, &sketches);
+    break;
+  case arrow::Type::DOUBLE:
+    SketchNumeric<arrow::DoubleType>(column, &sketches);
+    break;
+  case arrow::Type::BOOL:
+    ForEachValid<arrow::BooleanArray>(
+        column, &sketches, [](const auto& array, int64_t i, ColumnSketch* s) {
+          bool value = array.Value(i);
+          s->AddValue(value, katana::HyperLogLog::HashValue(value));
+        });
+    break;
+  case arrow::Type::STRING:
+    SketchString<arrow::StringArray>(column, &sketches);
+    break;
+  case arrow::Type::LARGE_STRING:
+    SketchString<arrow::LargeStringArray>(column, &sketches);
+    break;
+  default:
+    return stats;
+  }
+
+  ColumnSketch total;
+  for (unsigned i = 0; i < sketches.size(); ++i) {
+    total.Merge(*sketches.getRemote(i));
+  }
+  stats.distinct_estimate = total.distinct.Estimate();
+  stats.has_range = total.has_range;
+  stats.min = total.min;
+  stats.max = total.max;
+  return stats;
+}
+
+void
+PrintDegreeStats(
+    std::ostream& os, const char* name, const katana::DegreeStats& stats) {
+  os << name << ": max " << stats.max << ", mean " << stats.mean
+     << ", median " << stats.median << ", isolated " << stats.num_isolated
+     << ", gini " << stats.gini << ", top 1% edge share "
+     << stats.top_percent_edge_share << "\n";
+  uint64_t lo = 0;
+  for (uint64_t count : stats.log2_histogram) {
+    uint64_t hi = lo == 0 ? 1 : lo * 2;
+    os << "  [" << lo << ", " << hi << "): " << count << "\n";
+    lo = hi;
+  }
+}
+
+void
+PrintPropertyStats(
+    std::ostream& os, const char* kind,
+    const std::vector<katana::PropertyStats>& properties) {
+  for (const auto& p : properties) {
+    os << kind << " property " << p.name << " (" << p.type << "): "
+       << p.null_count << " nulls, ~" << p.distinct_estimate << " distinct";
+    if (p.has_range) {
+      os << ", range [" << p.min << ", " << p.max << "]";
+    }
+    os << "\n";
+  }
+}
+
+/// Drop the statistics of properties that are no longer in schema with the
+/// same type
+void
+DropStalePropertyStats(
+    const arrow::Schema& schema,
+    std::vector<katana::PropertyStats>* properties) {
+  auto stale = [&](const katana::PropertyStats& p) {
+    auto field = schema.GetFieldByName(p.name);
+    return !field || field->type()->ToString() != p.type;
+  };
+  properties->erase(
+      std::remove_if(properties->begin(), properties->end(), stale),
+      properties->end());
+}
+
+}  // namespace
+
+bool
+katana::DegreeStats::IsPowerLaw() const {
+  return mean / 1.3 > median;
+}
+
+katana::Result<katana::GraphStats>
+katana::GraphStats::Compute(const PropertyFileGraph& pfg) {
+  const GraphTopology& topology = pfg.topology();
+  GraphStats stats;
+  stats.num_nodes = topology.num_nodes();
+  stats.num_edges = topology.num_edges();
+
+  katana::LargeArray<uint64_t> out_degrees;
+  katana::LargeArray<uint64_t> in_degrees;
+  out_degrees.allocateBlocked(stats.num_nodes);
+  in_degrees.allocateBlocked(stats.num_nodes);
+  katana::do_all(
+      katana::iterate(uint64_t{0}, stats.num_nodes),
+      [&](uint64_t n) {
+        auto edges = topology.edge_range(n);
+        out_degrees[n] = edges.second - edges.first;
+        in_degrees[n] = 0;
+      },
+      katana::no_stats(), katana::loopname("Degrees"));
+  katana::do_all(
+      katana::iterate(uint64_t{0}, stats.num_edges),
+      [&](uint64_t e) {
+        __sync_fetch_and_add(&in_degrees[topology.out_dests->Value(e)], 1);
+      },
+      katana::no_stats(), katana::loopname("InDegrees"));
+
+  stats.out_degree = ComputeDegreeStats(&out_degrees, stats.num_edges);
+  stats.in_degree = ComputeDegreeStats(&in_degrees, stats.num_edges);
+
+  auto node_schema = pfg.node_schema();
+  for (int i = 0; i < node_schema->num_fields(); ++i) {
+    stats.node_properties.emplace_back(ComputePropertyStats(
+        node_schema->field(i)->name(), *pfg.NodeProperty(i)));
+  }
+  auto edge_schema = pfg.edge_schema();
+  for (int i = 0; i < edge_schema->num_fields(); ++i) {
+    stats.edge_properties.emplace_back(ComputePropertyStats(
+        edge_schema->field(i)->name(), *pfg.EdgeProperty(i)));
+  }
+
+  return stats;
+}
+
+katana::Result<katana::GraphStats>
+katana::GraphStats::Load(const PropertyFileGraph& pfg) {
+  if (pfg.graph_stats().empty()) {
+    return katana::ErrorCode::NotFound;
+  }
+  auto stats_result = FromJson(pfg.graph_stats());
+  if (!stats_result) {
+    return stats_result.error();
+  }
+  GraphStats stats = std::move(stats_result.value());
+  // Stale stats of an earlier version of the graph
+  if (stats.num_nodes != pfg.num_nodes() ||
+      stats.num_edges != pfg.num_edges()) {
+    return katana::ErrorCode::NotFound;
+  }
+  DropStalePropertyStats(*pfg.node_schema(), &stats.node_properties);
+  DropStalePropertyStats(*pfg.edge_schema(), &stats.edge_properties);
+  return stats;
+}
+
+katana::Result<void>
+katana::GraphStats::Store(PropertyFileGraph* pfg) const {
+  auto json_result = ToJson();
+  if (!json_result) {
+    return json_result.error();
+  }
+  return pfg->set_graph_stats(std::move(json_result.value()));
+}
+
+katana::Result<std::string>
+katana::GraphStats::ToJson() const {
+  return katana::JsonDump(*this);
+}
+
+katana::Result<katana::GraphStats>
+katana::GraphStats::FromJson(const std::string& json) {
+  return katana::JsonParse<GraphStats>(json);
+}
+
+void
+katana::GraphStats::Print(std::ostream& os) const {
+  os << "Nodes: " << num_nodes << "\n";
+  os << "Edges: " << num_edges << "\n";
+  PrintDegreeStats(os, "Out degree", out_degree);
+  PrintDegreeStats(os, "In degree", in_degree);
+  PrintPropertyStats(os, "Node", node_properties);
+  PrintPropertyStats(os, "Edge", edge_properties);
+}
@@ -2,11 +2,16 @@
 
 #include <sys/mman.h>
 
+#include <algorithm>
+#include <atomic>
+
 #include "katana/Logging.h"
 #include "katana/Loops.h"
+#include "katana/ParallelSTL.h"
 #include "katana/Platform.h"
 #include "katana/Properties.h"
 #include "katana/Result.h"
+#include "katana/Timer.h"
 #include "tsuba/Errors.h"
 #include "tsuba/FileFrame.h"
 #include "tsuba/RDG.h"
@@ -159,6 +164,210 @@ MakePropertyFileGraph(std::unique_ptr<tsuba::RDGFile> rdg_file) {
       std::move(rdg_file), std::move(rdg_result.value()));
 }
 
+/// Allocate an arrow array of length values that the caller fills through
+/// *data before sharing the array
+template <typename ArrayType>
+katana::Result<std::shared_ptr<ArrayType>>
+AllocateArray(uint64_t length, typename ArrayType::value_type** data) {
+  using T = typename ArrayType::value_type;
+  auto buffer_result =
+      arrow::AllocateBuffer(length * sizeof(T), arrow::default_memory_pool());
+  if (!buffer_result.ok()) {
+    KATANA_LOG_DEBUG("arrow error: {}", buffer_result.status());
+    return katana::ErrorCode::ArrowError;
+  }
+  std::shared_ptr<arrow::Buffer> buffer =
+      std::move(buffer_result.ValueOrDie());
+  *data = reinterpret_cast<T*>(buffer->mutable_data());
+  return std::make_shared<ArrayType>(length, std::move(buffer));
+}
+
+/// Edge lists that are not necessarily sorted or contiguous, the input of the
+/// last step of building a derived topology
+struct AdjacencyLists {
+  katana::LargeArray<uint64_t> begin;
+  katana::LargeArray<uint64_t> degree;
+  // Either the dests of the original topology or owned_dests
+  const uint32_t* dests{nullptr};
+  katana::LargeArray<uint32_t> owned_dests;
+};
+
+/// Reverse the edges of topology, adding them to the original ones if
+/// symmetric is set. The edges of symmetric lists are sorted and free of
+/// duplicates.
+void
+ReverseEdges(
+    const katana::GraphTopology& topology, bool symmetric,
+    AdjacencyLists* lists) {
+  uint64_t num_nodes = topology.num_nodes();
+  const uint32_t* dests = topology.out_dests->raw_values();
+
+  katana::LargeArray<std::atomic<uint64_t>> cursor;
+  cursor.allocateBlocked(num_nodes);
+  katana::do_all(katana::iterate(uint64_t{0}, num_nodes), [&](uint64_t n) {
+    auto [begin, end] = topology.edge_range(n);
+    cursor[n].store(symmetric ? end - begin : 0, std::memory_order_relaxed);
+  });
+  katana::do_all(
+      katana::iterate(topology),
+      [&](uint32_t n) {
+        auto [begin, end] = topology.edge_range(n);
+        for (auto e = begin; e != end; ++e) {
+          cursor[dests[e]].fetch_add(1, std::memory_order_relaxed);
+        }
+      },
+      katana::steal());
+
+  lists->degree.allocateBlocked(num_nodes);
+  lists->begin.allocateBlocked(num_nodes);
+  katana::do_all(katana::iterate(uint64_t{0}, num_nodes), [&](uint64_t n) {
+    lists->degree[n] = cursor[n].load(std::memory_order_relaxed);
+  });
+  katana::ParallelSTL::partial_sum(
+      lists->degree.begin(), lists->degree.end(), lists->begin.begin());
+  uint64_t num_edges = num_nodes > 0 ? lists->begin[num_nodes - 1] : 0;
+  katana::do_all(katana::iterate(uint64_t{0}, num_nodes), [&](uint64_t n) {
+    lists->begin[n] -= lists->degree[n];
+    cursor[n].store(lists->begin[n], std::memory_order_relaxed);
+  });
+
+  lists->owned_dests.allocateBlocked(num_edges);
+  lists->dests = lists->owned_dests.data();
+  auto& out = lists->owned_dests;
+  katana::do_all(
+      katana::iterate(topology),
+      [&](uint32_t n) {
+        auto [begin, end] = topology.edge_range(n);
+        for (auto e = begin; e != end; ++e) {
+          out[cursor[dests[e]].fetch_add(1, std::memory_order_relaxed)] = n;
+          if (symmetric) {
+            out[cursor[n].fetch_add(1, std::memory_order_relaxed)] = dests[e];
+          }
+        }
+      },
+      katana::steal());
+
+  if (symmetric) {
+    katana::do_all(
+        katana::iterate(uint64_t{0}, num_nodes),
+        [&](uint64_t n) {
+          uint32_t* first = &out[lists->begin[n]];
+          uint32_t* last = first + lists->degree[n];
+          std::sort(first, last);
+          lists->degree[n] = std::unique(first, last) - first;
+        },
+        katana::steal());
+  }
+}
+
+/// Sort nodes in descending order of degree, breaking ties like
+/// SortNodesByDegree does
+void
+OrderByDegree(
+    const AdjacencyLists& lists, uint64_t num_nodes,
+    uint32_t* derived_to_original, uint32_t* original_to_derived) {
+  using DegreeNodePair = std::pair<uint64_t, uint32_t>;
+  std::vector<DegreeNodePair> dn_pairs(num_nodes);
+  katana::do_all(katana::iterate(uint64_t{0}, num_nodes), [&](uint64_t n) {
+    dn_pairs[n] = DegreeNodePair(lists.degree[n], n);
+  });
+  katana::ParallelSTL::sort(
+      dn_pairs.begin(), dn_pairs.end(), std::greater<DegreeNodePair>());
+  katana::do_all(katana::iterate(uint64_t{0}, num_nodes), [&](uint64_t i) {
+    derived_to_original[i] = dn_pairs[i].second;
+    original_to_derived[dn_pairs[i].second] = i;
+  });
+}
+
+katana::Result<std::shared_ptr<const katana::DerivedTopology>>
+BuildDerivedTopology(
+    const katana::GraphTopology& topology, uint32_t transforms) {
+  using DerivedTopology = katana::DerivedTopology;
+  uint64_t num_nodes = topology.num_nodes();
+  if (num_nodes == 0) {
+    return std::make_shared<const DerivedTopology>();
+  }
+
+  AdjacencyLists lists;
+  constexpr uint32_t kReversing =
+      DerivedTopology::kTransposed | DerivedTopology::kSymmetric;
+  if (transforms & kReversing) {
+    ReverseEdges(topology, transforms & DerivedTopology::kSymmetric, &lists);
+  } else {
+    lists.begin.allocateBlocked(num_nodes);
+    lists.degree.allocateBlocked(num_nodes);
+    katana::do_all(katana::iterate(uint64_t{0}, num_nodes), [&](uint64_t n) {
+      auto [begin, end] = topology.edge_range(n);
+      lists.begin[n] = begin;
+      lists.degree[n] = end - begin;
+    });
+    lists.dests = topology.out_dests->raw_values();
+  }
+
+  auto derived = std::make_shared<DerivedTopology>();
+
+  uint32_t* derived_to_original = nullptr;
+  uint32_t* original_to_derived = nullptr;
+  if (transforms & DerivedTopology::kDegreeRelabeled) {
+    auto d2o_result = AllocateArray<arrow::UInt32Array>(
+        num_nodes, &derived_to_original);
+    if (!d2o_result) {
+      return d2o_result.error();
+    }
+    auto o2d_result = AllocateArray<arrow::UInt32Array>(
+        num_nodes, &original_to_derived);
+    if (!o2d_result) {
+      return o2d_result.error();
+    }
+    derived->derived_to_original = std::move(d2o_result.value());
+    derived->original_to_derived = std::move(o2d_result.value());
+    OrderByDegree(lists, num_nodes, derived_to_original, original_to_derived);
+  }
+  auto original = [&](uint64_t n) -> uint64_t {
+    return derived_to_original ? derived_to_original[n] : n;
+  };
+
+  uint64_t* out_indices = nullptr;
+  auto indices_result =
+      AllocateArray<arrow::UInt64Array>(num_nodes, &out_indices);
+  if (!indices_result) {
+    return indices_result.error();
+  }
+  katana::do_all(katana::iterate(uint64_t{0}, num_nodes), [&](uint64_t n) {
+    out_indices[n] = lists.degree[original(n)];
+  });
+  katana::ParallelSTL::partial_sum(
+      out_indices, out_indices + num_nodes, out_indices);
+  uint64_t num_edges = num_nodes > 0 ? out_indices[num_nodes - 1] : 0;
+
+  uint32_t* out_dests = nullptr;
+  auto dests_result = AllocateArray<arrow::UInt32Array>(num_edges, &out_dests);
+  if (!dests_result) {
+    return dests_result.error();
+  }
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_nodes),
+      [&](uint64_t n) {
+        uint64_t src = original(n);
+        const uint32_t* first = lists.dests + lists.begin[src];
+        const uint32_t* last = first + lists.degree[src];
+        uint32_t* out = out_dests + (n > 0 ? out_indices[n - 1] : 0);
+        if (original_to_derived) {
+          std::transform(first, last, out, [&](uint32_t d) {
+            return original_to_derived[d];
+          });
+        } else {
+          std::copy(first, last, out);
+        }
+        std::sort(out, out + (last - first));
+      },
+      katana::steal());
+
+  derived->topology.out_indices = std::move(indices_result.value());
+  derived->topology.out_dests = std::move(dests_result.value());
+  return std::shared_ptr<const DerivedTopology>(std::move(derived));
+}
+
 }  // namespace
 
 katana::PropertyFileGraph::PropertyFileGraph() = default;
@@ -323,12 +532,41 @@ katana::PropertyFileGraph::SetTopology(const katana::GraphTopology& topology) {
     return res.error();
   }
   topology_ = topology;
+  DropDerivedTopologies();
 
   return katana::ResultSuccess();
 }
 
+katana::Result<std::shared_ptr<const katana::DerivedTopology>>
+katana::PropertyFileGraph::GetDerivedTopology(uint32_t transforms) {
+  // Building under the lock serializes concurrent requests, which is the
+  // point: the same topology is never built twice. Each build is parallel.
+  std::lock_guard<std::mutex> lock(derived_topologies_->mutex);
+  auto& cached = derived_topologies_->topologies[transforms];
+  if (!cached) {
+    katana::StatTimer timer("DerivedTopology", "PropertyFileGraph");
+    timer.start();
+    auto build_result = BuildDerivedTopology(topology_, transforms);
+    timer.stop();
+    if (!build_result) {
+      derived_topologies_->topologies.erase(transforms);
+      return build_result.error();
+    }
+    cached = std::move(build_result.value());
+  }
+  return cached;
+}
+
+void
+katana::PropertyFileGraph::DropDerivedTopologies() {
+  std::lock_guard<std::mutex> lock(derived_topologies_->mutex);
+  derived_topologies_->topologies.clear();
+}
+
 katana::Result<std::shared_ptr<arrow::UInt64Array>>
 katana::SortAllEdgesByDest(katana::PropertyFileGraph* pfg) {
+  pfg->DropDerivedTopologies();
+
   auto view_result_dests =
       katana::ConstructPropertyView<katana::UInt32Property>(
           pfg->topology().out_dests.get());
@@ -410,6 +648,8 @@ katana::FindEdgeSortedByDest(
 
 katana::Result<void>
 katana::SortNodesByDegree(katana::PropertyFileGraph* pfg) {
+  pfg->DropDerivedTopologies();
+
   uint64_t num_nodes = pfg->topology().num_nodes();
   uint64_t num_edges = pfg->topology().num_edges();
 
@@ -0,0 +1,445 @@
+#include "katana/RoaringBitset.h"
+
+#include <algorithm>
+#include <iterator>
+
+#include "katana/Logging.h"
+
+namespace {
+
+uint64_t
+CountBits(const std::vector<uint64_t>& words) {
+  uint64_t count = 0;
+  for (uint64_t word : words) {
+    count += __builtin_popcountll(word);
+  }
+  return count;
+}
+
+}  // namespace
+
+bool
+katana::RoaringBitset::Container::Test(uint16_t low) const {
+  if (is_bitmap()) {
+    return (bitmap[low / 64] >> (low % 64)) & 1;
+  }
+  return std::binary_search(array.begin(), array.end(), low);
+}
+
+void
+katana::RoaringBitset::Container::Normalize() {
+  if (cardinality == 0) {
+    array = {};
+    bitmap = {};
+    return;
+  }
+
+  if (is_bitmap() && cardinality <= kMaxArraySize) {
+    std::vector<uint16_t> new_array;
+    new_array.reserve(cardinality);
+    for (uint32_t w = 0; w < kBitmapWords; ++w) {
+      uint64_t word = bitmap[w];
+      while (word != 0) {
+        new_array.push_back(w * 64 + __builtin_ctzll(word));
+        word &= word - 1;
+      }
+    }
+    array = std::move(new_array);
+    bitmap = {};
+  } else if (!is_bitmap() && cardinality > kMaxArraySize) {
+    bitmap.assign(kBitmapWords, 0);
+    for (uint16_t low : array) {
+      bitmap[low / 64] |= uint64_t{1} << (low % 64);
+    }
+    array = {};
+  }
+}
+
+katana::RoaringBitset::Container
+katana::RoaringBitset::Combine(const Container& a, const Container& b, Op op) {
+  KATANA_LOG_DEBUG_ASSERT(a.key == b.key);
+  Container result;
+  result.key = a.key;
+
+  auto filter = [&](const Container& from, const Container& by, bool keep) {
+    for (uint16_t low : from.array) {
+      if (by.Test(low) == keep) {
+        result.array.push_back(low);
+      }
+    }
+    result.cardinality = result.array.size();
+  };
+
+  if (!a.is_bitmap() && !b.is_bitmap()) {
+    auto out = std::back_inserter(result.array);
+    switch (op) {
+    case Op::kOr:
+      std::set_union(
+          a.array.begin(), a.array.end(), b.array.begin(), b.array.end(), out);
+      break;
+    case Op::kAnd:
+      std::set_intersection(
+          a.array.begin(), a.array.end(), b.array.begin(), b.array.end(), out);
+      break;
+    case Op::kAndNot:
+      std::set_difference(
+          a.array.begin(), a.array.end(), b.array.begin(), b.array.end(), out);
+      break;
+    }
+    result.cardinality = result.array.size();
+    result.Normalize();
+    return result;
+  }
+
+  // An array and a bitmap: the result is at most as large as the array for
+  // these, so filter the array instead of building a bitmap
+  if (op == Op::kAnd && !a.is_bitmap()) {
+    filter(a, b, true);
+    return result;
+  }
+  if (op == Op::kAnd && !b.is_bitmap()) {
+    filter(b, a, true);
+    return result;
+  }
+  if (op == Op::kAndNot && !a.is_bitmap()) {
+    filter(a, b, false);
+    return result;
+  }
+
+  if (a.is_bitmap()) {
+    result.bitmap = a.bitmap;
+  } else {
+    result.bitmap.assign(kBitmapWords, 0);
+    for (uint16_t low : a.array) {
+      result.bitmap[low / 64] |= uint64_t{1} << (low % 64);
+    }
+  }
+
+  if (b.is_bitmap()) {
+    for (uint32_t w = 0; w < kBitmapWords; ++w) {
+      switch (op) {
+      case Op::kOr:
+        result.bitmap[w] |= b.bitmap[w];
+        break;
+      case Op::kAnd:
+        result.bitmap[w] &= b.bitmap[w];
+        break;
+      case Op::kAndNot:
+        result.bitmap[w] &= ~b.bitmap[w];
+        break;
+      }
+    }
+  } else {
+    // kAnd with an array b was handled above
+    for (uint16_t low : b.array) {
+      uint64_t bit = uint64_t{1} << (low % 64);
+      if (op == Op::kOr) {
+        result.bitmap[low / 64] |= bit;
+      } else {
+        result.bitmap[low / 64] &= ~bit;
+      }
+    }
+  }
+
+  result.cardinality = CountBits(result.bitmap);
+  result.Normalize();
+  return result;
+}
+
+void
+katana::RoaringBitset::Apply(const RoaringBitset& other, Op op) {
+  // Match up containers by key, then combine the pairs in parallel. -1 marks
+  // a container without a partner.
+  std::vector<std::pair<int64_t, int64_t>> pairs;
+  size_t i = 0;
+  size_t j = 0;
+  const auto& theirs = other.containers_;
+  while (i < containers_.size() || j < theirs.size()) {
+    if (j == theirs.size() ||
+        (i < containers_.size() && containers_[i].key < theirs[j].key)) {
+      if (op != Op::kAnd) {
+        pairs.emplace_back(i, -1);
+      }
+      ++i;
+    } else if (
+        i == containers_.size() || theirs[j].key < containers_[i].key) {
+      if (op == Op::kOr) {
+        pairs.emplace_back(-1, j);
+      }
+      ++j;
+    } else {
+      pairs.emplace_back(i, j);
+      ++i;
+      ++j;
+    }
+  }
+
+  std::vector<Container> result(pairs.size());
+  katana::do_all(
+      katana::iterate(size_t{0}, pairs.size()),
+      [&](size_t p) {
+        auto [mine, their] = pairs[p];
+        if (their < 0) {
+          result[p] = std::move(containers_[mine]);
+        } else if (mine < 0) {
+          result[p] = theirs[their];
+        } else {
+          result[p] = Combine(containers_[mine], theirs[their], op);
+        }
+      },
+      katana::steal(), katana::no_stats());
+
+  result.erase(
+      std::remove_if(
+          result.begin(), result.end(),
+          [](const Container& c) { return c.cardinality == 0; }),
+      result.end());
+  containers_ = std::move(result);
+}
+
+void
+katana::RoaringBitset::bitwise_or(const RoaringBitset& other) {
+  Apply(other, Op::kOr);
+}
+
+void
+katana::RoaringBitset::bitwise_and(const RoaringBitset& other) {
+  Apply(other, Op::kAnd);
+}
+
+void
+katana::RoaringBitset::bitwise_andnot(const RoaringBitset& other) {
+  Apply(other, Op::kAndNot);
+}
+
+bool
+katana::RoaringBitset::set(uint64_t index) {
+  uint64_t key = index >> kContainerBits;
+  auto low = static_cast<uint16_t>(index);
+  auto it = std::lower_bound(
+      containers_.begin(), containers_.end(), key,
+      [](const Container& c, uint64_t k) { return c.key < k; });
+  if (it == containers_.end() || it->key != key) {
+    it = containers_.insert(it, Container{});
+    it->key = key;
+  }
+
+  if (it->is_bitmap()) {
+    uint64_t& word = it->bitmap[low / 64];
+    uint64_t bit = uint64_t{1} << (low % 64);
+    if (word & bit) {
+      return true;
+    }
+    word |= bit;
+  } else {
+    auto pos = std::lower_bound(it->array.begin(), it->array.end(), low);
+    if (pos != it->array.end() && *pos == low) {
+      return true;
+    }
+    it->array.insert(pos, low);
+  }
+  ++it->cardinality;
+  it->Normalize();
+  return false;
+}
+
+bool
+katana::RoaringBitset::reset(uint64_t index) {
+  uint64_t key = index >> kContainerBits;
+  auto low = static_cast<uint16_t>(index);
+  auto it = std::lower_bound(
+      containers_.begin(), containers_.end(), key,
+      [](const Container& c, uint64_t k) { return c.key < k; });
+  if (it == containers_.end() || it->key != key) {
+    return false;
+  }
+
+  if (it->is_bitmap()) {
+    uint64_t& word = it->bitmap[low / 64];
+    uint64_t bit = uint64_t{1} << (low % 64);
+    if (!(word & bit)) {
+      return false;
+    }
+    word &= ~bit;
+  } else {
+    auto pos = std::lower_bound(it->array.begin(), it->array.end(), low);
+    if (pos == it->array.end() || *pos != low) {
+      return false;
+    }
+    it->array.erase(pos);
+  }
+  if (--it->cardinality == 0) {
+    containers_.erase(it);
+  } else {
+    it->Normalize();
+  }
+  return true;
+}
+
+bool
+katana::RoaringBitset::test(uint64_t index) const {
+  uint64_t key = index >> kContainerBits;
+  auto it = std::lower_bound(
+      containers_.begin(), containers_.end(), key,
+      [](const Container& c, uint64_t k) { return c.key < k; });
+  return it != containers_.end() && it->key == key &&
+         it->Test(static_cast<uint16_t>(index));
+}
+
+uint64_t
+katana::RoaringBitset::count() const {
+  uint64_t count = 0;
+  for (const Container& c : containers_) {
+    count += c.cardinality;
+  }
+  return count;
+}
+
+size_t
+katana::RoaringBitset::alloc_size() const {
+  size_t size = containers_.capacity() * sizeof(Container);
+  for (const Container& c : containers_) {
+    size += c.array.capacity() * sizeof(uint16_t) +
+            c.bitmap.capacity() * sizeof(uint64_t);
+  }
+  return size;
+}
+
+katana::RoaringBitset
+katana::RoaringBitset::FromBitset(const DynamicBitset& bitset) {
+  const size_t num_words = bitset.get_vec().size();
+  const size_t num_containers = (num_words + kBitmapWords - 1) / kBitmapWords;
+
+  RoaringBitset result;
+  result.containers_.resize(num_containers);
+  katana::do_all(
+      katana::iterate(size_t{0}, num_containers),
+      [&](size_t key) {
+        Container& c = result.containers_[key];
+        c.key = key;
+        size_t begin = key * kBitmapWords;
+        size_t end = std::min(num_words, begin + kBitmapWords);
+
+        uint64_t cardinality = 0;
+        for (size_t w = begin; w < end; ++w) {
+          cardinality += __builtin_popcountll(bitset.word_at(w));
+        }
+        if (cardinality == 0) {
+          return;
+        }
+
+        c.cardinality = cardinality;
+        c.bitmap.assign(kBitmapWords, 0);
+        for (size_t w = begin; w < end; ++w) {
+          c.bitmap[w - begin] = bitset.word_at(w);
+        }
+        c.Normalize();
+      },
+      katana::steal(), katana::no_stats());
+
+  auto& containers = result.containers_;
+  containers.erase(
+      std::remove_if(
+          containers.begin(), containers.end(),
+          [](const Container& c) { return c.cardinality == 0; }),
+      containers.end());
+  return result;
+}
+
+katana::RoaringBitset
+katana::RoaringBitset::FromSortedOffsets(const uint64_t* offsets, size_t size) {
+  RoaringBitset result;
+  size_t begin = 0;
+  while (begin < size) {
+    uint64_t key = offsets[begin] >> kContainerBits;
+    size_t end = begin;
+    while (end < size && (offsets[end] >> kContainerBits) == key) {
+      KATANA_LOG_DEBUG_ASSERT(end == begin || offsets[end - 1] < offsets[end]);
+      ++end;
+    }
+
+    Container& c = result.containers_.emplace_back();
+    c.key = key;
+    c.cardinality = end - begin;
+    if (c.cardinality <= kMaxArraySize) {
+      c.array.assign(offsets + begin, offsets + end);
+    } else {
+      c.bitmap.assign(kBitmapWords, 0);
+      for (size_t i = begin; i < end; ++i) {
+        auto low = static_cast<uint16_t>(offsets[i]);
+        c.bitmap[low / 64] |= uint64_t{1} << (low % 64);
+      }
+    }
+    begin = end;
+  }
+  return result;
+}
+
+void
+katana::RoaringBitset::ToBitset(DynamicBitset* bitset) const {
+  auto& words = bitset->get_vec();
+  KATANA_LOG_DEBUG_ASSERT(
+      containers_.empty() ||
+      (containers_.back().key << kContainerBits) < bitset->size());
+
+  // Containers cover disjoint ranges of words, so each word has one writer
+  katana::do_all(
+      katana::iterate(containers_.begin(), containers_.end()),
+      [&](const Container& c) {
+        size_t base = c.key * kBitmapWords;
+        auto or_word = [&](size_t w, uint64_t bits) {
+          KATANA_LOG_DEBUG_ASSERT(base + w < words.size());
+          auto& word = words[base + w];
+          word.store(
+              word.load(std::memory_order_relaxed) | bits,
+              std::memory_order_relaxed);
+        };
+        if (c.is_bitmap()) {
+          for (uint32_t w = 0; w < kBitmapWords; ++w) {
+            if (c.bitmap[w] != 0) {
+              or_word(w, c.bitmap[w]);
+            }
+          }
+        } else {
+          for (uint16_t low : c.array) {
+            or_word(low / 64, uint64_t{1} << (low % 64));
+          }
+        }
+      },
+      katana::steal(), katana::no_stats());
+}
+
+namespace {
+
+template <typename Integer, typename Containers>
+std::vector<Integer>
+GetOffsets(const Containers& containers) {
+  std::vector<uint64_t> prefix(containers.size() + 1);
+  for (size_t i = 0; i < containers.size(); ++i) {
+    prefix[i + 1] = prefix[i] + containers[i].cardinality;
+  }
+
+  std::vector<Integer> offsets(prefix.back());
+  katana::do_all(
+      katana::iterate(size_t{0}, containers.size()),
+      [&](size_t i) {
+        Integer* out = offsets.data() + prefix[i];
+        containers[i].ForEach([&](uint64_t index) { *out++ = index; });
+      },
+      katana::steal(), katana::no_stats());
+  return offsets;
+}
+
+}  // namespace
+
+template <>
+std::vector<uint32_t>
+katana::RoaringBitset::getOffsets<uint32_t>() const {
+  return GetOffsets<uint32_t>(containers_);
+}
+
+template <>
+std::vector<uint64_t>
+katana::RoaringBitset::getOffsets<uint64_t>() const {
+  return GetOffsets<uint64_t>(containers_);
+}
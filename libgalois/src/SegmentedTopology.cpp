@@ -0,0 +1,152 @@
+#include "katana/SegmentedTopology.h"
+
+#include <algorithm>
+#include <future>
+
+#include <boost/iterator/counting_iterator.hpp>
+
+#include "katana/Logging.h"
+
+katana::Result<katana::SegmentedTopology>
+katana::SegmentedTopology::Make(
+    const std::string& rdg_name, uint64_t segment_bytes) {
+  auto handle = tsuba::Open(rdg_name, tsuba::kReadOnly);
+  if (!handle) {
+    return handle.error();
+  }
+  auto rdg_file = std::make_unique<tsuba::RDGFile>(handle.value());
+
+  auto prefix_result = tsuba::RDGPrefix::Make(*rdg_file);
+  if (!prefix_result) {
+    return prefix_result.error();
+  }
+  tsuba::RDGPrefix prefix = std::move(prefix_result.value());
+  if (!prefix.has_topology()) {
+    KATANA_LOG_DEBUG("{} has no topology", rdg_name);
+    return katana::ErrorCode::NotFound;
+  }
+
+  // Segments address edges as 32-bit destinations directly in the topology
+  // file, see MapTopology
+  if (prefix.version() != 1) {
+    KATANA_LOG_DEBUG("unsupported topology version: {}", prefix.version());
+    return katana::ErrorCode::InvalidArgument;
+  }
+
+  uint64_t num_nodes = prefix.num_nodes();
+  // Bytes taken by the out indices and edges of the first n nodes
+  auto cost = [&](uint64_t n) -> uint64_t {
+    if (n == 0) {
+      return 0;
+    }
+    return n * sizeof(uint64_t) + prefix[n - 1] * sizeof(uint32_t);
+  };
+
+  std::vector<GraphTopology::Node> segment_nodes{0};
+  for (uint64_t begin = 0; begin < num_nodes;) {
+    uint64_t base = cost(begin);
+    auto last_fitting = std::partition_point(
+        boost::counting_iterator<uint64_t>(begin + 1),
+        boost::counting_iterator<uint64_t>(num_nodes + 1),
+        [&](uint64_t end) { return cost(end) - base <= segment_bytes; });
+    // A node whose edges do not fit in a segment gets one of its own
+    uint64_t end = std::max(*last_fitting - 1, begin + 1);
+    segment_nodes.emplace_back(end);
+    begin = end;
+  }
+
+  return SegmentedTopology(
+      std::move(rdg_file), std::move(prefix), std::move(segment_nodes));
+}
+
+katana::Result<katana::SegmentedTopology::LoadedSegment>
+katana::SegmentedTopology::LoadSegment(size_t segment) {
+  GraphTopology::Node node_begin = segment_nodes_[segment];
+  GraphTopology::Node node_end = segment_nodes_[segment + 1];
+  GraphTopology::Edge edge_begin = node_begin > 0 ? prefix_[node_begin - 1] : 0;
+  GraphTopology::Edge edge_end = prefix_[node_end - 1];
+
+  uint64_t topo_off = prefix_.view_offset() + edge_begin * sizeof(uint32_t);
+  uint64_t topo_size = (edge_end - edge_begin) * sizeof(uint32_t);
+
+  std::vector<std::string> no_properties;
+  auto slice_result = tsuba::RDGSlice::Make(
+      *rdg_file_,
+      tsuba::RDGSlice::SliceArg{
+          .node_range = std::make_pair(node_begin, node_end),
+          .edge_range = std::make_pair(edge_begin, edge_end),
+          .topo_off = topo_off,
+          .topo_size = topo_size,
+      },
+      &no_properties, &no_properties);
+  if (!slice_result) {
+    return slice_result.error();
+  }
+
+  // Out indices are rebased to the segment; this runs beside the parallel
+  // loops of the current segment, so it is a plain serial loop.
+  uint64_t num_nodes = node_end - node_begin;
+  auto indices_result = arrow::AllocateBuffer(
+      num_nodes * sizeof(uint64_t), arrow::default_memory_pool());
+  if (!indices_result.ok()) {
+    KATANA_LOG_DEBUG("arrow error: {}", indices_result.status());
+    return katana::ErrorCode::ArrowError;
+  }
+  std::shared_ptr<arrow::Buffer> indices =
+      std::move(indices_result.ValueOrDie());
+  auto* out_indices = reinterpret_cast<uint64_t*>(indices->mutable_data());
+  for (uint64_t n = 0; n < num_nodes; ++n) {
+    out_indices[n] = prefix_[node_begin + n] - edge_begin;
+  }
+
+  // Destinations are used in place in the mapped slice, which stays at the
+  // same address when the slice is moved
+  tsuba::RDGSlice slice = std::move(slice_result.value());
+  auto dests = std::make_shared<arrow::Buffer>(
+      slice.topology_file_storage().ptr<uint8_t>(topo_off), topo_size);
+
+  return LoadedSegment{
+      .slice = std::move(slice),
+      .segment = {
+          .node_begin = node_begin,
+          .node_end = node_end,
+          .edge_begin = edge_begin,
+          .edge_end = edge_end,
+          .topology =
+              GraphTopology{
+                  .out_indices =
+                      std::make_shared<arrow::UInt64Array>(num_nodes, indices),
+                  .out_dests = std::make_shared<arrow::UInt32Array>(
+                      edge_end - edge_begin, dests),
+              },
+      }};
+}
+
+katana::Result<void>
+katana::SegmentedTopology::ForEachSegment(
+    const std::function<Result<void>(const TopologySegment&)>& fn) {
+  if (num_segments() == 0) {
+    return katana::ResultSuccess();
+  }
+
+  auto load = [this](size_t segment) { return LoadSegment(segment); };
+
+  // Double buffering: segment i + 1 is loaded while fn runs on segment i
+  std::future<Result<LoadedSegment>> next =
+      std::async(std::launch::async, load, 0);
+  for (size_t i = 0; i < num_segments(); ++i) {
+    Result<LoadedSegment> current = next.get();
+    if (!current) {
+      return current.error();
+    }
+    if (i + 1 < num_segments()) {
+      next = std::async(std::launch::async, load, i + 1);
+    }
+
+    if (auto res = fn(current.value().segment); !res) {
+      return res.error();
+    }
+  }
+
+  return katana::ResultSuccess();
+}
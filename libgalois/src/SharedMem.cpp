@@ -221,8 +221,8 @@ katana::SharedMem::SharedMem() : impl_(std::make_unique<Impl>()) {
   // The thread pool must be initialized first because other substrate classes
   // may call GetThreadPool() in their constructors
   impl_->deps = std::make_unique<Impl::Dependents>();
-  impl_->deps->barrier =
-      katana::CreateTopoBarrier(impl_->thread_pool.getMaxUsableThreads());
+  impl_->deps->barrier = katana::CreateHierarchicalBarrier(
+      impl_->thread_pool.getMaxUsableThreads());
 
   internal::SetBarrier(impl_->deps->barrier.get());
   internal::SetTerminationDetection(&impl_->deps->term);
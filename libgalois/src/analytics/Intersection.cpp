@@ -0,0 +1,270 @@
+#include "katana/analytics/Intersection.h"
+
+#include <algorithm>
+
+#include "katana/Logging.h"
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#define KATANA_INTERSECTION_X86 1
+#else
+#define KATANA_INTERSECTION_X86 0
+#endif
+
+namespace {
+
+/// Use galloping when the larger set is this many times larger than the
+/// smaller one
+constexpr size_t kGallopRatio = 32;
+
+/// Scalar merge of [a, a_end) and [b, b_end). Written without unpredictable
+/// branches since whether a or b advances is a coin flip.
+uint64_t
+MergeTail(
+    const uint32_t* a, const uint32_t* a_end, const uint32_t* b,
+    const uint32_t* b_end) {
+  uint64_t count = 0;
+  while (a != a_end && b != b_end) {
+    uint32_t x = *a;
+    uint32_t y = *b;
+    count += x == y;
+    a += x <= y;
+    b += y <= x;
+  }
+  return count;
+}
+
+// The block merges compare a block of a against a block of b for all pairs
+// of positions by comparing against every rotation of the block of b, then
+// advance the block whose last element is smaller (both when equal). Each
+// element of a equal to an element of b is counted exactly once because it
+// is compared against the block of b holding its match. The remainders of
+// both sets are merged by MergeTail.
+
+#if KATANA_INTERSECTION_X86
+
+__attribute__((target("sse4.2,popcnt"))) uint64_t
+MergeSSE(const uint32_t* a, size_t a_size, const uint32_t* b, size_t b_size) {
+  constexpr size_t kWidth = 4;
+  const uint32_t* a_end = a + a_size;
+  const uint32_t* b_end = b + b_size;
+  const uint32_t* a_blocks_end = a + (a_size - a_size % kWidth);
+  const uint32_t* b_blocks_end = b + (b_size - b_size % kWidth);
+
+  uint64_t count = 0;
+  while (a != a_blocks_end && b != b_blocks_end) {
+    __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a));
+    __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b));
+    __m128i rot1 = _mm_shuffle_epi32(vb, _MM_SHUFFLE(0, 3, 2, 1));
+    __m128i rot2 = _mm_shuffle_epi32(vb, _MM_SHUFFLE(1, 0, 3, 2));
+    __m128i rot3 = _mm_shuffle_epi32(vb, _MM_SHUFFLE(2, 1, 0, 3));
+    __m128i eq = _mm_or_si128(
+        _mm_or_si128(_mm_cmpeq_epi32(va, vb), _mm_cmpeq_epi32(va, rot1)),
+        _mm_or_si128(_mm_cmpeq_epi32(va, rot2), _mm_cmpeq_epi32(va, rot3)));
+    count += __builtin_popcount(_mm_movemask_ps(_mm_castsi128_ps(eq)));
+
+    uint32_t a_max = a[kWidth - 1];
+    uint32_t b_max = b[kWidth - 1];
+    a += (a_max <= b_max) * kWidth;
+    b += (b_max <= a_max) * kWidth;
+  }
+  return count + MergeTail(a, a_end, b, b_end);
+}
+
+__attribute__((target("avx2,popcnt"))) uint64_t
+MergeAVX2(const uint32_t* a, size_t a_size, const uint32_t* b, size_t b_size) {
+  constexpr size_t kWidth = 8;
+  const uint32_t* a_end = a + a_size;
+  const uint32_t* b_end = b + b_size;
+  const uint32_t* a_blocks_end = a + (a_size - a_size % kWidth);
+  const uint32_t* b_blocks_end = b + (b_size - b_size % kWidth);
+
+  __m256i rotations[kWidth - 1];
+  for (size_t r = 1; r < kWidth; ++r) {
+    alignas(32) uint32_t index[kWidth];
+    for (size_t i = 0; i < kWidth; ++i) {
+      index[i] = (i + r) % kWidth;
+    }
+    rotations[r - 1] =
+        _mm256_load_si256(reinterpret_cast<const __m256i*>(index));
+  }
+
+  uint64_t count = 0;
+  while (a != a_blocks_end && b != b_blocks_end) {
+    __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a));
+    __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b));
+    __m256i eq = _mm256_cmpeq_epi32(va, vb);
+    for (const __m256i& rotation : rotations) {
+      eq = _mm256_or_si256(
+          eq,
+          _mm256_cmpeq_epi32(va, _mm256_permutevar8x32_epi32(vb, rotation)));
+    }
+    count += __builtin_popcount(_mm256_movemask_ps(_mm256_castsi256_ps(eq)));
+
+    uint32_t a_max = a[kWidth - 1];
+    uint32_t b_max = b[kWidth - 1];
+    a += (a_max <= b_max) * kWidth;
+    b += (b_max <= a_max) * kWidth;
+  }
+  return count + MergeTail(a, a_end, b, b_end);
+}
+
+__attribute__((target("avx512f,popcnt"))) uint64_t
+MergeAVX512(
+    const uint32_t* a, size_t a_size, const uint32_t* b, size_t b_size) {
+  constexpr size_t kWidth = 16;
+  const uint32_t* a_end = a + a_size;
+  const uint32_t* b_end = b + b_size;
+  const uint32_t* a_blocks_end = a + (a_size - a_size % kWidth);
+  const uint32_t* b_blocks_end = b + (b_size - b_size % kWidth);
+
+  __m512i rotations[kWidth - 1];
+  for (size_t r = 1; r < kWidth; ++r) {
+    alignas(64) uint32_t index[kWidth];
+    for (size_t i = 0; i < kWidth; ++i) {
+      index[i] = (i + r) % kWidth;
+    }
+    rotations[r - 1] = _mm512_load_si512(index);
+  }
+
+  uint64_t count = 0;
+  while (a != a_blocks_end && b != b_blocks_end) {
+    __m512i va = _mm512_loadu_si512(a);
+    __m512i vb = _mm512_loadu_si512(b);
+    __mmask16 eq = _mm512_cmpeq_epi32_mask(va, vb);
+    for (const __m512i& rotation : rotations) {
+      __m512i rotated = _mm512_maskz_permutexvar_epi32(0xFFFF, rotation, vb);
+      eq |= _mm512_cmpeq_epi32_mask(va, rotated);
+    }
+    count += __builtin_popcount(eq);
+
+    uint32_t a_max = a[kWidth - 1];
+    uint32_t b_max = b[kWidth - 1];
+    a += (a_max <= b_max) * kWidth;
+    b += (b_max <= a_max) * kWidth;
+  }
+  return count + MergeTail(a, a_end, b, b_end);
+}
+
+#endif
+
+katana::analytics::IntersectionKernel
+DetectKernel() {
+#if KATANA_INTERSECTION_X86
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx512f")) {
+    return katana::analytics::IntersectionKernel::kAVX512;
+  }
+  if (__builtin_cpu_supports("avx2")) {
+    return katana::analytics::IntersectionKernel::kAVX2;
+  }
+  if (__builtin_cpu_supports("sse4.2")) {
+    return katana::analytics::IntersectionKernel::kSSE;
+  }
+#endif
+  return katana::analytics::IntersectionKernel::kScalar;
+}
+
+}  // namespace
+
+katana::analytics::IntersectionKernel
+katana::analytics::BestIntersectionKernel() {
+  static const IntersectionKernel kernel = DetectKernel();
+  return kernel;
+}
+
+uint64_t
+katana::analytics::IntersectCountMerge(
+    const uint32_t* a, size_t a_size, const uint32_t* b, size_t b_size,
+    IntersectionKernel kernel) {
+  switch (kernel) {
+#if KATANA_INTERSECTION_X86
+  case IntersectionKernel::kAVX512:
+    return MergeAVX512(a, a_size, b, b_size);
+  case IntersectionKernel::kAVX2:
+    return MergeAVX2(a, a_size, b, b_size);
+  case IntersectionKernel::kSSE:
+    return MergeSSE(a, a_size, b, b_size);
+#endif
+  default:
+    return MergeTail(a, a + a_size, b, b + b_size);
+  }
+}
+
+uint64_t
+katana::analytics::IntersectCountGallop(
+    const uint32_t* small, size_t small_size, const uint32_t* large,
+    size_t large_size) {
+  const uint32_t* large_end = large + large_size;
+  uint64_t count = 0;
+  for (const uint32_t* it = small; it != small + small_size; ++it) {
+    uint32_t x = *it;
+    // Double the step until it overshoots x, then binary search the last
+    // step
+    size_t step = 1;
+    while (step < static_cast<size_t>(large_end - large) &&
+           large[step - 1] < x) {
+      step *= 2;
+    }
+    const uint32_t* bound = large + std::min<size_t>(step, large_end - large);
+    large = std::lower_bound(large + step / 2, bound, x);
+    if (large == large_end) {
+      break;
+    }
+    count += *large == x;
+  }
+  return count;
+}
+
+uint64_t
+katana::analytics::IntersectCount(
+    const uint32_t* a, size_t a_size, const uint32_t* b, size_t b_size) {
+  if (a_size > b_size) {
+    std::swap(a, b);
+    std::swap(a_size, b_size);
+  }
+  if (a_size == 0) {
+    return 0;
+  }
+  if (b_size / a_size >= kGallopRatio) {
+    return IntersectCountGallop(a, a_size, b, b_size);
+  }
+  return IntersectCountMerge(a, a_size, b, b_size, BestIntersectionKernel());
+}
+
+void
+katana::analytics::IntersectionBitmap::Set(const uint32_t* set, size_t size) {
+  if (size == 0) {
+    return;
+  }
+  size_t num_words = *std::max_element(set, set + size) / 64 + 1;
+  if (words_.size() < num_words) {
+    words_.resize(num_words);
+  }
+  for (size_t i = 0; i < size; ++i) {
+    words_[set[i] / 64] |= UINT64_C(1) << (set[i] % 64);
+  }
+}
+
+void
+katana::analytics::IntersectionBitmap::Clear(const uint32_t* set, size_t size) {
+  for (size_t i = 0; i < size; ++i) {
+    KATANA_LOG_DEBUG_ASSERT(set[i] / 64 < words_.size());
+    words_[set[i] / 64] &= ~(UINT64_C(1) << (set[i] % 64));
+  }
+}
+
+uint64_t
+katana::analytics::IntersectionBitmap::Count(
+    const uint32_t* set, size_t size) const {
+  uint64_t count = 0;
+  for (size_t i = 0; i < size; ++i) {
+    size_t word = set[i] / 64;
+    if (word >= words_.size()) {
+      // Sets are sorted, so no later element is in the bitmap either
+      break;
+    }
+    count += (words_[word] >> (set[i] % 64)) & 1;
+  }
+  return count;
+}
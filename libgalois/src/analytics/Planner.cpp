@@ -0,0 +1,266 @@
+#include "katana/analytics/Planner.h"
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "katana/EdgeTiles.h"
+#include "katana/GraphStats.h"
+#include "katana/Reduction.h"
+#include "katana/Statistics.h"
+#include "katana/Threads.h"
+
+namespace {
+
+/// Nodes per thread a bulk-synchronous round needs to be worth its barrier;
+/// the chunk size of the synchronous BFS
+constexpr double kMinFrontierPerThread = 256;
+
+/// Largest SSSP delta chosen, as a shift
+constexpr unsigned kMaxDelta = 30;
+
+/// BFS from a node with edges in the middle of the graph, which stops at a
+/// budget of nodes and edges
+void
+Probe(
+    const katana::GraphTopology& topology,
+    katana::analytics::GraphFeatures* features) {
+  using Node = katana::GraphTopology::Node;
+  using Features = katana::analytics::GraphFeatures;
+
+  uint64_t num_nodes = topology.num_nodes();
+  Node source = num_nodes / 2;
+  for (uint64_t i = 0; i < num_nodes && topology.edges(source).empty(); ++i) {
+    source = (source + 1) % num_nodes;
+  }
+
+  std::unordered_set<Node> visited{source};
+  std::vector<Node> frontier{source};
+  std::vector<Node> next;
+  uint64_t num_edges = 0;
+  uint32_t levels = 0;
+  auto exhausted = [&]() {
+    return visited.size() >= Features::kProbeNodes ||
+           num_edges >= Features::kProbeEdges;
+  };
+
+  while (!exhausted()) {
+    next.clear();
+    for (Node n : frontier) {
+      auto [begin, end] = topology.edge_range(n);
+      for (auto e = begin; e != end; ++e) {
+        Node dest = topology.out_dests->Value(e);
+        if (visited.insert(dest).second) {
+          next.emplace_back(dest);
+        }
+      }
+      num_edges += end - begin;
+      if (exhausted()) {
+        break;
+      }
+    }
+    if (next.empty()) {
+      break;
+    }
+    ++levels;
+    frontier.swap(next);
+  }
+
+  features->probe_levels = levels;
+  features->probe_nodes = visited.size();
+}
+
+/// The criterion of IsApproximateDegreeDistributionPowerLaw on the degrees
+/// of evenly spaced nodes with edges, so that it does not change between runs
+bool
+IsPowerLawSampled(const katana::GraphTopology& topology) {
+  using Features = katana::analytics::GraphFeatures;
+
+  uint64_t num_nodes = topology.num_nodes();
+  if (num_nodes < 10 || topology.num_edges() / num_nodes < 10) {
+    return false;
+  }
+  uint64_t num_samples = std::min(num_nodes, Features::kPowerLawSamples);
+  std::vector<uint64_t> samples;
+  samples.reserve(num_samples);
+  uint64_t sample_total = 0;
+  for (uint64_t i = 0; i < num_samples; ++i) {
+    uint64_t degree = topology.edges(i * num_nodes / num_samples).size();
+    if (degree > 0) {
+      samples.emplace_back(degree);
+      sample_total += degree;
+    }
+  }
+  if (samples.empty()) {
+    return false;
+  }
+  std::sort(samples.begin(), samples.end());
+  double sample_average = static_cast<double>(sample_total) / samples.size();
+  double sample_median = samples[samples.size() / 2];
+  return sample_average / 1.3 > sample_median;
+}
+
+void
+ReportChoice(
+    const std::string& analytic, const std::string& algorithm,
+    const katana::analytics::GraphFeatures& features) {
+  katana::ReportParam("Planner", analytic, algorithm);
+  katana::ReportStatSingle("Planner", "MaxDegree", features.max_degree);
+  katana::ReportStatSingle("Planner", "PowerLaw", features.power_law);
+  katana::ReportStatSingle("Planner", "ProbeLevels", features.probe_levels);
+  katana::ReportStatSingle(
+      "Planner", "AverageFrontier", features.average_frontier());
+  katana::ReportStatSingle("Planner", "EdgeTileSize", features.edge_tile_size);
+}
+
+}  // namespace
+
+double
+katana::analytics::GraphFeatures::average_degree() const {
+  return num_nodes > 0 ? static_cast<double>(num_edges) / num_nodes : 0;
+}
+
+double
+katana::analytics::GraphFeatures::average_frontier() const {
+  return static_cast<double>(probe_nodes) / (probe_levels + 1);
+}
+
+bool
+katana::analytics::GraphFeatures::narrow_frontier() const {
+  // A probe that ran out of nodes early only saw a small component of the
+  // source and says little about the rest of the graph
+  bool representative =
+      2 * probe_nodes >= std::min<uint64_t>(num_nodes, kProbeNodes);
+  return representative && probe_levels > 0 &&
+         average_frontier() < kMinFrontierPerThread * num_threads;
+}
+
+katana::analytics::GraphFeatures
+katana::analytics::GraphFeatures::Compute(const PropertyFileGraph& pfg) {
+  const GraphTopology& topology = pfg.topology();
+
+  GraphFeatures features;
+  features.num_nodes = topology.num_nodes();
+  features.num_edges = topology.num_edges();
+  features.num_threads = katana::getActiveThreads();
+  features.edge_tile_size = katana::AdaptiveEdgeTileSize(topology);
+  if (features.num_nodes == 0) {
+    return features;
+  }
+
+  if (auto stats = katana::GraphStats::Load(pfg); stats) {
+    features.max_degree = stats.value().out_degree.max;
+    features.power_law = features.num_nodes >= 10 &&
+                         features.average_degree() >= 10 &&
+                         stats.value().out_degree.IsPowerLaw();
+  } else {
+    katana::GReduceMax<uint64_t> max_degree;
+    katana::do_all(
+        katana::iterate(topology),
+        [&](GraphTopology::Node n) {
+          max_degree.update(topology.edges(n).size());
+        },
+        katana::no_stats(), katana::loopname("PlannerMaxDegree"));
+    features.max_degree = max_degree.reduce();
+    features.power_law = IsPowerLawSampled(topology);
+  }
+
+  Probe(topology, &features);
+  return features;
+}
+
+void
+katana::analytics::GraphFeatures::Print(std::ostream& os) const {
+  os << "Nodes: " << num_nodes << "\n";
+  os << "Edges: " << num_edges << "\n";
+  os << "Average degree: " << average_degree() << "\n";
+  os << "Max degree: " << max_degree << "\n";
+  os << "Power law: " << (power_law ? "yes" : "no") << "\n";
+  os << "Probe: " << probe_nodes << " nodes in " << probe_levels
+     << " levels, average frontier " << average_frontier() << "\n";
+  os << "Threads: " << num_threads << "\n";
+  os << "Edge tile size: " << edge_tile_size << "\n";
+}
+
+katana::analytics::BfsPlan
+katana::analytics::ChooseBfsPlan(const GraphFeatures& features) {
+  // Narrow frontiers leave a bulk-synchronous BFS waiting at a barrier every
+  // level; the asynchronous algorithms run ahead without one
+  if (features.narrow_frontier()) {
+    if (features.has_hubs()) {
+      ReportChoice("BFS", "AsynchronousTile", features);
+      return BfsPlan::AsynchronousTile(features.edge_tile_size);
+    }
+    ReportChoice("BFS", "Asynchronous", features);
+    return BfsPlan::Asynchronous();
+  }
+  if (features.has_hubs()) {
+    ReportChoice("BFS", "SynchronousTile", features);
+    return BfsPlan::SynchronousTile(features.edge_tile_size);
+  }
+  ReportChoice("BFS", "Synchronous", features);
+  return BfsPlan::Synchronous();
+}
+
+katana::analytics::ConnectedComponentsPlan
+katana::analytics::ChooseConnectedComponentsPlan(
+    const GraphFeatures& features) {
+  // Afforest links components without traversing them, so it is as fast on
+  // high diameter graphs as on low diameter ones
+  if (features.num_threads == 1) {
+    ReportChoice("ConnectedComponents", "Serial", features);
+    return ConnectedComponentsPlan::Serial();
+  }
+  if (features.has_hubs()) {
+    ReportChoice("ConnectedComponents", "EdgeTiledAfforest", features);
+    return ConnectedComponentsPlan::EdgeTiledAfforest(features.edge_tile_size);
+  }
+  ReportChoice("ConnectedComponents", "Afforest", features);
+  return ConnectedComponentsPlan::Afforest();
+}
+
+katana::analytics::PagerankPlan
+katana::analytics::ChoosePagerankPlan(
+    const GraphFeatures& features, const PagerankPlan& params) {
+  // Residuals converge unevenly on skewed and on high diameter graphs, where
+  // the data-driven push only works on the nodes that still change. On the
+  // rest all nodes stay active for about the same number of rounds and
+  // sweeping them is cheaper than scheduling them.
+  if (features.num_threads == 1 || features.power_law ||
+      features.narrow_frontier()) {
+    ReportChoice("Pagerank", "PushAsynchronous", features);
+    return PagerankPlan::PushAsynchronous(params.tolerance(), params.alpha());
+  }
+  ReportChoice("Pagerank", "PushSynchronous", features);
+  unsigned max_iterations =
+      params.max_iterations() > 0 ? params.max_iterations() : 1000;
+  return PagerankPlan::PushSynchronous(
+      params.tolerance(), max_iterations, params.alpha());
+}
+
+katana::analytics::SsspPlan
+katana::analytics::ChooseSsspPlan(
+    const GraphFeatures& features, const WeightFeatures& weights) {
+  double width = weights.max / std::max(features.average_degree(), 1.0);
+  auto delta = static_cast<unsigned>(std::clamp(
+      std::floor(std::log2(std::max(width, 1.0))), 0.0,
+      static_cast<double>(kMaxDelta)));
+  katana::ReportStatSingle("Planner", "SSSP-Delta", delta);
+
+  if (features.num_threads == 1) {
+    ReportChoice("SSSP", "SerialDelta", features);
+    return SsspPlan::SerialDelta(delta);
+  }
+  if (!features.power_law) {
+    ReportChoice("SSSP", "DeltaStepBarrier", features);
+    return SsspPlan::DeltaStepBarrier(delta);
+  }
+  if (features.has_hubs()) {
+    ReportChoice("SSSP", "DeltaTile", features);
+    return SsspPlan::DeltaTile(delta, features.edge_tile_size);
+  }
+  ReportChoice("SSSP", "DeltaStep", features);
+  return SsspPlan::DeltaStep(delta);
+}
@@ -19,8 +19,27 @@
 
 #include "katana/analytics/Utils.h"
 
+#include <arrow/array.h>
+
+#include "katana/GraphStats.h"
+#include "katana/Loops.h"
 #include "katana/Random.h"
 
+namespace {
+
+template <typename ArrowType>
+void
+CopyEdgeWeights(const arrow::Array& array, katana::LargeArray<double>* out) {
+  const auto& weights =
+      static_cast<const arrow::NumericArray<ArrowType>&>(array);
+  katana::do_all(
+      katana::iterate(uint64_t{0}, static_cast<uint64_t>(weights.length())),
+      [&](uint64_t e) { (*out)[e] = weights.Value(e); }, katana::no_stats(),
+      katana::loopname("CopyEdgeWeights"));
+}
+
+}  // namespace
+
 uint32_t
 katana::analytics::SourcePicker::PickNext() {
   uint32_t source;
@@ -41,6 +60,10 @@ katana::analytics::IsApproximateDegreeDistributionPowerLaw(
   if (averageDegree < 10) {
     return false;
   }
+  // Statistics cached with the graph cover every node, not just a sample
+  if (auto stats = katana::GraphStats::Load(graph); stats) {
+    return stats.value().out_degree.IsPowerLaw();
+  }
   SourcePicker sp(graph);
   uint32_t num_samples = 1000;
   if (num_samples > graph.num_nodes()) {
@@ -58,3 +81,66 @@ katana::analytics::IsApproximateDegreeDistributionPowerLaw(
   double sample_median = samples[num_samples / 2];
   return sample_average / 1.3 > sample_median;
 }
+
+katana::Result<void>
+katana::analytics::CheckEdgeBatch(
+    const PropertyFileGraph& graph, const EdgeBatch& edge_batch) {
+  for (const auto& [src, dest] : edge_batch) {
+    if (src >= graph.num_nodes() || dest >= graph.num_nodes()) {
+      KATANA_LOG_DEBUG(
+          "edge ({}, {}) is not in a graph with {} nodes", src, dest,
+          graph.num_nodes());
+      return katana::ErrorCode::InvalidArgument;
+    }
+  }
+  return katana::ResultSuccess();
+}
+
+katana::Result<void>
+katana::analytics::ReadEdgeWeights(
+    const PropertyFileGraph& graph,
+    const std::string& edge_weight_property_name, LargeArray<double>* out) {
+  out->allocateBlocked(graph.num_edges());
+  if (edge_weight_property_name.empty()) {
+    katana::do_all(
+        katana::iterate(uint64_t{0}, graph.num_edges()),
+        [&](uint64_t e) { (*out)[e] = 1; }, katana::no_stats(),
+        katana::loopname("CopyEdgeWeights"));
+    return katana::ResultSuccess();
+  }
+
+  auto property = graph.EdgeProperty(edge_weight_property_name);
+  if (!property) {
+    return katana::ErrorCode::PropertyNotFound;
+  }
+  if (property->num_chunks() != 1) {
+    KATANA_LOG_DEBUG(
+        "expected 1 chunk in {}, found {}", edge_weight_property_name,
+        property->num_chunks());
+    return katana::ErrorCode::InvalidArgument;
+  }
+  const arrow::Array& array = *property->chunk(0);
+  switch (array.type()->id()) {
+  case arrow::UInt32Type::type_id:
+    CopyEdgeWeights<arrow::UInt32Type>(array, out);
+    break;
+  case arrow::Int32Type::type_id:
+    CopyEdgeWeights<arrow::Int32Type>(array, out);
+    break;
+  case arrow::UInt64Type::type_id:
+    CopyEdgeWeights<arrow::UInt64Type>(array, out);
+    break;
+  case arrow::Int64Type::type_id:
+    CopyEdgeWeights<arrow::Int64Type>(array, out);
+    break;
+  case arrow::FloatType::type_id:
+    CopyEdgeWeights<arrow::FloatType>(array, out);
+    break;
+  case arrow::DoubleType::type_id:
+    CopyEdgeWeights<arrow::DoubleType>(array, out);
+    break;
+  default:
+    return katana::ErrorCode::TypeError;
+  }
+  return katana::ResultSuccess();
+}
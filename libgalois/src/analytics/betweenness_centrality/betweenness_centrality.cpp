@@ -41,6 +41,8 @@ katana::analytics::BetweennessCentrality(
     return BetweennessCentralityLevel(pfg, sources, output_property_name, plan);
   case BetweennessCentralityPlan::kOuter:
     return BetweennessCentralityOuter(pfg, sources, output_property_name, plan);
+  case BetweennessCentralityPlan::kSampling:
+    return BetweennessCentralitySampling(pfg, output_property_name, plan);
   default:
     return katana::ErrorCode::InvalidArgument;
   }
@@ -51,6 +53,10 @@ BetweennessCentralityStatistics::Print(std::ostream& os) {
   os << "Maximum centrality = " << max_centrality << std::endl;
   os << "Minimum centrality = " << min_centrality << std::endl;
   os << "Average centrality = " << average_centrality << std::endl;
+  if (num_samples > 0) {
+    os << "Error bound = " << error_bound << std::endl;
+    os << "Number of samples = " << num_samples << std::endl;
+  }
 }
 
 katana::Result<BetweennessCentralityStatistics>
@@ -77,7 +83,26 @@ BetweennessCentralityStatistics::Compute(
       katana::no_stats(),
       katana::loopname("Betweenness Centrality Statistics"));
 
+  float error_bound = 0;
+  uint64_t num_samples = 0;
+  auto field = pfg->node_schema()->GetFieldByName(output_property_name);
+  if (field && field->HasMetadata()) {
+    const auto& metadata = field->metadata();
+    if (auto i = metadata->FindKey(kBetweennessCentralityErrorBoundKey);
+        i >= 0) {
+      error_bound = std::stof(metadata->value(i));
+    }
+    if (auto i = metadata->FindKey(kBetweennessCentralityNumSamplesKey);
+        i >= 0) {
+      num_samples = std::stoull(metadata->value(i));
+    }
+  }
+
   return BetweennessCentralityStatistics{
-      accum_max.reduce(), accum_min.reduce(),
-      accum_sum.reduce() / pfg->num_nodes()};
+      accum_max.reduce(),
+      accum_min.reduce(),
+      accum_sum.reduce() / pfg->num_nodes(),
+      error_bound,
+      num_samples,
+  };
 }
@@ -16,4 +16,15 @@ katana::Result<void> BetweennessCentralityLevel(
     const std::string& output_property_name,
     katana::analytics::BetweennessCentralityPlan plan);
 
+katana::Result<void> BetweennessCentralitySampling(
+    katana::PropertyFileGraph* pfg, const std::string& output_property_name,
+    katana::analytics::BetweennessCentralityPlan plan);
+
+/// Keys of the metadata of the output field of the sampling algorithm, from
+/// which \ref BetweennessCentralityStatistics recovers its accuracy
+constexpr const char* kBetweennessCentralityErrorBoundKey =
+    "katana.betweenness_centrality.error_bound";
+constexpr const char* kBetweennessCentralityNumSamplesKey =
+    "katana.betweenness_centrality.num_samples";
+
 #endif
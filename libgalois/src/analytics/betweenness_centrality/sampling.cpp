@@ -0,0 +1,267 @@
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include <arrow/util/key_value_metadata.h>
+
+#include "betweenness_centrality_impl.h"
+#include "katana/LargeArray.h"
+#include "katana/Timer.h"
+
+using namespace katana::analytics;
+
+namespace {
+
+using GNode = katana::GraphTopology::Node;
+
+constexpr uint32_t kUnvisited = std::numeric_limits<uint32_t>::max();
+/// Target of a BFS that visits everything reachable
+constexpr GNode kNoTarget = std::numeric_limits<GNode>::max();
+
+/// Constant of the Riondato-Kornaropoulos sample size bound
+constexpr double kSampleSizeConstant = 0.5;
+/// Number of BFS used to estimate the vertex diameter
+constexpr uint32_t kDiameterProbes = 8;
+/// Samples taken before the error is first checked
+constexpr uint64_t kFirstRoundSamples = 1024;
+constexpr uint64_t kSeed = 0x6bc1e7c5;
+
+/// Per-thread state of a shortest path sample. The arrays span every node but
+/// only the nodes a BFS visits are reset after it, so a sample costs time
+/// proportional to the part of the graph it explores.
+struct SampleState {
+  std::vector<uint32_t> distance;
+  std::vector<double> sigma;
+  std::vector<GNode> predecessor;
+  std::vector<GNode> queue;
+  std::mt19937_64 rng;
+};
+
+class BCSampler {
+  const katana::GraphTopology& topology_;
+  const uint32_t* dests_;
+  katana::PerThreadStorage<SampleState> states_;
+
+public:
+  BCSampler(const katana::GraphTopology& topology)
+      : topology_(topology), dests_(topology.out_dests->raw_values()) {
+    uint64_t num_nodes = topology.num_nodes();
+    katana::on_each([&](unsigned tid, unsigned) {
+      SampleState& state = *states_.getLocal();
+      state.distance.assign(num_nodes, kUnvisited);
+      state.sigma.assign(num_nodes, 0);
+      state.predecessor.resize(num_nodes);
+      state.rng.seed(kSeed + tid);
+    });
+  }
+
+  /// BFS from source, stopping once the level of target (unless kNoTarget) is
+  /// complete.
+  /// Each node's predecessor is drawn with probability proportional to its
+  /// number of shortest paths as the BFS discovers them, so following
+  /// predecessors back from target gives a uniformly random shortest path
+  /// without needing the incoming edges. Returns the distance to the farthest
+  /// node visited.
+  uint32_t Bfs(SampleState* state, GNode source, GNode target) {
+    auto& distance = state->distance;
+    auto& sigma = state->sigma;
+    auto& queue = state->queue;
+    std::uniform_real_distribution<double> coin;
+
+    queue.clear();
+    queue.push_back(source);
+    distance[source] = 0;
+    sigma[source] = 1;
+
+    for (size_t head = 0; head < queue.size(); ++head) {
+      GNode src = queue[head];
+      if (target != kNoTarget && distance[target] != kUnvisited &&
+          distance[src] >= distance[target]) {
+        break;
+      }
+      auto [begin, end] = topology_.edge_range(src);
+      for (auto e = begin; e != end; ++e) {
+        GNode dest = dests_[e];
+        if (distance[dest] == kUnvisited) {
+          distance[dest] = distance[src] + 1;
+          queue.push_back(dest);
+        }
+        if (distance[dest] == distance[src] + 1) {
+          sigma[dest] += sigma[src];
+          if (coin(state->rng) * sigma[dest] < sigma[src]) {
+            state->predecessor[dest] = src;
+          }
+        }
+      }
+    }
+    return distance[queue.back()];
+  }
+
+  void Reset(SampleState* state) {
+    for (GNode n : state->queue) {
+      state->distance[n] = kUnvisited;
+      state->sigma[n] = 0;
+    }
+  }
+
+  /// Sample a shortest path between a random pair of distinct nodes and count
+  /// it for its internal nodes
+  void Sample(katana::LargeArray<std::atomic<uint64_t>>* counts) {
+    SampleState* state = states_.getLocal();
+    uint64_t num_nodes = topology_.num_nodes();
+    std::uniform_int_distribution<GNode> pick(0, num_nodes - 1);
+    GNode source = pick(state->rng);
+    GNode target = std::uniform_int_distribution<GNode>(0, num_nodes - 2)(
+        state->rng);
+    target += target >= source;
+
+    Bfs(state, source, target);
+    if (state->distance[target] != kUnvisited) {
+      for (GNode n = state->predecessor[target]; n != source;
+           n = state->predecessor[n]) {
+        (*counts)[n].fetch_add(1, std::memory_order_relaxed);
+      }
+    }
+    Reset(state);
+  }
+
+  /// Estimate the vertex diameter, the number of nodes on the longest
+  /// shortest path, as twice the largest eccentricity found from a few random
+  /// nodes. This is a bound for undirected graphs and a heuristic for
+  /// directed ones; the sample size only grows with its logarithm.
+  uint64_t EstimateVertexDiameter() {
+    SampleState* state = states_.getLocal();
+    uint64_t num_nodes = topology_.num_nodes();
+    std::uniform_int_distribution<GNode> pick(0, num_nodes - 1);
+    uint64_t eccentricity = 0;
+    for (uint32_t i = 0; i < kDiameterProbes; ++i) {
+      eccentricity = std::max<uint64_t>(
+          eccentricity, Bfs(state, pick(state->rng), kNoTarget));
+      Reset(state);
+    }
+    return std::min<uint64_t>(num_nodes, 2 * eccentricity + 1);
+  }
+};
+
+/// Error of the empirical Bernstein bound (Maurer and Pontil) for the mean of
+/// num_samples values in [0, 1] with empirical mean mean, holding with
+/// probability 1 - delta
+double
+EmpiricalBernsteinError(double mean, uint64_t num_samples, double delta) {
+  double log_term = std::log(2 / delta);
+  double variance = mean * (1 - mean);
+  return std::sqrt(2 * variance * log_term / num_samples) +
+         7 * log_term / (3 * (num_samples - 1));
+}
+
+}  // namespace
+
+katana::Result<void>
+BetweennessCentralitySampling(
+    katana::PropertyFileGraph* pfg, const std::string& output_property_name,
+    BetweennessCentralityPlan plan) {
+  double epsilon = plan.epsilon();
+  double delta = plan.delta();
+  if (!(epsilon > 0 && epsilon < 1) || !(delta > 0 && delta < 1)) {
+    KATANA_LOG_DEBUG(
+        "epsilon ({}) and delta ({}) must be in (0, 1)", epsilon, delta);
+    return katana::ErrorCode::InvalidArgument;
+  }
+
+  uint64_t num_nodes = pfg->num_nodes();
+  katana::LargeArray<std::atomic<uint64_t>> counts;
+  counts.allocateBlocked(num_nodes);
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_nodes),
+      [&](uint64_t n) { counts[n] = 0; }, katana::no_stats(),
+      katana::loopname("Initialize"));
+
+  katana::StatTimer exec_time("Betweenness Centrality Sampling");
+  exec_time.start();
+
+  uint64_t num_samples = 0;
+  double achieved_epsilon = 0;
+  if (num_nodes > 2) {
+    BCSampler sampler(pfg->topology());
+
+    // Half of delta goes to the fixed sample size bound, which always holds
+    // once it is reached; the other half is split over the rounds of the
+    // adaptive bound, delta / 2^(i + 2) for round i, and over the nodes.
+    uint64_t vertex_diameter = sampler.EstimateVertexDiameter();
+    double vc_term = vertex_diameter > 2
+                         ? std::floor(std::log2(vertex_diameter - 2)) + 1
+                         : 1;
+    uint64_t max_samples = std::ceil(
+        kSampleSizeConstant / (epsilon * epsilon) *
+        (vc_term + std::log(2 / delta)));
+
+    uint64_t round_end = std::min(max_samples, kFirstRoundSamples);
+    for (uint32_t round = 0;; ++round) {
+      katana::do_all(
+          katana::iterate(num_samples, round_end),
+          [&](uint64_t) { sampler.Sample(&counts); }, katana::steal(),
+          katana::chunk_size<64>(), katana::loopname("Sample"));
+      num_samples = round_end;
+
+      if (num_samples >= max_samples) {
+        achieved_epsilon = std::sqrt(
+            kSampleSizeConstant * (vc_term + std::log(2 / delta)) /
+            num_samples);
+        break;
+      }
+
+      // The bound grows with the mean up to 1/2, so the largest count gives
+      // the error of every node
+      katana::GReduceMax<uint64_t> max_count;
+      katana::do_all(
+          katana::iterate(uint64_t{0}, num_nodes),
+          [&](uint64_t n) { max_count.update(counts[n].load()); },
+          katana::no_stats(), katana::loopname("MaxCount"));
+      double mean = std::min(
+          0.5, static_cast<double>(max_count.reduce()) / num_samples);
+      double round_delta = delta / std::pow(2.0, round + 2) / num_nodes;
+      achieved_epsilon =
+          EmpiricalBernsteinError(mean, num_samples, round_delta);
+      if (achieved_epsilon <= epsilon) {
+        break;
+      }
+      round_end = std::min(max_samples, 2 * num_samples);
+    }
+  }
+
+  exec_time.stop();
+
+  katana::ReportStatSingle(
+      "Betweenness Centrality Sampling", "Samples", num_samples);
+
+  // Scale the fraction of sampled paths through each node to the number of
+  // pairs, the scale of the exact algorithms
+  double num_pairs = static_cast<double>(num_nodes) * (num_nodes - 1);
+  arrow::FloatBuilder builder;
+  if (auto r = builder.Resize(num_nodes); !r.ok()) {
+    return katana::ErrorCode::ArrowError;
+  }
+  for (uint64_t n = 0; n < num_nodes; ++n) {
+    double fraction =
+        num_samples > 0 ? static_cast<double>(counts[n]) / num_samples : 0;
+    builder.UnsafeAppend(fraction * num_pairs);
+  }
+  std::shared_ptr<arrow::FloatArray> values;
+  if (auto r = builder.Finish(&values); !r.ok()) {
+    return katana::ErrorCode::ArrowError;
+  }
+
+  auto metadata = arrow::key_value_metadata(
+      {kBetweennessCentralityErrorBoundKey,
+       kBetweennessCentralityNumSamplesKey},
+      {std::to_string(achieved_epsilon * num_pairs),
+       std::to_string(num_samples)});
+  auto table = arrow::Table::Make(
+      arrow::schema({arrow::field(
+          output_property_name, arrow::float32(), true, metadata)}),
+      {values});
+  return pfg->AddNodeProperties(table);
+}
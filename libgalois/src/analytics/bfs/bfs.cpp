@@ -20,6 +20,7 @@
 #include <deque>
 #include <type_traits>
 
+#include "katana/analytics/Planner.h"
 #include "katana/analytics/bfs/bfs_internal.h"
 
 using namespace katana::analytics;
@@ -190,6 +191,11 @@ SynchronousAlgo(
 
   auto curr = std::make_unique<Cont>();
   auto next = std::make_unique<Cont>();
+  if constexpr (CONCURRENT) {
+    // The frontiers are refilled every level; keep their blocks
+    curr->set_block_recycling();
+    next->set_block_recycling();
+  }
 
   Dist next_level = 0U;
   graph->GetData<BfsNodeDistance>(source) = 0U;
@@ -228,7 +234,8 @@ SynchronousAlgo(
 template <bool CONCURRENT>
 void
 RunAlgo(BfsPlan algo, Graph* graph, const Graph::Node& source) {
-  BfsImplementation impl{algo.edge_tile_size()};
+  BfsImplementation impl{katana::ChooseEdgeTileSize(
+      algo.edge_tile_size(), graph->GetPropertyFileGraph().topology())};
   switch (algo.algorithm()) {
   case BfsPlan::kAsynchronousTile:
     AsynchronousAlgo<CONCURRENT, SrcEdgeTile>(
@@ -273,6 +280,10 @@ BfsImpl(
   katana::StatTimer execTime("BFS");
   execTime.start();
 
+  if (algo.algorithm() == BfsPlan::kAutomatic) {
+    algo = ChooseBfsPlan(GraphFeatures::Compute(graph.GetPropertyFileGraph()));
+  }
+
   RunAlgo<true>(algo, &graph, source);
 
   execTime.stop();
@@ -0,0 +1,511 @@
+#include <algorithm>
+#include <unordered_map>
+#include <vector>
+
+#include "clustering_impl.h"
+#include "katana/AtomicHelpers.h"
+#include "katana/ParallelSTL.h"
+#include "katana/analytics/Utils.h"
+
+using katana::atomicAdd;
+
+namespace {
+
+void
+ComputeDegrees(ClusteringGraph* graph) {
+  graph->degree.allocateBlocked(graph->num_nodes);
+  katana::GAccumulator<double> total_weight;
+  katana::do_all(
+      katana::iterate(uint64_t{0}, graph->num_nodes),
+      [&](uint64_t n) {
+        double degree = 0;
+        for (uint64_t e = graph->edge_begin[n]; e < graph->edge_begin[n + 1];
+             ++e) {
+          degree += graph->edge_weight[e];
+        }
+        graph->degree[n] = degree;
+        total_weight += degree;
+      },
+      katana::steal(), katana::no_stats(), katana::loopname("Degrees"));
+  graph->total_weight = total_weight.reduce();
+}
+
+/// The total degree of every community
+void
+CommunityDegrees(
+    const ClusteringGraph& graph, const CommunityArray& communities,
+    katana::LargeArray<std::atomic<double>>* community_degree) {
+  katana::do_all(
+      katana::iterate(uint64_t{0}, graph.num_nodes),
+      [&](uint64_t c) { (*community_degree)[c] = 0; }, katana::no_stats(),
+      katana::loopname("CommunityDegrees"));
+  katana::do_all(
+      katana::iterate(uint64_t{0}, graph.num_nodes),
+      [&](uint64_t n) {
+        atomicAdd((*community_degree)[communities[n]], graph.degree[n]);
+      },
+      katana::no_stats(), katana::loopname("CommunityDegrees"));
+}
+
+}  // namespace
+
+katana::Result<ClusteringGraph>
+MakeClusteringGraph(
+    const katana::PropertyFileGraph& pfg,
+    const std::string& edge_weight_property_name) {
+  const katana::GraphTopology& topology = pfg.topology();
+
+  ClusteringGraph graph;
+  graph.num_nodes = topology.num_nodes();
+  graph.edge_begin.allocateBlocked(graph.num_nodes + 1);
+  graph.edge_dest.allocateBlocked(topology.num_edges());
+
+  graph.edge_begin[0] = 0;
+  const uint64_t* indices = topology.out_indices->raw_values();
+  const uint32_t* dests = topology.out_dests->raw_values();
+  katana::do_all(
+      katana::iterate(uint64_t{0}, graph.num_nodes),
+      [&](uint64_t n) { graph.edge_begin[n + 1] = indices[n]; },
+      katana::no_stats(), katana::loopname("CopyTopology"));
+  katana::do_all(
+      katana::iterate(uint64_t{0}, topology.num_edges()),
+      [&](uint64_t e) { graph.edge_dest[e] = dests[e]; }, katana::no_stats(),
+      katana::loopname("CopyTopology"));
+
+  if (auto r = katana::analytics::ReadEdgeWeights(
+          pfg, edge_weight_property_name, &graph.edge_weight);
+      !r) {
+    return r.error();
+  }
+
+  ComputeDegrees(&graph);
+  return ClusteringGraph(std::move(graph));
+}
+
+void
+InitializeSingletons(
+    const ClusteringGraph& graph, CommunityArray* communities) {
+  communities->allocateBlocked(graph.num_nodes);
+  katana::do_all(
+      katana::iterate(uint64_t{0}, graph.num_nodes),
+      [&](uint64_t n) { (*communities)[n] = n; }, katana::no_stats(),
+      katana::loopname("InitializeSingletons"));
+}
+
+double
+ClusteringModularity(
+    const ClusteringGraph& graph, const CommunityArray& communities,
+    double resolution) {
+  if (graph.total_weight == 0) {
+    return 0;
+  }
+
+  katana::LargeArray<std::atomic<double>> community_degree;
+  community_degree.allocateBlocked(graph.num_nodes);
+  CommunityDegrees(graph, communities, &community_degree);
+
+  katana::GAccumulator<double> internal_weight;
+  katana::GAccumulator<double> degree_squares;
+  katana::do_all(
+      katana::iterate(uint64_t{0}, graph.num_nodes),
+      [&](uint64_t n) {
+        uint32_t community = communities[n];
+        for (uint64_t e = graph.edge_begin[n]; e < graph.edge_begin[n + 1];
+             ++e) {
+          if (communities[graph.edge_dest[e]] == community) {
+            internal_weight += graph.edge_weight[e];
+          }
+        }
+        double degree = community_degree[n];
+        degree_squares += degree * degree;
+      },
+      katana::steal(), katana::no_stats(), katana::loopname("Modularity"));
+
+  double constant = 1 / graph.total_weight;
+  return internal_weight.reduce() * constant -
+         resolution * degree_squares.reduce() * constant * constant;
+}
+
+double
+LocalMove(
+    const ClusteringGraph& graph, CommunityArray* communities,
+    double resolution, double threshold, uint32_t max_iterations,
+    uint32_t* iterations) {
+  katana::LargeArray<std::atomic<double>> community_degree;
+  community_degree.allocateBlocked(graph.num_nodes);
+  CommunityDegrees(graph, *communities, &community_degree);
+
+  katana::LargeArray<std::atomic<uint64_t>> community_size;
+  community_size.allocateBlocked(graph.num_nodes);
+  katana::do_all(
+      katana::iterate(uint64_t{0}, graph.num_nodes),
+      [&](uint64_t c) { community_size[c] = 0; }, katana::no_stats(),
+      katana::loopname("CommunitySizes"));
+  katana::do_all(
+      katana::iterate(uint64_t{0}, graph.num_nodes),
+      [&](uint64_t n) { community_size[(*communities)[n]] += 1; },
+      katana::no_stats(), katana::loopname("CommunitySizes"));
+
+  // constant is 1 / 2m
+  double constant = graph.total_weight > 0 ? 1 / graph.total_weight : 0;
+  double modularity = ClusteringModularity(graph, *communities, resolution);
+
+  while (*iterations < max_iterations) {
+    ++*iterations;
+    katana::GAccumulator<uint64_t> moves;
+
+    katana::do_all(
+        katana::iterate(uint64_t{0}, graph.num_nodes),
+        [&](uint64_t n) {
+          double degree = graph.degree[n];
+          if (graph.edge_begin[n] == graph.edge_begin[n + 1]) {
+            return;
+          }
+
+          thread_local std::unordered_map<uint32_t, double> weight_to;
+          weight_to.clear();
+          uint32_t current = (*communities)[n].load(std::memory_order_relaxed);
+          weight_to[current] = 0;
+          for (uint64_t e = graph.edge_begin[n]; e < graph.edge_begin[n + 1];
+               ++e) {
+            uint32_t dest = graph.edge_dest[e];
+            if (dest == n) {
+              continue;
+            }
+            weight_to[(*communities)[dest].load(std::memory_order_relaxed)] +=
+                graph.edge_weight[e];
+          }
+
+          double current_weight = weight_to[current];
+          double current_degree = community_degree[current] - degree;
+          uint32_t best = current;
+          double best_gain = 0;
+          for (const auto& [community, weight] : weight_to) {
+            if (community == current) {
+              continue;
+            }
+            double community_degree_c = community_degree[community];
+            double gain = 2 * constant * (weight - current_weight) +
+                          2 * degree * resolution *
+                              (current_degree - community_degree_c) *
+                              constant * constant;
+            if (gain > best_gain ||
+                (gain == best_gain && gain > 0 && community < best)) {
+              best_gain = gain;
+              best = community;
+            }
+          }
+
+          // Two singletons that pick each other would only swap communities
+          // and undo each other's gain, so, as in the lonestar app, a
+          // singleton only joins a singleton with a smaller id
+          if (best != current && best > current &&
+              community_size[best].load(std::memory_order_relaxed) == 1 &&
+              community_size[current].load(std::memory_order_relaxed) == 1) {
+            best = current;
+          }
+
+          if (best != current) {
+            atomicAdd(community_degree[best], degree);
+            atomicAdd(community_degree[current], -degree);
+            community_size[best] += 1;
+            community_size[current] -= 1;
+            (*communities)[n].store(best, std::memory_order_relaxed);
+            moves += 1;
+          }
+        },
+        katana::steal(), katana::loopname("LocalMove"));
+
+    double next_modularity =
+        ClusteringModularity(graph, *communities, resolution);
+    double gain = next_modularity - modularity;
+    modularity = next_modularity;
+    if (moves.reduce() == 0 || gain < threshold) {
+      break;
+    }
+  }
+
+  return modularity;
+}
+
+uint64_t
+RenumberCommunities(CommunityArray* communities) {
+  uint64_t num_nodes = communities->size();
+  katana::LargeArray<std::atomic<uint32_t>> used;
+  used.allocateBlocked(num_nodes);
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_nodes), [&](uint64_t c) { used[c] = 0; },
+      katana::no_stats(), katana::loopname("Renumber"));
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_nodes),
+      [&](uint64_t n) {
+        used[(*communities)[n]].store(1, std::memory_order_relaxed);
+      },
+      katana::no_stats(), katana::loopname("Renumber"));
+
+  katana::LargeArray<uint32_t> new_id;
+  new_id.allocateBlocked(num_nodes);
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_nodes),
+      [&](uint64_t c) { new_id[c] = used[c]; }, katana::no_stats(),
+      katana::loopname("Renumber"));
+  katana::ParallelSTL::partial_sum(
+      new_id.begin(), new_id.end(), new_id.begin());
+  uint64_t num_communities = num_nodes > 0 ? new_id[num_nodes - 1] : 0;
+
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_nodes),
+      [&](uint64_t n) { (*communities)[n] = new_id[(*communities)[n]] - 1; },
+      katana::no_stats(), katana::loopname("Renumber"));
+  return num_communities;
+}
+
+void
+GroupMembers(
+    const CommunityArray& communities, uint64_t num_communities,
+    katana::LargeArray<uint64_t>* member_begin,
+    katana::LargeArray<uint32_t>* members) {
+  // A counting sort of the nodes by community
+  uint64_t num_nodes = communities.size();
+  member_begin->allocateBlocked(num_communities + 1);
+  katana::LargeArray<std::atomic<uint64_t>> cursor;
+  cursor.allocateBlocked(num_communities);
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_communities),
+      [&](uint64_t c) { cursor[c] = 0; }, katana::no_stats(),
+      katana::loopname("GroupMembers"));
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_nodes),
+      [&](uint64_t n) {
+        cursor[communities[n]].fetch_add(1, std::memory_order_relaxed);
+      },
+      katana::no_stats(), katana::loopname("GroupMembers"));
+  (*member_begin)[0] = 0;
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_communities),
+      [&](uint64_t c) { (*member_begin)[c + 1] = cursor[c]; },
+      katana::no_stats(), katana::loopname("GroupMembers"));
+  katana::ParallelSTL::partial_sum(
+      member_begin->begin(), member_begin->end(), member_begin->begin());
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_communities),
+      [&](uint64_t c) { cursor[c] = (*member_begin)[c]; }, katana::no_stats(),
+      katana::loopname("GroupMembers"));
+  members->allocateBlocked(num_nodes);
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_nodes),
+      [&](uint64_t n) { (*members)[cursor[communities[n]]++] = n; },
+      katana::no_stats(), katana::loopname("GroupMembers"));
+}
+
+ClusteringGraph
+Coarsen(
+    const ClusteringGraph& graph, const CommunityArray& communities,
+    uint64_t num_communities) {
+  katana::LargeArray<uint64_t> member_begin;
+  katana::LargeArray<uint32_t> members;
+  GroupMembers(communities, num_communities, &member_begin, &members);
+
+  // Merge the edges of the members of each community by destination
+  // community, then lay the merged lists out in CSR form
+  std::vector<std::vector<std::pair<uint32_t, double>>> edges(num_communities);
+  ClusteringGraph coarse;
+  coarse.num_nodes = num_communities;
+  coarse.edge_begin.allocateBlocked(num_communities + 1);
+  coarse.edge_begin[0] = 0;
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_communities),
+      [&](uint64_t c) {
+        thread_local std::unordered_map<uint32_t, double> weight_to;
+        weight_to.clear();
+        for (uint64_t i = member_begin[c]; i < member_begin[c + 1]; ++i) {
+          uint32_t n = members[i];
+          for (uint64_t e = graph.edge_begin[n]; e < graph.edge_begin[n + 1];
+               ++e) {
+            weight_to[communities[graph.edge_dest[e]]] += graph.edge_weight[e];
+          }
+        }
+        edges[c].assign(weight_to.begin(), weight_to.end());
+        std::sort(edges[c].begin(), edges[c].end());
+        coarse.edge_begin[c + 1] = edges[c].size();
+      },
+      katana::steal(), katana::loopname("CoarsenEdges"));
+
+  katana::ParallelSTL::partial_sum(
+      coarse.edge_begin.begin(), coarse.edge_begin.end(),
+      coarse.edge_begin.begin());
+  uint64_t num_edges = coarse.edge_begin[num_communities];
+  coarse.edge_dest.allocateBlocked(num_edges);
+  coarse.edge_weight.allocateBlocked(num_edges);
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_communities),
+      [&](uint64_t c) {
+        uint64_t e = coarse.edge_begin[c];
+        for (const auto& [dest, weight] : edges[c]) {
+          coarse.edge_dest[e] = dest;
+          coarse.edge_weight[e] = weight;
+          ++e;
+        }
+        std::vector<std::pair<uint32_t, double>>().swap(edges[c]);
+      },
+      katana::steal(), katana::no_stats(), katana::loopname("CoarsenLayout"));
+
+  ComputeDegrees(&coarse);
+  return coarse;
+}
+
+katana::Result<void>
+WriteCommunities(
+    katana::PropertyFileGraph* pfg,
+    const katana::LargeArray<uint32_t>& communities,
+    const std::string& output_property_name) {
+  uint64_t num_nodes = pfg->num_nodes();
+  auto buffer_result = arrow::AllocateBuffer(
+      num_nodes * sizeof(uint64_t), arrow::default_memory_pool());
+  if (!buffer_result.ok()) {
+    KATANA_LOG_DEBUG("arrow error: {}", buffer_result.status());
+    return katana::ErrorCode::ArrowError;
+  }
+  std::shared_ptr<arrow::Buffer> buffer = std::move(buffer_result.ValueOrDie());
+  auto* data = reinterpret_cast<uint64_t*>(buffer->mutable_data());
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_nodes),
+      [&](uint64_t n) { data[n] = communities[n]; }, katana::no_stats(),
+      katana::loopname("WriteCommunities"));
+
+  auto table = arrow::Table::Make(
+      arrow::schema({arrow::field(output_property_name, arrow::uint64())}),
+      {std::make_shared<arrow::UInt64Array>(num_nodes, std::move(buffer))});
+  return pfg->AddNodeProperties(table);
+}
+
+katana::Result<void>
+katana::analytics::ClusteringAssertValid(
+    PropertyFileGraph* pfg, const std::string& property_name) {
+  auto property_result = pfg->NodePropertyTyped<uint64_t>(property_name);
+  if (!property_result) {
+    return property_result.error();
+  }
+  auto property = property_result.value();
+  uint64_t num_nodes = pfg->num_nodes();
+
+  katana::LargeArray<std::atomic<uint8_t>> used;
+  used.allocateBlocked(num_nodes);
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_nodes), [&](uint64_t c) { used[c] = 0; },
+      katana::no_stats());
+  katana::GAccumulator<uint64_t> out_of_range;
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_nodes),
+      [&](uint64_t n) {
+        uint64_t community = property->Value(n);
+        if (community >= num_nodes) {
+          out_of_range += 1;
+          return;
+        }
+        used[community].store(1, std::memory_order_relaxed);
+      },
+      katana::no_stats());
+  if (out_of_range.reduce() > 0) {
+    return katana::ErrorCode::AssertionFailed;
+  }
+
+  // Communities are contiguous if the used ones are a prefix of the ids
+  katana::GAccumulator<uint64_t> num_used;
+  katana::GReduceMax<uint64_t> max_used;
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_nodes),
+      [&](uint64_t c) {
+        if (used[c]) {
+          num_used += 1;
+          max_used.update(c);
+        }
+      },
+      katana::no_stats());
+  if (num_nodes > 0 && max_used.reduce() + 1 != num_used.reduce()) {
+    return katana::ErrorCode::AssertionFailed;
+  }
+  return katana::ResultSuccess();
+}
+
+void
+katana::analytics::ClusteringStatistics::Print(std::ostream& os) const {
+  os << "Total number of clusters = " << n_clusters << std::endl;
+  os << "Total number of non trivial clusters = " << n_non_trivial_clusters
+     << std::endl;
+  os << "Number of nodes in the largest cluster = " << largest_cluster_size
+     << std::endl;
+  os << "Ratio of nodes in the largest cluster = " << largest_cluster_proportion
+     << std::endl;
+  os << "Modularity = " << modularity << std::endl;
+}
+
+katana::Result<katana::analytics::ClusteringStatistics>
+katana::analytics::ClusteringStatistics::Compute(
+    PropertyFileGraph* pfg, const std::string& edge_weight_property_name,
+    const std::string& property_name) {
+  auto property_result = pfg->NodePropertyTyped<uint64_t>(property_name);
+  if (!property_result) {
+    return property_result.error();
+  }
+  auto property = property_result.value();
+  uint64_t num_nodes = pfg->num_nodes();
+
+  auto graph_result = MakeClusteringGraph(*pfg, edge_weight_property_name);
+  if (!graph_result) {
+    return graph_result.error();
+  }
+  ClusteringGraph graph = std::move(graph_result.value());
+
+  CommunityArray communities;
+  communities.allocateBlocked(num_nodes);
+  katana::LargeArray<std::atomic<uint64_t>> sizes;
+  sizes.allocateBlocked(num_nodes);
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_nodes),
+      [&](uint64_t n) { sizes[n] = 0; }, katana::no_stats());
+  katana::GAccumulator<uint64_t> out_of_range;
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_nodes),
+      [&](uint64_t n) {
+        uint64_t community = property->Value(n);
+        if (community >= num_nodes) {
+          out_of_range += 1;
+          return;
+        }
+        communities[n] = community;
+        sizes[community].fetch_add(1, std::memory_order_relaxed);
+      },
+      katana::no_stats());
+  if (out_of_range.reduce() > 0) {
+    KATANA_LOG_DEBUG("communities must be node ids");
+    return katana::ErrorCode::InvalidArgument;
+  }
+
+  katana::GAccumulator<uint64_t> n_clusters;
+  katana::GAccumulator<uint64_t> n_non_trivial_clusters;
+  katana::GReduceMax<uint64_t> largest_cluster_size;
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_nodes),
+      [&](uint64_t c) {
+        uint64_t size = sizes[c];
+        if (size > 0) {
+          n_clusters += 1;
+        }
+        if (size > 1) {
+          n_non_trivial_clusters += 1;
+        }
+        largest_cluster_size.update(size);
+      },
+      katana::no_stats());
+
+  return ClusteringStatistics{
+      n_clusters.reduce(),
+      n_non_trivial_clusters.reduce(),
+      largest_cluster_size.reduce(),
+      num_nodes > 0 ? static_cast<double>(largest_cluster_size.reduce()) /
+                          num_nodes
+                    : 0,
+      ClusteringModularity(graph, communities, 1.0),
+  };
+}
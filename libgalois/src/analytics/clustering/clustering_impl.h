@@ -0,0 +1,82 @@
+#ifndef KATANA_LIBGALOIS_ANALYTICS_CLUSTERING_CLUSTERINGIMPL_H_
+#define KATANA_LIBGALOIS_ANALYTICS_CLUSTERING_CLUSTERINGIMPL_H_
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+#include "katana/LargeArray.h"
+#include "katana/analytics/clustering/clustering.h"
+
+// The building blocks shared by Louvain and Leiden clustering. Each level of
+// the hierarchy is a ClusteringGraph: level 0 is the input graph and every
+// further level has one node per community of the level below.
+
+/// A weighted symmetric graph in CSR form
+struct ClusteringGraph {
+  uint64_t num_nodes{0};
+  /// The edges of node n are [edge_begin[n], edge_begin[n + 1])
+  katana::LargeArray<uint64_t> edge_begin;
+  katana::LargeArray<uint32_t> edge_dest;
+  katana::LargeArray<double> edge_weight;
+  /// The sum of the weights of the edges of each node
+  katana::LargeArray<double> degree;
+  /// The sum of all edge weights, i.e., twice the weight of the graph
+  double total_weight{0};
+};
+
+/// The community of each node of a level, named by one of its nodes until it
+/// is renumbered. Nodes read the communities of their neighbors while those
+/// move, hence the atomics.
+using CommunityArray = katana::LargeArray<std::atomic<uint32_t>>;
+
+/// Build level 0 from the topology of pfg and the edge weights in
+/// edge_weight_property_name, or weight 1 if it is empty
+katana::Result<ClusteringGraph> MakeClusteringGraph(
+    const katana::PropertyFileGraph& pfg,
+    const std::string& edge_weight_property_name);
+
+/// Put every node of graph in its own community
+void InitializeSingletons(
+    const ClusteringGraph& graph, CommunityArray* communities);
+
+/// Modularity of communities on graph
+double ClusteringModularity(
+    const ClusteringGraph& graph, const CommunityArray& communities,
+    double resolution);
+
+/// Move nodes between communities, starting from communities, until a round
+/// improves modularity by less than threshold or *iterations reaches
+/// max_iterations. Returns the final modularity; *iterations is incremented
+/// once per round.
+double LocalMove(
+    const ClusteringGraph& graph, CommunityArray* communities,
+    double resolution, double threshold, uint32_t max_iterations,
+    uint32_t* iterations);
+
+/// Rename the communities to 0, ..., k - 1 and return k
+uint64_t RenumberCommunities(CommunityArray* communities);
+
+/// Group the nodes by community, where communities are numbered from 0 to
+/// num_communities - 1: the nodes of community c are (*members)[i] for i in
+/// [(*member_begin)[c], (*member_begin)[c + 1])
+void GroupMembers(
+    const CommunityArray& communities, uint64_t num_communities,
+    katana::LargeArray<uint64_t>* member_begin,
+    katana::LargeArray<uint32_t>* members);
+
+/// Coarsen graph into a graph with a node per community, where communities
+/// are numbered from 0 to num_communities - 1. The edges between two
+/// communities become one edge whose weight is the sum of theirs and the
+/// edges inside a community become a self loop.
+ClusteringGraph Coarsen(
+    const ClusteringGraph& graph, const CommunityArray& communities,
+    uint64_t num_communities);
+
+/// Store the community of every node of level 0 in output_property_name
+katana::Result<void> WriteCommunities(
+    katana::PropertyFileGraph* pfg,
+    const katana::LargeArray<uint32_t>& communities,
+    const std::string& output_property_name);
+
+#endif
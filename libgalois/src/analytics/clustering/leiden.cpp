@@ -0,0 +1,246 @@
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+#include "clustering_impl.h"
+#include "katana/Timer.h"
+
+using katana::analytics::LeidenClusteringPlan;
+
+namespace {
+
+constexpr uint64_t kSeed = 0x2c9277b5;
+
+/// Split every community into well-connected subcommunities, in
+/// (*refined)[n] for each node n. Every subcommunity starts as a singleton
+/// and a node that is still alone may join another subcommunity of its
+/// community that is itself well connected, with a probability that grows
+/// exponentially with the modularity gain.
+///
+/// A community only touches the entries of its own members, so the
+/// communities are refined in parallel and each serially.
+void
+Refine(
+    const ClusteringGraph& graph, const CommunityArray& communities,
+    uint64_t num_communities, const LeidenClusteringPlan& plan,
+    uint32_t level, CommunityArray* refined) {
+  katana::LargeArray<uint64_t> member_begin;
+  katana::LargeArray<uint32_t> members;
+  GroupMembers(communities, num_communities, &member_begin, &members);
+
+  // The degree, size and weight of the edges to the rest of their community
+  // of each subcommunity, named by one of its nodes
+  katana::LargeArray<double> sub_degree;
+  katana::LargeArray<uint32_t> sub_size;
+  katana::LargeArray<double> sub_external;
+  sub_degree.allocateBlocked(graph.num_nodes);
+  sub_size.allocateBlocked(graph.num_nodes);
+  sub_external.allocateBlocked(graph.num_nodes);
+  refined->allocateBlocked(graph.num_nodes);
+
+  double constant = graph.total_weight > 0 ? 1 / graph.total_weight : 0;
+  double resolution = plan.resolution();
+
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_communities),
+      [&](uint64_t c) {
+        uint64_t begin = member_begin[c];
+        uint64_t end = member_begin[c + 1];
+        double community_degree = 0;
+        for (uint64_t i = begin; i < end; ++i) {
+          uint32_t n = members[i];
+          double external = 0;
+          for (uint64_t e = graph.edge_begin[n]; e < graph.edge_begin[n + 1];
+               ++e) {
+            uint32_t dest = graph.edge_dest[e];
+            if (dest != n && communities[dest] == c) {
+              external += graph.edge_weight[e];
+            }
+          }
+          (*refined)[n] = n;
+          sub_degree[n] = graph.degree[n];
+          sub_size[n] = 1;
+          sub_external[n] = external;
+          community_degree += graph.degree[n];
+        }
+
+        auto well_connected = [&](double external, double degree) {
+          return external >=
+                 resolution * degree * (community_degree - degree) * constant;
+        };
+
+        thread_local std::vector<uint32_t> order;
+        order.assign(members.begin() + begin, members.begin() + end);
+        std::mt19937_64 rng(kSeed ^ (c + (uint64_t{level} << 32)));
+        std::shuffle(order.begin(), order.end(), rng);
+
+        thread_local std::unordered_map<uint32_t, double> weight_to;
+        thread_local std::vector<std::pair<uint32_t, double>> candidates;
+        for (uint32_t n : order) {
+          double degree = graph.degree[n];
+          double external = 0;
+          for (uint64_t e = graph.edge_begin[n]; e < graph.edge_begin[n + 1];
+               ++e) {
+            uint32_t dest = graph.edge_dest[e];
+            if (dest != n && communities[dest] == c) {
+              external += graph.edge_weight[e];
+            }
+          }
+          if (sub_size[(*refined)[n]] > 1 ||
+              !well_connected(external, degree)) {
+            continue;
+          }
+
+          weight_to.clear();
+          for (uint64_t e = graph.edge_begin[n]; e < graph.edge_begin[n + 1];
+               ++e) {
+            uint32_t dest = graph.edge_dest[e];
+            if (dest != n && communities[dest] == c) {
+              weight_to[(*refined)[dest]] += graph.edge_weight[e];
+            }
+          }
+
+          // The gain of joining each well-connected subcommunity, in units of
+          // edge weight so that randomness does not depend on the graph size;
+          // staying alone gains nothing
+          candidates.clear();
+          candidates.emplace_back((*refined)[n], 0);
+          double max_gain = 0;
+          for (const auto& [sub, weight] : weight_to) {
+            if (!well_connected(sub_external[sub], sub_degree[sub])) {
+              continue;
+            }
+            double gain =
+                weight - resolution * degree * sub_degree[sub] * constant;
+            if (gain < 0) {
+              continue;
+            }
+            candidates.emplace_back(sub, gain);
+            max_gain = std::max(max_gain, gain);
+          }
+
+          double total = 0;
+          for (auto& candidate : candidates) {
+            candidate.second =
+                std::exp((candidate.second - max_gain) / plan.randomness());
+            total += candidate.second;
+          }
+          double pick = std::uniform_real_distribution<double>(0, total)(rng);
+          uint32_t chosen = candidates.back().first;
+          for (const auto& [sub, probability] : candidates) {
+            if (pick < probability) {
+              chosen = sub;
+              break;
+            }
+            pick -= probability;
+          }
+          if (chosen == (*refined)[n]) {
+            continue;
+          }
+
+          sub_external[chosen] += external - 2 * weight_to[chosen];
+          sub_degree[chosen] += degree;
+          sub_size[chosen] += 1;
+          sub_size[(*refined)[n]] = 0;
+          (*refined)[n] = chosen;
+        }
+      },
+      katana::steal(), katana::loopname("Refine"));
+}
+
+}  // namespace
+
+katana::Result<void>
+katana::analytics::LeidenClustering(
+    PropertyFileGraph* pfg, const std::string& edge_weight_property_name,
+    const std::string& output_property_name, LeidenClusteringPlan plan) {
+  if (!(plan.randomness() > 0)) {
+    KATANA_LOG_DEBUG("randomness ({}) must be positive", plan.randomness());
+    return katana::ErrorCode::InvalidArgument;
+  }
+
+  auto graph_result = MakeClusteringGraph(*pfg, edge_weight_property_name);
+  if (!graph_result) {
+    return graph_result.error();
+  }
+  ClusteringGraph graph = std::move(graph_result.value());
+
+  katana::StatTimer exec_time("LeidenClustering");
+  exec_time.start();
+
+  // The node of the current level that each node of the input belongs to.
+  // The nodes of a level are the refined subcommunities of the level below,
+  // while their initial communities are the unrefined ones.
+  katana::LargeArray<uint32_t> node_to_aggregate;
+  node_to_aggregate.allocateBlocked(graph.num_nodes);
+  katana::do_all(
+      katana::iterate(uint64_t{0}, graph.num_nodes),
+      [&](uint64_t n) { node_to_aggregate[n] = n; }, katana::no_stats(),
+      katana::loopname("Initialize"));
+
+  CommunityArray communities;
+  InitializeSingletons(graph, &communities);
+  double prev_modularity =
+      ClusteringModularity(graph, communities, plan.resolution());
+
+  uint32_t iterations = 0;
+  uint32_t levels = 0;
+  while (true) {
+    ++levels;
+    double modularity = LocalMove(
+        graph, &communities, plan.resolution(),
+        plan.modularity_threshold_per_round(), plan.max_iterations(),
+        &iterations);
+    uint64_t num_communities = RenumberCommunities(&communities);
+
+    CommunityArray refined;
+    Refine(graph, communities, num_communities, plan, levels, &refined);
+    uint64_t num_subcommunities = RenumberCommunities(&refined);
+
+    if (num_subcommunities == graph.num_nodes ||
+        num_subcommunities <= plan.min_graph_size() ||
+        iterations >= plan.max_iterations() ||
+        modularity - prev_modularity < plan.modularity_threshold_total()) {
+      katana::do_all(
+          katana::iterate(uint64_t{0}, pfg->num_nodes()),
+          [&](uint64_t n) {
+            node_to_aggregate[n] = communities[node_to_aggregate[n]];
+          },
+          katana::no_stats(), katana::loopname("Project"));
+      break;
+    }
+    prev_modularity = modularity;
+
+    katana::do_all(
+        katana::iterate(uint64_t{0}, pfg->num_nodes()),
+        [&](uint64_t n) {
+          node_to_aggregate[n] = refined[node_to_aggregate[n]];
+        },
+        katana::no_stats(), katana::loopname("Project"));
+
+    // Every subcommunity lies inside one community, so all of its nodes
+    // store the same parent
+    CommunityArray parents;
+    parents.allocateBlocked(num_subcommunities);
+    katana::do_all(
+        katana::iterate(uint64_t{0}, graph.num_nodes),
+        [&](uint64_t n) {
+          parents[refined[n]].store(
+              communities[n].load(std::memory_order_relaxed),
+              std::memory_order_relaxed);
+        },
+        katana::no_stats(), katana::loopname("Parents"));
+
+    graph = Coarsen(graph, refined, num_subcommunities);
+    communities = std::move(parents);
+  }
+
+  exec_time.stop();
+
+  katana::ReportStatSingle("LeidenClustering", "Levels", levels);
+  katana::ReportStatSingle("LeidenClustering", "Iterations", iterations);
+
+  return WriteCommunities(pfg, node_to_aggregate, output_property_name);
+}
@@ -0,0 +1,67 @@
+#include "clustering_impl.h"
+#include "katana/Timer.h"
+
+using katana::analytics::LouvainClusteringPlan;
+
+katana::Result<void>
+katana::analytics::LouvainClustering(
+    PropertyFileGraph* pfg, const std::string& edge_weight_property_name,
+    const std::string& output_property_name, LouvainClusteringPlan plan) {
+  auto graph_result = MakeClusteringGraph(*pfg, edge_weight_property_name);
+  if (!graph_result) {
+    return graph_result.error();
+  }
+  ClusteringGraph graph = std::move(graph_result.value());
+
+  katana::StatTimer exec_time("LouvainClustering");
+  exec_time.start();
+
+  // The node of the current level that each node of the input belongs to
+  katana::LargeArray<uint32_t> node_to_aggregate;
+  node_to_aggregate.allocateBlocked(graph.num_nodes);
+  katana::do_all(
+      katana::iterate(uint64_t{0}, graph.num_nodes),
+      [&](uint64_t n) { node_to_aggregate[n] = n; }, katana::no_stats(),
+      katana::loopname("Initialize"));
+
+  CommunityArray singletons;
+  InitializeSingletons(graph, &singletons);
+  double prev_modularity =
+      ClusteringModularity(graph, singletons, plan.resolution());
+
+  uint32_t iterations = 0;
+  uint32_t levels = 0;
+  while (true) {
+    ++levels;
+    CommunityArray communities;
+    InitializeSingletons(graph, &communities);
+    double modularity = LocalMove(
+        graph, &communities, plan.resolution(),
+        plan.modularity_threshold_per_round(), plan.max_iterations(),
+        &iterations);
+    uint64_t num_communities = RenumberCommunities(&communities);
+
+    katana::do_all(
+        katana::iterate(uint64_t{0}, pfg->num_nodes()),
+        [&](uint64_t n) {
+          node_to_aggregate[n] = communities[node_to_aggregate[n]];
+        },
+        katana::no_stats(), katana::loopname("Project"));
+
+    if (num_communities == graph.num_nodes ||
+        num_communities <= plan.min_graph_size() ||
+        iterations >= plan.max_iterations() ||
+        modularity - prev_modularity < plan.modularity_threshold_total()) {
+      break;
+    }
+    prev_modularity = modularity;
+    graph = Coarsen(graph, communities, num_communities);
+  }
+
+  exec_time.stop();
+
+  katana::ReportStatSingle("LouvainClustering", "Levels", levels);
+  katana::ReportStatSingle("LouvainClustering", "Iterations", iterations);
+
+  return WriteCommunities(pfg, node_to_aggregate, output_property_name);
+}
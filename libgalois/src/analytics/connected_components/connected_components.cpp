@@ -20,6 +20,7 @@
 #include "katana/analytics/connected_components/connected_components.h"
 
 #include "katana/ArrowRandomAccessBuilder.h"
+#include "katana/analytics/Planner.h"
 
 using namespace katana::analytics;
 
@@ -199,6 +200,9 @@ struct ConnectedComponentsSynchronousAlgo {
 
     current_bag = &wls[0];
     next_bag = &wls[1];
+    // The worklists are refilled every round; keep their blocks
+    current_bag->set_block_recycling();
+    next_bag->set_block_recycling();
 
     katana::do_all(katana::iterate(*graph), [&](const GNode& src) {
       for (auto ii : graph->edges(src)) {
@@ -537,64 +541,23 @@ struct ConnectedComponentsEdgeTiledAsynchronousAlgo {
     });
   }
 
-  struct EdgeTile {
-    // ConnectedComponentsNode* sData;
-    GNode src;
-    Graph::edge_iterator beg;
-    Graph::edge_iterator end;
-  };
-
-  /*struct EdgeTileMaker {
-      EdgeTile operator() (ConnectedComponentsNode* sdata, Graph::edge_iterator beg,
-  Graph::edge_iterator end) const{ return EdgeTile{sdata, beg, end};
-      }
-  };*/
-
   void operator()(Graph* graph) {
     katana::GAccumulator<size_t> empty_merges;
 
-    katana::InsertBag<EdgeTile> works;
-    katana::do_all(
-        katana::iterate(*graph),
-        [&](const GNode& src) {
-          auto beg = graph->edge_begin(src);
-          const auto& end = graph->edge_end(src);
-
-          KATANA_LOG_DEBUG_ASSERT(beg <= end);
-          if ((end - beg) > plan_.edge_tile_size()) {
-            for (; beg + plan_.edge_tile_size() < end;) {
-              const auto& ne = beg + plan_.edge_tile_size();
-              KATANA_LOG_DEBUG_ASSERT(ne < end);
-              works.push_back(EdgeTile{src, beg, ne});
-              beg = ne;
-            }
-          }
-
-          if ((end - beg) > 0) {
-            works.push_back(EdgeTile{src, beg, end});
-          }
-        },
-        katana::loopname("CC-EdgeTiledAsynchronousInit"), katana::steal());
+    katana::do_all_edges(
+        graph->GetPropertyFileGraph().topology(),
+        [&](const GNode& src, const katana::GraphTopology::Edge& edge) {
+          auto dest = graph->GetEdgeDest(Graph::edge_iterator(edge));
+          if (src >= *dest)
+            return;
 
-    katana::do_all(
-        katana::iterate(works),
-        [&](const EdgeTile& tile) {
-          const auto& src = tile.src;
           auto& sdata = graph->GetData<NodeComponent>(src);
-
-          for (auto ii = tile.beg; ii != tile.end; ++ii) {
-            auto dest = graph->GetEdgeDest(ii);
-            if (src >= *dest)
-              continue;
-
-            auto& ddata = graph->GetData<NodeComponent>(dest);
-            if (!sdata->merge(ddata))
-              empty_merges += 1;
-          }
+          auto& ddata = graph->GetData<NodeComponent>(dest);
+          if (!sdata->merge(ddata))
+            empty_merges += 1;
         },
-        katana::loopname("CC-edgetiledAsynchronous"), katana::steal(),
-        katana::chunk_size<ConnectedComponentsPlan::kChunkSize>()  // 16 -> 1
-    );
+        plan_.edge_tile_size(), katana::loopname("CC-edgetiledAsynchronous"),
+        katana::steal());
 
     katana::do_all(
         katana::iterate(*graph),
@@ -1020,6 +983,9 @@ struct ConnectedComponentsEdgeTiledAfforestAlgo {
             graph, plan_.component_sample_frequency());
     StatTimer_Sampling.stop();
 
+    const ptrdiff_t edge_tile_size = katana::ChooseEdgeTileSize(
+        plan_.edge_tile_size(), graph->GetPropertyFileGraph().topology());
+
     katana::InsertBag<EdgeTile> works;
     katana::do_all(
         katana::iterate(*graph),
@@ -1030,17 +996,12 @@ struct ConnectedComponentsEdgeTiledAfforestAlgo {
           auto beg = graph->edge_begin(src);
           const auto end = graph->edge_end(src);
 
-          for (std::advance(beg, plan_.neighbor_sample_size());
-               beg + plan_.edge_tile_size() < end;) {
-            auto ne = beg + plan_.edge_tile_size();
-            KATANA_LOG_DEBUG_ASSERT(ne < end);
-            works.push_back(EdgeTile{src, beg, ne});
-            beg = ne;
-          }
-
-          if ((end - beg) > 0) {
-            works.push_back(EdgeTile{src, beg, end});
-          }
+          std::advance(beg, plan_.neighbor_sample_size());
+          katana::ForEachEdgeTile(
+              beg, end, edge_tile_size,
+              [&](const auto& tile_beg, const auto& tile_end) {
+                works.push_back(EdgeTile{src, tile_beg, tile_end});
+              });
         },
         katana::loopname("EdgetiledAfforest-LCS-Tiling"), katana::steal());
 
@@ -1070,6 +1031,56 @@ struct ConnectedComponentsEdgeTiledAfforestAlgo {
   }
 };
 
+/// Relabel every component with the smallest node id in it. The labels the
+/// algorithms leave behind depend on the order of the unions, and for the
+/// union-find algorithms on the addresses of the union-find nodes. This
+/// sorts (label, node) pairs, i.e., O(n log n) work and 16 bytes per node.
+katana::Result<void>
+CanonicalizeComponents(
+    katana::PropertyFileGraph* pfg, const std::string& property_name) {
+  using ComponentType = uint64_t;
+  struct NodeComponent : public katana::PODProperty<ComponentType> {};
+
+  using Graph =
+      katana::PropertyGraph<std::tuple<NodeComponent>, std::tuple<>>;
+  using GNode = Graph::Node;
+
+  auto pg_result = Graph::Make(pfg, {property_name}, {});
+  if (!pg_result) {
+    return pg_result.error();
+  }
+  auto graph = pg_result.value();
+
+  katana::LargeArray<std::pair<ComponentType, GNode>> members;
+  members.allocateBlocked(graph.size());
+  katana::do_all(
+      katana::iterate(graph),
+      [&](const GNode& node) {
+        members[node] = {graph.GetData<NodeComponent>(node), node};
+      },
+      katana::no_stats(), katana::loopname("CC-Canonicalize-Gather"));
+  katana::ParallelSTL::sort(members.begin(), members.end());
+
+  katana::GAccumulator<size_t> num_components;
+  katana::do_all(
+      katana::iterate(size_t{0}, members.size()),
+      [&](size_t i) {
+        // The first member of each run of a label has the smallest id
+        auto first = std::lower_bound(
+            members.begin(), members.begin() + i,
+            std::make_pair(members[i].first, GNode{0}));
+        if (first == members.begin() + i) {
+          num_components += 1;
+        }
+        graph.GetData<NodeComponent>(members[i].second) = first->second;
+      },
+      katana::steal(), katana::loopname("CC-Canonicalize-Relabel"));
+
+  katana::ReportStatSingle(
+      "CC-Deterministic", "components", num_components.reduce());
+  return katana::ResultSuccess();
+}
+
 }  //namespace
 
 template <typename Algorithm>
@@ -1104,6 +1115,10 @@ ConnectedComponentsWithWrap(
 
   execTime.stop();
 
+  if (plan.deterministic()) {
+    return CanonicalizeComponents(pfg, output_property_name);
+  }
+
   return katana::ResultSuccess();
 }
 
@@ -1111,6 +1126,12 @@ katana::Result<void>
 katana::analytics::ConnectedComponents(
     PropertyFileGraph* pfg, const std::string& output_property_name,
     ConnectedComponentsPlan plan) {
+  if (plan.algorithm() == ConnectedComponentsPlan::kAutomatic) {
+    ConnectedComponentsPlan chosen =
+        ChooseConnectedComponentsPlan(GraphFeatures::Compute(*pfg));
+    plan = plan.deterministic() ? Deterministic(chosen) : chosen;
+  }
+
   switch (plan.algorithm()) {
   case ConnectedComponentsPlan::kSerial:
     return ConnectedComponentsWithWrap<ConnectedComponentsSerialAlgo>(
@@ -1150,6 +1171,173 @@ katana::analytics::ConnectedComponents(
   }
 }
 
+namespace {
+
+/// Union-find node over the component labels touched by an edge batch, or
+/// over all nodes for ConnectedComponentsSegmented. The nodes live in one
+/// array indexed by the position of their label in the sorted list of labels,
+/// so the lock-free merge (which points larger addresses at smaller ones)
+/// always elects the smallest label.
+struct LabelUnionFindNode : public katana::UnionFindNode<LabelUnionFindNode> {
+  LabelUnionFindNode() : katana::UnionFindNode<LabelUnionFindNode>(this) {}
+};
+
+}  // namespace
+
+katana::Result<void>
+katana::analytics::ConnectedComponentsIncremental(
+    PropertyFileGraph* pfg, const std::string& property_name,
+    const EdgeBatch& edge_batch) {
+  using ComponentType = uint64_t;
+  struct NodeComponent : public katana::PODProperty<ComponentType> {};
+
+  using NodeData = std::tuple<NodeComponent>;
+  using EdgeData = std::tuple<>;
+  typedef katana::PropertyGraph<NodeData, EdgeData> Graph;
+  typedef typename Graph::Node GNode;
+
+  if (auto r = CheckEdgeBatch(*pfg, edge_batch); !r) {
+    return r.error();
+  }
+
+  auto pg_result = Graph::Make(pfg, {property_name}, {});
+  if (!pg_result) {
+    return pg_result.error();
+  }
+
+  auto graph = pg_result.value();
+
+  if (edge_batch.empty()) {
+    return katana::ResultSuccess();
+  }
+
+  katana::StatTimer exec_time("ConnectedComponentIncremental");
+  exec_time.start();
+
+  // Only the components that an edge of the batch touches can change, so the
+  // union-find is over their labels rather than over all nodes.
+  std::vector<ComponentType> labels(edge_batch.size() * 2);
+  katana::do_all(
+      katana::iterate(size_t{0}, edge_batch.size()),
+      [&](size_t i) {
+        labels[2 * i] = graph.GetData<NodeComponent>(edge_batch[i].first);
+        labels[2 * i + 1] = graph.GetData<NodeComponent>(edge_batch[i].second);
+      },
+      katana::no_stats());
+  katana::ParallelSTL::sort(labels.begin(), labels.end());
+  labels.erase(std::unique(labels.begin(), labels.end()), labels.end());
+
+  auto label_index = [&labels](ComponentType label) {
+    return std::lower_bound(labels.begin(), labels.end(), label) -
+           labels.begin();
+  };
+
+  katana::LargeArray<LabelUnionFindNode> components;
+  components.allocateBlocked(labels.size());
+  components.construct();
+
+  katana::GAccumulator<size_t> merges;
+  katana::do_all(
+      katana::iterate(edge_batch),
+      [&](const std::pair<GNode, GNode>& edge) {
+        auto src = label_index(graph.GetData<NodeComponent>(edge.first));
+        auto dest = label_index(graph.GetData<NodeComponent>(edge.second));
+        if (src != dest && components[src].merge(&components[dest])) {
+          merges += 1;
+        }
+      },
+      katana::steal(), katana::loopname("CC-Incremental-Merge"));
+
+  if (merges.reduce() > 0) {
+    katana::do_all(
+        katana::iterate(graph),
+        [&](const GNode& node) {
+          auto& data = graph.GetData<NodeComponent>(node);
+          auto it = std::lower_bound(labels.begin(), labels.end(), data);
+          if (it == labels.end() || *it != data) {
+            return;
+          }
+          auto* rep = components[it - labels.begin()].find();
+          data = labels[rep - &components[0]];
+        },
+        katana::steal(), katana::loopname("CC-Incremental-Relabel"));
+  }
+
+  exec_time.stop();
+
+  katana::ReportStatSingle(
+      "CC-Incremental", "touched_components", labels.size());
+  katana::ReportStatSingle("CC-Incremental", "merges", merges.reduce());
+
+  return katana::ResultSuccess();
+}
+
+katana::Result<std::shared_ptr<arrow::UInt64Array>>
+katana::analytics::ConnectedComponentsSegmented(
+    const std::string& rdg_name, uint64_t segment_bytes) {
+  auto topology_result = SegmentedTopology::Make(rdg_name, segment_bytes);
+  if (!topology_result) {
+    return topology_result.error();
+  }
+  SegmentedTopology topology = std::move(topology_result.value());
+  uint64_t num_nodes = topology.num_nodes();
+
+  katana::StatTimer exec_time("ConnectedComponentsSegmented");
+  exec_time.start();
+
+  katana::LargeArray<LabelUnionFindNode> components;
+  components.allocateBlocked(num_nodes);
+  components.construct();
+
+  // Every edge is merged exactly once, so a single pass over the segments
+  // finds the components.
+  auto res = topology.ForEachSegment(
+      [&](const TopologySegment& segment) -> katana::Result<void> {
+        const GraphTopology& local = segment.topology;
+        katana::do_all_edges(
+            local,
+            [&](GraphTopology::Node src, GraphTopology::Edge e) {
+              components[segment.node_begin + src].merge(
+                  &components[local.out_dests->Value(e)]);
+            },
+            katana::kAdaptiveEdgeTileSize, katana::steal(),
+            katana::no_stats(), katana::loopname("CC-Segmented-Merge"));
+        return katana::ResultSuccess();
+      });
+  if (!res) {
+    return res.error();
+  }
+
+  auto buffer_result = arrow::AllocateBuffer(
+      num_nodes * sizeof(uint64_t), arrow::default_memory_pool());
+  if (!buffer_result.ok()) {
+    KATANA_LOG_DEBUG("arrow error: {}", buffer_result.status());
+    return katana::ErrorCode::ArrowError;
+  }
+  std::shared_ptr<arrow::Buffer> buffer = std::move(buffer_result.ValueOrDie());
+  auto* component_ids = reinterpret_cast<uint64_t*>(buffer->mutable_data());
+
+  katana::GAccumulator<uint64_t> num_components;
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_nodes),
+      [&](uint64_t n) {
+        component_ids[n] = components[n].find() - &components[0];
+        if (component_ids[n] == n) {
+          num_components += 1;
+        }
+      },
+      katana::steal(), katana::loopname("CC-Segmented-Relabel"));
+
+  exec_time.stop();
+
+  katana::ReportStatSingle(
+      "CC-Segmented", "segments", topology.num_segments());
+  katana::ReportStatSingle(
+      "CC-Segmented", "components", num_components.reduce());
+
+  return std::make_shared<arrow::UInt64Array>(num_nodes, buffer);
+}
+
 katana::Result<void>
 katana::analytics::ConnectedComponentsAssertValid(
     PropertyFileGraph* pfg, const std::string& property_name) {
@@ -25,7 +25,9 @@
 #include <vector>
 
 #include "katana/Bag.h"
+#include "katana/EdgeTiles.h"
 #include "katana/Galois.h"
+#include "katana/LargeArray.h"
 #include "katana/ParallelSTL.h"
 #include "katana/Properties.h"
 #include "katana/PropertyGraph.h"
@@ -422,6 +424,94 @@ struct PrioAlgo {
   }
 };
 
+/// The priority algorithm in bulk-synchronous rounds: every round decides
+/// nodes from the flags of the previous round only, so the set does not
+/// depend on the schedule. The cost over PrioAlgo is a second flag array and
+/// a pass to copy it back per round.
+struct DeterministicPrioAlgo {
+  struct NodeFlag {
+    using ArrowType = arrow::CTypeTraits<uint8_t>::ArrowType;
+    using ViewType = katana::PODPropertyView<uint8_t>;
+  };
+
+  using NodeData = std::tuple<NodeFlag>;
+  using EdgeData = std::tuple<>;
+
+  typedef katana::PropertyGraph<NodeData, EdgeData> Graph;
+  typedef typename Graph::Node GNode;
+
+  void Initialize(Graph* graph) {
+    for (auto n : *graph) {
+      graph->GetData<NodeFlag>(n) = kUndecided;
+    }
+  }
+
+  void operator()(Graph* graph) {
+    size_t rounds = 0;
+    katana::GReduceLogicalOr unmatched;
+    katana::LargeArray<uint8_t> next_flag;
+    next_flag.allocateBlocked(graph->size());
+
+    float avg_degree = graph->num_edges() / float(graph->size());
+    uint8_t in = ~1;
+    float scale_avg = ((in / 2) - 1) * avg_degree;
+
+    katana::do_all(
+        katana::iterate(*graph),
+        [&](const GNode& src) {
+          float degree = graph->edges(src).size();
+          float x = degree - hash(src) * kHashScale;
+          int res = round(scale_avg / (avg_degree + x));
+          uint8_t val = (res + res) | 1;
+          graph->GetData<NodeFlag>(src) = val;
+          next_flag[src] = val;
+        },
+        katana::loopname("IndependentSet-init-prio"));
+
+    do {
+      unmatched.reset();
+      katana::do_all(
+          katana::iterate(*graph),
+          [&](const GNode& src) {
+            auto src_flag = graph->GetData<NodeFlag>(src);
+            if (!(src_flag & kUndecided)) {
+              return;
+            }
+
+            for (auto edge : graph->edges(src)) {
+              auto dest = graph->GetEdgeDest(edge);
+              auto dest_flag = graph->GetData<NodeFlag>(dest);
+
+              if (dest_flag == kPermanentYes || src == *dest) {
+                next_flag[src] = kPermanentNo;
+                return;
+              }
+              // Undecided neighbors with a higher (priority, id) win
+              if (dest_flag > src_flag ||
+                  (dest_flag == src_flag && *dest > src)) {
+                unmatched.update(true);
+                return;
+              }
+            }
+            next_flag[src] = kPermanentYes;
+          },
+          katana::loopname("IndependentSet-execute"), katana::steal());
+
+      katana::do_all(
+          katana::iterate(*graph),
+          [&](const GNode& src) {
+            graph->GetData<NodeFlag>(src) = next_flag[src];
+          },
+          katana::loopname("IndependentSet-commit"));
+
+      rounds += 1;
+    } while (unmatched.reduce());
+
+    katana::ReportStatSingle(
+        "IndependentSet-DeterministicPrioAlgo", "rounds", rounds);
+  }
+};
+
 struct EdgeTiledPrioAlgo {
   struct NodeFlag {
     using ArrowType = arrow::CTypeTraits<uint8_t>::ArrowType;
@@ -452,7 +542,8 @@ struct EdgeTiledPrioAlgo {
     katana::GReduceLogicalOr unmatched;
     katana::PerThreadStorage<std::mt19937*> generator;
     katana::InsertBag<EdgeTile> works;
-    constexpr int kEdgeTileSize = 64;
+    const ptrdiff_t edge_tile_size = katana::AdaptiveEdgeTileSize(
+        graph->GetPropertyFileGraph().topology());
 
     float avg_degree = graph->num_edges() / float(graph->size());
     uint8_t in = ~1;
@@ -472,17 +563,11 @@ struct EdgeTiledPrioAlgo {
 
           src_flag = val;
           KATANA_LOG_DEBUG_ASSERT(beg <= end);
-          if ((end - beg) > kEdgeTileSize) {
-            for (; beg + kEdgeTileSize < end;) {
-              auto ne = beg + kEdgeTileSize;
-              KATANA_LOG_DEBUG_ASSERT(ne < end);
-              works.push_back(EdgeTile{src, beg, ne, false});
-              beg = ne;
-            }
-          }
-          if ((end - beg) > 0) {
-            works.push_back(EdgeTile{src, beg, end, false});
-          }
+          katana::ForEachEdgeTile(
+              beg, end, edge_tile_size,
+              [&](const auto& tile_beg, const auto& tile_end) {
+                works.push_back(EdgeTile{src, tile_beg, tile_end, false});
+              });
         },
         katana::loopname("IndependentSet-init-prio"), katana::steal());
 
@@ -651,7 +736,8 @@ Run(katana::PropertyFileGraph* pfg, const std::string& output_property_name) {
   katana::reportPageAlloc("MeminfoPost");
 
   if (std::is_same<Algo, PrioAlgo>::value ||
-      std::is_same<Algo, EdgeTiledPrioAlgo>::value) {
+      std::is_same<Algo, EdgeTiledPrioAlgo>::value ||
+      std::is_same<Algo, DeterministicPrioAlgo>::value) {
     // For these algorithms we need to translate the flags into MatchFlag/bool.
     // Check for errors as we go since it costs almost nothing.
     katana::GReduceLogicalOr has_error;
@@ -682,6 +768,14 @@ katana::Result<void>
 katana::analytics::IndependentSet(
     katana::PropertyFileGraph* pfg, const std::string& output_property_name,
     IndependentSetPlan plan) {
+  // The serial and pull algorithms only read flags of earlier rounds, so
+  // they are deterministic as they are
+  if (plan.deterministic() &&
+      (plan.algorithm() == IndependentSetPlan::kPriority ||
+       plan.algorithm() == IndependentSetPlan::kEdgeTiledPriority)) {
+    return Run<DeterministicPrioAlgo>(pfg, output_property_name);
+  }
+
   switch (plan.algorithm()) {
   case IndependentSetPlan::kSerial:
     return Run<SerialAlgo>(pfg, output_property_name);
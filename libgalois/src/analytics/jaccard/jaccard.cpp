@@ -19,6 +19,12 @@
 
 #include "katana/analytics/jaccard/jaccard.h"
 
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <optional>
+
+#include "katana/analytics/Intersection.h"
 #include "katana/analytics/Utils.h"
 
 using namespace katana::analytics;
@@ -29,62 +35,196 @@ using EdgeData = std::tuple<>;
 typedef katana::PropertyGraph<NodeData, EdgeData> Graph;
 typedef typename Graph::Node GNode;
 
+using AllEdgesGraph =
+    katana::PropertyGraph<std::tuple<>, std::tuple<JaccardSimilarity>>;
+
 namespace {
 
+/// Similarity of two neighborhoods of a_size and b_size nodes with
+/// intersection_size nodes in common
+double
+Similarity(
+    JaccardPlan::SimilarityMetric metric, uint64_t a_size, uint64_t b_size,
+    double intersection_size) {
+  if (metric == JaccardPlan::kCosine) {
+    if (a_size == 0 || b_size == 0) {
+      return a_size == b_size ? 1 : 0;
+    }
+    return intersection_size / std::sqrt(static_cast<double>(a_size * b_size));
+  }
+  double union_size = a_size + b_size - intersection_size;
+  return union_size > 0 ? intersection_size / union_size : 1;
+}
+
+/// MinHash sketches of the neighborhoods of some of the nodes of a graph.
+///
+/// The fraction of positions at which the sketches of two nodes agree is an
+/// unbiased estimate of the Jaccard similarity of their neighborhoods, and it
+/// costs num_hashes comparisons however large the neighborhoods are.
+class MinHashSketches {
+public:
+  /// Sketch the nodes n for which needs_sketch(n) is true; only those may be
+  /// passed to Estimate
+  template <typename Predicate>
+  MinHashSketches(
+      const katana::GraphTopology& topology, uint32_t num_hashes,
+      Predicate needs_sketch)
+      : num_hashes_(num_hashes) {
+    uint64_t num_nodes = topology.num_nodes();
+    slots_.allocateBlocked(num_nodes);
+    katana::do_all(
+        katana::iterate(topology),
+        [&](GNode n) { slots_[n] = needs_sketch(n) ? 1 : kNoSketch; },
+        katana::no_stats(), katana::loopname("Jaccard_MinHashSelect"));
+    uint32_t num_sketches = 0;
+    for (uint64_t n = 0; n < num_nodes; ++n) {
+      if (slots_[n] != kNoSketch) {
+        slots_[n] = num_sketches++;
+      }
+    }
+
+    values_.allocateBlocked(uint64_t{num_sketches} * num_hashes_);
+    const uint32_t* dests = topology.out_dests->raw_values();
+    katana::do_all(
+        katana::iterate(topology),
+        [&](GNode n) {
+          if (slots_[n] == kNoSketch) {
+            return;
+          }
+          uint32_t* sketch = Sketch(n);
+          std::fill(
+              sketch, sketch + num_hashes_,
+              std::numeric_limits<uint32_t>::max());
+          auto [begin, end] = topology.edge_range(n);
+          for (auto e = begin; e != end; ++e) {
+            for (uint32_t i = 0; i < num_hashes_; ++i) {
+              sketch[i] = std::min(sketch[i], Hash(dests[e], i));
+            }
+          }
+        },
+        katana::steal(), katana::loopname("Jaccard_MinHashSketch"));
+  }
+
+  double EstimateJaccard(GNode a, GNode b) const {
+    const uint32_t* a_sketch = Sketch(a);
+    const uint32_t* b_sketch = Sketch(b);
+    uint32_t equal = 0;
+    for (uint32_t i = 0; i < num_hashes_; ++i) {
+      equal += a_sketch[i] == b_sketch[i];
+    }
+    return static_cast<double>(equal) / num_hashes_;
+  }
+
+  /// Estimate the similarity of nodes a and b of degrees a_size and b_size
+  double Estimate(
+      JaccardPlan::SimilarityMetric metric, GNode a, uint64_t a_size, GNode b,
+      uint64_t b_size) const {
+    double jaccard = EstimateJaccard(a, b);
+    if (metric == JaccardPlan::kJaccard) {
+      return jaccard;
+    }
+    // |A & B| = J * |A | B| = J * (|A| + |B|) / (1 + J)
+    double intersection_size = jaccard * (a_size + b_size) / (1 + jaccard);
+    return Similarity(metric, a_size, b_size, intersection_size);
+  }
+
+private:
+  /// The i-th hash function, the finalizer of splitmix64 applied to i and
+  /// node
+  static uint32_t Hash(uint32_t node, uint32_t i) {
+    uint64_t x = ((uint64_t{i} << 32) | node) + UINT64_C(0x9E3779B97F4A7C15);
+    x = (x ^ (x >> 30)) * UINT64_C(0xBF58476D1CE4E5B9);
+    x = (x ^ (x >> 27)) * UINT64_C(0x94D049BB133111EB);
+    return (x ^ (x >> 31)) >> 32;
+  }
+
+  static constexpr uint32_t kNoSketch = std::numeric_limits<uint32_t>::max();
+
+  uint32_t* Sketch(GNode n) {
+    KATANA_LOG_DEBUG_ASSERT(slots_[n] != kNoSketch);
+    return &values_[uint64_t{slots_[n]} * num_hashes_];
+  }
+  const uint32_t* Sketch(GNode n) const {
+    KATANA_LOG_DEBUG_ASSERT(slots_[n] != kNoSketch);
+    return &values_[uint64_t{slots_[n]} * num_hashes_];
+  }
+
+  uint32_t num_hashes_;
+  /// Index of the sketch of each node among the sketched nodes
+  katana::LargeArray<uint32_t> slots_;
+  katana::LargeArray<uint32_t> values_;
+};
+
+/// The sorted topology the neighborhoods of pfg should be intersected on:
+/// its own if the plan says it is sorted and its cached edge-sorted derived
+/// topology otherwise. derived holds the latter alive.
+katana::Result<const katana::GraphTopology*>
+SortedTopology(
+    katana::PropertyFileGraph* pfg, const JaccardPlan& plan,
+    std::shared_ptr<const katana::DerivedTopology>* derived) {
+  if (plan.edge_sorting() == JaccardPlan::kSorted) {
+    return &pfg->topology();
+  }
+  auto derived_result =
+      pfg->GetDerivedTopology(katana::DerivedTopology::kEdgesSorted);
+  if (!derived_result) {
+    return derived_result.error();
+  }
+  *derived = std::move(derived_result.value());
+  return &(*derived)->topology;
+}
+
 struct IntersectWithSortedEdgeList {
 private:
-  const GNode base_;
-  const Graph& graph_;
+  const katana::GraphTopology& topology_;
+  const uint32_t* base_begin_;
+  size_t base_size_;
+  // Every node is intersected with base, so if base is a hub it pays to probe
+  // a bitmap of its neighbors rather than merge with them each time
+  IntersectionBitmap base_bitmap_;
+  bool use_bitmap_;
 
 public:
-  IntersectWithSortedEdgeList(const Graph& graph, GNode base)
-      : base_(base), graph_(graph) {}
+  IntersectWithSortedEdgeList(const katana::GraphTopology& topology, GNode base)
+      : topology_(topology) {
+    auto [begin, end] = topology_.edge_range(base);
+    base_begin_ = topology_.out_dests->raw_values() + begin;
+    base_size_ = end - begin;
+    use_bitmap_ = base_size_ >= kIntersectionHubDegree;
+    if (use_bitmap_) {
+      base_bitmap_.Set(base_begin_, base_size_);
+    }
+  }
 
   uint32_t operator()(GNode n2) {
-    uint32_t intersection_size = 0;
-    // Iterate over the edges of both n2 and base in sync, based on the
-    // assumption that edges lists are sorted.
-    auto edges_n2_iter = graph_.edge_begin(n2);
-    auto edges_n2_end = graph_.edge_end(n2);
-    auto edges_base_iter = graph_.edge_begin(base_);
-    auto edges_base_end = graph_.edge_end(base_);
-    while (edges_n2_iter != edges_n2_end && edges_base_iter != edges_base_end) {
-      auto edge_n2_dst = graph_.GetEdgeDest(*edges_n2_iter);
-      auto edge_base_dst = graph_.GetEdgeDest(*edges_base_iter);
-      if (edge_n2_dst == edge_base_dst) {
-        intersection_size++;
-        edges_n2_iter++;
-        edges_base_iter++;
-      } else if (edge_n2_dst > edge_base_dst) {
-        edges_base_iter++;
-      } else if (edge_n2_dst < edge_base_dst) {
-        edges_n2_iter++;
-      }
+    auto [begin, end] = topology_.edge_range(n2);
+    const uint32_t* n2_begin = topology_.out_dests->raw_values() + begin;
+    if (use_bitmap_) {
+      return base_bitmap_.Count(n2_begin, end - begin);
     }
-    return intersection_size;
+    return IntersectCount(base_begin_, base_size_, n2_begin, end - begin);
   }
 };
 
 struct IntersectWithUnsortedEdgeList {
 private:
   std::unordered_set<GNode> base_neighbors;
-  const Graph& graph_;
+  const katana::GraphTopology& topology_;
 
 public:
-  IntersectWithUnsortedEdgeList(const Graph& graph, GNode base)
-      : graph_(graph) {
+  IntersectWithUnsortedEdgeList(
+      const katana::GraphTopology& topology, GNode base)
+      : topology_(topology) {
     // Collect all the neighbors of the base node into a hash set.
-    for (const auto& e : graph.edges(base)) {
-      auto dest = graph.GetEdgeDest(e);
-      base_neighbors.emplace(*dest);
+    for (const auto& e : topology.edges(base)) {
+      base_neighbors.emplace(topology.out_dests->Value(e));
     }
   }
 
   uint32_t operator()(GNode n2) {
     uint32_t intersection_size = 0;
-    for (const auto& e : graph_.edges(n2)) {
-      auto neighbor = graph_.GetEdgeDest(e);
-      if (base_neighbors.count(*neighbor) > 0)
+    for (const auto& e : topology_.edges(n2)) {
+      if (base_neighbors.count(topology_.out_dests->Value(e)) > 0)
         intersection_size++;
     }
     return intersection_size;
@@ -95,7 +235,8 @@ template <typename IntersectAlgorithm>
 katana::Result<void>
 JaccardImpl(
     katana::PropertyGraph<std::tuple<JaccardSimilarity>, std::tuple<>>& graph,
-    size_t compare_node, JaccardPlan /*plan*/) {
+    const katana::GraphTopology& topology, size_t compare_node,
+    JaccardPlan plan) {
   if (compare_node >= graph.size()) {
     return katana::ErrorCode::InvalidArgument;
   }
@@ -106,7 +247,7 @@ JaccardImpl(
 
   uint32_t base_size = graph.edges(base).size();
 
-  IntersectAlgorithm intersect_with_base{graph, base};
+  IntersectAlgorithm intersect_with_base{topology, base};
 
   // Compute the similarity for each node
   katana::do_all(
@@ -117,18 +258,255 @@ JaccardImpl(
         // Count the number of neighbors of n2 and the number that are shared
         // with base
         uint32_t intersection_size = intersect_with_base(n2);
-        // Compute the similarity
-        uint32_t union_size = base_size + n2_size - intersection_size;
-        double similarity =
-            union_size > 0 ? (double)intersection_size / union_size : 1;
-        // Store the similarity back into the graph.
-        n2_data = similarity;
+        // Compute the similarity and store it back into the graph.
+        n2_data = Similarity(
+            plan.similarity_metric(), base_size, n2_size, intersection_size);
       },
       katana::loopname("Jaccard"));
 
   return katana::ResultSuccess();
 }
 
+/// Similarity of the endpoints of every edge. The edges of graph are those of
+/// the original graph, which may be unsorted; neighborhoods are intersected
+/// on sorted.
+void
+AllEdgesImpl(
+    AllEdgesGraph* graph, const katana::GraphTopology& sorted,
+    const JaccardPlan& plan) {
+  const uint32_t* dests = sorted.out_dests->raw_values();
+  auto degree = [&](GNode n) { return sorted.edges(n).size(); };
+  auto is_hub = [&](GNode n) {
+    return plan.hub_degree() > 0 && degree(n) >= plan.hub_degree();
+  };
+
+  // Pairs involving a hub are estimated, so only hubs and the nodes at
+  // either end of their edges need sketches
+  std::optional<MinHashSketches> sketches;
+  if (plan.hub_degree() > 0) {
+    katana::LargeArray<std::atomic<uint8_t>> hub_dest;
+    hub_dest.allocateBlocked(sorted.num_nodes());
+    katana::do_all(
+        katana::iterate(sorted), [&](GNode n) { hub_dest[n] = 0; },
+        katana::no_stats(), katana::loopname("Jaccard_HubDests"));
+    katana::do_all(
+        katana::iterate(sorted),
+        [&](GNode n) {
+          if (!is_hub(n)) {
+            return;
+          }
+          for (auto e : sorted.edges(n)) {
+            hub_dest[dests[e]].store(1, std::memory_order_relaxed);
+          }
+        },
+        katana::steal(), katana::no_stats(),
+        katana::loopname("Jaccard_HubDests"));
+
+    sketches.emplace(sorted, plan.num_hashes(), [&](GNode n) {
+      if (is_hub(n) || hub_dest[n].load(std::memory_order_relaxed)) {
+        return true;
+      }
+      for (auto e : sorted.edges(n)) {
+        if (is_hub(dests[e])) {
+          return true;
+        }
+      }
+      return false;
+    });
+  }
+
+  katana::PerThreadStorage<IntersectionBitmap> bitmaps;
+
+  katana::do_all(
+      katana::iterate(*graph),
+      [&](GNode u) {
+        auto [u_begin, u_end] = sorted.edge_range(u);
+        const uint32_t* u_first = dests + u_begin;
+        uint64_t u_size = u_end - u_begin;
+        bool u_hub = is_hub(u);
+
+        IntersectionBitmap* bitmap = nullptr;
+        if (!u_hub && u_size >= kIntersectionHubDegree) {
+          bitmap = bitmaps.getLocal();
+          bitmap->Set(u_first, u_size);
+        }
+
+        for (auto e : graph->edges(u)) {
+          GNode v = *graph->GetEdgeDest(e);
+          auto [v_begin, v_end] = sorted.edge_range(v);
+          const uint32_t* v_first = dests + v_begin;
+          uint64_t v_size = v_end - v_begin;
+
+          double similarity;
+          if (u_hub || is_hub(v)) {
+            similarity = sketches->Estimate(
+                plan.similarity_metric(), u, u_size, v, v_size);
+          } else {
+            uint64_t intersection_size =
+                bitmap != nullptr
+                    ? bitmap->Count(v_first, v_size)
+                    : IntersectCount(u_first, u_size, v_first, v_size);
+            similarity = Similarity(
+                plan.similarity_metric(), u_size, v_size, intersection_size);
+          }
+          graph->GetEdgeData<JaccardSimilarity>(e) = similarity;
+        }
+
+        if (bitmap != nullptr) {
+          bitmap->Clear(u_first, u_size);
+        }
+      },
+      katana::steal(), katana::chunk_size<64>(),
+      katana::loopname("JaccardAllEdges"));
+}
+
+/// The k most similar nodes among the nodes sharing an out-neighbor with each
+/// node, in row-major num_nodes x k arrays; valid is 0 past the last
+/// candidate of a node. Those nodes are the in-neighbors of the out-neighbors
+/// of a node, so the second hop follows transposed.
+void
+TopKImpl(
+    const katana::GraphTopology& sorted,
+    const katana::GraphTopology& transposed, uint32_t k,
+    const JaccardPlan& plan, std::vector<uint32_t>* nodes,
+    std::vector<double>* similarities, std::vector<uint8_t>* valid) {
+  const uint32_t* dests = sorted.out_dests->raw_values();
+  const uint32_t* sources = transposed.out_dests->raw_values();
+  auto is_hub = [&](GNode n) {
+    return plan.hub_degree() > 0 && sorted.edges(n).size() >= plan.hub_degree();
+  };
+  auto skip_expansion = [&](GNode v) {
+    return plan.hub_degree() > 0 &&
+           transposed.edges(v).size() >= plan.hub_degree();
+  };
+
+  // Pairs with at most one hub are counted exactly, so only pairs of two
+  // hubs need sketches
+  std::optional<MinHashSketches> sketches;
+  if (plan.hub_degree() > 0) {
+    sketches.emplace(sorted, plan.num_hashes(), is_hub);
+  }
+
+  katana::PerThreadStorage<IntersectionBitmap> bitmaps;
+
+  katana::do_all(
+      katana::iterate(sorted),
+      [&](GNode u) {
+        static thread_local std::vector<uint32_t> reached;
+        static thread_local std::vector<std::pair<double, uint32_t>> scored;
+        reached.clear();
+        scored.clear();
+
+        auto [u_begin, u_end] = sorted.edge_range(u);
+        const uint32_t* u_first = dests + u_begin;
+        uint64_t u_size = u_end - u_begin;
+        bool u_hub = is_hub(u);
+
+        // Each candidate w appears once per common out-neighbor of u and w,
+        // so counting runs gives exact intersection sizes unless some
+        // out-neighbor was not expanded
+        bool skipped = false;
+        for (const uint32_t* v = u_first; v != u_first + u_size; ++v) {
+          if (skip_expansion(*v)) {
+            skipped = true;
+            continue;
+          }
+          auto [v_begin, v_end] = transposed.edge_range(*v);
+          reached.insert(reached.end(), sources + v_begin, sources + v_end);
+        }
+        std::sort(reached.begin(), reached.end());
+
+        IntersectionBitmap* bitmap = nullptr;
+        if (skipped && u_size >= kIntersectionHubDegree) {
+          bitmap = bitmaps.getLocal();
+          bitmap->Set(u_first, u_size);
+        }
+
+        for (auto run = reached.begin(); run != reached.end();) {
+          GNode w = *run;
+          auto run_end = std::upper_bound(run, reached.end(), w);
+          uint64_t count = run_end - run;
+          run = run_end;
+          if (w == u) {
+            continue;
+          }
+
+          auto [w_begin, w_end] = sorted.edge_range(w);
+          const uint32_t* w_first = dests + w_begin;
+          uint64_t w_size = w_end - w_begin;
+          double similarity;
+          if (u_hub && is_hub(w)) {
+            similarity = sketches->Estimate(
+                plan.similarity_metric(), u, u_size, w, w_size);
+          } else {
+            if (skipped) {
+              count = bitmap != nullptr
+                          ? bitmap->Count(w_first, w_size)
+                          : IntersectCount(u_first, u_size, w_first, w_size);
+            }
+            similarity =
+                Similarity(plan.similarity_metric(), u_size, w_size, count);
+          }
+          scored.emplace_back(similarity, w);
+        }
+
+        if (bitmap != nullptr) {
+          bitmap->Clear(u_first, u_size);
+        }
+
+        // Most similar first, ties broken by node id
+        size_t found = std::min<size_t>(k, scored.size());
+        std::partial_sort(
+            scored.begin(), scored.begin() + found, scored.end(),
+            [](const auto& a, const auto& b) {
+              return a.first > b.first ||
+                     (a.first == b.first && a.second < b.second);
+            });
+        uint64_t row = uint64_t{u} * k;
+        for (size_t i = 0; i < k; ++i) {
+          bool is_valid = i < found;
+          (*nodes)[row + i] = is_valid ? scored[i].second : 0;
+          (*similarities)[row + i] = is_valid ? scored[i].first : 0;
+          (*valid)[row + i] = is_valid;
+        }
+      },
+      katana::steal(), katana::chunk_size<64>(),
+      katana::loopname("JaccardTopK"));
+}
+
+/// Wrap a row-major num_rows x k array in an arrow array of fixed size lists
+template <typename ArrowType, typename T>
+katana::Result<std::shared_ptr<arrow::Array>>
+MakeFixedSizeListArray(
+    const std::vector<T>& values, const std::vector<uint8_t>& valid,
+    uint64_t num_rows, uint32_t k) {
+  typename arrow::TypeTraits<ArrowType>::BuilderType builder;
+  if (auto r = builder.AppendValues(values.data(), values.size(), valid.data());
+      !r.ok()) {
+    KATANA_LOG_DEBUG("arrow error: {}", r);
+    return katana::ErrorCode::ArrowError;
+  }
+  std::shared_ptr<arrow::Array> flat;
+  if (auto r = builder.Finish(&flat); !r.ok()) {
+    KATANA_LOG_DEBUG("arrow error: {}", r);
+    return katana::ErrorCode::ArrowError;
+  }
+  return std::make_shared<arrow::FixedSizeListArray>(
+      arrow::fixed_size_list(
+          arrow::TypeTraits<ArrowType>::type_singleton(), k),
+      num_rows, flat);
+}
+
+/// MinHash plans need at least one hash per sketch
+katana::Result<void>
+CheckPlan(const JaccardPlan& plan) {
+  if (plan.hub_degree() > 0 && plan.num_hashes() == 0) {
+    KATANA_LOG_DEBUG("MinHash plans need num_hashes > 0");
+    return katana::ErrorCode::InvalidArgument;
+  }
+  return katana::ResultSuccess();
+}
+
 }  // namespace
 
 katana::Result<void>
@@ -148,22 +526,125 @@ katana::analytics::Jaccard(
 
   katana::Result<void> r = katana::ResultSuccess();
   switch (plan.edge_sorting()) {
-  case JaccardPlan::kUnknown:
-    // TODO(amp): It would be possible to start with the sorted case and then
-    //  fail to the unsorted case if unsorted nodes are detected.
+  case JaccardPlan::kUnknown: {
+    // Use the sorted algorithm on the edge-sorted derived topology, which
+    // pfg caches for later analytics too. Sorting does not change node ids
+    // or degrees, so the results are those of the original graph.
+    auto derived_result =
+        pfg->GetDerivedTopology(katana::DerivedTopology::kEdgesSorted);
+    if (!derived_result) {
+      return derived_result.error();
+    }
+    r = JaccardImpl<IntersectWithSortedEdgeList>(
+        pg_result.value(), derived_result.value()->topology, compare_node,
+        plan);
+    break;
+  }
   case JaccardPlan::kUnsorted:
     r = JaccardImpl<IntersectWithUnsortedEdgeList>(
-        pg_result.value(), compare_node, plan);
+        pg_result.value(), pfg->topology(), compare_node, plan);
     break;
   case JaccardPlan::kSorted:
     r = JaccardImpl<IntersectWithSortedEdgeList>(
-        pg_result.value(), compare_node, plan);
+        pg_result.value(), pfg->topology(), compare_node, plan);
     break;
   }
 
   return r;
 }
 
+katana::Result<void>
+katana::analytics::JaccardAllEdges(
+    PropertyFileGraph* pfg, const std::string& output_property_name,
+    JaccardPlan plan) {
+  if (auto r = CheckPlan(plan); !r) {
+    return r.error();
+  }
+
+  std::shared_ptr<const katana::DerivedTopology> derived;
+  auto sorted_result = SortedTopology(pfg, plan, &derived);
+  if (!sorted_result) {
+    return sorted_result.error();
+  }
+
+  if (auto result = ConstructEdgeProperties<std::tuple<JaccardSimilarity>>(
+          pfg, {output_property_name});
+      !result) {
+    return result.error();
+  }
+
+  auto pg_result = AllEdgesGraph::Make(pfg, {}, {output_property_name});
+  if (!pg_result) {
+    return pg_result.error();
+  }
+  auto graph = pg_result.value();
+
+  katana::StatTimer exec_time("JaccardAllEdges", "Jaccard");
+  exec_time.start();
+  AllEdgesImpl(&graph, *sorted_result.value(), plan);
+  exec_time.stop();
+
+  return katana::ResultSuccess();
+}
+
+katana::Result<void>
+katana::analytics::JaccardTopK(
+    PropertyFileGraph* pfg, uint32_t k,
+    const std::string& output_nodes_property_name,
+    const std::string& output_similarities_property_name, JaccardPlan plan) {
+  if (k == 0) {
+    return katana::ErrorCode::InvalidArgument;
+  }
+  if (auto r = CheckPlan(plan); !r) {
+    return r.error();
+  }
+
+  std::shared_ptr<const katana::DerivedTopology> derived;
+  auto sorted_result = SortedTopology(pfg, plan, &derived);
+  if (!sorted_result) {
+    return sorted_result.error();
+  }
+  auto transposed_result =
+      pfg->GetDerivedTopology(katana::DerivedTopology::kTransposed);
+  if (!transposed_result) {
+    return transposed_result.error();
+  }
+
+  uint64_t num_nodes = pfg->num_nodes();
+  std::vector<uint32_t> nodes(num_nodes * k);
+  std::vector<double> similarities(num_nodes * k);
+  std::vector<uint8_t> valid(num_nodes * k);
+
+  katana::StatTimer exec_time("JaccardTopK", "Jaccard");
+  exec_time.start();
+  TopKImpl(
+      *sorted_result.value(), transposed_result.value()->topology, k, plan,
+      &nodes, &similarities, &valid);
+  exec_time.stop();
+
+  auto nodes_result =
+      MakeFixedSizeListArray<arrow::UInt32Type>(nodes, valid, num_nodes, k);
+  if (!nodes_result) {
+    return nodes_result.error();
+  }
+  auto similarities_result = MakeFixedSizeListArray<arrow::DoubleType>(
+      similarities, valid, num_nodes, k);
+  if (!similarities_result) {
+    return similarities_result.error();
+  }
+
+  auto table = arrow::Table::Make(
+      arrow::schema({
+          arrow::field(
+              output_nodes_property_name, nodes_result.value()->type()),
+          arrow::field(
+              output_similarities_property_name,
+              similarities_result.value()->type()),
+      }),
+      {nodes_result.value(), similarities_result.value()});
+  return pfg->AddNodeProperties(table);
+}
+
 constexpr static const double EPSILON = 1e-6;
 
 katana::Result<void>
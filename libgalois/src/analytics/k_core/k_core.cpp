@@ -19,6 +19,9 @@
 
 #include "katana/analytics/k_core/k_core.h"
 
+#include <algorithm>
+#include <limits>
+
 #include "katana/ArrowRandomAccessBuilder.h"
 
 using namespace katana::analytics;
@@ -97,6 +100,9 @@ void
 SyncCascadeKCore(Graph* graph, uint32_t k_core_number) {
   auto current = std::make_unique<katana::InsertBag<GNode>>();
   auto next = std::make_unique<katana::InsertBag<GNode>>();
+  //! The worklists are refilled every round; keep their blocks.
+  current->set_block_recycling();
+  next->set_block_recycling();
 
   //! Setup worklist.
   SetupInitialWorklist(*graph, *next, k_core_number);
@@ -261,6 +267,174 @@ katana::analytics::KCore(
   return KCoreMarkAliveNodes(&graph_final, k_core_number);
 }
 
+struct KCoreNodeCoreNumber {
+  using ArrowType = arrow::CTypeTraits<uint32_t>::ArrowType;
+  using ViewType = katana::PODPropertyView<std::atomic<uint32_t>>;
+};
+
+using DecompositionGraph = katana::PropertyGraph<
+    std::tuple<KCoreNodeCurrentDegree, KCoreNodeCoreNumber>, std::tuple<>>;
+
+//! Core number of nodes that have not been peeled yet.
+constexpr uint32_t kNotPeeled = std::numeric_limits<uint32_t>::max();
+
+//! Number of consecutive degree buckets materialized at a time. Nodes with
+//! larger degrees stay in an implicit overflow bucket, which is rescanned
+//! when the open buckets are exhausted.
+constexpr uint64_t kOpenBuckets = 128;
+
+/**
+ * Peel all nodes in order of degree; the bucket a node is peeled from is its
+ * core number. Follows the bucketing scheme of Julienne [1]: buckets are
+ * processed in increasing order and, within a bucket, in rounds. The degree
+ * decrements of a round are batched so that each affected node is moved to
+ * its new bucket once per round, with its degree clamped to the current
+ * bucket (a neighbor whose degree falls below k still has core number k).
+ *
+ * [1] L. Dhulipala, G. Blelloch and J. Shun, "Julienne: A Framework for
+ * Parallel Graph Algorithms using Work-efficient Bucketing," SPAA 2017.
+ *
+ * @param graph Graph to operate on
+ */
+void
+BucketedPeel(DecompositionGraph* graph) {
+  //! Last round in which the degree of a node was decremented.
+  katana::LargeArray<std::atomic<uint32_t>> last_touched;
+  last_touched.allocateBlocked(graph->size());
+
+  katana::do_all(
+      katana::iterate(*graph),
+      [&](const GNode& node) {
+        graph->GetData<KCoreNodeCurrentDegree>(node).store(
+            std::distance(graph->edge_begin(node), graph->edge_end(node)));
+        graph->GetData<KCoreNodeCoreNumber>(node).store(kNotPeeled);
+        last_touched[node].store(0);
+      },
+      katana::loopname("KCoreDecomposition Init"), katana::no_stats());
+
+  std::vector<katana::InsertBag<GNode>> buckets(kOpenBuckets);
+  auto current = std::make_unique<katana::InsertBag<GNode>>();
+  auto next = std::make_unique<katana::InsertBag<GNode>>();
+  katana::InsertBag<GNode> moved;
+  uint32_t round = 0;
+
+  while (true) {
+    //! Open the window of buckets starting at the smallest remaining degree;
+    //! this skips runs of empty buckets.
+    katana::GReduceMin<uint64_t> min_degree;
+    katana::do_all(
+        katana::iterate(*graph),
+        [&](const GNode& node) {
+          if (graph->GetData<KCoreNodeCoreNumber>(node) == kNotPeeled) {
+            min_degree.update(graph->GetData<KCoreNodeCurrentDegree>(node));
+          }
+        },
+        katana::loopname("KCoreDecomposition MinDegree"), katana::no_stats());
+    if (min_degree.reduce() == std::numeric_limits<uint64_t>::max()) {
+      break;
+    }
+    uint64_t base = min_degree.reduce();
+    uint64_t window_end = base + kOpenBuckets;
+
+    katana::do_all(
+        katana::iterate(*graph),
+        [&](const GNode& node) {
+          uint64_t degree = graph->GetData<KCoreNodeCurrentDegree>(node);
+          if (graph->GetData<KCoreNodeCoreNumber>(node) == kNotPeeled &&
+              degree < window_end) {
+            buckets[degree - base].push(node);
+          }
+        },
+        katana::loopname("KCoreDecomposition Bucket"), katana::no_stats());
+
+    for (uint64_t k = base; k < window_end; ++k) {
+      //! Buckets may hold stale entries of nodes that have since moved to a
+      //! lower bucket and been peeled; claiming the node filters them out.
+      katana::InsertBag<GNode>* frontier = &buckets[k - base];
+      while (!frontier->empty()) {
+        ++round;
+        katana::do_all(
+            katana::iterate(*frontier),
+            [&](const GNode& node) {
+              uint32_t not_peeled = kNotPeeled;
+              if (!graph->GetData<KCoreNodeCoreNumber>(node)
+                       .compare_exchange_strong(
+                           not_peeled, static_cast<uint32_t>(k))) {
+                return;
+              }
+              for (auto e : graph->edges(node)) {
+                auto dest = *graph->GetEdgeDest(e);
+                if (graph->GetData<KCoreNodeCoreNumber>(dest) != kNotPeeled) {
+                  continue;
+                }
+                katana::atomicSub(
+                    graph->GetData<KCoreNodeCurrentDegree>(dest), 1u);
+                if (last_touched[dest].exchange(round) != round) {
+                  moved.push(dest);
+                }
+              }
+            },
+            katana::steal(), katana::chunk_size<KCorePlan::kChunkSize>(),
+            katana::loopname("KCoreDecomposition Peel"));
+
+        katana::do_all(
+            katana::iterate(moved),
+            [&](const GNode& node) {
+              if (graph->GetData<KCoreNodeCoreNumber>(node) != kNotPeeled) {
+                return;
+              }
+              uint64_t degree = std::max<uint64_t>(
+                  graph->GetData<KCoreNodeCurrentDegree>(node), k);
+              if (degree == k) {
+                next->push(node);
+              } else if (degree < window_end) {
+                buckets[degree - base].push(node);
+              }
+            },
+            katana::loopname("KCoreDecomposition Rebucket"),
+            katana::no_stats());
+        moved.clear();
+
+        frontier->clear();
+        std::swap(current, next);
+        frontier = current.get();
+      }
+    }
+  }
+
+  katana::ReportStatSingle("KCoreDecomposition", "Rounds", round);
+}
+
+katana::Result<void>
+katana::analytics::KCoreDecomposition(
+    katana::PropertyFileGraph* pfg, const std::string& output_property_name) {
+  katana::analytics::TemporaryPropertyGuard temporary_property{pfg};
+  if (auto result = ConstructNodeProperties<std::tuple<KCoreNodeCurrentDegree>>(
+          pfg, {temporary_property.name()});
+      !result) {
+    return result.error();
+  }
+  if (auto result = ConstructNodeProperties<std::tuple<KCoreNodeCoreNumber>>(
+          pfg, {output_property_name});
+      !result) {
+    return result.error();
+  }
+
+  auto pg_result = DecompositionGraph::Make(
+      pfg, {temporary_property.name(), output_property_name}, {});
+  if (!pg_result) {
+    return pg_result.error();
+  }
+  auto graph = pg_result.value();
+
+  katana::StatTimer exec_time("KCoreDecomposition");
+  exec_time.start();
+  BucketedPeel(&graph);
+  exec_time.stop();
+
+  return katana::ResultSuccess();
+}
+
 // Doxygen doesn't correctly handle implementation annotations that do not
 // appear in the declaration.
 /// \cond DO_NOT_DOCUMENT
@@ -299,7 +473,91 @@ katana::analytics::KCoreStatistics::Compute(
       },
       katana::loopname("KCore sanity check"), katana::no_stats());
 
-  return KCoreStatistics{alive_nodes.reduce()};
+  return KCoreStatistics{alive_nodes.reduce(), {}};
+}
+
+katana::Result<void>
+katana::analytics::KCoreDecompositionAssertValid(
+    katana::PropertyFileGraph* pfg, const std::string& property_name) {
+  using CoreGraph =
+      katana::PropertyGraph<std::tuple<KCoreNodeAlive>, std::tuple<>>;
+  auto pg_result = CoreGraph::Make(pfg, {property_name}, {});
+  if (!pg_result) {
+    return pg_result.error();
+  }
+  auto graph = pg_result.value();
+
+  auto is_bad = [&graph](const GNode& node) {
+    uint32_t core_number = graph.GetData<KCoreNodeAlive>(node);
+    uint64_t at_least = 0;
+    uint64_t greater = 0;
+    for (auto e : graph.edges(node)) {
+      uint32_t other = graph.GetData<KCoreNodeAlive>(graph.GetEdgeDest(e));
+      at_least += other >= core_number;
+      greater += other > core_number;
+    }
+    if (at_least < core_number || greater > core_number) {
+      KATANA_LOG_DEBUG(
+          "node {} has core number {} but {} neighbors with at least and {} "
+          "with more",
+          node, core_number, at_least, greater);
+      return true;
+    }
+    return false;
+  };
+
+  if (katana::ParallelSTL::find_if(graph.begin(), graph.end(), is_bad) !=
+      graph.end()) {
+    return katana::ErrorCode::AssertionFailed;
+  }
+
+  return katana::ResultSuccess();
+}
+
+katana::Result<KCoreStatistics>
+katana::analytics::KCoreStatistics::Compute(
+    katana::PropertyFileGraph* pfg, const std::string& property_name) {
+  auto pg_result =
+      katana::PropertyGraph<std::tuple<KCoreNodeAlive>, std::tuple<>>::Make(
+          pfg, {property_name}, {});
+  if (!pg_result) {
+    return pg_result.error();
+  }
+  auto graph = pg_result.value();
+
+  katana::GReduceMax<uint32_t> max_core_number;
+  katana::do_all(
+      katana::iterate(graph),
+      [&](const GNode& node) {
+        max_core_number.update(graph.GetData<KCoreNodeAlive>(node));
+      },
+      katana::loopname("KCore max core number"), katana::no_stats());
+  if (graph.num_nodes() == 0) {
+    return KCoreStatistics{0, {}};
+  }
+
+  size_t num_buckets = max_core_number.reduce() + 1;
+  katana::PerThreadStorage<std::vector<uint64_t>> local_histograms;
+  katana::do_all(
+      katana::iterate(graph),
+      [&](const GNode& node) {
+        auto* histogram = local_histograms.getLocal();
+        if (histogram->empty()) {
+          histogram->resize(num_buckets);
+        }
+        ++(*histogram)[graph.GetData<KCoreNodeAlive>(node)];
+      },
+      katana::loopname("KCore histogram"), katana::no_stats());
+
+  std::vector<uint64_t> histogram(num_buckets);
+  for (unsigned i = 0; i < local_histograms.size(); ++i) {
+    const auto* local = local_histograms.getRemote(i);
+    for (size_t k = 0; k < local->size(); ++k) {
+      histogram[k] += (*local)[k];
+    }
+  }
+
+  return KCoreStatistics{histogram.back(), std::move(histogram)};
 }
 /// \endcond DO_NOT_DOCUMENT
 
@@ -307,4 +565,10 @@ void
 katana::analytics::KCoreStatistics::Print(std::ostream& os) const {
   os << "Number of nodes in the core = " << number_of_nodes_in_kcore
      << std::endl;
+  for (size_t k = 0; k < core_number_histogram.size(); ++k) {
+    if (core_number_histogram[k] > 0) {
+      os << "Number of nodes with core number " << k << " = "
+         << core_number_histogram[k] << std::endl;
+    }
+  }
 }
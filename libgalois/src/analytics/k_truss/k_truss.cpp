@@ -20,6 +20,7 @@
 #include "katana/analytics/k_truss/k_truss.h"
 
 #include "katana/ArrowRandomAccessBuilder.h"
+#include "katana/analytics/Intersection.h"
 
 using namespace katana::analytics;
 
@@ -79,6 +80,17 @@ IsValidDegreeNoLessThanJ(const Graph& g, GNode n, unsigned int j) {
   return numValid >= j;
 }
 
+/// Replace the contents of out with the destinations of the valid edges of n
+void
+CollectValidDests(const Graph& g, GNode n, std::vector<uint32_t>* out) {
+  out->clear();
+  for (auto e : g.edges(n)) {
+    if (!(g.GetEdgeData<EdgeFlag>(e) & removed)) {
+      out->push_back(*g.GetEdgeDest(e));
+    }
+  }
+}
+
 /**
  * Measure the number of intersected edges between the src and the dest nodes.
  *
@@ -91,40 +103,22 @@ IsValidDegreeNoLessThanJ(const Graph& g, GNode n, unsigned int j) {
  */
 bool
 IsSupportNoLessThanJ(const Graph& g, GNode src, GNode dest, unsigned int j) {
-  size_t numValidEqual = 0;
-  auto srcI = g.edge_begin(src), srcE = g.edge_end(src),
-       dstI = g.edge_begin(dest), dstE = g.edge_end(dest);
-
-  while (true) {
-    //! Find the first valid edge.
-    while (srcI != srcE && (g.GetEdgeData<EdgeFlag>(srcI) & removed)) {
-      ++srcI;
-    }
-    while (dstI != dstE && (g.GetEdgeData<EdgeFlag>(dstI) & removed)) {
-      ++dstI;
-    }
-
-    if (srcI == srcE || dstI == dstE) {
-      return numValidEqual >= j;
-    }
-
-    //! Check for intersection.
-    auto sN = *g.GetEdgeDest(srcI), dN = *g.GetEdgeDest(dstI);
-    if (sN < dN) {
-      ++srcI;
-    } else if (dN < sN) {
-      ++dstI;
-    } else {
-      numValidEqual += 1;
-      if (numValidEqual >= j) {
-        return true;
-      }
-      ++srcI;
-      ++dstI;
-    }
+  // Compact the valid neighbors so that they can be intersected with the
+  // vectorized kernels, which have no notion of removed edges
+  static thread_local std::vector<uint32_t> src_dests;
+  static thread_local std::vector<uint32_t> dst_dests;
+
+  CollectValidDests(g, src, &src_dests);
+  if (src_dests.size() < j) {
+    return false;
   }
-
-  return numValidEqual >= j;
+  CollectValidDests(g, dest, &dst_dests);
+  if (dst_dests.size() < j) {
+    return false;
+  }
+  return IntersectCount(
+             src_dests.data(), src_dests.size(), dst_dests.data(),
+             dst_dests.size()) >= j;
 }
 
 struct PickUnsupportedEdges {
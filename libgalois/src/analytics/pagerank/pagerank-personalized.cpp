@@ -0,0 +1,301 @@
+#include <algorithm>
+#include <atomic>
+
+#include "katana/AtomicHelpers.h"
+#include "katana/LargeArray.h"
+#include "katana/Timer.h"
+#include "katana/analytics/Utils.h"
+#include "pagerank-impl.h"
+
+using katana::atomicAdd;
+using katana::analytics::PagerankPlan;
+
+namespace {
+
+using GNode = katana::GraphTopology::Node;
+
+/// Residual pushed into a lane of a node before the push starts
+struct SeedResidual {
+  GNode node;
+  uint32_t lane;
+  PRTy residual;
+};
+
+/// Push residual for num_lanes personalization vectors at once. Lane l of
+/// node n, at n * num_lanes + l, holds the rank and residual of n with respect
+/// to the l-th vector, so one traversal of the edges of a node serves every
+/// lane.
+///
+/// The residual form is the one of the push algorithms for the whole graph,
+/// except that the residual starts at (1 - alpha) times the personalization
+/// vector instead of at (1 - alpha) on every node. Only nodes reached from the
+/// seeds are ever activated.
+katana::LargeArray<std::atomic<PRTy>>
+PushPersonalized(
+    const katana::GraphTopology& topology, uint32_t num_lanes,
+    const std::vector<SeedResidual>& seed_residuals, const PagerankPlan& plan) {
+  uint64_t size = topology.num_nodes() * num_lanes;
+  katana::LargeArray<std::atomic<PRTy>> values;
+  katana::LargeArray<std::atomic<PRTy>> residuals;
+  values.allocateBlocked(size);
+  residuals.allocateBlocked(size);
+  katana::do_all(
+      katana::iterate(uint64_t{0}, size),
+      [&](uint64_t i) {
+        values[i] = 0;
+        residuals[i] = 0;
+      },
+      katana::no_stats(), katana::loopname("Initialize"));
+
+  // The local push of Andersen, Chung and Lang only pushes from a node once
+  // its residual is large relative to its degree. This bounds the work of the
+  // push by 1 / (tolerance * (1 - alpha)) independently of the graph size.
+  auto limit = [&](GNode n) -> PRTy {
+    if (plan.algorithm() != PagerankPlan::kPushLocal) {
+      return plan.tolerance();
+    }
+    return plan.tolerance() * std::max<uint64_t>(topology.edges(n).size(), 1);
+  };
+
+  std::vector<GNode> active;
+  for (const auto& s : seed_residuals) {
+    atomicAdd(
+        residuals[s.node * num_lanes + s.lane],
+        plan.initial_residual() * s.residual);
+    active.push_back(s.node);
+  }
+  std::sort(active.begin(), active.end());
+  active.erase(std::unique(active.begin(), active.end()), active.end());
+
+  typedef katana::PerSocketChunkFIFO<PagerankPlan::kChunkSize> WL;
+  katana::for_each(
+      katana::iterate(active),
+      [&](const GNode& src, auto& ctx) {
+        thread_local std::vector<PRTy> deltas;
+        deltas.assign(num_lanes, 0);
+
+        auto edges = topology.edges(src);
+        uint64_t src_nout = edges.size();
+        PRTy src_limit = limit(src);
+        bool pushed = false;
+        for (uint32_t l = 0; l < num_lanes; ++l) {
+          auto& src_residual = residuals[src * num_lanes + l];
+          if (src_residual.load(std::memory_order_relaxed) < src_limit) {
+            continue;
+          }
+          PRTy old_residual = src_residual.exchange(0.0);
+          atomicAdd(values[src * num_lanes + l], old_residual);
+          if (src_nout > 0) {
+            deltas[l] = old_residual * plan.alpha() / src_nout;
+            pushed |= deltas[l] > 0;
+          }
+        }
+        if (!pushed) {
+          return;
+        }
+
+        for (const auto& e : edges) {
+          GNode dest = topology.out_dests->Value(e);
+          PRTy dest_limit = limit(dest);
+          bool activate = false;
+          for (uint32_t l = 0; l < num_lanes; ++l) {
+            if (deltas[l] <= 0) {
+              continue;
+            }
+            auto old = atomicAdd(residuals[dest * num_lanes + l], deltas[l]);
+            activate |= (old < dest_limit) && (old + deltas[l] >= dest_limit);
+          }
+          if (activate) {
+            ctx.push(dest);
+          }
+        }
+      },
+      katana::loopname("PagerankPersonalized"),
+      katana::disable_conflict_detection(), katana::wl<WL>());
+
+  return values;
+}
+
+katana::Result<void>
+CheckPersonalizedPlan(const PagerankPlan& plan) {
+  // The automatic plan pushes asynchronously
+  if (plan.algorithm() != PagerankPlan::kPushAsynchronous &&
+      plan.algorithm() != PagerankPlan::kPushLocal &&
+      plan.algorithm() != PagerankPlan::kAutomatic) {
+    KATANA_LOG_DEBUG(
+        "personalized pagerank requires the asynchronous or local push "
+        "algorithm");
+    return katana::ErrorCode::InvalidArgument;
+  }
+  return katana::ResultSuccess();
+}
+
+katana::Result<void>
+CheckSeeds(
+    const katana::PropertyFileGraph& pfg, const std::vector<GNode>& seeds) {
+  if (seeds.empty()) {
+    KATANA_LOG_DEBUG("personalized pagerank requires at least one seed");
+    return katana::ErrorCode::InvalidArgument;
+  }
+  for (GNode seed : seeds) {
+    if (seed >= pfg.num_nodes()) {
+      KATANA_LOG_DEBUG(
+          "seed {} is not a node of a graph with {} nodes", seed,
+          pfg.num_nodes());
+      return katana::ErrorCode::InvalidArgument;
+    }
+  }
+  return katana::ResultSuccess();
+}
+
+/// Add lane l of values as the node property output_property_names[l]
+katana::Result<void>
+AddLanes(
+    katana::PropertyFileGraph* pfg,
+    const katana::LargeArray<std::atomic<PRTy>>& values,
+    const std::vector<std::string>& output_property_names) {
+  uint64_t num_nodes = pfg->num_nodes();
+  uint32_t num_lanes = output_property_names.size();
+
+  std::vector<std::shared_ptr<arrow::Field>> fields;
+  std::vector<std::shared_ptr<arrow::Array>> columns;
+  for (uint32_t l = 0; l < num_lanes; ++l) {
+    auto buffer_result = arrow::AllocateBuffer(
+        num_nodes * sizeof(PRTy), arrow::default_memory_pool());
+    if (!buffer_result.ok()) {
+      KATANA_LOG_DEBUG("arrow error: {}", buffer_result.status());
+      return katana::ErrorCode::ArrowError;
+    }
+    std::shared_ptr<arrow::Buffer> buffer =
+        std::move(buffer_result.ValueOrDie());
+    auto* data = reinterpret_cast<PRTy*>(buffer->mutable_data());
+    katana::do_all(
+        katana::iterate(uint64_t{0}, num_nodes),
+        [&](uint64_t n) { data[n] = values[n * num_lanes + l].load(); },
+        katana::no_stats(), katana::loopname("CopyLane"));
+
+    fields.emplace_back(
+        arrow::field(output_property_names[l], arrow::float32()));
+    columns.emplace_back(
+        std::make_shared<arrow::FloatArray>(num_nodes, std::move(buffer)));
+  }
+
+  return pfg->AddNodeProperties(
+      arrow::Table::Make(arrow::schema(fields), columns));
+}
+
+}  // namespace
+
+katana::Result<void>
+katana::analytics::PagerankPersonalized(
+    PropertyFileGraph* pfg, const std::vector<uint32_t>& seeds,
+    const std::string& output_property_name, PagerankPlan plan) {
+  if (auto r = CheckPersonalizedPlan(plan); !r) {
+    return r.error();
+  }
+  if (auto r = CheckSeeds(*pfg, seeds); !r) {
+    return r.error();
+  }
+
+  std::vector<SeedResidual> seed_residuals;
+  for (GNode seed : seeds) {
+    seed_residuals.emplace_back(
+        SeedResidual{seed, 0, PRTy{1} / static_cast<PRTy>(seeds.size())});
+  }
+
+  katana::StatTimer exec_time("PagerankPersonalized");
+  exec_time.start();
+  auto values = PushPersonalized(pfg->topology(), 1, seed_residuals, plan);
+  exec_time.stop();
+
+  return AddLanes(pfg, values, {output_property_name});
+}
+
+katana::Result<void>
+katana::analytics::PagerankPersonalizedWeighted(
+    PropertyFileGraph* pfg, const std::string& seed_weight_property_name,
+    const std::string& output_property_name, PagerankPlan plan) {
+  if (auto r = CheckPersonalizedPlan(plan); !r) {
+    return r.error();
+  }
+
+  auto graph_result =
+      PropertyGraph<std::tuple<NodeValue>, std::tuple<>>::Make(
+          pfg, {seed_weight_property_name}, {});
+  if (!graph_result) {
+    return graph_result.error();
+  }
+  auto graph = graph_result.value();
+
+  katana::InsertBag<GNode> seed_bag;
+  katana::GAccumulator<double> total_weight;
+  katana::GAccumulator<uint64_t> negative_weights;
+  katana::do_all(
+      katana::iterate(graph),
+      [&](const GNode& n) {
+        PRTy weight = graph.GetData<NodeValue>(n);
+        if (weight > 0) {
+          seed_bag.push(n);
+          total_weight += weight;
+        } else if (weight < 0) {
+          negative_weights += 1;
+        }
+      },
+      katana::no_stats(), katana::loopname("FindSeeds"));
+
+  if (negative_weights.reduce() > 0 || total_weight.reduce() <= 0) {
+    KATANA_LOG_DEBUG(
+        "seed weights must be non-negative with a positive sum; {} are "
+        "negative and the sum is {}",
+        negative_weights.reduce(), total_weight.reduce());
+    return katana::ErrorCode::InvalidArgument;
+  }
+
+  std::vector<SeedResidual> seed_residuals;
+  for (GNode seed : seed_bag) {
+    seed_residuals.emplace_back(SeedResidual{
+        seed, 0,
+        static_cast<PRTy>(
+            graph.GetData<NodeValue>(seed) / total_weight.reduce())});
+  }
+
+  katana::StatTimer exec_time("PagerankPersonalized");
+  exec_time.start();
+  auto values = PushPersonalized(pfg->topology(), 1, seed_residuals, plan);
+  exec_time.stop();
+
+  return AddLanes(pfg, values, {output_property_name});
+}
+
+katana::Result<void>
+katana::analytics::PagerankMultiSeed(
+    PropertyFileGraph* pfg, const std::vector<uint32_t>& seeds,
+    const std::vector<std::string>& output_property_names, PagerankPlan plan) {
+  if (auto r = CheckPersonalizedPlan(plan); !r) {
+    return r.error();
+  }
+  if (auto r = CheckSeeds(*pfg, seeds); !r) {
+    return r.error();
+  }
+  if (seeds.size() != output_property_names.size()) {
+    KATANA_LOG_DEBUG(
+        "{} seeds but {} output properties", seeds.size(),
+        output_property_names.size());
+    return katana::ErrorCode::InvalidArgument;
+  }
+
+  std::vector<SeedResidual> seed_residuals;
+  for (uint32_t l = 0; l < seeds.size(); ++l) {
+    seed_residuals.emplace_back(SeedResidual{seeds[l], l, 1});
+  }
+
+  katana::StatTimer exec_time("PagerankMultiSeed");
+  exec_time.start();
+  auto values =
+      PushPersonalized(pfg->topology(), seeds.size(), seed_residuals, plan);
+  exec_time.stop();
+
+  katana::ReportStatSingle("PagerankMultiSeed", "seeds", seeds.size());
+
+  return AddLanes(pfg, values, output_property_names);
+}
@@ -17,7 +17,10 @@
  * Documentation, or loss or inaccuracy of data of any kind.
  */
 
+#include <cmath>
+
 #include "katana/AtomicHelpers.h"
+#include "katana/EdgeTiles.h"
 #include "katana/analytics/Utils.h"
 #include "pagerank-impl.h"
 
@@ -135,7 +138,8 @@ PagerankPushSynchronous(
     Graph::edge_iterator end;
   };
 
-  constexpr ptrdiff_t kEdgeTileSize = 128;
+  const ptrdiff_t edge_tile_size = katana::AdaptiveEdgeTileSize(
+      graph.GetPropertyFileGraph().topology());
 
   katana::InsertBag<Update> updates;
   katana::InsertBag<GNode> active_nodes;
@@ -165,17 +169,11 @@ PagerankPushSynchronous(
             KATANA_LOG_ASSERT(beg <= end);
 
             //! Edge tiling for large outdegree nodes.
-            if ((end - beg) > kEdgeTileSize) {
-              for (; beg + kEdgeTileSize < end;) {
-                auto ne = beg + kEdgeTileSize;
-                updates.push(Update{delta, beg, ne});
-                beg = ne;
-              }
-            }
-
-            if ((end - beg) > 0) {
-              updates.push(Update{delta, beg, end});
-            }
+            katana::ForEachEdgeTile(
+                beg, end, edge_tile_size,
+                [&](const auto& tile_beg, const auto& tile_end) {
+                  updates.push(Update{delta, tile_beg, tile_end});
+                });
           }
         },
         katana::steal(),
@@ -209,3 +207,142 @@ PagerankPushSynchronous(
   }
   return katana::ResultSuccess();
 }
+
+katana::Result<void>
+katana::analytics::PagerankIncremental(
+    katana::PropertyFileGraph* pfg, const std::string& property_name,
+    const EdgeBatch& edge_batch, katana::analytics::PagerankPlan plan) {
+  if (auto r = CheckEdgeBatch(*pfg, edge_batch); !r) {
+    return r.error();
+  }
+
+  // Group the batch by source so that each affected source is handled by one
+  // task, which knows how many of its edges are new.
+  EdgeBatch sorted_batch(edge_batch);
+  katana::ParallelSTL::sort(sorted_batch.begin(), sorted_batch.end());
+
+  std::vector<size_t> source_offsets;
+  for (size_t i = 0; i < sorted_batch.size(); ++i) {
+    if (i == 0 || sorted_batch[i].first != sorted_batch[i - 1].first) {
+      source_offsets.push_back(i);
+    }
+  }
+  source_offsets.push_back(sorted_batch.size());
+
+  for (size_t i = 0; i + 1 < source_offsets.size(); ++i) {
+    auto src = sorted_batch[source_offsets[i]].first;
+    if (pfg->edges(src).size() < source_offsets[i + 1] - source_offsets[i]) {
+      KATANA_LOG_DEBUG(
+          "node {} has fewer edges than the batch adds to it; the batch must "
+          "already be part of the graph",
+          src);
+      return katana::ErrorCode::InvalidArgument;
+    }
+  }
+
+  katana::analytics::TemporaryPropertyGuard temporary_property{pfg};
+
+  if (auto result =
+          katana::analytics::ConstructNodeProperties<std::tuple<NodeResidual>>(
+              pfg, {temporary_property.name()});
+      !result) {
+    return result.error();
+  }
+
+  auto graph_result =
+      Graph::Make(pfg, {property_name, temporary_property.name()}, {});
+  if (!graph_result) {
+    return graph_result.error();
+  }
+  Graph graph = graph_result.value();
+
+  katana::do_all(
+      katana::iterate(graph),
+      [&](const GNode& n) { graph.GetData<NodeResidual>(n) = 0; },
+      katana::no_stats(), katana::loopname("Initialize"));
+
+  katana::StatTimer exec_time("PagerankIncremental");
+  exec_time.start();
+
+  // The previous ranks are a fixed point of
+  //   rank(v) = (1 - alpha) + alpha * sum_{u -> v} rank(u) / out_degree(u)
+  // on the graph without the batch. Adding edges only changes the terms of
+  // the batch sources, so the residual of the new graph is the difference of
+  // those terms: every edge of a source now carries rank / new_degree instead
+  // of rank / old_degree.
+  katana::InsertBag<GNode> active_nodes;
+  katana::do_all(
+      katana::iterate(size_t{0}, source_offsets.size() - 1),
+      [&](size_t i) {
+        auto src = sorted_batch[source_offsets[i]].first;
+        PRTy src_rank = graph.GetData<NodeValue>(src);
+        size_t new_degree = graph.edges(src).size();
+        size_t old_degree =
+            new_degree - (source_offsets[i + 1] - source_offsets[i]);
+
+        PRTy new_share = plan.alpha() * src_rank / new_degree;
+        PRTy old_share =
+            old_degree > 0 ? plan.alpha() * src_rank / old_degree : 0;
+
+        auto push = [&](GNode dest, PRTy delta) {
+          auto& dest_residual = graph.GetData<NodeResidual>(dest);
+          auto old = atomicAdd(dest_residual, delta);
+          if ((std::abs(old) < plan.tolerance()) &&
+              (std::abs(old + delta) >= plan.tolerance())) {
+            active_nodes.push(dest);
+          }
+        };
+
+        // Every current edge, including the new ones, moves from the old
+        // share to the new share; new edges then get back the old share
+        // they were never given.
+        for (const auto& jj : graph.edges(src)) {
+          push(*graph.GetEdgeDest(jj), new_share - old_share);
+        }
+        if (old_degree > 0) {
+          for (size_t j = source_offsets[i]; j < source_offsets[i + 1]; ++j) {
+            push(sorted_batch[j].second, old_share);
+          }
+        }
+      },
+      katana::steal(), katana::loopname("PagerankIncremental-Seed"));
+
+  // Residuals may now be negative, so unlike the push algorithms above a
+  // node is active while the magnitude of its residual exceeds the tolerance.
+  typedef katana::PerSocketChunkFIFO<
+      katana::analytics::PagerankPlan::kChunkSize>
+      WL;
+  katana::for_each(
+      katana::iterate(active_nodes),
+      [&](const GNode& src, auto& ctx) {
+        auto& src_residual = graph.GetData<NodeResidual>(src);
+        if (std::abs(src_residual.load()) < plan.tolerance()) {
+          return;
+        }
+        PRTy old_residual = src_residual.exchange(0.0);
+        graph.GetData<NodeValue>(src) += old_residual;
+        int src_nout = graph.edges(src).size();
+        if (src_nout == 0) {
+          return;
+        }
+        PRTy delta = old_residual * plan.alpha() / src_nout;
+        for (const auto& jj : graph.edges(src)) {
+          auto dest = graph.GetEdgeDest(jj);
+          auto& dest_residual = graph.GetData<NodeResidual>(dest);
+          auto old = atomicAdd(dest_residual, delta);
+          if ((std::abs(old) < plan.tolerance()) &&
+              (std::abs(old + delta) >= plan.tolerance())) {
+            ctx.push(*dest);
+          }
+        }
+      },
+      katana::loopname("PagerankIncremental-Push"),
+      katana::disable_conflict_detection(), katana::wl<WL>());
+
+  exec_time.stop();
+
+  katana::ReportStatSingle(
+      "PagerankIncremental", "affected_sources", source_offsets.size() - 1);
+
+  return katana::ResultSuccess();
+}
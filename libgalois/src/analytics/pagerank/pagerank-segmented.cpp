@@ -0,0 +1,102 @@
+#include <atomic>
+
+#include "katana/AtomicHelpers.h"
+#include "katana/EdgeTiles.h"
+#include "katana/LargeArray.h"
+#include "katana/SegmentedTopology.h"
+#include "pagerank-impl.h"
+
+using katana::atomicAdd;
+
+katana::Result<std::shared_ptr<arrow::FloatArray>>
+katana::analytics::PagerankSegmented(
+    const std::string& rdg_name, PagerankPlan plan, uint64_t segment_bytes) {
+  // Other algorithms leave max_iterations at 0, which would return before the
+  // first round
+  if (plan.algorithm() != PagerankPlan::kPushSynchronous) {
+    KATANA_LOG_DEBUG("PagerankSegmented only runs kPushSynchronous plans");
+    return katana::ErrorCode::InvalidArgument;
+  }
+
+  auto topology_result = SegmentedTopology::Make(rdg_name, segment_bytes);
+  if (!topology_result) {
+    return topology_result.error();
+  }
+  SegmentedTopology topology = std::move(topology_result.value());
+  uint64_t num_nodes = topology.num_nodes();
+
+  auto buffer_result = arrow::AllocateBuffer(
+      num_nodes * sizeof(PRTy), arrow::default_memory_pool());
+  if (!buffer_result.ok()) {
+    KATANA_LOG_DEBUG("arrow error: {}", buffer_result.status());
+    return katana::ErrorCode::ArrowError;
+  }
+  std::shared_ptr<arrow::Buffer> buffer = std::move(buffer_result.ValueOrDie());
+  auto* rank = reinterpret_cast<PRTy*>(buffer->mutable_data());
+
+  katana::LargeArray<std::atomic<PRTy>> residual;
+  residual.allocateBlocked(num_nodes);
+  // Residual each node pushes along each of its edges this round
+  katana::LargeArray<PRTy> delta;
+  delta.allocateBlocked(num_nodes);
+
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_nodes),
+      [&](uint64_t n) {
+        rank[n] = 0;
+        residual[n].store(plan.initial_residual(), std::memory_order_relaxed);
+      },
+      katana::no_stats(), katana::loopname("Initialize"));
+
+  // Synchronous push: residuals above the tolerance are folded into the
+  // ranks and then pushed in one streaming pass over the edges per round.
+  size_t iter = 0;
+  for (; iter < plan.max_iterations(); ++iter) {
+    katana::GAccumulator<uint64_t> active;
+    katana::do_all(
+        katana::iterate(uint64_t{0}, num_nodes),
+        [&](uint64_t n) {
+          delta[n] = 0;
+          PRTy old_residual = residual[n].load(std::memory_order_relaxed);
+          if (old_residual <= plan.tolerance()) {
+            return;
+          }
+          rank[n] += old_residual;
+          residual[n].store(0, std::memory_order_relaxed);
+          if (uint64_t degree = topology.degree(n); degree > 0) {
+            delta[n] = old_residual * plan.alpha() / degree;
+          }
+          active += 1;
+        },
+        katana::no_stats(), katana::loopname("Activate"));
+
+    if (active.reduce() == 0) {
+      break;
+    }
+
+    auto res = topology.ForEachSegment(
+        [&](const TopologySegment& segment) -> katana::Result<void> {
+          const GraphTopology& local = segment.topology;
+          katana::do_all_edges(
+              local,
+              [&](GraphTopology::Node src, GraphTopology::Edge e) {
+                PRTy d = delta[segment.node_begin + src];
+                if (d > 0) {
+                  atomicAdd(residual[local.out_dests->Value(e)], d);
+                }
+              },
+              katana::kAdaptiveEdgeTileSize, katana::steal(),
+              katana::no_stats(), katana::loopname("PushSegment"));
+          return katana::ResultSuccess();
+        });
+    if (!res) {
+      return res.error();
+    }
+  }
+
+  katana::ReportStatSingle("PagerankSegmented", "Iterations", iter);
+  katana::ReportStatSingle(
+      "PagerankSegmented", "Segments", topology.num_segments());
+
+  return std::make_shared<arrow::FloatArray>(num_nodes, buffer);
+}
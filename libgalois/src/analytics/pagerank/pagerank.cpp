@@ -17,6 +17,7 @@
  * Documentation, or loss or inaccuracy of data of any kind.
  */
 
+#include "katana/analytics/Planner.h"
 #include "pagerank-impl.h"
 
 katana::Result<void>
@@ -32,6 +33,13 @@ katana::analytics::Pagerank(
     return PagerankPushAsynchronous(pfg, output_property_name, plan);
   case PagerankPlan::kPushSynchronous:
     return PagerankPushSynchronous(pfg, output_property_name, plan);
+  case PagerankPlan::kPushLocal:
+    KATANA_LOG_DEBUG("local push only applies to personalized pagerank");
+    return katana::ErrorCode::InvalidArgument;
+  case PagerankPlan::kAutomatic:
+    return Pagerank(
+        pfg, output_property_name,
+        ChoosePagerankPlan(GraphFeatures::Compute(*pfg), plan));
   default:
     return katana::ErrorCode::InvalidArgument;
   }
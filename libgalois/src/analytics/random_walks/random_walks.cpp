@@ -0,0 +1,553 @@
+#include "katana/analytics/random_walks/random_walks.h"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "katana/LargeArray.h"
+#include "katana/ParallelSTL.h"
+#include "katana/Timer.h"
+#include "katana/analytics/Utils.h"
+
+using katana::analytics::RandomWalksPlan;
+
+namespace {
+
+using GNode = katana::GraphTopology::Node;
+
+constexpr uint64_t kSeed = 0x51ed2701;
+
+/// Vose's alias method: fill prob and alias so that picking i uniformly and
+/// keeping it with probability prob[i], or taking alias[i] otherwise, draws i
+/// with probability proportional to weights[i]. The buffers are reused
+/// between tables.
+class AliasTableBuilder {
+  std::vector<uint32_t> small_;
+  std::vector<uint32_t> large_;
+  std::vector<double> scaled_;
+
+public:
+  void Build(
+      const double* weights, uint32_t size, float* prob, uint32_t* alias) {
+    double total = 0;
+    for (uint32_t i = 0; i < size; ++i) {
+      total += weights[i];
+    }
+    if (!(total > 0)) {
+      for (uint32_t i = 0; i < size; ++i) {
+        prob[i] = 1;
+        alias[i] = i;
+      }
+      return;
+    }
+
+    scaled_.resize(size);
+    small_.clear();
+    large_.clear();
+    for (uint32_t i = 0; i < size; ++i) {
+      scaled_[i] = weights[i] * size / total;
+      (scaled_[i] < 1 ? small_ : large_).push_back(i);
+    }
+    while (!small_.empty() && !large_.empty()) {
+      uint32_t s = small_.back();
+      small_.pop_back();
+      uint32_t l = large_.back();
+      prob[s] = scaled_[s];
+      alias[s] = l;
+      scaled_[l] -= 1 - scaled_[s];
+      if (scaled_[l] < 1) {
+        large_.pop_back();
+        small_.push_back(l);
+      }
+    }
+    // Whatever is left is 1 up to rounding
+    for (uint32_t i : large_) {
+      prob[i] = 1;
+      alias[i] = i;
+    }
+    for (uint32_t i : small_) {
+      prob[i] = 1;
+      alias[i] = i;
+    }
+  }
+};
+
+template <typename RNG>
+uint32_t
+SampleAlias(const float* prob, const uint32_t* alias, uint32_t size, RNG* rng) {
+  uint32_t i = std::uniform_int_distribution<uint32_t>(0, size - 1)(*rng);
+  if (std::uniform_real_distribution<float>(0, 1)(*rng) < prob[i]) {
+    return i;
+  }
+  return alias[i];
+}
+
+/// Edge weights are probabilities up to a factor, so they may not be
+/// negative
+katana::Result<void>
+CheckEdgeWeights(const katana::LargeArray<double>& weights) {
+  katana::GAccumulator<uint64_t> negative;
+  katana::do_all(
+      katana::iterate(uint64_t{0}, weights.size()),
+      [&](uint64_t e) {
+        if (weights[e] < 0) {
+          negative += 1;
+        }
+      },
+      katana::no_stats(), katana::loopname("CheckEdgeWeights"));
+  if (negative.reduce() > 0) {
+    KATANA_LOG_DEBUG("{} edge weights are negative", negative.reduce());
+    return katana::ErrorCode::InvalidArgument;
+  }
+  return katana::ResultSuccess();
+}
+
+/// Generates the walks of a RandomWalksPlan. Every node has an alias table
+/// over its edges, weighted by edge weight, and every edge into a node of
+/// small degree has an alias table over the edges of that node, weighted by
+/// edge weight times the node2vec bias given the node the walk came from.
+/// A step out of a node whose table was not precomputed draws from the
+/// first order table of the node and accepts the draw with probability
+/// proportional to its bias.
+class Walker {
+  const katana::GraphTopology& topology_;
+  const katana::GraphTopology& sorted_;
+  const uint32_t* dests_;
+  const RandomWalksPlan& plan_;
+  double backward_weight_;
+  double forward_weight_;
+
+  katana::LargeArray<float> node_prob_;
+  katana::LargeArray<uint32_t> node_alias_;
+  /// The table of edge e is [table_begin_[e], table_begin_[e + 1]), empty if
+  /// it was not precomputed
+  katana::LargeArray<uint64_t> table_begin_;
+  katana::LargeArray<float> edge_prob_;
+  katana::LargeArray<uint32_t> edge_alias_;
+
+  /// For kEdge2vec, the type of each edge and the row-major transition
+  /// matrix between the types of consecutive edges
+  const uint32_t* types_{nullptr};
+  uint32_t num_types_{0};
+  std::vector<double> matrix_;
+  double max_bias_{1};
+
+  // Not katana::RandomUniformInt and RandomUniformFloat: they seed from
+  // std::random_device, so walks could not be reproduced, and every draw is
+  // an out-of-line call. RandomUniformFloat is also closed at its maximum,
+  // while SampleAlias needs draws in [0, 1).
+  katana::PerThreadStorage<std::mt19937_64> rngs_;
+
+public:
+  Walker(
+      const katana::GraphTopology& topology,
+      const katana::GraphTopology& sorted, const RandomWalksPlan& plan)
+      : topology_(topology),
+        sorted_(sorted),
+        dests_(topology.out_dests->raw_values()),
+        plan_(plan),
+        backward_weight_(1 / plan.backward_probability()),
+        forward_weight_(1 / plan.forward_probability()) {
+    max_bias_ = std::max({1.0, backward_weight_, forward_weight_});
+    katana::on_each([&](unsigned tid, unsigned) {
+      rngs_.getLocal()->seed(kSeed + tid);
+    });
+  }
+
+  /// The node2vec bias of stepping to x after coming from prev
+  double Bias(GNode prev, GNode x) const {
+    if (x == prev) {
+      return backward_weight_;
+    }
+    auto [begin, end] = sorted_.edge_range(prev);
+    const uint32_t* sorted_dests = sorted_.out_dests->raw_values();
+    if (std::binary_search(sorted_dests + begin, sorted_dests + end, x)) {
+      return 1;
+    }
+    return forward_weight_;
+  }
+
+  void BuildNodeTables(const katana::LargeArray<double>& weights) {
+    node_prob_.allocateBlocked(topology_.num_edges());
+    node_alias_.allocateBlocked(topology_.num_edges());
+    katana::do_all(
+        katana::iterate(uint64_t{0}, topology_.num_nodes()),
+        [&](uint64_t n) {
+          thread_local AliasTableBuilder builder;
+          auto [begin, end] = topology_.edge_range(n);
+          builder.Build(
+              weights.data() + begin, end - begin, node_prob_.data() + begin,
+              node_alias_.data() + begin);
+        },
+        katana::steal(), katana::no_stats(),
+        katana::loopname("BuildNodeTables"));
+  }
+
+  void BuildEdgeTables(const katana::LargeArray<double>& weights) {
+    uint64_t num_edges = topology_.num_edges();
+    uint32_t max_degree = plan_.max_degree_for_edge_tables();
+    table_begin_.allocateBlocked(num_edges + 1);
+    table_begin_[0] = 0;
+    katana::do_all(
+        katana::iterate(uint64_t{0}, num_edges),
+        [&](uint64_t e) {
+          uint64_t degree = topology_.edges(dests_[e]).size();
+          table_begin_[e + 1] = degree <= max_degree ? degree : 0;
+        },
+        katana::no_stats(), katana::loopname("BuildEdgeTables"));
+    katana::ParallelSTL::partial_sum(
+        table_begin_.begin(), table_begin_.end(), table_begin_.begin());
+
+    uint64_t size = table_begin_[num_edges];
+    edge_prob_.allocateBlocked(size);
+    edge_alias_.allocateBlocked(size);
+    katana::do_all(
+        katana::iterate(uint64_t{0}, topology_.num_nodes()),
+        [&](uint64_t prev) {
+          thread_local AliasTableBuilder builder;
+          thread_local std::vector<double> biased;
+          for (auto e : topology_.edges(prev)) {
+            uint64_t table = table_begin_[e];
+            if (table == table_begin_[e + 1]) {
+              continue;
+            }
+            auto [begin, end] = topology_.edge_range(dests_[e]);
+            biased.resize(end - begin);
+            for (auto f = begin; f != end; ++f) {
+              biased[f - begin] = weights[f] * Bias(prev, dests_[f]);
+            }
+            builder.Build(
+                biased.data(), end - begin, edge_prob_.data() + table,
+                edge_alias_.data() + table);
+          }
+        },
+        katana::steal(), katana::no_stats(),
+        katana::loopname("BuildEdgeTables"));
+  }
+
+  void SetTypes(const uint32_t* types, uint32_t num_types) {
+    types_ = types;
+    num_types_ = num_types;
+    matrix_.assign(num_types * num_types, 1);
+  }
+
+  /// Set the transition matrix of kEdge2vec to the sigmoid of the Pearson
+  /// correlation between the number of edges of each type in the walks
+  void UpdateMatrix(
+      const katana::LargeArray<uint32_t>& walk_types,
+      const katana::LargeArray<uint32_t>& lengths, uint64_t num_walks) {
+    uint32_t k = num_types_;
+    uint32_t stride = plan_.walk_length();
+    katana::PerThreadStorage<std::vector<double>> sums;
+    katana::on_each(
+        [&](unsigned, unsigned) { sums.getLocal()->assign(k + k * k, 0); });
+    katana::do_all(
+        katana::iterate(uint64_t{0}, num_walks),
+        [&](uint64_t w) {
+          thread_local std::vector<uint32_t> counts;
+          counts.assign(k, 0);
+          for (uint32_t s = 0; s + 1 < lengths[w]; ++s) {
+            counts[walk_types[w * stride + s]]++;
+          }
+          std::vector<double>& local = *sums.getLocal();
+          for (uint32_t a = 0; a < k; ++a) {
+            local[a] += counts[a];
+            for (uint32_t b = 0; b < k; ++b) {
+              local[k + a * k + b] +=
+                  static_cast<double>(counts[a]) * counts[b];
+            }
+          }
+        },
+        katana::steal(), katana::no_stats(), katana::loopname("CountTypes"));
+
+    std::vector<double> total(k + k * k, 0);
+    for (unsigned i = 0; i < sums.size(); ++i) {
+      const std::vector<double>& local = *sums.getRemote(i);
+      for (size_t j = 0; j < local.size(); ++j) {
+        total[j] += local[j];
+      }
+    }
+
+    auto mean = [&](uint32_t a) { return total[a] / num_walks; };
+    auto covariance = [&](uint32_t a, uint32_t b) {
+      return total[k + a * k + b] / num_walks - mean(a) * mean(b);
+    };
+    max_bias_ = 0;
+    for (uint32_t a = 0; a < k; ++a) {
+      for (uint32_t b = 0; b < k; ++b) {
+        double deviations = std::sqrt(covariance(a, a) * covariance(b, b));
+        double correlation =
+            deviations > 0 ? covariance(a, b) / deviations : 0;
+        matrix_[a * k + b] = 1 / (1 + std::exp(-correlation));
+        max_bias_ = std::max(max_bias_, matrix_[a * k + b]);
+      }
+    }
+    max_bias_ *= std::max({1.0, backward_weight_, forward_weight_});
+  }
+
+  /// The edge out of curr that a walk which reached curr by prev_edge from
+  /// prev takes next
+  template <typename RNG>
+  uint64_t Step(GNode prev, uint64_t prev_edge, GNode curr, RNG* rng) const {
+    auto [begin, end] = topology_.edge_range(curr);
+    uint32_t degree = end - begin;
+    if (table_begin_.size() > 0) {
+      uint64_t table = table_begin_[prev_edge];
+      if (table != table_begin_[prev_edge + 1]) {
+        return begin +
+               SampleAlias(
+                   edge_prob_.data() + table, edge_alias_.data() + table,
+                   degree, rng);
+      }
+    }
+
+    std::uniform_real_distribution<double> coin(0, max_bias_);
+    while (true) {
+      uint64_t e =
+          begin + SampleAlias(
+                      node_prob_.data() + begin, node_alias_.data() + begin,
+                      degree, rng);
+      double bias = Bias(prev, dests_[e]);
+      if (types_) {
+        bias *= matrix_[types_[prev_edge] * num_types_ + types_[e]];
+      }
+      if (coin(*rng) <= bias) {
+        return e;
+      }
+    }
+  }
+
+  /// Write walk w to nodes and, for kEdge2vec, the types of its edges to
+  /// edge_types. Returns the number of nodes in the walk.
+  uint32_t Walk(uint64_t w, uint32_t* nodes, uint32_t* edge_types) {
+    std::mt19937_64* rng = rngs_.getLocal();
+    GNode curr = w % topology_.num_nodes();
+    nodes[0] = curr;
+
+    GNode prev = curr;
+    uint64_t edge = 0;
+    uint32_t length = 1;
+    for (uint32_t step = 0; step < plan_.walk_length(); ++step) {
+      auto [begin, end] = topology_.edge_range(curr);
+      if (begin == end) {
+        break;
+      }
+      if (step == 0) {
+        edge = begin + SampleAlias(
+                           node_prob_.data() + begin,
+                           node_alias_.data() + begin, end - begin, rng);
+      } else {
+        edge = Step(prev, edge, curr, rng);
+      }
+      prev = curr;
+      curr = dests_[edge];
+      nodes[length++] = curr;
+      if (edge_types) {
+        edge_types[step] = types_[edge];
+      }
+    }
+    return length;
+  }
+};
+
+katana::Result<std::shared_ptr<arrow::LargeListArray>>
+MakeWalkArray(
+    const katana::LargeArray<uint32_t>& nodes,
+    const katana::LargeArray<uint32_t>& lengths, uint64_t num_walks,
+    uint32_t stride) {
+  auto offsets_result = arrow::AllocateBuffer(
+      (num_walks + 1) * sizeof(int64_t), arrow::default_memory_pool());
+  if (!offsets_result.ok()) {
+    KATANA_LOG_DEBUG("arrow error: {}", offsets_result.status());
+    return katana::ErrorCode::ArrowError;
+  }
+  std::shared_ptr<arrow::Buffer> offsets_buffer =
+      std::move(offsets_result.ValueOrDie());
+  auto* offsets = reinterpret_cast<int64_t*>(offsets_buffer->mutable_data());
+  offsets[0] = 0;
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_walks),
+      [&](uint64_t w) { offsets[w + 1] = lengths[w]; }, katana::no_stats(),
+      katana::loopname("WalkOffsets"));
+  katana::ParallelSTL::partial_sum(
+      offsets, offsets + num_walks + 1, offsets);
+
+  uint64_t num_values = offsets[num_walks];
+  auto values_result = arrow::AllocateBuffer(
+      num_values * sizeof(uint32_t), arrow::default_memory_pool());
+  if (!values_result.ok()) {
+    KATANA_LOG_DEBUG("arrow error: {}", values_result.status());
+    return katana::ErrorCode::ArrowError;
+  }
+  std::shared_ptr<arrow::Buffer> values_buffer =
+      std::move(values_result.ValueOrDie());
+  auto* values = reinterpret_cast<uint32_t*>(values_buffer->mutable_data());
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_walks),
+      [&](uint64_t w) {
+        std::copy(
+            nodes.begin() + w * stride, nodes.begin() + w * stride + lengths[w],
+            values + offsets[w]);
+      },
+      katana::no_stats(), katana::loopname("CopyWalks"));
+
+  return std::make_shared<arrow::LargeListArray>(
+      arrow::large_list(arrow::uint32()), num_walks, std::move(offsets_buffer),
+      std::make_shared<arrow::UInt32Array>(
+          num_values, std::move(values_buffer)));
+}
+
+}  // namespace
+
+katana::Result<std::shared_ptr<arrow::LargeListArray>>
+katana::analytics::RandomWalks(
+    PropertyFileGraph* pfg, const std::string& edge_weight_property_name,
+    const std::string& edge_type_property_name, RandomWalksPlan plan) {
+  if (!(plan.backward_probability() > 0) ||
+      !(plan.forward_probability() > 0)) {
+    KATANA_LOG_DEBUG(
+        "backward ({}) and forward ({}) probabilities must be positive",
+        plan.backward_probability(), plan.forward_probability());
+    return katana::ErrorCode::InvalidArgument;
+  }
+
+  std::shared_ptr<arrow::UInt32Array> types;
+  if (plan.algorithm() == RandomWalksPlan::kEdge2vec) {
+    auto types_result =
+        pfg->EdgePropertyTyped<uint32_t>(edge_type_property_name);
+    if (!types_result) {
+      return types_result.error();
+    }
+    types = types_result.value();
+    katana::GAccumulator<uint64_t> out_of_range;
+    katana::do_all(
+        katana::iterate(uint64_t{0}, pfg->num_edges()),
+        [&](uint64_t e) {
+          if (types->Value(e) > plan.number_of_edge_types()) {
+            out_of_range += 1;
+          }
+        },
+        katana::no_stats(), katana::loopname("CheckEdgeTypes"));
+    if (out_of_range.reduce() > 0) {
+      KATANA_LOG_DEBUG(
+          "{} edge types are larger than {}", out_of_range.reduce(),
+          plan.number_of_edge_types());
+      return katana::ErrorCode::InvalidArgument;
+    }
+  }
+
+  auto sorted_result =
+      pfg->GetDerivedTopology(katana::DerivedTopology::kEdgesSorted);
+  if (!sorted_result) {
+    return sorted_result.error();
+  }
+  std::shared_ptr<const katana::DerivedTopology> sorted =
+      std::move(sorted_result.value());
+
+  uint64_t num_walks = pfg->num_nodes() * plan.number_of_walks();
+  uint32_t stride = plan.walk_length() + 1;
+
+  katana::StatTimer exec_time("RandomWalks");
+  exec_time.start();
+
+  Walker walker(pfg->topology(), sorted->topology, plan);
+  {
+    katana::LargeArray<double> weights;
+    if (auto r = katana::analytics::ReadEdgeWeights(
+            *pfg, edge_weight_property_name, &weights);
+        !r) {
+      return r.error();
+    }
+    if (auto r = CheckEdgeWeights(weights); !r) {
+      return r.error();
+    }
+    walker.BuildNodeTables(weights);
+    if (plan.algorithm() == RandomWalksPlan::kNode2vec &&
+        plan.max_degree_for_edge_tables() > 0) {
+      walker.BuildEdgeTables(weights);
+    }
+  }
+
+  katana::LargeArray<uint32_t> nodes;
+  katana::LargeArray<uint32_t> lengths;
+  katana::LargeArray<uint32_t> walk_types;
+  nodes.allocateBlocked(num_walks * stride);
+  lengths.allocateBlocked(num_walks);
+
+  uint32_t rounds = 1;
+  if (types) {
+    walker.SetTypes(types->raw_values(), plan.number_of_edge_types() + 1);
+    walk_types.allocateBlocked(num_walks * plan.walk_length());
+    rounds += plan.max_iterations();
+  }
+
+  for (uint32_t round = 0; round < rounds; ++round) {
+    katana::do_all(
+        katana::iterate(uint64_t{0}, num_walks),
+        [&](uint64_t w) {
+          lengths[w] = walker.Walk(
+              w, nodes.data() + w * stride,
+              types ? walk_types.data() + w * plan.walk_length() : nullptr);
+        },
+        katana::steal(), katana::chunk_size<64>(),
+        katana::loopname("RandomWalks"));
+    if (round + 1 < rounds) {
+      walker.UpdateMatrix(walk_types, lengths, num_walks);
+    }
+  }
+
+  exec_time.stop();
+
+  return MakeWalkArray(nodes, lengths, num_walks, stride);
+}
+
+katana::Result<void>
+katana::analytics::RandomWalksAssertValid(
+    PropertyFileGraph* pfg,
+    const std::shared_ptr<arrow::LargeListArray>& walks) {
+  auto values =
+      std::dynamic_pointer_cast<arrow::UInt32Array>(walks->values());
+  if (!values) {
+    return katana::ErrorCode::TypeError;
+  }
+
+  auto sorted_result =
+      pfg->GetDerivedTopology(katana::DerivedTopology::kEdgesSorted);
+  if (!sorted_result) {
+    return sorted_result.error();
+  }
+  const katana::GraphTopology& sorted = sorted_result.value()->topology;
+  const uint32_t* sorted_dests = sorted.out_dests->raw_values();
+  uint64_t num_nodes = pfg->num_nodes();
+
+  katana::GAccumulator<uint64_t> invalid;
+  katana::do_all(
+      katana::iterate(int64_t{0}, walks->length()),
+      [&](int64_t w) {
+        int64_t begin = walks->value_offset(w);
+        int64_t end = begin + walks->value_length(w);
+        for (int64_t i = begin; i < end; ++i) {
+          GNode n = values->Value(i);
+          if (n >= num_nodes) {
+            invalid += 1;
+            return;
+          }
+          if (i == begin) {
+            continue;
+          }
+          auto [edge_begin, edge_end] = sorted.edge_range(values->Value(i - 1));
+          if (!std::binary_search(
+                  sorted_dests + edge_begin, sorted_dests + edge_end, n)) {
+            invalid += 1;
+            return;
+          }
+        }
+      },
+      katana::no_stats(), katana::loopname("RandomWalksAssertValid"));
+
+  if (invalid.reduce() > 0) {
+    return katana::ErrorCode::AssertionFailed;
+  }
+  return katana::ResultSuccess();
+}
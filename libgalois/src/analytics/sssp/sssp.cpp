@@ -19,6 +19,8 @@
 
 #include "katana/analytics/sssp/sssp.h"
 
+#include "katana/analytics/Planner.h"
+
 // Implementation
 
 namespace katana::analytics {
@@ -287,6 +289,22 @@ struct SsspImplementation : public katana::analytics::BfsSsspImplementationBase<
     katana::ReportStatSingle("SSSP-Topo", "rounds", rounds);
   }
 
+  /// Weights of evenly spaced edges, enough to tell the scale of the weights
+  static WeightFeatures SampleWeights(const Graph& graph) {
+    constexpr uint64_t kNumSamples = 1024;
+
+    WeightFeatures weights;
+    uint64_t num_edges = graph.num_edges();
+    uint64_t num_samples = std::min(num_edges, kNumSamples);
+    for (uint64_t i = 0; i < num_samples; ++i) {
+      typename Graph::edge_iterator edge(i * num_edges / num_samples);
+      auto weight =
+          static_cast<double>(graph.template GetEdgeData<EdgeWeight>(edge));
+      weights.max = std::max(weights.max, weight);
+    }
+    return weights;
+  }
+
 public:
   katana::Result<void> SSSP(Graph& graph, size_t start_node, SsspPlan plan) {
     if (start_node >= graph.size()) {
@@ -311,7 +329,9 @@ public:
     execTime.start();
 
     if (plan.algorithm() == SsspPlan::kAutomatic) {
-      plan = SsspPlan(&graph.GetPropertyFileGraph());
+      plan = ChooseSsspPlan(
+          GraphFeatures::Compute(graph.GetPropertyFileGraph()),
+          SampleWeights(graph));
     }
 
     switch (plan.algorithm()) {
@@ -369,7 +389,9 @@ Sssp(
         std::tuple<SsspEdgeWeight<Weight>>>& pg,
     size_t start_node, SsspPlan plan) {
   static_assert(std::is_integral_v<Weight> || std::is_floating_point_v<Weight>);
-  katana::analytics::SsspImplementation<Weight> impl{{plan.edge_tile_size()}};
+  ptrdiff_t edge_tile_size = katana::ChooseEdgeTileSize(
+      plan.edge_tile_size(), pg.GetPropertyFileGraph().topology());
+  katana::analytics::SsspImplementation<Weight> impl{{edge_tile_size}};
   return impl.SSSP(pg, start_node, plan);
 }
 
@@ -19,15 +19,23 @@
 
 #include "katana/analytics/triangle_count/triangle_count.h"
 
+#include "katana/analytics/Intersection.h"
 #include "katana/analytics/Utils.h"
 
 using namespace katana::analytics;
 
 using PropertyFileGraph = katana::PropertyFileGraph;
 using Node = katana::PropertyFileGraph::Node;
+using GraphTopology = katana::GraphTopology;
 
 constexpr static const unsigned kChunkSize = 64U;
 
+struct NodeTriangleCount : public katana::PODProperty<uint64_t> {};
+struct NodeClusteringCoefficient : public katana::PODProperty<double> {};
+
+using LocalNodeData = std::tuple<NodeTriangleCount, NodeClusteringCoefficient>;
+using LocalGraph = katana::PropertyGraph<LocalNodeData, std::tuple<>>;
+
 /**
  * Like std::lower_bound but doesn't dereference iterators. Returns the first
  * element for which comp is not true.
@@ -57,31 +65,6 @@ LowerBound(Iterator first, Iterator last, Compare comp) {
   return first;
 }
 
-/**
- * std::set_intersection over edge_iterators.
- */
-template <typename G>
-size_t
-CountEqual(
-    const G& g, typename G::edge_iterator aa, typename G::edge_iterator ea,
-    typename G::edge_iterator bb, typename G::edge_iterator eb) {
-  size_t retval = 0;
-  while (aa != ea && bb != eb) {
-    typename G::Node a = *g.GetEdgeDest(aa);
-    typename G::Node b = *g.GetEdgeDest(bb);
-    if (a < b) {
-      ++aa;
-    } else if (b < a) {
-      ++bb;
-    } else {
-      retval += 1;
-      ++aa;
-      ++bb;
-    }
-  }
-  return retval;
-}
-
 template <typename G>
 struct LessThan {
   const G& g;
@@ -170,32 +153,47 @@ NodeIteratingAlgo(katana::PropertyFileGraph* graph) {
 
 /**
  * Lambda function to count triangles
+ *
+ * For each neighbor v < n, counts the common neighbors of n and v that are
+ * smaller than v. The neighborhood of a hub n is loaded into a bitmap once
+ * instead of being merged with the neighborhood of every v.
  */
 void
 OrderedCountFunc(
     PropertyFileGraph* graph, Node n,
-    katana::GAccumulator<size_t>& numTriangles) {
+    katana::GAccumulator<size_t>& numTriangles,
+    katana::PerThreadStorage<IntersectionBitmap>& bitmaps) {
+  const GraphTopology& topology = graph->topology();
+  const uint32_t* dests = topology.out_dests->raw_values();
+
+  // Neighbors of n no greater than n
+  auto [n_begin, n_end] = topology.edge_range(n);
+  const uint32_t* n_first = dests + n_begin;
+  const uint32_t* n_last = std::upper_bound(n_first, dests + n_end, n);
+
+  IntersectionBitmap* bitmap = nullptr;
+  if (static_cast<size_t>(n_last - n_first) >= kIntersectionHubDegree) {
+    bitmap = bitmaps.getLocal();
+    bitmap->Set(n_first, n_last - n_first);
+  }
+
   size_t numTriangles_local = 0;
-  for (auto it_v : graph->edges(n)) {
-    auto v = *graph->GetEdgeDest(it_v);
-    if (v > n) {
-      break;
-    }
-    PropertyFileGraph::edge_iterator it_n = graph->edges(n).begin();
-
-    for (auto it_vv : graph->edges(v)) {
-      auto vv = *graph->GetEdgeDest(it_vv);
-      if (vv > v) {
-        break;
-      }
-      while (*graph->GetEdgeDest(it_n) < vv) {
-        it_n++;
-      }
-      if (vv == *graph->GetEdgeDest(it_n)) {
-        numTriangles_local += 1;
-      }
+  for (const uint32_t* it_v = n_first; it_v != n_last; ++it_v) {
+    Node v = *it_v;
+    auto [v_begin, v_end] = topology.edge_range(v);
+    const uint32_t* v_first = dests + v_begin;
+    const uint32_t* v_last = std::upper_bound(v_first, dests + v_end, v);
+    if (bitmap != nullptr) {
+      numTriangles_local += bitmap->Count(v_first, v_last - v_first);
+    } else {
+      numTriangles_local += IntersectCount(
+          n_first, it_v + 1 - n_first, v_first, v_last - v_first);
     }
   }
+
+  if (bitmap != nullptr) {
+    bitmap->Clear(n_first, n_last - n_first);
+  }
   numTriangles += numTriangles_local;
 }
 
@@ -205,9 +203,12 @@ OrderedCountFunc(
 size_t
 OrderedCountAlgo(PropertyFileGraph* graph) {
   katana::GAccumulator<size_t> numTriangles;
+  katana::PerThreadStorage<IntersectionBitmap> bitmaps;
   katana::do_all(
       katana::iterate(*graph),
-      [&](const Node& n) { OrderedCountFunc(graph, n, numTriangles); },
+      [&](const Node& n) {
+        OrderedCountFunc(graph, n, numTriangles, bitmaps);
+      },
       katana::chunk_size<kChunkSize>(), katana::steal(),
       katana::loopname("TriangleCount_OrderedCountAlgo"));
 
@@ -237,6 +238,7 @@ EdgeIteratingAlgo(PropertyFileGraph* graph) {
 
   katana::InsertBag<WorkItem> items;
   katana::GAccumulator<size_t> numTriangles;
+  const uint32_t* dests = graph->topology().out_dests->raw_values();
 
   katana::do_all(
       katana::iterate(*graph),
@@ -269,7 +271,8 @@ EdgeIteratingAlgo(PropertyFileGraph* graph) {
         PropertyFileGraph::edge_iterator eb = LowerBound(
             bbegin, bend, LessThan<PropertyFileGraph>(*graph, w.dst));
 
-        numTriangles += CountEqual(*graph, aa, ea, bb, eb);
+        numTriangles +=
+            IntersectCount(dests + *aa, ea - aa, dests + *bb, eb - bb);
       },
       katana::loopname("TriangleCount_EdgeIteratingAlgo"),
       katana::chunk_size<kChunkSize>(), katana::steal());
@@ -277,6 +280,82 @@ EdgeIteratingAlgo(PropertyFileGraph* graph) {
   return numTriangles.reduce();
 }
 
+/**
+ * Per-node triangle counts.
+ *
+ * Every edge (n, v) with v < n is intersected once, over the full
+ * neighborhoods of n and v, and the number of triangles on it is stored in
+ * both directions of the edge. Each slot is written by exactly one thread,
+ * so no atomics are needed. The triangles of a node are then half the sum
+ * over its edges, which the node accumulates itself.
+ */
+void
+LocalCountAlgo(PropertyFileGraph* sorted, LocalGraph* graph) {
+  const GraphTopology& topology = sorted->topology();
+  const uint32_t* dests = topology.out_dests->raw_values();
+
+  katana::LargeArray<uint32_t> edge_triangles;
+  edge_triangles.allocateBlocked(topology.num_edges());
+  katana::PerThreadStorage<IntersectionBitmap> bitmaps;
+
+  katana::do_all(
+      katana::iterate(*sorted),
+      [&](const Node& n) {
+        auto [n_begin, n_end] = topology.edge_range(n);
+        const uint32_t* n_first = dests + n_begin;
+        const uint32_t* n_last = dests + n_end;
+        const uint32_t* n_lower = std::lower_bound(n_first, n_last, n);
+
+        IntersectionBitmap* bitmap = nullptr;
+        if (static_cast<size_t>(n_last - n_first) >= kIntersectionHubDegree) {
+          bitmap = bitmaps.getLocal();
+          bitmap->Set(n_first, n_last - n_first);
+        }
+
+        for (const uint32_t* it_v = n_first; it_v != n_lower; ++it_v) {
+          Node v = *it_v;
+          auto [v_begin, v_end] = topology.edge_range(v);
+          const uint32_t* v_first = dests + v_begin;
+          const uint32_t* v_last = dests + v_end;
+          uint32_t count =
+              bitmap != nullptr
+                  ? bitmap->Count(v_first, v_last - v_first)
+                  : IntersectCount(
+                        n_first, n_last - n_first, v_first, v_last - v_first);
+
+          edge_triangles[it_v - dests] = count;
+          const uint32_t* reverse = std::lower_bound(v_first, v_last, n);
+          KATANA_LOG_DEBUG_ASSERT(reverse != v_last && *reverse == n);
+          edge_triangles[reverse - dests] = count;
+        }
+
+        if (bitmap != nullptr) {
+          bitmap->Clear(n_first, n_last - n_first);
+        }
+      },
+      katana::chunk_size<kChunkSize>(), katana::steal(),
+      katana::loopname("TriangleCount_LocalCountAlgo"));
+
+  katana::do_all(
+      katana::iterate(*sorted),
+      [&](const Node& n) {
+        auto [n_begin, n_end] = topology.edge_range(n);
+        uint64_t sum = 0;
+        for (auto e = n_begin; e != n_end; ++e) {
+          sum += edge_triangles[e];
+        }
+        uint64_t triangles = sum / 2;
+        uint64_t degree = n_end - n_begin;
+
+        graph->GetData<NodeTriangleCount>(n) = triangles;
+        graph->GetData<NodeClusteringCoefficient>(n) =
+            degree < 2 ? 0.0
+                       : 2.0 * static_cast<double>(triangles) /
+                             static_cast<double>(degree * (degree - 1));
+      },
+      katana::loopname("TriangleCount_LocalCoefficient"));
+}
+
 katana::Result<uint64_t>
 katana::analytics::TriangleCount(
     katana::PropertyFileGraph* pfg, TriangleCountPlan plan) {
@@ -301,31 +380,22 @@ katana::analytics::TriangleCount(
     return katana::ErrorCode::AssertionFailed;
   }
 
-  std::unique_ptr<katana::PropertyFileGraph> mutable_pfg;
+  // Run on a cached derived topology rather than the users graph so that
+  // the graph is not mutated and repeated calls do not sort again. If we
+  // relabel we must also sort. Relabeling will break the sorting.
+  katana::PropertyFileGraph derived_view;
   if (relabel || !plan.edges_sorted()) {
-    // Copy the graph so we don't mutate the users graph.
-    auto mutable_pfg_result = pfg->Copy({}, {});
-    if (!mutable_pfg_result) {
-      return mutable_pfg_result.error();
+    auto derived_result = pfg->GetDerivedTopology(
+        relabel ? katana::DerivedTopology::kDegreeRelabeled
+                : katana::DerivedTopology::kEdgesSorted);
+    if (!derived_result) {
+      return derived_result.error();
     }
-    mutable_pfg = std::move(mutable_pfg_result.value());
-    pfg = mutable_pfg.get();
-  }
-
-  if (relabel) {
-    katana::StatTimer timer_relabel("GraphRelabelTimer", "TriangleCount");
-    timer_relabel.start();
-    if (auto r = katana::SortNodesByDegree(pfg); !r) {
-      return r.error();
-    }
-    timer_relabel.stop();
-  }
-
-  // If we relabel we must also sort. Relabeling will break the sorting.
-  if (relabel || !plan.edges_sorted()) {
-    if (auto r = katana::SortAllEdgesByDest(pfg); !r) {
+    if (auto r = derived_view.SetTopology(derived_result.value()->topology);
+        !r) {
       return r.error();
     }
+    pfg = &derived_view;
   }
 
   timer_graph_read.stop();
@@ -355,3 +425,49 @@ katana::analytics::TriangleCount(
 
   return total_count;
 }
+
+katana::Result<void>
+katana::analytics::LocalTriangleCount(
+    katana::PropertyFileGraph* pfg,
+    const std::string& triangle_count_property_name,
+    const std::string& clustering_coefficient_property_name,
+    TriangleCountPlan plan) {
+  // Node ids are kept, so that the results line up with the nodes of pfg,
+  // but the edges still have to be sorted.
+  katana::PropertyFileGraph derived_view;
+  katana::PropertyFileGraph* sorted = pfg;
+  if (!plan.edges_sorted()) {
+    auto derived_result =
+        pfg->GetDerivedTopology(katana::DerivedTopology::kEdgesSorted);
+    if (!derived_result) {
+      return derived_result.error();
+    }
+    if (auto r = derived_view.SetTopology(derived_result.value()->topology);
+        !r) {
+      return r.error();
+    }
+    sorted = &derived_view;
+  }
+
+  if (auto r = ConstructNodeProperties<LocalNodeData>(
+          pfg, {triangle_count_property_name,
+                clustering_coefficient_property_name});
+      !r) {
+    return r.error();
+  }
+  auto pg_result = LocalGraph::Make(
+      pfg,
+      {triangle_count_property_name, clustering_coefficient_property_name},
+      {});
+  if (!pg_result) {
+    return pg_result.error();
+  }
+  auto graph = pg_result.value();
+
+  katana::StatTimer execTime("LocalTriangleCount", "TriangleCount");
+  execTime.start();
+  LocalCountAlgo(sorted, &graph);
+  execTime.stop();
+
+  return katana::ResultSuccess();
+}
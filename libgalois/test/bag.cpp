@@ -0,0 +1,89 @@
+#include <algorithm>
+#include <iostream>
+#include <vector>
+
+#include "katana/Bag.h"
+#include "katana/Galois.h"
+#include "katana/Logging.h"
+#include "katana/PagePool.h"
+#include "katana/SharedMemSys.h"
+
+namespace {
+
+template <typename Bag>
+void
+Fill(Bag* bag, uint64_t round, uint64_t size) {
+  katana::do_all(katana::iterate(uint64_t{0}, size), [&](uint64_t i) {
+    bag->push(round * size + i);
+  });
+}
+
+template <typename Bag>
+void
+Check(const Bag& bag, uint64_t round, uint64_t size) {
+  std::vector<uint64_t> values(bag.begin(), bag.end());
+  std::sort(values.begin(), values.end());
+  KATANA_LOG_ASSERT(values.size() == size);
+  for (uint64_t i = 0; i < size; ++i) {
+    KATANA_LOG_ASSERT(values[i] == round * size + i);
+  }
+}
+
+template <unsigned BlockSize>
+void
+TestRecycling(uint64_t size) {
+  katana::InsertBag<uint64_t, BlockSize> curr;
+  katana::InsertBag<uint64_t, BlockSize> next;
+  curr.set_block_recycling();
+  next.set_block_recycling();
+  next.reserve(size);
+  KATANA_LOG_ASSERT(next.free_blocks() > 0);
+
+  // Rounds of the same size reuse the blocks of earlier rounds. The second
+  // round is the first to fill the other bag; after it no blocks are
+  // allocated, so the free blocks of both bags and the pages taken by the
+  // page pool stay the same.
+  size_t first_free = 0;
+  int first_pages = 0;
+  for (uint64_t round = 0; round < 10; ++round) {
+    Fill(&next, round, size);
+    curr.swap(next);
+    next.clear();
+    Check(curr, round, size);
+
+    size_t free = curr.free_blocks() + next.free_blocks();
+    int pages = katana::numPagePoolAllocTotal();
+    if (round == 1) {
+      first_free = free;
+      first_pages = pages;
+    } else if (round > 1) {
+      KATANA_LOG_ASSERT(free == first_free);
+      KATANA_LOG_ASSERT(pages == first_pages);
+    }
+  }
+  KATANA_LOG_ASSERT(first_free > 0);
+  KATANA_LOG_ASSERT(curr.peak_blocks() > 0);
+
+  // A bounded bag keeps at most the bound per thread
+  next.set_block_recycling(1);
+  KATANA_LOG_ASSERT(next.free_blocks() <= katana::getActiveThreads());
+  next.set_block_recycling(0);
+  KATANA_LOG_ASSERT(next.free_blocks() == 0);
+  Fill(&next, 0, size);
+  Check(next, 0, size);
+}
+
+}  // namespace
+
+int
+main() {
+  katana::SharedMemSys sys;
+  katana::setActiveThreads(4);
+
+  TestRecycling<0>(1000000);
+  TestRecycling<256>(100000);
+  TestRecycling<4096>(5000);
+
+  std::cout << "ok\n";
+  return 0;
+}
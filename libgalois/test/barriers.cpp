@@ -24,6 +24,7 @@
 
 #include "katana/Barrier.h"
 #include "katana/Galois.h"
+#include "katana/Logging.h"
 #include "katana/Timer.h"
 
 unsigned iter = 0;
@@ -51,6 +52,21 @@ struct emp {
   }
 };
 
+// Each thread passes its id plus one, so every sum must be M * (M + 1) / 2
+void
+testSum(katana::Barrier& b, unsigned M) {
+  uint64_t expected = uint64_t{M} * (M + 1) / 2;
+  katana::on_each([&](unsigned tid, unsigned) {
+    for (unsigned i = 0; i < iter / 16 + 1; ++i) {
+      uint64_t sum = b.WaitAndSum(tid + 1);
+      KATANA_LOG_VASSERT(
+          sum == expected, "{} summed to {} instead of {}", b.name(), sum,
+          expected);
+      KATANA_LOG_ASSERT(b.WaitAndAny(tid == i % M) && !b.WaitAndAny(false));
+    }
+  });
+}
+
 void
 test(std::unique_ptr<katana::Barrier> b) {
   if (b == nullptr) {
@@ -69,6 +85,7 @@ test(std::unique_ptr<katana::Barrier> b) {
     emp e{*b.get()};
     katana::on_each(e);
     t.stop();
+    testSum(*b, M);
     std::cout << bname << "," << b->name() << "," << M << "," << t.get()
               << "\n";
     M -= 1;
@@ -93,5 +110,6 @@ main(int argc, char** argv) {
   test(CreateMCSBarrier(1));
   test(CreateTopoBarrier(1));
   test(CreateDisseminationBarrier(1));
+  test(CreateHierarchicalBarrier(1));
   return 0;
 }
@@ -0,0 +1,190 @@
+#include <algorithm>
+#include <iostream>
+#include <iterator>
+#include <random>
+#include <set>
+#include <vector>
+
+#include "katana/DynamicBitset.h"
+#include "katana/Galois.h"
+#include "katana/Logging.h"
+#include "katana/RoaringBitset.h"
+#include "katana/SharedMemSys.h"
+
+namespace {
+
+std::set<uint64_t>
+RandomSet(std::mt19937* gen, size_t size, uint64_t range) {
+  std::uniform_int_distribution<uint64_t> dist(0, range - 1);
+  std::set<uint64_t> set;
+  while (set.size() < std::min<size_t>(size, range)) {
+    set.insert(dist(*gen));
+  }
+  return set;
+}
+
+katana::DynamicBitset
+MakeBitset(const std::set<uint64_t>& set, size_t size) {
+  katana::DynamicBitset bitset;
+  bitset.resize(size);
+  for (uint64_t i : set) {
+    bitset.set(i);
+  }
+  return bitset;
+}
+
+katana::RoaringBitset
+MakeRoaring(const std::set<uint64_t>& set) {
+  std::vector<uint64_t> offsets(set.begin(), set.end());
+  return katana::RoaringBitset::FromSortedOffsets(
+      offsets.data(), offsets.size());
+}
+
+void
+CheckOffsets(
+    const katana::DynamicBitset& bitset, const std::set<uint64_t>& expected) {
+  std::vector<uint64_t> want(expected.begin(), expected.end());
+  KATANA_LOG_ASSERT(bitset.count() == want.size());
+  KATANA_LOG_ASSERT(bitset.getOffsets<uint64_t>() == want);
+
+  std::vector<uint32_t> want32(want.begin(), want.end());
+  KATANA_LOG_ASSERT(bitset.getOffsets<uint32_t>() == want32);
+
+  katana::GAccumulator<uint64_t> sum;
+  bitset.for_each_set_bit([&](uint64_t i) { sum += i; });
+  uint64_t want_sum = 0;
+  for (uint64_t i : want) {
+    want_sum += i;
+  }
+  KATANA_LOG_ASSERT(sum.reduce() == want_sum);
+}
+
+void
+CheckOffsets(
+    const katana::RoaringBitset& bitset, const std::set<uint64_t>& expected) {
+  std::vector<uint64_t> want(expected.begin(), expected.end());
+  KATANA_LOG_ASSERT(bitset.count() == want.size());
+  KATANA_LOG_ASSERT(bitset.getOffsets<uint64_t>() == want);
+  for (uint64_t i : want) {
+    KATANA_LOG_ASSERT(bitset.test(i));
+  }
+}
+
+std::set<uint64_t>
+Union(const std::set<uint64_t>& a, const std::set<uint64_t>& b) {
+  std::set<uint64_t> result(a);
+  result.insert(b.begin(), b.end());
+  return result;
+}
+
+std::set<uint64_t>
+Intersection(const std::set<uint64_t>& a, const std::set<uint64_t>& b) {
+  std::set<uint64_t> result;
+  std::copy_if(
+      a.begin(), a.end(), std::inserter(result, result.end()),
+      [&](uint64_t i) { return b.count(i) != 0; });
+  return result;
+}
+
+std::set<uint64_t>
+Difference(const std::set<uint64_t>& a, const std::set<uint64_t>& b) {
+  std::set<uint64_t> result;
+  std::copy_if(
+      a.begin(), a.end(), std::inserter(result, result.end()),
+      [&](uint64_t i) { return b.count(i) == 0; });
+  return result;
+}
+
+void
+TestDynamicBitset(std::mt19937* gen, size_t size, size_t count) {
+  auto a = RandomSet(gen, count, size);
+  auto b = RandomSet(gen, count, size);
+
+  CheckOffsets(MakeBitset(a, size), a);
+
+  auto x = MakeBitset(a, size);
+  x.bitwise_or(MakeBitset(b, size));
+  CheckOffsets(x, Union(a, b));
+
+  x.bitwise_and(MakeBitset(a, size), MakeBitset(b, size));
+  CheckOffsets(x, Intersection(a, b));
+
+  x = MakeBitset(a, size);
+  x.bitwise_andnot(MakeBitset(b, size));
+  CheckOffsets(x, Difference(a, b));
+
+  x.bitwise_xor(MakeBitset(a, size), MakeBitset(b, size));
+  CheckOffsets(x, Union(Difference(a, b), Difference(b, a)));
+
+  std::set<uint64_t> all;
+  for (uint64_t i = 0; i < size; ++i) {
+    all.insert(i);
+  }
+  x = MakeBitset(a, size);
+  x.bitwise_not();
+  CheckOffsets(x, Difference(all, a));
+}
+
+void
+TestRoaringBitset(std::mt19937* gen, uint64_t range, size_t count) {
+  auto a = RandomSet(gen, count, range);
+  auto b = RandomSet(gen, count / 4, range);
+
+  CheckOffsets(MakeRoaring(a), a);
+
+  auto x = MakeRoaring(a);
+  x.bitwise_or(MakeRoaring(b));
+  CheckOffsets(x, Union(a, b));
+
+  x = MakeRoaring(a);
+  x.bitwise_and(MakeRoaring(b));
+  CheckOffsets(x, Intersection(a, b));
+
+  x = MakeRoaring(a);
+  x.bitwise_andnot(MakeRoaring(b));
+  CheckOffsets(x, Difference(a, b));
+
+  x = MakeRoaring(b);
+  x.bitwise_andnot(MakeRoaring(a));
+  CheckOffsets(x, Difference(b, a));
+
+  katana::RoaringBitset y;
+  for (uint64_t i : a) {
+    KATANA_LOG_ASSERT(!y.set(i));
+  }
+  for (uint64_t i : b) {
+    y.reset(i);
+  }
+  CheckOffsets(y, Difference(a, b));
+
+  if (range <= (uint64_t{1} << 24)) {
+    auto bitset = MakeBitset(a, range);
+    CheckOffsets(katana::RoaringBitset::FromBitset(bitset), a);
+
+    katana::DynamicBitset round_trip;
+    round_trip.resize(range);
+    MakeRoaring(a).ToBitset(&round_trip);
+    CheckOffsets(round_trip, a);
+  }
+}
+
+}  // namespace
+
+int
+main() {
+  katana::SharedMemSys sys;
+  katana::setActiveThreads(4);
+
+  std::mt19937 gen(0);
+  for (size_t size : {0, 1, 63, 64, 65, 1000, 100000}) {
+    TestDynamicBitset(&gen, size, size / 3);
+  }
+
+  // Sparse containers stay arrays and dense ones become bitmaps
+  TestRoaringBitset(&gen, 1 << 20, 1000);
+  TestRoaringBitset(&gen, 1 << 20, 200000);
+  TestRoaringBitset(&gen, uint64_t{1} << 40, 10000);
+
+  std::cout << "ok\n";
+  return 0;
+}
@@ -0,0 +1,179 @@
+#include <cmath>
+#include <iostream>
+
+#include <boost/filesystem.hpp>
+
+#include "TestPropertyGraph.h"
+#include "katana/GraphStats.h"
+#include "katana/HyperLogLog.h"
+#include "katana/Logging.h"
+#include "katana/SharedMemSys.h"
+#include "katana/Uri.h"
+
+namespace fs = boost::filesystem;
+
+namespace {
+
+void
+TestHyperLogLog() {
+  constexpr uint64_t kNumValues = 200000;
+
+  katana::HyperLogLog all;
+  katana::HyperLogLog even;
+  katana::HyperLogLog odd;
+  for (uint64_t i = 0; i < kNumValues; ++i) {
+    uint64_t hash = katana::HyperLogLog::HashValue(i);
+    all.Add(hash);
+    // Duplicates do not change the estimate
+    all.Add(hash);
+    (i % 2 == 0 ? even : odd).Add(hash);
+  }
+  even.Merge(odd);
+
+  double error = std::abs(static_cast<double>(all.Estimate()) - kNumValues);
+  KATANA_LOG_VASSERT(
+      error / kNumValues < 0.05, "estimate {} of {} distinct values",
+      all.Estimate(), kNumValues);
+  KATANA_LOG_ASSERT(even.Estimate() == all.Estimate());
+
+  katana::HyperLogLog small;
+  for (uint64_t i = 0; i < 10; ++i) {
+    small.Add(katana::HyperLogLog::HashValue(i));
+  }
+  KATANA_LOG_VASSERT(small.Estimate() == 10, "estimate {}", small.Estimate());
+}
+
+void
+TestGraphStats() {
+  constexpr size_t kNumNodes = 1000;
+  constexpr size_t kWidth = 3;
+
+  LinePolicy policy{kWidth};
+  auto g = MakeFileGraph<int32_t>(kNumNodes, 1, &policy);
+
+  auto stats_result = katana::GraphStats::Compute(*g);
+  KATANA_LOG_ASSERT(stats_result);
+  katana::GraphStats stats = std::move(stats_result.value());
+
+  KATANA_LOG_ASSERT(stats.num_nodes == kNumNodes);
+  KATANA_LOG_ASSERT(stats.num_edges == kNumNodes * kWidth);
+  for (const auto* degree : {&stats.out_degree, &stats.in_degree}) {
+    KATANA_LOG_ASSERT(degree->max == kWidth);
+    KATANA_LOG_ASSERT(degree->mean == kWidth);
+    KATANA_LOG_ASSERT(degree->median == kWidth);
+    KATANA_LOG_ASSERT(degree->num_isolated == 0);
+    KATANA_LOG_VASSERT(std::abs(degree->gini) < 1e-9, "gini {}", degree->gini);
+    KATANA_LOG_ASSERT(!degree->IsPowerLaw());
+    // Degree 3 is in the bin [2, 4)
+    KATANA_LOG_ASSERT(degree->log2_histogram.size() == 3);
+    KATANA_LOG_ASSERT(degree->log2_histogram[2] == kNumNodes);
+  }
+
+  KATANA_LOG_ASSERT(stats.node_properties.size() == 1);
+  KATANA_LOG_ASSERT(stats.edge_properties.size() == 1);
+  const katana::PropertyStats& node_prop = stats.node_properties[0];
+  KATANA_LOG_ASSERT(node_prop.has_range);
+  KATANA_LOG_ASSERT(node_prop.min <= node_prop.max);
+  KATANA_LOG_ASSERT(node_prop.distinct_estimate <= kNumNodes * 1.05);
+
+  // Nothing cached yet
+  KATANA_LOG_ASSERT(!katana::GraphStats::Load(*g));
+
+  auto store_result = stats.Store(g.get());
+  KATANA_LOG_ASSERT(store_result);
+  auto load_result = katana::GraphStats::Load(*g);
+  KATANA_LOG_ASSERT(load_result);
+  const katana::GraphStats& loaded = load_result.value();
+  KATANA_LOG_ASSERT(loaded.num_edges == stats.num_edges);
+  KATANA_LOG_ASSERT(
+      loaded.out_degree.log2_histogram == stats.out_degree.log2_histogram);
+  KATANA_LOG_ASSERT(
+      loaded.node_properties[0].distinct_estimate ==
+      node_prop.distinct_estimate);
+
+  // The statistics of a removed property are dropped, the rest are kept
+  KATANA_LOG_ASSERT(g->RemoveNodeProperty(0));
+  auto stale_result = katana::GraphStats::Load(*g);
+  KATANA_LOG_ASSERT(stale_result);
+  KATANA_LOG_ASSERT(stale_result.value().node_properties.empty());
+  KATANA_LOG_ASSERT(stale_result.value().edge_properties.size() == 1);
+  KATANA_LOG_ASSERT(stale_result.value().out_degree.max == kWidth);
+
+  KATANA_LOG_ASSERT(!g->set_graph_stats("{not json"));
+  KATANA_LOG_ASSERT(g->graph_stats() == stats.ToJson().value());
+}
+
+void
+TestIsolatedNodes() {
+  // Half of the nodes have no out edges
+  constexpr size_t kNumNodes = 100;
+  constexpr size_t kWidth = 4;
+
+  LinePolicy policy{kWidth};
+  auto g = MakeFileGraph<int32_t>(kNumNodes, 1, &policy);
+  katana::GraphTopology topology;
+  auto indices = g->topology().out_indices;
+  arrow::UInt64Builder builder;
+  KATANA_LOG_ASSERT(builder.Reserve(kNumNodes).ok());
+  for (size_t n = 0; n < kNumNodes; ++n) {
+    builder.UnsafeAppend(indices->Value(n / 2 * 2 + 1));
+  }
+  KATANA_LOG_ASSERT(builder.Finish(&topology.out_indices).ok());
+  topology.out_dests = g->topology().out_dests;
+  KATANA_LOG_ASSERT(g->SetTopology(topology));
+
+  auto stats_result = katana::GraphStats::Compute(*g);
+  KATANA_LOG_ASSERT(stats_result);
+  const katana::DegreeStats& out_degree = stats_result.value().out_degree;
+  KATANA_LOG_ASSERT(out_degree.num_isolated == kNumNodes / 2);
+  // The mean, like the median, is over the nodes with edges
+  KATANA_LOG_ASSERT(out_degree.mean == 2 * kWidth);
+  KATANA_LOG_ASSERT(out_degree.median == 2 * kWidth);
+}
+
+void
+TestGraphStatsRoundTrip() {
+  constexpr size_t kNumNodes = 100;
+
+  LinePolicy policy{3};
+  auto g = MakeFileGraph<int32_t>(kNumNodes, 1, &policy);
+  auto stats_result = katana::GraphStats::Compute(*g);
+  KATANA_LOG_ASSERT(stats_result);
+  KATANA_LOG_ASSERT(stats_result.value().Store(g.get()));
+  g->MarkAllPropertiesPersistent();
+
+  auto uri_res = katana::Uri::MakeRand("/tmp/graphstats");
+  KATANA_LOG_ASSERT(uri_res);
+  std::string rdg_dir(uri_res.value().path());  // path() because local
+  if (auto res = g->Write(rdg_dir, "graph-stats"); !res) {
+    fs::remove_all(rdg_dir);
+    KATANA_LOG_FATAL("writing result: {}", res.error());
+  }
+  auto make_result = katana::PropertyFileGraph::Make(rdg_dir);
+  fs::remove_all(rdg_dir);
+  if (!make_result) {
+    KATANA_LOG_FATAL("making result: {}", make_result.error());
+  }
+
+  auto load_result = katana::GraphStats::Load(*make_result.value());
+  KATANA_LOG_ASSERT(load_result);
+  KATANA_LOG_ASSERT(
+      load_result.value().ToJson().value() ==
+      stats_result.value().ToJson().value());
+}
+
+}  // namespace
+
+int
+main() {
+  katana::SharedMemSys sys;
+  katana::setActiveThreads(4);
+
+  TestHyperLogLog();
+  TestGraphStats();
+  TestIsolatedNodes();
+  TestGraphStatsRoundTrip();
+
+  std::cout << "ok\n";
+  return 0;
+}
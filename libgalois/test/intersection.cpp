@@ -0,0 +1,80 @@
+#include "katana/analytics/Intersection.h"
+
+#include <algorithm>
+#include <iostream>
+#include <iterator>
+#include <random>
+#include <set>
+#include <vector>
+
+#include "katana/Logging.h"
+
+using katana::analytics::IntersectionKernel;
+
+namespace {
+
+std::vector<uint32_t>
+RandomSet(std::mt19937* gen, size_t size, uint32_t range) {
+  std::uniform_int_distribution<uint32_t> dist(0, range - 1);
+  std::set<uint32_t> set;
+  while (set.size() < std::min<size_t>(size, range)) {
+    set.insert(dist(*gen));
+  }
+  return std::vector<uint32_t>(set.begin(), set.end());
+}
+
+void
+CheckIntersection(
+    const std::vector<uint32_t>& a, const std::vector<uint32_t>& b) {
+  std::vector<uint32_t> expected;
+  std::set_intersection(
+      a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(expected));
+
+  for (auto kernel :
+       {IntersectionKernel::kScalar, IntersectionKernel::kSSE,
+        IntersectionKernel::kAVX2, IntersectionKernel::kAVX512}) {
+    if (kernel > katana::analytics::BestIntersectionKernel()) {
+      continue;
+    }
+    KATANA_LOG_ASSERT(
+        katana::analytics::IntersectCountMerge(
+            a.data(), a.size(), b.data(), b.size(), kernel) ==
+        expected.size());
+  }
+  KATANA_LOG_ASSERT(
+      katana::analytics::IntersectCountGallop(
+          a.data(), a.size(), b.data(), b.size()) == expected.size());
+  KATANA_LOG_ASSERT(
+      katana::analytics::IntersectCount(
+          a.data(), a.size(), b.data(), b.size()) == expected.size());
+
+  katana::analytics::IntersectionBitmap bitmap;
+  bitmap.Set(a.data(), a.size());
+  KATANA_LOG_ASSERT(bitmap.Count(b.data(), b.size()) == expected.size());
+  bitmap.Clear(a.data(), a.size());
+  KATANA_LOG_ASSERT(bitmap.Count(b.data(), b.size()) == 0);
+}
+
+}  // namespace
+
+int
+main() {
+  std::mt19937 gen(0);
+  std::uniform_int_distribution<size_t> size_dist(0, 300);
+
+  for (int i = 0; i < 1000; ++i) {
+    // Similar sizes, which are merged, and skewed sizes, which gallop
+    uint32_t range = 1 + gen() % 2000;
+    CheckIntersection(
+        RandomSet(&gen, size_dist(gen), range),
+        RandomSet(&gen, size_dist(gen), range));
+    CheckIntersection(
+        RandomSet(&gen, size_dist(gen) / 10, 50 * range),
+        RandomSet(&gen, 100 * size_dist(gen), 50 * range));
+  }
+
+  std::cout << "kernel "
+            << static_cast<int>(katana::analytics::BestIntersectionKernel())
+            << " ok\n";
+  return 0;
+}
@@ -1,3 +1,5 @@
+#include <cstdlib>
+
 #include <arrow/api.h>
 #include <boost/filesystem.hpp>
 
@@ -147,6 +149,48 @@ TestGarbageMetadata() {
   KATANA_LOG_ASSERT(!no_dir_result.has_value());
 }
 
+/// Write more properties than the write buffer holds frames for
+void
+TestWriteManyProperties() {
+  constexpr size_t test_length = 1000;
+  constexpr size_t num_properties = 16;
+  using ValueType = int64_t;
+
+  auto g = std::make_unique<katana::PropertyFileGraph>();
+  std::vector<std::string> names;
+  for (size_t i = 0; i < num_properties; ++i) {
+    names.emplace_back(fmt::format("node-{}", i));
+    auto add_result =
+        g->AddNodeProperties(MakeTable<ValueType>(names.back(), test_length));
+    KATANA_LOG_ASSERT(add_result);
+  }
+  KATANA_LOG_ASSERT(g->MarkNodePropertiesPersistent(names));
+
+  auto uri_res = katana::Uri::MakeRand("/tmp/propertyfilegraph");
+  KATANA_LOG_ASSERT(uri_res);
+  std::string rdg_dir(uri_res.value().path());  // path() because local
+
+  auto write_result = g->Write(rdg_dir, command_line);
+  if (!write_result) {
+    fs::remove_all(rdg_dir);
+    KATANA_LOG_FATAL("writing result: {}", write_result.error());
+  }
+
+  auto make_result = katana::PropertyFileGraph::Make(rdg_dir);
+  fs::remove_all(rdg_dir);
+  if (!make_result) {
+    KATANA_LOG_FATAL("making result: {}", make_result.error());
+  }
+  std::unique_ptr<katana::PropertyFileGraph> g2 =
+      std::move(make_result.value());
+
+  KATANA_LOG_ASSERT(g2->NodeProperties().size() == num_properties);
+  for (size_t i = 0; i < num_properties; ++i) {
+    KATANA_LOG_ASSERT(g2->node_schema()->field(i)->name() == names[i]);
+    KATANA_LOG_ASSERT(g2->NodeProperty(i)->Equals(*g->NodeProperty(i)));
+  }
+}
+
 std::string
 MakePFGFile(const std::string& n1name) {
   constexpr size_t test_length = 10;
@@ -239,8 +283,92 @@ TestTopologyAccess() {
   KATANA_LOG_ASSERT(n_nodes == 10);
 }
 
+/// Edges of topology as (src, dest) pairs, with src and dest translated to the
+/// original graph by derived_to_original when given
+std::vector<std::pair<uint32_t, uint32_t>>
+EdgeList(
+    const katana::GraphTopology& topology,
+    const std::shared_ptr<arrow::UInt32Array>& derived_to_original) {
+  auto original = [&](uint32_t n) {
+    return derived_to_original ? derived_to_original->Value(n) : n;
+  };
+  std::vector<std::pair<uint32_t, uint32_t>> edges;
+  for (auto n : topology) {
+    for (auto e : topology.edges(n)) {
+      edges.emplace_back(original(n), original(topology.out_dests->Value(e)));
+    }
+  }
+  return edges;
+}
+
+void
+CheckDerived(
+    katana::PropertyFileGraph* g, uint32_t transforms,
+    std::vector<std::pair<uint32_t, uint32_t>> expected) {
+  auto derived_result = g->GetDerivedTopology(transforms);
+  KATANA_LOG_ASSERT(derived_result);
+  auto derived = derived_result.value();
+  const katana::GraphTopology& topology = derived->topology;
+
+  KATANA_LOG_ASSERT(topology.num_nodes() == g->num_nodes());
+  for (auto n : topology) {
+    auto [begin, end] = topology.edge_range(n);
+    const uint32_t* dests = topology.out_dests->raw_values();
+    KATANA_LOG_ASSERT(std::is_sorted(dests + begin, dests + end));
+    if (n > 0 && (transforms & katana::DerivedTopology::kDegreeRelabeled)) {
+      KATANA_LOG_ASSERT(topology.edges(n - 1).size() >= end - begin);
+    }
+  }
+
+  auto actual = EdgeList(topology, derived->derived_to_original);
+  std::sort(actual.begin(), actual.end());
+  std::sort(expected.begin(), expected.end());
+  KATANA_LOG_ASSERT(actual == expected);
+
+  // Asking again returns the cached topology
+  auto again = g->GetDerivedTopology(transforms);
+  KATANA_LOG_ASSERT(again && again.value() == derived);
+}
+
+void
+TestDerivedTopology() {
+  RandomPolicy policy{4};
+  auto g = MakeFileGraph<uint32_t>(100, 0, &policy);
+
+  auto edges = EdgeList(g->topology(), nullptr);
+  std::vector<std::pair<uint32_t, uint32_t>> transposed;
+  for (const auto& [src, dest] : edges) {
+    transposed.emplace_back(dest, src);
+  }
+  std::vector<std::pair<uint32_t, uint32_t>> symmetric = edges;
+  symmetric.insert(symmetric.end(), transposed.begin(), transposed.end());
+  std::sort(symmetric.begin(), symmetric.end());
+  symmetric.erase(
+      std::unique(symmetric.begin(), symmetric.end()), symmetric.end());
+
+  using katana::DerivedTopology;
+  CheckDerived(g.get(), DerivedTopology::kEdgesSorted, edges);
+  CheckDerived(g.get(), DerivedTopology::kDegreeRelabeled, edges);
+  CheckDerived(g.get(), DerivedTopology::kTransposed, transposed);
+  CheckDerived(g.get(), DerivedTopology::kSymmetric, symmetric);
+  CheckDerived(
+      g.get(), DerivedTopology::kSymmetric | DerivedTopology::kDegreeRelabeled,
+      symmetric);
+
+  // Changing the topology drops the cache
+  auto before = g->GetDerivedTopology(DerivedTopology::kEdgesSorted);
+  KATANA_LOG_ASSERT(before);
+  KATANA_LOG_ASSERT(katana::SortAllEdgesByDest(g.get()));
+  auto after = g->GetDerivedTopology(DerivedTopology::kEdgesSorted);
+  KATANA_LOG_ASSERT(after && after.value() != before.value());
+}
+
 int
 main(int argc, char** argv) {
+  // A write buffer smaller than one part of a streaming write, so that every
+  // property being written waits for the buffer held by the others
+  setenv("KATANA_WRITE_BUFFER_MB", "1", 1);
+
   katana::SharedMemSys sys;
 
   std::ostringstream cmdout;
@@ -252,9 +380,11 @@ main(int argc, char** argv) {
   command_line = cmdout.str();
 
   TestRoundTrip();
+  TestWriteManyProperties();
   TestGarbageMetadata();
   TestSimplePGs();
   TestTopologyAccess();
+  TestDerivedTopology();
 
   return 0;
 }
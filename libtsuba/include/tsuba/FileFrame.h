@@ -4,6 +4,7 @@
 #include <cstdint>
 #include <future>
 #include <string>
+#include <vector>
 
 #include <parquet/arrow/writer.h>
 
@@ -20,7 +21,17 @@ class KATANA_EXPORT FileFrame : public arrow::io::OutputStream {
   uint64_t cursor_;
   bool valid_ = false;
   bool synced_ = false;
+
+  // Set by StreamTo: the frame holds only the part being written, completed
+  // parts are stored as they fill
+  bool streaming_ = false;
+  uint64_t part_size_ = 0;
+  std::vector<uint8_t> part_;
+  std::vector<std::future<katana::Result<void>>> part_ops_;
+
   katana::Result<void> GrowBuffer(int64_t accommodate);
+  katana::Result<void> StorePart();
+  katana::Result<void> FinishParts();
 
 public:
   FileFrame() = default;
@@ -34,8 +45,13 @@ public:
         region_size_(other.region_size_),
         cursor_(other.cursor_),
         valid_(other.valid_),
-        synced_(other.synced_) {
+        synced_(other.synced_),
+        streaming_(other.streaming_),
+        part_size_(other.part_size_),
+        part_(std::move(other.part_)),
+        part_ops_(std::move(other.part_ops_)) {
     other.valid_ = false;
+    other.streaming_ = false;
   }
 
   FileFrame& operator=(FileFrame&& other) noexcept {
@@ -50,17 +66,40 @@ public:
       cursor_ = other.cursor_;
       synced_ = other.synced_;
       valid_ = other.valid_;
+      streaming_ = other.streaming_;
+      part_size_ = other.part_size_;
+      part_ = std::move(other.part_);
+      part_ops_ = std::move(other.part_ops_);
       other.valid_ = false;
+      other.streaming_ = false;
     }
     return *this;
   }
 
+  /// Size of the parts a streaming FileFrame stores
+  static constexpr uint64_t kDefaultPartSize = UINT64_C(16) << 20;
+
   ~FileFrame() override;
 
   katana::Result<void> Init(uint64_t reserve_size);
   katana::Result<void> Init() { return Init(1); }
   void Bind(std::string_view filename);
 
+  /// Bind the frame to filename and store it while it is being written:
+  /// every part_size bytes are handed to storage as one part of a multipart
+  /// upload and then dropped, so the frame never holds the whole file.
+  /// Persist completes the upload. The number of bytes held by all streaming
+  /// frames in the process, waiting to be stored, is bounded (see
+  /// KATANA_WRITE_BUFFER_MB); writes block until parts are stored. Each frame
+  /// holds part_size of that buffer until it is persisted, so persist a frame
+  /// as soon as it is written instead of after writing others.
+  ///
+  /// Must be called after Init and before the first write. If the storage for
+  /// filename cannot store parts, the frame is only bound and buffers the
+  /// file in memory as usual. ptr() is not meaningful for a streaming frame.
+  katana::Result<void> StreamTo(
+      std::string_view filename, uint64_t part_size = kDefaultPartSize);
+
   katana::Result<void> Destroy();
 
   katana::Result<void> Persist();
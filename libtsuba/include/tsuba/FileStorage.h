@@ -60,6 +60,21 @@ public:
   virtual katana::Result<void> Delete(
       const std::string& directory,
       const std::unordered_set<std::string>& files) = 0;
+
+  /// Multipart writes: the contents of uri are stored as a sequence of parts,
+  /// possibly concurrently and out of order, and the file only appears once
+  /// PutPartsFinish returns. All parts but the last have the same size.
+  /// Backends that cannot store parts return ErrorCode::NotImplemented from
+  /// PutPartsBegin; callers then fall back to PutMultiSync.
+  virtual katana::Result<void> PutPartsBegin(const std::string& uri);
+  virtual std::future<katana::Result<void>> PutPartAsync(
+      const std::string& uri, uint64_t offset, const uint8_t* data,
+      uint64_t size);
+  virtual katana::Result<void> PutPartsFinish(
+      const std::string& uri, uint64_t size);
+  /// Discard the parts stored so far; uri is left as it was before
+  /// PutPartsBegin
+  virtual katana::Result<void> PutPartsAbort(const std::string& uri);
 };
 
 /// RegisterFileStorage adds a file storage backend to the tsuba library. File
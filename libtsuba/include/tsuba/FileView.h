@@ -30,6 +30,24 @@ class KATANA_EXPORT FileView : public arrow::io::RandomAccessFile {
   std::vector<uint64_t> filling_;
   std::unique_ptr<std::vector<FillingRange>> fetches_;
 
+public:
+  /// Counters describing how well fetches from storage matched the reads
+  struct Stats {
+    /// Bytes requested from storage, including prefetches
+    uint64_t fetched_bytes{0};
+    /// Bytes returned by Read
+    uint64_t read_bytes{0};
+    /// Number of requests issued to storage
+    uint64_t fetch_count{0};
+  };
+
+private:
+  Stats stats_;
+  // Size of the next prefetch; grows while reads are sequential
+  int64_t readahead_{0};
+  // End of the previous Read, to detect sequential access
+  int64_t last_read_end_{-1};
+
 public:
   FileView() = default;
   FileView(const FileView&) = delete;
@@ -44,7 +62,10 @@ public:
         filename_(std::move(other.filename_)),
         valid_(other.valid_),
         filling_(std::move(other.filling_)),
-        fetches_(std::move(other.fetches_)) {
+        fetches_(std::move(other.fetches_)),
+        stats_(other.stats_),
+        readahead_(other.readahead_),
+        last_read_end_(other.last_read_end_) {
     other.valid_ = false;
   }
 
@@ -63,6 +84,9 @@ public:
       filling_ = std::move(other.filling_);
       fetches_ =
           std::unique_ptr<std::vector<FillingRange>>(std::move(other.fetches_));
+      stats_ = other.stats_;
+      readahead_ = other.readahead_;
+      last_read_end_ = other.last_read_end_;
       other.valid_ = false;
     }
     return *this;
@@ -126,6 +150,12 @@ public:
 
   uint64_t size() const { return file_size_; }
 
+  /// The size of the unit in which the file is fetched from storage. It is
+  /// chosen in Bind based on the size of the file and where it is stored.
+  uint64_t page_size() const { return UINT64_C(1) << page_shift_; }
+
+  const Stats& stats() const { return stats_; }
+
   // support iterating through characters
   const char* begin() { return ptr<char>(); }
   const char* end() { return ptr<char>() + size(); }
@@ -167,7 +197,8 @@ private:
   katana::Result<void> Resolve(int64_t start, int64_t size);
 
   // Start asynchronously fetching data that we think we might need from storage
-  // @start and @size give the location and range of the previous read
+  // @start and @size give the location and range of the previous read;
+  // consecutive sequential reads grow the amount fetched ahead of the cursor
   katana::Result<void> PreFetch(int64_t start, int64_t size);
 };
 }  // namespace tsuba
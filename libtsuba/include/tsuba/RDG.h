@@ -127,6 +127,13 @@ public:
   const PartitionMetadata& part_metadata() const;
   void set_part_metadata(const PartitionMetadata& metadata);
 
+  /// Statistics of the graph as an opaque JSON document, stored with the
+  /// partition metadata; empty if none were stored
+  const std::string& graph_stats() const;
+  /// Fails with JsonParseFailed unless graph_stats is empty or a JSON
+  /// document
+  katana::Result<void> set_graph_stats(std::string graph_stats);
+
   const FileView& topology_file_storage() const;
 
 private:
@@ -18,6 +18,10 @@ class KATANA_EXPORT RDGPrefix {
 public:
   static katana::Result<RDGPrefix> Make(RDGHandle handle);
 
+  /// False for an RDG without a topology, whose prefix has no other valid
+  /// accessor
+  bool has_topology() const { return prefix_ != nullptr; }
+
   uint64_t num_nodes() const { return prefix_->header.num_nodes; }
   uint64_t num_edges() const { return prefix_->header.num_edges; }
   uint64_t version() const { return prefix_->header.version; }
@@ -29,6 +29,9 @@ RoundUpToBlock(T val) {
 
 struct StatBuf {
   uint64_t size{UINT64_C(0)};
+  /// Changes whenever the contents of the file change, e.g., an object etag
+  /// or a modification time. Empty if the storage cannot tell.
+  std::string version;
 };
 
 // Returns an error file filename does not exist
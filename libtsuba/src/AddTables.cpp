@@ -1,5 +1,12 @@
 #include "AddTables.h"
 
+#include <algorithm>
+#include <climits>
+#include <cstring>
+#include <limits>
+
+#include <arrow/util/parallel.h>
+
 #include "tsuba/Errors.h"
 #include "tsuba/FileView.h"
 
@@ -60,6 +67,78 @@ DoLoadTable(const std::string& expected_name, const katana::Uri& file_path) {
   return out;
 }
 
+/// Byte range of the single column chunk of row group rg in a file
+std::pair<int64_t, int64_t>
+ColumnChunkRange(const parquet::RowGroupMetaData& rg_md) {
+  auto cc_md = rg_md.ColumnChunk(0);
+  int64_t begin = cc_md->has_dictionary_page()
+                      ? cc_md->dictionary_page_offset()
+                      : cc_md->data_page_offset();
+  return {begin, begin + cc_md->total_compressed_size()};
+}
+
+/// Whether values of type are laid out in one buffer of whole bytes, so that
+/// decoded row groups can be copied side by side into a single array
+bool
+IsByteWidth(const arrow::DataType& type) {
+  if (type.id() == arrow::Type::DICTIONARY) {
+    return false;
+  }
+  const auto* fixed = dynamic_cast<const arrow::FixedWidthType*>(&type);
+  return fixed != nullptr && fixed->bit_width() % CHAR_BIT == 0;
+}
+
+/// Copy rows [begin, begin + length) of the concatenation of chunks, which
+/// have no nulls and a byte width type, into one array. Each chunk is copied
+/// by its own task so the copy runs at memory bandwidth rather than at the
+/// speed of one core.
+Result<std::shared_ptr<arrow::Array>>
+Concatenate(
+    const std::vector<std::shared_ptr<arrow::Array>>& chunks, int64_t begin,
+    int64_t length) {
+  const auto& type = chunks[0]->type();
+  int64_t width =
+      static_cast<const arrow::FixedWidthType&>(*type).bit_width() / CHAR_BIT;
+
+  auto buffer_result =
+      arrow::AllocateBuffer(length * width, arrow::default_memory_pool());
+  if (!buffer_result.ok()) {
+    KATANA_LOG_DEBUG("arrow error: {}", buffer_result.status());
+    return tsuba::ErrorCode::ArrowError;
+  }
+  std::shared_ptr<arrow::Buffer> buffer = std::move(buffer_result.ValueOrDie());
+
+  // Offset of each chunk in the concatenation
+  std::vector<int64_t> chunk_begin(chunks.size() + 1, 0);
+  for (size_t i = 0; i < chunks.size(); ++i) {
+    chunk_begin[i + 1] = chunk_begin[i] + chunks[i]->length();
+  }
+
+  auto copy = [&](int i) -> arrow::Status {
+    int64_t from = std::max(begin, chunk_begin[i]);
+    int64_t to = std::min(begin + length, chunk_begin[i + 1]);
+    if (from >= to) {
+      return arrow::Status::OK();
+    }
+    const auto& data = chunks[i]->data();
+    const uint8_t* src = data->buffers[1]->data() +
+                         (data->offset + from - chunk_begin[i]) * width;
+    std::memcpy(
+        buffer->mutable_data() + (from - begin) * width, src,
+        (to - from) * width);
+    return arrow::Status::OK();
+  };
+  if (auto status = arrow::internal::ParallelFor(
+          static_cast<int>(chunks.size()), copy);
+      !status.ok()) {
+    KATANA_LOG_DEBUG("arrow error: {}", status);
+    return tsuba::ErrorCode::ArrowError;
+  }
+
+  return arrow::MakeArray(
+      arrow::ArrayData::Make(type, length, {nullptr, buffer}, 0));
+}
+
 Result<std::shared_ptr<arrow::Table>>
 DoLoadTableSlice(
     const std::string& expected_name, const katana::Uri& file_path,
@@ -81,60 +160,109 @@ DoLoadTableSlice(
     return tsuba::ErrorCode::ArrowError;
   }
 
+  std::shared_ptr<arrow::Schema> schema;
+  if (auto status = reader->GetSchema(&schema); !status.ok()) {
+    KATANA_LOG_DEBUG("arrow error: {}", status);
+    return tsuba::ErrorCode::ArrowError;
+  }
+  if (schema->num_fields() != 1) {
+    KATANA_LOG_DEBUG("expected 1 field found {} instead", schema->num_fields());
+    return tsuba::ErrorCode::InvalidArgument;
+  }
+  if (schema->field(0)->name() != expected_name) {
+    KATANA_LOG_DEBUG(
+        "expected {} found {} instead", expected_name,
+        schema->field(0)->name());
+    return tsuba::ErrorCode::InvalidArgument;
+  }
+
+  // Find the row groups overlapping the slice and the bytes of the file that
+  // hold them. Row groups are not necessarily laid out back to back (the
+  // writer may pad them), so take the range from the column chunk metadata
+  // rather than summing row group sizes, which are uncompressed anyway.
   std::vector<int> row_groups;
   int rg_count = reader->num_row_groups();
   int64_t row_offset = 0;
   int64_t cumulative_rows = 0;
-  int64_t file_offset = 0;
-  int64_t cumulative_bytes = 0;
+  int64_t file_begin = std::numeric_limits<int64_t>::max();
+  int64_t file_end = 0;
   for (int i = 0; cumulative_rows < offset + length && i < rg_count; ++i) {
     auto rg_md = reader->parquet_reader()->metadata()->RowGroup(i);
     int64_t new_rows = rg_md->num_rows();
-    int64_t new_bytes = rg_md->total_byte_size();
     if (offset < cumulative_rows + new_rows) {
       if (row_groups.empty()) {
         row_offset = offset - cumulative_rows;
-        file_offset = cumulative_bytes;
       }
       row_groups.push_back(i);
+      auto [begin, end] = ColumnChunkRange(*rg_md);
+      file_begin = std::min(file_begin, begin);
+      file_end = std::max(file_end, end);
     }
     cumulative_rows += new_rows;
-    cumulative_bytes += new_bytes;
   }
 
-  if (auto res = fv->Fill(file_offset, cumulative_bytes, false); !res) {
-    return res.error();
+  if (row_groups.empty()) {
+    std::shared_ptr<arrow::Table> out;
+    if (auto status = reader->ReadRowGroups(row_groups, &out); !status.ok()) {
+      KATANA_LOG_DEBUG("arrow error: {}", status);
+      return tsuba::ErrorCode::ArrowError;
+    }
+    return out;
   }
 
-  std::shared_ptr<arrow::Table> out;
-  auto read_result = reader->ReadRowGroups(row_groups, &out);
-  if (!read_result.ok()) {
-    KATANA_LOG_DEBUG("arrow error: {}", read_result);
-    return tsuba::ErrorCode::ArrowError;
+  if (auto res = fv->Fill(file_begin, file_end, false); !res) {
+    return res.error();
   }
 
-  auto combine_result = out->CombineChunks(arrow::default_memory_pool());
-  if (!combine_result.ok()) {
-    KATANA_LOG_DEBUG("arrow error: {}", combine_result.status());
+  // Decode the row groups in parallel. FileView reads are serialized by
+  // arrow's ReadAt, but the fill above means they are memory copies; the
+  // decompression and decoding, which dominate, run concurrently.
+  std::vector<std::shared_ptr<arrow::Array>> chunks(row_groups.size());
+  auto decode = [&](int i) -> arrow::Status {
+    std::shared_ptr<arrow::Table> table;
+    ARROW_RETURN_NOT_OK(reader->ReadRowGroup(row_groups[i], &table));
+    ARROW_ASSIGN_OR_RAISE(table, table->CombineChunks());
+    chunks[i] = table->column(0)->chunk(0);
+    return arrow::Status::OK();
+  };
+  if (auto status = arrow::internal::ParallelFor(
+          static_cast<int>(row_groups.size()), decode);
+      !status.ok()) {
+    KATANA_LOG_DEBUG("arrow error: {}", status);
     return tsuba::ErrorCode::ArrowError;
   }
 
-  out = std::move(combine_result.ValueOrDie());
+  int64_t available = 0;
+  bool has_nulls = false;
+  for (const auto& chunk : chunks) {
+    available += chunk->length();
+    has_nulls = has_nulls || chunk->null_count() > 0;
+  }
+  int64_t out_length =
+      std::max<int64_t>(0, std::min(length, available - row_offset));
 
-  std::shared_ptr<arrow::Schema> schema = out->schema();
-  if (schema->num_fields() != 1) {
-    KATANA_LOG_DEBUG("expected 1 field found {} instead", schema->num_fields());
-    return tsuba::ErrorCode::InvalidArgument;
+  // The common case of a fixed width column without nulls goes straight into
+  // one preallocated array. Everything else (strings, nulls, nested types)
+  // is combined by arrow, which knows how to handle offsets and bitmaps.
+  if (chunks.size() > 1 && !has_nulls &&
+      IsByteWidth(*schema->field(0)->type())) {
+    auto array_res = Concatenate(chunks, row_offset, out_length);
+    if (!array_res) {
+      return array_res.error();
+    }
+    return arrow::Table::Make(schema, {array_res.value()});
   }
 
-  if (schema->field(0)->name() != expected_name) {
-    KATANA_LOG_DEBUG(
-        "expected {} found {} instead", expected_name,
-        schema->field(0)->name());
-    return tsuba::ErrorCode::InvalidArgument;
+  std::shared_ptr<arrow::Table> out = arrow::Table::Make(
+      schema, {std::make_shared<arrow::ChunkedArray>(chunks)});
+  // Binary and string columns may not fit in a single chunk; c.f. DoLoadTable
+  auto combine_result = out->CombineChunks(arrow::default_memory_pool());
+  if (!combine_result.ok()) {
+    KATANA_LOG_DEBUG("arrow error: {}", combine_result.status());
+    return tsuba::ErrorCode::ArrowError;
   }
 
-  return out->Slice(row_offset, length);
+  return combine_result.ValueOrDie()->Slice(row_offset, length);
 }
 
 }  // namespace
@@ -0,0 +1,469 @@
+#include "CachedStorage.h"
+
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include <boost/filesystem.hpp>
+
+#include "katana/Env.h"
+#include "katana/Logging.h"
+#include "katana/Result.h"
+#include "tsuba/Errors.h"
+#include "tsuba/file.h"
+
+namespace fs = boost::filesystem;
+
+namespace {
+
+constexpr uint64_t kDefaultCapacityMB = 10240;
+
+/// Once over capacity, evict down to this fraction of it so that eviction is
+/// not triggered again by the very next insert
+constexpr double kEvictToRatio = 0.9;
+
+/// Bytes read from each end of a file by ProbeVersion
+constexpr uint64_t kProbeSize = 4096;
+
+constexpr uint64_t kFnvOffset = UINT64_C(14695981039346656037);
+
+/// FNV-1a; unlike std::hash its value is stable across builds, which matters
+/// because the cache outlives the process that filled it
+uint64_t
+HashBytes(const uint8_t* data, uint64_t size, uint64_t hash = kFnvOffset) {
+  for (uint64_t i = 0; i < size; ++i) {
+    hash ^= data[i];
+    hash *= UINT64_C(1099511628211);
+  }
+  return hash;
+}
+
+uint64_t
+HashName(const std::string& name) {
+  return HashBytes(reinterpret_cast<const uint8_t*>(name.data()), name.size());
+}
+
+std::string
+BlockPath(const std::string& entry_dir, uint64_t block) {
+  return fmt::format("{}/{}", entry_dir, block);
+}
+
+uint64_t
+BlockBegin(uint64_t block) {
+  return block * tsuba::CachedStorage::kCacheBlockSize;
+}
+
+uint64_t
+BlockEnd(uint64_t block, uint64_t file_size) {
+  return std::min(file_size, BlockBegin(block + 1));
+}
+
+}  // namespace
+
+std::optional<tsuba::CachedStorage::Config>
+tsuba::CachedStorage::ConfigFromEnv() {
+  Config config;
+  if (!katana::GetEnv("KATANA_CACHE_DIR", &config.cache_dir) ||
+      config.cache_dir.empty()) {
+    return std::nullopt;
+  }
+  int capacity_mb = 0;
+  if (!katana::GetEnv("KATANA_CACHE_SIZE_MB", &capacity_mb) ||
+      capacity_mb <= 0) {
+    capacity_mb = kDefaultCapacityMB;
+  }
+  config.capacity = static_cast<uint64_t>(capacity_mb) << 20;
+  return config;
+}
+
+tsuba::CachedStorage::CachedStorage(FileStorage* storage, Config config)
+    : FileStorage(storage->uri_scheme()),
+      storage_(storage),
+      config_(std::move(config)) {}
+
+tsuba::CachedStorage::~CachedStorage() { StopEvictor(); }
+
+katana::Result<void>
+tsuba::CachedStorage::Init() {
+  if (boost::system::error_code err;
+      !fs::create_directories(config_.cache_dir, err)) {
+    if (err) {
+      KATANA_LOG_ERROR(
+          "cannot create cache directory {}: {}", config_.cache_dir,
+          err.message());
+      return err;
+    }
+  }
+
+  StopEvictor();
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = false;
+    // Learn the size of what earlier processes left in the cache
+    evict_requested_ = true;
+  }
+  evictor_ = std::thread([this]() { EvictLoop(); });
+
+  return storage_->Init();
+}
+
+katana::Result<void>
+tsuba::CachedStorage::Fini() {
+  StopEvictor();
+  return storage_->Fini();
+}
+
+katana::Result<void>
+tsuba::CachedStorage::Stat(const std::string& uri, StatBuf* s_buf) {
+  if (auto res = storage_->Stat(uri, s_buf); !res) {
+    return res.error();
+  }
+  StatBuf stat = *s_buf;
+  if (stat.version.empty() && stat.size > 0) {
+    auto version_res = ProbeVersion(uri, stat.size);
+    if (!version_res) {
+      return version_res.error();
+    }
+    stat.version = std::move(version_res.value());
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  file_stats_[uri] = std::move(stat);
+  return katana::ResultSuccess();
+}
+
+katana::Result<std::string>
+tsuba::CachedStorage::ProbeVersion(const std::string& uri, uint64_t size) {
+  // Small files are read whole; otherwise the head and the tail, which
+  // hold the headers and the last written data of most formats
+  uint64_t head_size = std::min(size, 2 * kProbeSize);
+  uint64_t tail_size = size > head_size ? kProbeSize : 0;
+  if (tail_size > 0) {
+    head_size = kProbeSize;
+  }
+  std::vector<uint8_t> probe(head_size + tail_size);
+  if (auto res = storage_->GetMultiSync(uri, 0, head_size, probe.data());
+      !res) {
+    return res.error();
+  }
+  if (tail_size > 0) {
+    if (auto res = storage_->GetMultiSync(
+            uri, size - tail_size, tail_size, probe.data() + head_size);
+        !res) {
+      return res.error();
+    }
+  }
+  return fmt::format("probe-{:016x}", HashBytes(probe.data(), probe.size()));
+}
+
+katana::Result<tsuba::StatBuf>
+tsuba::CachedStorage::LastStat(const std::string& uri) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (auto it = file_stats_.find(uri); it != file_stats_.end()) {
+      return it->second;
+    }
+  }
+  StatBuf s_buf;
+  if (auto res = Stat(uri, &s_buf); !res) {
+    return res.error();
+  }
+  return s_buf;
+}
+
+void
+tsuba::CachedStorage::Forget(const std::string& uri) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = file_stats_.find(uri);
+  if (it == file_stats_.end()) {
+    return;
+  }
+  if (!it->second.version.empty()) {
+    boost::system::error_code err;
+    fs::remove_all(EntryDir(uri, it->second), err);
+  }
+  file_stats_.erase(it);
+}
+
+katana::Result<void>
+tsuba::CachedStorage::Delete(
+    const std::string& directory,
+    const std::unordered_set<std::string>& files) {
+  for (const auto& file : files) {
+    Forget(fmt::format("{}/{}", directory, file));
+  }
+  return storage_->Delete(directory, files);
+}
+
+std::string
+tsuba::CachedStorage::EntryDir(
+    const std::string& uri, const StatBuf& stat) const {
+  return fmt::format(
+      "{}/{:016x}-{}-{:016x}", config_.cache_dir, HashName(uri), stat.size,
+      HashName(stat.version));
+}
+
+bool
+tsuba::CachedStorage::ReadBlock(
+    const std::string& path, uint64_t block_size, uint64_t offset,
+    uint64_t size, uint8_t* buf) const {
+  int fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    return false;
+  }
+  struct stat s_buf;
+  bool hit = fstat(fd, &s_buf) == 0 &&
+             static_cast<uint64_t>(s_buf.st_size) == block_size &&
+             pread(fd, buf, size, offset) == static_cast<ssize_t>(size);
+  if (hit) {
+    // Refresh the modification time; it is the recency used by Evict
+    futimens(fd, nullptr);
+  }
+  close(fd);
+  return hit;
+}
+
+void
+tsuba::CachedStorage::WriteBlock(
+    const std::string& entry_dir, uint64_t block, const uint8_t* data,
+    uint64_t size) {
+  // The cache is best effort: failing to fill it only costs a later refetch,
+  // so errors are logged and otherwise ignored.
+  if (boost::system::error_code err;
+      !fs::create_directories(entry_dir, err) && err) {
+    KATANA_LOG_DEBUG("cannot create {}: {}", entry_dir, err.message());
+    return;
+  }
+
+  std::string path = BlockPath(entry_dir, block);
+  std::string tmp_path = fmt::format(
+      "{}.tmp.{}.{}", path, getpid(),
+      std::hash<std::thread::id>()(std::this_thread::get_id()));
+
+  int fd = open(tmp_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  if (fd < 0) {
+    KATANA_LOG_DEBUG("cannot create {}: {}", tmp_path, std::strerror(errno));
+    return;
+  }
+  bool ok = write(fd, data, size) == static_cast<ssize_t>(size);
+  close(fd);
+  // rename is atomic, so readers in other processes never see a partial block
+  if (!ok || rename(tmp_path.c_str(), path.c_str()) != 0) {
+    KATANA_LOG_DEBUG("cannot write {}: {}", path, std::strerror(errno));
+    unlink(tmp_path.c_str());
+    return;
+  }
+
+  bool must_evict = false;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    size_estimate_ += size;
+    inserted_since_scan_ += size;
+    // Other processes sharing the cache are invisible to size_estimate_, so
+    // rescan after a fraction of the capacity has been inserted as well
+    must_evict = size_estimate_ > config_.capacity ||
+                 inserted_since_scan_ > config_.capacity / 8;
+    evict_requested_ = evict_requested_ || must_evict;
+  }
+  if (must_evict) {
+    evict_cv_.notify_one();
+  }
+}
+
+void
+tsuba::CachedStorage::EvictLoop() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    evict_cv_.wait(lock, [this]() { return evict_requested_ || stopping_; });
+    if (stopping_) {
+      return;
+    }
+    evict_requested_ = false;
+    lock.unlock();
+    Evict();
+    lock.lock();
+  }
+}
+
+void
+tsuba::CachedStorage::StopEvictor() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = true;
+  }
+  evict_cv_.notify_one();
+  if (evictor_.joinable()) {
+    evictor_.join();
+  }
+}
+
+void
+tsuba::CachedStorage::Evict() {
+  // Only one process evicts at a time; if another one already is, it will
+  // leave room for us too.
+  std::string lock_path = fmt::format("{}/.lock", config_.cache_dir);
+  int lock_fd = open(lock_path.c_str(), O_RDWR | O_CREAT, 0644);
+  if (lock_fd < 0) {
+    return;
+  }
+  if (flock(lock_fd, LOCK_EX | LOCK_NB) != 0) {
+    close(lock_fd);
+    return;
+  }
+
+  struct Block {
+    std::time_t last_use;
+    uint64_t size;
+    fs::path path;
+  };
+  std::vector<Block> blocks;
+  uint64_t total = 0;
+
+  boost::system::error_code err;
+  for (fs::recursive_directory_iterator it(config_.cache_dir, err), end;
+       !err && it != end; it.increment(err)) {
+    if (!fs::is_regular_file(it->status()) || it->path() == lock_path) {
+      continue;
+    }
+    boost::system::error_code stat_err;
+    uint64_t size = fs::file_size(it->path(), stat_err);
+    std::time_t last_use = fs::last_write_time(it->path(), stat_err);
+    if (stat_err) {
+      continue;
+    }
+    blocks.emplace_back(Block{last_use, size, it->path()});
+    total += size;
+  }
+
+  if (total > config_.capacity) {
+    std::sort(blocks.begin(), blocks.end(), [](const Block& a, const Block& b) {
+      return a.last_use < b.last_use;
+    });
+    uint64_t target = config_.capacity * kEvictToRatio;
+    for (const Block& block : blocks) {
+      if (total <= target) {
+        break;
+      }
+      if (fs::remove(block.path, err)) {
+        total -= block.size;
+      }
+    }
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    size_estimate_ = total;
+    inserted_since_scan_ = 0;
+  }
+
+  flock(lock_fd, LOCK_UN);
+  close(lock_fd);
+}
+
+katana::Result<void>
+tsuba::CachedStorage::GetMultiSync(
+    const std::string& uri, uint64_t start, uint64_t size,
+    uint8_t* result_buf) {
+  return GetAsync(uri, start, size, result_buf).get();
+}
+
+std::future<katana::Result<void>>
+tsuba::CachedStorage::GetAsync(
+    const std::string& uri, uint64_t start, uint64_t size,
+    uint8_t* result_buf) {
+  auto stat_res = LastStat(uri);
+  if (!stat_res) {
+    return std::async(
+        std::launch::deferred,
+        [=]() -> katana::Result<void> { return stat_res.error(); });
+  }
+  uint64_t file_size = stat_res.value().size;
+  uint64_t end = std::min(start + size, file_size);
+  if (start >= end) {
+    return storage_->GetAsync(uri, start, size, result_buf);
+  }
+
+  std::string entry_dir = EntryDir(uri, stat_res.value());
+  uint64_t first_block = start / kCacheBlockSize;
+  uint64_t last_block = (end - 1) / kCacheBlockSize;
+
+  // Runs of consecutive missing blocks are fetched with one request to the
+  // underlying storage
+  struct Fetch {
+    uint64_t first_block;
+    uint64_t end_block;
+    std::unique_ptr<uint8_t[]> data;
+    std::future<katana::Result<void>> future;
+  };
+  std::vector<Fetch> fetches;
+  for (uint64_t block = first_block; block <= last_block;) {
+    uint64_t copy_begin = std::max(start, BlockBegin(block));
+    uint64_t copy_end = std::min(end, BlockEnd(block, file_size));
+    if (ReadBlock(
+            BlockPath(entry_dir, block),
+            BlockEnd(block, file_size) - BlockBegin(block),
+            copy_begin - BlockBegin(block), copy_end - copy_begin,
+            result_buf + (copy_begin - start))) {
+      ++block;
+      continue;
+    }
+
+    uint64_t run_end = block + 1;
+    while (run_end <= last_block &&
+           !fs::exists(BlockPath(entry_dir, run_end))) {
+      ++run_end;
+    }
+
+    uint64_t fetch_begin = BlockBegin(block);
+    uint64_t fetch_size = BlockEnd(run_end - 1, file_size) - fetch_begin;
+    Fetch fetch{block, run_end, std::make_unique<uint8_t[]>(fetch_size), {}};
+    fetch.future =
+        storage_->GetAsync(uri, fetch_begin, fetch_size, fetch.data.get());
+    fetches.emplace_back(std::move(fetch));
+    block = run_end;
+  }
+
+  if (fetches.empty()) {
+    return std::async(std::launch::deferred, []() -> katana::Result<void> {
+      return katana::ResultSuccess();
+    });
+  }
+
+  return std::async(
+      std::launch::deferred,
+      [this, entry_dir, start, end, file_size, result_buf,
+       fetches = std::move(fetches)]() mutable -> katana::Result<void> {
+        katana::Result<void> result = katana::ResultSuccess();
+        // Every fetch is waited on, even after an error, because they all
+        // write into buffers owned by this closure
+        for (Fetch& fetch : fetches) {
+          if (auto res = fetch.future.get(); !res) {
+            if (result) {
+              result = res.error();
+            }
+            continue;
+          }
+          uint64_t fetch_begin = BlockBegin(fetch.first_block);
+          for (uint64_t b = fetch.first_block; b < fetch.end_block; ++b) {
+            const uint8_t* data =
+                fetch.data.get() + (BlockBegin(b) - fetch_begin);
+            WriteBlock(
+                entry_dir, b, data, BlockEnd(b, file_size) - BlockBegin(b));
+
+            uint64_t copy_begin = std::max(start, BlockBegin(b));
+            uint64_t copy_end = std::min(end, BlockEnd(b, file_size));
+            std::memcpy(
+                result_buf + (copy_begin - start),
+                fetch.data.get() + (copy_begin - fetch_begin),
+                copy_end - copy_begin);
+          }
+        }
+        return result;
+      });
+}
@@ -0,0 +1,168 @@
+#ifndef KATANA_LIBTSUBA_CACHEDSTORAGE_H_
+#define KATANA_LIBTSUBA_CACHEDSTORAGE_H_
+
+#include <condition_variable>
+#include <cstdint>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+#include "katana/Result.h"
+#include "tsuba/FileStorage.h"
+#include "tsuba/file.h"
+
+namespace tsuba {
+
+/// Keep a local on-disk copy of the blocks read from another (typically
+/// remote) FileStorage so that repeated reads of the same file, from this
+/// process or any other process on the host, are served from local disk.
+///
+/// Blocks are addressed by file name, size and the version reported by Stat
+/// (an etag or a modification time), so a file rewritten under the same name
+/// and size is fetched again. When the storage reports no version, Stat
+/// fetches the first and last few KiB of the file and uses their hash
+/// instead; a rewrite that keeps the size and only changes bytes in between
+/// goes unnoticed, which is acceptable because RDG files are never rewritten
+/// in place. The version is taken from the last Stat of the file, which
+/// FileView does whenever it opens one. Each block is its own file,
+/// published with an atomic rename, so processes can share a cache directory
+/// without coordination. The least recently used blocks (by modification
+/// time, which is refreshed on every hit) are evicted by a background thread
+/// once the cache grows past its capacity.
+///
+/// Writes, listings and deletes pass straight through to the wrapped storage.
+class CachedStorage : public FileStorage {
+public:
+  /// Cached blocks are aligned to and as large as the smallest FileView page
+  /// used for remote files
+  static constexpr uint64_t kCacheBlockSize = UINT64_C(1) << 20;
+
+  struct Config {
+    std::string cache_dir;
+    uint64_t capacity;
+  };
+
+  /// Read the cache configuration from the environment.
+  ///
+  /// KATANA_CACHE_DIR enables the cache and names the directory holding it;
+  /// KATANA_CACHE_SIZE_MB bounds its size (default 10 GiB).
+  static std::optional<Config> ConfigFromEnv();
+
+  CachedStorage(FileStorage* storage, Config config);
+  ~CachedStorage() override;
+
+  katana::Result<void> Init() override;
+  katana::Result<void> Fini() override;
+  katana::Result<void> Stat(const std::string& uri, StatBuf* size) override;
+
+  uint32_t Priority() const override { return storage_->Priority(); }
+
+  katana::Result<void> GetMultiSync(
+      const std::string& uri, uint64_t start, uint64_t size,
+      uint8_t* result_buf) override;
+
+  katana::Result<void> PutMultiSync(
+      const std::string& uri, const uint8_t* data, uint64_t size) override {
+    Forget(uri);
+    return storage_->PutMultiSync(uri, data, size);
+  }
+
+  katana::Result<void> RemoteCopy(
+      const std::string& source_uri, const std::string& dest_uri,
+      uint64_t begin, uint64_t size) override {
+    Forget(dest_uri);
+    return storage_->RemoteCopy(source_uri, dest_uri, begin, size);
+  }
+
+  std::future<katana::Result<void>> PutAsync(
+      const std::string& uri, const uint8_t* data, uint64_t size) override {
+    Forget(uri);
+    return storage_->PutAsync(uri, data, size);
+  }
+
+  /// Cached blocks are copied before returning; missing ones are fetched
+  /// with the GetAsync of the wrapped storage and inserted into the cache
+  /// when the returned future is waited on
+  std::future<katana::Result<void>> GetAsync(
+      const std::string& uri, uint64_t start, uint64_t size,
+      uint8_t* result_buf) override;
+
+  std::future<katana::Result<void>> ListAsync(
+      const std::string& directory, std::vector<std::string>* list,
+      std::vector<uint64_t>* size) override {
+    return storage_->ListAsync(directory, list, size);
+  }
+
+  katana::Result<void> Delete(
+      const std::string& directory,
+      const std::unordered_set<std::string>& files) override;
+
+  katana::Result<void> PutPartsBegin(const std::string& uri) override {
+    Forget(uri);
+    return storage_->PutPartsBegin(uri);
+  }
+
+  std::future<katana::Result<void>> PutPartAsync(
+      const std::string& uri, uint64_t offset, const uint8_t* data,
+      uint64_t size) override {
+    return storage_->PutPartAsync(uri, offset, data, size);
+  }
+
+  katana::Result<void> PutPartsFinish(
+      const std::string& uri, uint64_t size) override {
+    return storage_->PutPartsFinish(uri, size);
+  }
+
+  katana::Result<void> PutPartsAbort(const std::string& uri) override {
+    return storage_->PutPartsAbort(uri);
+  }
+
+private:
+  /// The result of the last Stat of uri, which is done now if there was none
+  katana::Result<StatBuf> LastStat(const std::string& uri);
+  /// Stand-in for the version of files whose storage does not report one
+  katana::Result<std::string> ProbeVersion(
+      const std::string& uri, uint64_t size);
+  void Forget(const std::string& uri);
+
+  std::string EntryDir(const std::string& uri, const StatBuf& stat) const;
+
+  /// Copy [offset, offset + size) of a cached block into buf; returns false
+  /// on a miss
+  bool ReadBlock(
+      const std::string& path, uint64_t block_size, uint64_t offset,
+      uint64_t size, uint8_t* buf) const;
+  void WriteBlock(
+      const std::string& entry_dir, uint64_t block, const uint8_t* data,
+      uint64_t size);
+
+  /// Recompute the size of the cache and, if it is over capacity, remove the
+  /// least recently used blocks
+  void Evict();
+  /// Body of evictor_: runs Evict whenever it is requested
+  void EvictLoop();
+  void StopEvictor();
+
+  FileStorage* storage_;
+  Config config_;
+
+  std::thread evictor_;
+  std::condition_variable evict_cv_;
+
+  std::mutex mutex_;
+  bool evict_requested_{false};
+  bool stopping_{false};
+  // Bytes believed to be in the cache; other processes also insert blocks so
+  // this is refreshed by scanning the cache in Evict
+  uint64_t size_estimate_{0};
+  uint64_t inserted_since_scan_{0};
+  std::unordered_map<std::string, StatBuf> file_stats_;
+};
+
+}  // namespace tsuba
+
+#endif
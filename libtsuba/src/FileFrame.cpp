@@ -2,12 +2,71 @@
 
 #include <sys/mman.h>
 
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+
+#include "GlobalState.h"
+#include "katana/Env.h"
 #include "katana/Logging.h"
 #include "katana/Platform.h"
 #include "katana/Result.h"
 #include "tsuba/Errors.h"
 #include "tsuba/file.h"
 
+namespace {
+
+constexpr uint64_t kDefaultWriteBufferMB = 1024;
+
+/// Bytes held by streaming FileFrames, shared by all of them so that the
+/// memory used to write a graph does not grow with the number of columns
+/// being encoded concurrently or with the latency of storage
+class WriteBuffer {
+public:
+  WriteBuffer() {
+    int buffer_mb = 0;
+    if (!katana::GetEnv("KATANA_WRITE_BUFFER_MB", &buffer_mb) ||
+        buffer_mb <= 0) {
+      buffer_mb = kDefaultWriteBufferMB;
+    }
+    capacity_ = static_cast<uint64_t>(buffer_mb) << 20;
+    available_ = capacity_;
+  }
+
+  /// Block until size bytes are available. A request for more than the
+  /// capacity waits for the whole buffer instead of forever.
+  void Acquire(uint64_t size) {
+    size = std::min(size, capacity_);
+    std::unique_lock<std::mutex> lock(mutex_);
+    cv_.wait(lock, [&] { return available_ >= size; });
+    available_ -= size;
+  }
+
+  void Release(uint64_t size) {
+    size = std::min(size, capacity_);
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      available_ += size;
+    }
+    cv_.notify_all();
+  }
+
+private:
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  uint64_t capacity_;
+  uint64_t available_;
+};
+
+WriteBuffer&
+GetWriteBuffer() {
+  static WriteBuffer buffer;
+  return buffer;
+}
+
+}  // namespace
+
 namespace tsuba {
 
 FileFrame::~FileFrame() {
@@ -18,6 +77,19 @@ FileFrame::~FileFrame() {
 
 katana::Result<void>
 FileFrame::Destroy() {
+  if (streaming_) {
+    // Never persisted; drop what was stored so far
+    for (auto& op : part_ops_) {
+      op.wait();
+    }
+    part_ops_.clear();
+    std::vector<uint8_t>().swap(part_);
+    GetWriteBuffer().Release(part_size_);
+    streaming_ = false;
+    if (auto res = FS(path_)->PutPartsAbort(path_); !res) {
+      KATANA_LOG_DEBUG("abort of {} failed: {}", path_, res.error());
+    }
+  }
   if (valid_) {
     int err = munmap(map_start_, map_size_);
     valid_ = false;
@@ -55,6 +127,81 @@ FileFrame::Bind(std::string_view filename) {
   path_ = filename;
 }
 
+katana::Result<void>
+FileFrame::StreamTo(std::string_view filename, uint64_t part_size) {
+  if (!valid_ || streaming_ || cursor_ != 0 || part_size == 0) {
+    return tsuba::ErrorCode::InvalidArgument;
+  }
+  Bind(filename);
+  if (auto res = FS(path_)->PutPartsBegin(path_); !res) {
+    if (res.error() == tsuba::ErrorCode::NotImplemented) {
+      return katana::ResultSuccess();
+    }
+    return res.error();
+  }
+  streaming_ = true;
+  part_size_ = part_size;
+  GetWriteBuffer().Acquire(part_size_);
+  part_.reserve(part_size_);
+  return katana::ResultSuccess();
+}
+
+katana::Result<void>
+FileFrame::StorePart() {
+  uint64_t offset = cursor_ - part_.size();
+  part_ops_.emplace_back(std::async(
+      std::launch::async,
+      [path = path_, offset, part = std::move(part_),
+       part_size = part_size_]() -> katana::Result<void> {
+        auto res =
+            FS(path)->PutPartAsync(path, offset, part.data(), part.size())
+                .get();
+        GetWriteBuffer().Release(part_size);
+        return res;
+      }));
+  part_ = std::vector<uint8_t>();
+
+  // Surface the errors of parts already stored so that a failing upload
+  // stops the writer early
+  for (auto it = part_ops_.begin(); it != part_ops_.end();) {
+    if (it->wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+      ++it;
+      continue;
+    }
+    if (auto res = it->get(); !res) {
+      part_ops_.erase(it);
+      return res.error();
+    }
+    it = part_ops_.erase(it);
+  }
+  return katana::ResultSuccess();
+}
+
+katana::Result<void>
+FileFrame::FinishParts() {
+  auto res = StorePart();
+  for (auto& op : part_ops_) {
+    if (auto op_res = op.get(); res && !op_res) {
+      res = op_res.error();
+    }
+  }
+  part_ops_.clear();
+  streaming_ = false;
+
+  if (res) {
+    res = FS(path_)->PutPartsFinish(path_, cursor_);
+  }
+  if (!res) {
+    if (auto abort_res = FS(path_)->PutPartsAbort(path_); !abort_res) {
+      KATANA_LOG_DEBUG("abort of {} failed: {}", path_, abort_res.error());
+    }
+    return res.error();
+  }
+  synced_ = true;
+  // The contents are gone with the parts; the frame cannot be persisted again
+  return Destroy();
+}
+
 katana::Result<void>
 FileFrame::GrowBuffer(int64_t accomodate) {
   // We need a bigger buffer
@@ -103,6 +250,9 @@ FileFrame::Persist() {
     KATANA_LOG_DEBUG("No path provided to FileFrame");
     return tsuba::ErrorCode::InvalidArgument;
   }
+  if (streaming_) {
+    return FinishParts();
+  }
   if (auto res = tsuba::FileStore(path_, map_start_, cursor_); !res) {
     return res.error();
   }
@@ -118,6 +268,10 @@ FileFrame::PersistAsync() {
     KATANA_LOG_DEBUG("No path provided to FileFrame");
     return katana::AsyncError<void>(tsuba::ErrorCode::InvalidArgument);
   }
+  if (streaming_) {
+    // Most parts are already stored; only wait for them and the last one
+    return std::async(std::launch::async, [this]() { return FinishParts(); });
+  }
   return tsuba::FileStoreAsync(path_, map_start_, cursor_);
 }
 
@@ -153,6 +307,28 @@ FileFrame::Write(const void* data, int64_t nbytes) {
     return arrow::Status(
         arrow::StatusCode::Invalid, "Cannot Write negative bytes");
   }
+  if (streaming_) {
+    const auto* bytes = static_cast<const uint8_t*>(data);
+    while (nbytes > 0) {
+      int64_t n = std::min<int64_t>(
+          nbytes, static_cast<int64_t>(part_size_ - part_.size()));
+      part_.insert(part_.end(), bytes, bytes + n);
+      bytes += n;
+      nbytes -= n;
+      cursor_ += n;
+      if (part_.size() < part_size_) {
+        continue;
+      }
+      auto res = StorePart();
+      GetWriteBuffer().Acquire(part_size_);
+      part_.reserve(part_size_);
+      if (!res) {
+        return arrow::Status::IOError(
+            "FileFrame could not store part: ", res.error().message());
+      }
+    }
+    return arrow::Status::OK();
+  }
   if (cursor_ + nbytes > map_size_) {
     if (auto res = GrowBuffer(nbytes); !res) {
       return arrow::Status(
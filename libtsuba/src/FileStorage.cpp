@@ -1,9 +1,32 @@
 #include "tsuba/FileStorage.h"
 
 #include "FileStorage_internal.h"
+#include "katana/Result.h"
+#include "tsuba/Errors.h"
 
 tsuba::FileStorage::~FileStorage() = default;
 
+katana::Result<void>
+tsuba::FileStorage::PutPartsBegin(const std::string&) {
+  return ErrorCode::NotImplemented;
+}
+
+std::future<katana::Result<void>>
+tsuba::FileStorage::PutPartAsync(
+    const std::string&, uint64_t, const uint8_t*, uint64_t) {
+  return katana::AsyncError<void>(ErrorCode::NotImplemented);
+}
+
+katana::Result<void>
+tsuba::FileStorage::PutPartsFinish(const std::string&, uint64_t) {
+  return ErrorCode::NotImplemented;
+}
+
+katana::Result<void>
+tsuba::FileStorage::PutPartsAbort(const std::string&) {
+  return ErrorCode::NotImplemented;
+}
+
 std::vector<tsuba::FileStorage*>&
 tsuba::GetRegisteredFileStorages() {
   static std::vector<FileStorage*> fs;
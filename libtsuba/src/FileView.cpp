@@ -9,6 +9,7 @@
 
 #include "katana/Logging.h"
 #include "katana/Result.h"
+#include "katana/Uri.h"
 #include "tsuba/Errors.h"
 #include "tsuba/file.h"
 
@@ -30,6 +31,44 @@
  * somehow and also tell users to not modify our files?
  */
 
+namespace {
+
+/// Local reads are cheap to issue, so use small pages and fetch little more
+/// than what is asked for
+constexpr uint8_t kLocalPageShift = 16; /* 64K */
+/// Every request to remote storage has a high fixed latency, so use pages
+/// large enough to amortize it
+constexpr uint8_t kRemotePageShift = 20; /* 1M */
+constexpr uint8_t kMaxPageShift = 26; /* 64M */
+/// Larger files get larger pages so that they do not need more pages than
+/// this
+constexpr uint64_t kMaxPages = 4096;
+
+/// Upper bound on how far ahead of a sequential reader to fetch
+constexpr int64_t kMaxReadahead = INT64_C(1) << 26; /* 64M */
+
+uint8_t
+ChoosePageShift(const std::string& filename, uint64_t file_size) {
+  bool is_local = true;
+  if (auto uri_res = katana::Uri::Make(filename); uri_res) {
+    is_local = uri_res.value().scheme() == katana::Uri::kFileScheme;
+  }
+
+  uint8_t page_shift = is_local ? kLocalPageShift : kRemotePageShift;
+  // Pages are protected individually with mprotect so they cannot be smaller
+  // than a system page
+  while ((UINT64_C(1) << page_shift) <
+         static_cast<uint64_t>(sysconf(_SC_PAGESIZE))) {
+    ++page_shift;
+  }
+  while (page_shift < kMaxPageShift && (file_size >> page_shift) > kMaxPages) {
+    ++page_shift;
+  }
+  return page_shift;
+}
+
+}  // namespace
+
 namespace tsuba {
 
 FileView::~FileView() {
@@ -52,6 +91,11 @@ FileView::Unbind() {
         return katana::ResultErrno();
       }
     }
+    KATANA_LOG_DEBUG(
+        "{}: fetched {} bytes in {} requests ({} byte pages) for {} bytes "
+        "read",
+        filename_, stats_.fetched_bytes, stats_.fetch_count, page_size(),
+        stats_.read_bytes);
     valid_ = false;
   }
   return res;
@@ -61,8 +105,8 @@ katana::Result<void>
 FileView::Bind(
     std::string_view filename, uint64_t begin, uint64_t end, bool resolve) {
   StatBuf buf;
-  filename_ = filename;
-  if (auto res = FileStat(filename_, &buf); !res) {
+  std::string new_filename(filename);
+  if (auto res = FileStat(new_filename, &buf); !res) {
     return res.error();
   }
   uint64_t in_end = std::min<uint64_t>(end, static_cast<uint64_t>(buf.size));
@@ -70,12 +114,6 @@ FileView::Bind(
     return ErrorCode::InvalidArgument;
   }
 
-  // SCB 2020-07-23: Given that page_shift_ is treated as a compile-time
-  // constant, it seems silly to have it be a member of this class. But I can
-  // imagine one day wanting to set it dynamically based on file type, file
-  // size, type of backing storage, etc. So make it a class member and set it
-  // here.
-  page_shift_ = 20; /* 1M */
   void* tmp = nullptr;
 
   // Map enough virtual memory to hold entire file, but do not populate it
@@ -89,9 +127,15 @@ FileView::Bind(
     return res.error();
   }
 
+  filename_ = std::move(new_filename);
+  page_shift_ = ChoosePageShift(filename_, buf.size);
+  stats_ = Stats{};
+  readahead_ = 0;
+  last_read_end_ = -1;
+
   map_start_ = static_cast<uint8_t*>(tmp);
   mem_start_ = -1;
-  filling_.resize(page_number(buf.size) / 64 + 1, 0);
+  filling_.assign(page_number(buf.size) / 64 + 1, 0);
   file_size_ = buf.size;
   fetches_ = std::make_unique<std::vector<FillingRange>>();
   if (auto res = Fill(begin, in_end, resolve); !res) {
@@ -142,6 +186,8 @@ FileView::Fill(uint64_t begin, uint64_t end, bool resolve) {
       auto peek_fut =
           FileGetAsync(filename_, map_start_ + file_off, file_off, map_size);
       KATANA_LOG_ASSERT(peek_fut.valid());
+      stats_.fetched_bytes += map_size;
+      stats_.fetch_count += 1;
       FillingRange fetch = {first_page, last_page, std::move(peek_fut)};
       fetches_->push_back(std::move(fetch));
       if (auto res = MarkFilled(&filling_[0], first_page, last_page); !res) {
@@ -249,6 +295,7 @@ FileView::Read(int64_t nbytes) {
   auto ret =
       std::make_shared<arrow::Buffer>(map_start_ + cursor_, nbytes_internal);
   cursor_ += nbytes_internal;
+  stats_.read_bytes += nbytes_internal;
   return ret;
 }
 
@@ -283,6 +330,7 @@ FileView::Read(int64_t nbytes, void* out) {
   // and return the requested data
   std::memcpy(out, map_start_ + cursor_, nbytes_internal);
   cursor_ += nbytes_internal;
+  stats_.read_bytes += nbytes_internal;
   return nbytes_internal;
 }
 
@@ -404,7 +452,7 @@ FileView::MustFill(uint64_t* bitmap, uint64_t begin, uint64_t end) {
   // searching backward
   if (found_first && !found_last) {
     // search backward for last page, skip end_block
-    for (uint64_t i = end_block - 1; i > begin_block && !found_last; ++i) {
+    for (uint64_t i = end_block - 1; i > begin_block && !found_last; --i) {
       if (~bitmap[i]) {
         last_page = LastPage(bitmap, i, 0, 63);
         found_last = true;
@@ -478,11 +526,22 @@ FileView::Resolve(int64_t start, int64_t size) {
 
 katana::Result<void>
 FileView::PreFetch(int64_t start, int64_t size) {
-  // Our highly sophisticated prefetching algorithm is to crudely approximate
+  // For an isolated read, crudely approximate the size of the next read as
   // the size of the last read plus 10%. This is largely motivated by parquet
   // files, which consecutively read row groups that are (in theory)
   // approximately the same size.
-  int64_t fetch_size = (size / 10) * 11;
+  //
+  // A read that starts where the previous one ended is part of a sequential
+  // scan (e.g., a column being read chunk by chunk), so double the readahead
+  // each time, up to kMaxReadahead, to serve the scan with a few large
+  // requests instead of many small ones.
+  if (start == last_read_end_) {
+    readahead_ = std::min(std::max(readahead_ * 2, size), kMaxReadahead);
+  } else {
+    readahead_ = (size / 10) * 11;
+  }
+  last_read_end_ = start + size;
+  int64_t fetch_size = readahead_;
   // Make sure we haven't overflown
   KATANA_LOG_DEBUG_ASSERT(fetch_size >= 0);
   uint64_t begin = static_cast<uint64_t>(start + size);
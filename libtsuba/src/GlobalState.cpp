@@ -69,6 +69,19 @@ tsuba::GlobalState::Init(
   }
   registered.clear();
 
+  // Remote storage is read through a local block cache when one is
+  // configured; local files gain nothing from it
+  if (auto config = CachedStorage::ConfigFromEnv(); config) {
+    for (FileStorage*& fs : global_state->file_stores_) {
+      if (fs == &global_state->local_storage_) {
+        continue;
+      }
+      global_state->cached_stores_.emplace_back(
+          std::make_unique<CachedStorage>(fs, config.value()));
+      fs = global_state->cached_stores_.back().get();
+    }
+  }
+
   std::sort(
       global_state->file_stores_.begin(), global_state->file_stores_.end(),
       [](const FileStorage* lhs, const FileStorage* rhs) {
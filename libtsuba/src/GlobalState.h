@@ -4,6 +4,7 @@
 #include <memory>
 #include <vector>
 
+#include "CachedStorage.h"
 #include "LocalStorage.h"
 #include "katana/CommBackend.h"
 #include "katana/Logging.h"
@@ -24,6 +25,7 @@ class GlobalState {
   tsuba::NameServerClient* name_server_client_;
 
   tsuba::LocalStorage local_storage_;
+  std::vector<std::unique_ptr<tsuba::CachedStorage>> cached_stores_;
 
   GlobalState(katana::CommBackend* comm, tsuba::NameServerClient* ns)
       : comm_(comm), name_server_client_(ns) {
@@ -21,6 +21,15 @@
 
 namespace fs = boost::filesystem;
 
+namespace {
+
+std::string
+PartsPath(const std::string& path) {
+  return path + ".parts";
+}
+
+}  // namespace
+
 void
 tsuba::LocalStorage::CleanUri(std::string* uri) {
   if (uri->find(uri_scheme()) != 0) {
@@ -114,6 +123,8 @@ tsuba::LocalStorage::Stat(const std::string& uri, StatBuf* s_buf) {
     return katana::ResultErrno();
   }
   s_buf->size = local_s_buf.st_size;
+  s_buf->version = fmt::format(
+      "{}.{:09}", local_s_buf.st_mtim.tv_sec, local_s_buf.st_mtim.tv_nsec);
   return katana::ResultSuccess();
 }
 
@@ -193,3 +204,77 @@ tsuba::LocalStorage::Delete(
   }
   return katana::ResultSuccess();
 }
+
+katana::Result<void>
+tsuba::LocalStorage::PutPartsBegin(const std::string& uri) {
+  std::string path = uri;
+  CleanUri(&path);
+  fs::path dir = fs::path(path).parent_path();
+  if (boost::system::error_code err; !fs::create_directories(dir, err)) {
+    if (err) {
+      return err;
+    }
+  }
+
+  int fd = open(PartsPath(path).c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  if (fd < 0) {
+    KATANA_LOG_DEBUG(
+        "failed to create {}: {}", PartsPath(path),
+        katana::ResultErrno().message());
+    return ErrorCode::LocalStorageError;
+  }
+  close(fd);
+  return katana::ResultSuccess();
+}
+
+katana::Result<void>
+tsuba::LocalStorage::WritePart(
+    std::string uri, uint64_t offset, const uint8_t* data, uint64_t size) {
+  CleanUri(&uri);
+  int fd = open(PartsPath(uri).c_str(), O_WRONLY);
+  if (fd < 0) {
+    KATANA_LOG_DEBUG(
+        "failed to open {}: {}", PartsPath(uri),
+        katana::ResultErrno().message());
+    return ErrorCode::LocalStorageError;
+  }
+  while (size > 0) {
+    ssize_t written = pwrite(fd, data, size, offset);
+    if (written < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      KATANA_LOG_DEBUG(
+          "failed to write {}: {}", PartsPath(uri),
+          katana::ResultErrno().message());
+      close(fd);
+      return ErrorCode::LocalStorageError;
+    }
+    data += written;
+    offset += written;
+    size -= written;
+  }
+  close(fd);
+  return katana::ResultSuccess();
+}
+
+katana::Result<void>
+tsuba::LocalStorage::PutPartsFinish(const std::string& uri, uint64_t size) {
+  std::string path = uri;
+  CleanUri(&path);
+  if (truncate(PartsPath(path).c_str(), size) != 0 ||
+      rename(PartsPath(path).c_str(), path.c_str()) != 0) {
+    KATANA_LOG_DEBUG(
+        "failed to finish {}: {}", path, katana::ResultErrno().message());
+    return ErrorCode::LocalStorageError;
+  }
+  return katana::ResultSuccess();
+}
+
+katana::Result<void>
+tsuba::LocalStorage::PutPartsAbort(const std::string& uri) {
+  std::string path = uri;
+  CleanUri(&path);
+  unlink(PartsPath(path).c_str());
+  return katana::ResultSuccess();
+}
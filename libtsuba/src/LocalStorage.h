@@ -24,6 +24,8 @@ class LocalStorage : public FileStorage {
   katana::Result<void> RemoteCopyFile(
       std::string source_uri, std::string dest_uri, uint64_t begin,
       uint64_t size);
+  katana::Result<void> WritePart(
+      std::string uri, uint64_t offset, const uint8_t* data, uint64_t size);
 
 public:
   LocalStorage() : FileStorage("file://") {}
@@ -80,6 +82,24 @@ public:
   katana::Result<void> Delete(
       const std::string& directory,
       const std::unordered_set<std::string>& files) override;
+
+  /// Parts are written in place into a temporary file next to uri, which is
+  /// renamed to uri when the upload is finished
+  katana::Result<void> PutPartsBegin(const std::string& uri) override;
+  std::future<katana::Result<void>> PutPartAsync(
+      const std::string& uri, uint64_t offset, const uint8_t* data,
+      uint64_t size) override {
+    // Like PutAsync, the write happens synchronously
+    if (auto write_res = WritePart(uri, offset, data, size); !write_res) {
+      return std::async(
+          [=]() -> katana::Result<void> { return write_res.error(); });
+    }
+    return std::async(
+        []() -> katana::Result<void> { return katana::ResultSuccess(); });
+  }
+  katana::Result<void> PutPartsFinish(
+      const std::string& uri, uint64_t size) override;
+  katana::Result<void> PutPartsAbort(const std::string& uri) override;
 };
 
 }  // namespace tsuba
@@ -1,13 +1,17 @@
 #include "tsuba/RDG.h"
 
+#include <algorithm>
 #include <cassert>
+#include <climits>
 #include <exception>
 #include <fstream>
 #include <memory>
+#include <mutex>
 #include <regex>
 #include <unordered_set>
 
 #include <arrow/filesystem/api.h>
+#include <arrow/util/parallel.h>
 #include <parquet/arrow/reader.h>
 #include <parquet/arrow/schema.h>
 #include <parquet/arrow/writer.h>
@@ -54,26 +58,47 @@ StandardArrowProperties() {
   return parquet::ArrowWriterProperties::Builder().build();
 }
 
-/// Store the arrow array as a table in a unique file, return
-/// the final name of that file
+/// Uncompressed bytes per Parquet row group. Row groups are the unit of
+/// parallel decode in LoadTableSlice, so they should be small enough that a
+/// slice spans several of them but large enough to amortize page headers.
+constexpr int64_t kRowGroupTargetBytes = INT64_C(16) << 20;
+/// Rows per row group for types whose values do not have a fixed width
+constexpr int64_t kDefaultRowGroupRows = INT64_C(1) << 20;
+
+int64_t
+RowGroupRows(const arrow::DataType& type) {
+  const auto* fixed = dynamic_cast<const arrow::FixedWidthType*>(&type);
+  if (fixed == nullptr || fixed->bit_width() < CHAR_BIT) {
+    return kDefaultRowGroupRows;
+  }
+  return std::max<int64_t>(
+      1, kRowGroupTargetBytes / (fixed->bit_width() / CHAR_BIT));
+}
+
+/// Encode the arrow array as a table in a unique file, return the final name
+/// of that file and the frame holding it in ff. The frame streams the file to
+/// storage as it is encoded; storing ff with a WriteGroup completes it.
 katana::Result<std::string>
-DoStoreArrowArrayAtName(
+DoEncodeArrowArrayAtName(
     const std::shared_ptr<arrow::ChunkedArray>& array, const katana::Uri& dir,
-    const std::string& name, tsuba::WriteGroup* desc) {
+    const std::string& name, std::shared_ptr<tsuba::FileFrame>* ff) {
   katana::Uri next_path = dir.RandFile(name);
 
   // Metadata paths should relative to dir
   std::shared_ptr<arrow::Table> column = arrow::Table::Make(
       arrow::schema({arrow::field(name, array->type())}), {array});
 
-  auto ff = std::make_shared<tsuba::FileFrame>();
-  if (auto res = ff->Init(); !res) {
+  auto frame = std::make_shared<tsuba::FileFrame>();
+  if (auto res = frame->Init(); !res) {
+    return res.error();
+  }
+  if (auto res = frame->StreamTo(next_path.string()); !res) {
     return res.error();
   }
 
   auto write_result = parquet::arrow::WriteTable(
-      *column, arrow::default_memory_pool(), ff,
-      std::numeric_limits<int64_t>::max(), StandardWriterProperties(),
+      *column, arrow::default_memory_pool(), frame,
+      RowGroupRows(*array->type()), StandardWriterProperties(),
       StandardArrowProperties());
 
   if (!write_result.ok()) {
@@ -81,24 +106,38 @@ DoStoreArrowArrayAtName(
     return tsuba::ErrorCode::ArrowError;
   }
 
-  ff->Bind(next_path.string());
-  TSUBA_PTP(tsuba::internal::FaultSensitivity::Normal);
-  desc->StartStore(std::move(ff));
+  *ff = std::move(frame);
   return next_path.BaseName();
 }
 
 katana::Result<std::string>
-StoreArrowArrayAtName(
+EncodeArrowArrayAtName(
     const std::shared_ptr<arrow::ChunkedArray>& array, const katana::Uri& dir,
-    const std::string& name, tsuba::WriteGroup* desc) {
+    const std::string& name, std::shared_ptr<tsuba::FileFrame>* ff) {
   try {
-    return DoStoreArrowArrayAtName(array, dir, name, desc);
+    return DoEncodeArrowArrayAtName(array, dir, name, ff);
   } catch (const std::exception& exp) {
     KATANA_LOG_DEBUG("arrow exception: {}", exp.what());
     return tsuba::ErrorCode::ArrowError;
   }
 }
 
+/// Store the arrow array as a table in a unique file, return
+/// the final name of that file
+katana::Result<std::string>
+StoreArrowArrayAtName(
+    const std::shared_ptr<arrow::ChunkedArray>& array, const katana::Uri& dir,
+    const std::string& name, tsuba::WriteGroup* desc) {
+  std::shared_ptr<tsuba::FileFrame> ff;
+  auto name_res = EncodeArrowArrayAtName(array, dir, name, &ff);
+  if (!name_res) {
+    return name_res.error();
+  }
+  TSUBA_PTP(tsuba::internal::FaultSensitivity::Normal);
+  desc->StartStore(std::move(ff));
+  return name_res;
+}
+
 std::string
 MirrorPropName(unsigned i) {
   return std::string(kMirrorNodesPropName) + "_" + std::to_string(i);
@@ -116,18 +155,48 @@ WriteTable(
     const katana::Uri& dir, tsuba::WriteGroup* desc) {
   const auto& schema = table.schema();
 
-  std::vector<std::string> next_paths;
+  std::vector<size_t> to_store;
   for (size_t i = 0, n = properties.size(); i < n; ++i) {
-    if (!properties[i].persist || !properties[i].path.empty()) {
-      continue;
+    if (properties[i].persist && properties[i].path.empty()) {
+      to_store.emplace_back(i);
     }
+  }
+
+  // Encode columns concurrently; memory stays bounded because each frame
+  // streams its parts to storage as it fills. A frame keeps its share of the
+  // write buffer until it is stored, so it is stored as soon as it is
+  // encoded: waiting for all columns would leave the frames encoded last
+  // waiting for buffer held by the ones encoded first.
+  std::vector<std::string> next_paths(to_store.size());
+  std::vector<std::error_code> errors(to_store.size());
+  std::mutex desc_mutex;
+  auto encode = [&](int k) -> arrow::Status {
+    size_t i = to_store[k];
     auto name = properties[i].name.empty() ? schema->field(i)->name()
                                            : properties[i].name;
-    auto name_res = StoreArrowArrayAtName(table.column(i), dir, name, desc);
+    std::shared_ptr<tsuba::FileFrame> ff;
+    auto name_res = EncodeArrowArrayAtName(table.column(i), dir, name, &ff);
     if (!name_res) {
-      return name_res.error();
+      errors[k] = name_res.error();
+      return arrow::Status::IOError(name_res.error().message());
+    }
+    next_paths[k] = std::move(name_res.value());
+
+    TSUBA_PTP(tsuba::internal::FaultSensitivity::Normal);
+    std::lock_guard<std::mutex> lock(desc_mutex);
+    desc->StartStore(std::move(ff));
+    return arrow::Status::OK();
+  };
+  if (auto status = arrow::internal::ParallelFor(
+          static_cast<int>(to_store.size()), encode);
+      !status.ok()) {
+    for (const auto& err : errors) {
+      if (err) {
+        return err;
+      }
     }
-    next_paths.emplace_back(name_res.value());
+    KATANA_LOG_DEBUG("arrow error: {}", status);
+    return tsuba::ErrorCode::ArrowError;
   }
   TSUBA_PTP(tsuba::internal::FaultSensitivity::Normal);
 
@@ -583,6 +652,22 @@ tsuba::RDG::set_part_metadata(const tsuba::PartitionMetadata& metadata) {
   core_->part_header().set_metadata(metadata);
 }
 
+const std::string&
+tsuba::RDG::graph_stats() const {
+  return core_->part_header().graph_stats();
+}
+
+katana::Result<void>
+tsuba::RDG::set_graph_stats(std::string graph_stats) {
+  // Checked here so that the document can be embedded in the part header
+  // when the RDG is stored
+  if (!graph_stats.empty() && !nlohmann::json::accept(graph_stats)) {
+    return katana::ErrorCode::JsonParseFailed;
+  }
+  core_->part_header().set_graph_stats(std::move(graph_stats));
+  return katana::ResultSuccess();
+}
+
 const std::shared_ptr<arrow::Table>&
 tsuba::RDG::node_table() const {
   return core_->node_table();
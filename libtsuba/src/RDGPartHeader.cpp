@@ -28,6 +28,7 @@ const char* kNodePropertyKey = "kg.v1.node_property";
 const char* kEdgePropertyKey = "kg.v1.edge_property";
 const char* kPartPropertyFilesKey = "kg.v1.part_property_files";
 const char* kPartProperyMetaKey = "kg.v1.part_property_meta";
+const char* kGraphStatsKey = "kg.v1.graph_stats";
 //
 //constexpr std::string_view  mirror_nodes_prop_name = "mirror_nodes";
 //constexpr std::string_view  master_nodes_prop_name = "master_nodes";
@@ -401,6 +402,10 @@ tsuba::to_json(json& j, const tsuba::RDGPartHeader& header) {
       {kPartPropertyFilesKey, header.part_prop_info_list_},
       {kPartProperyMetaKey, header.metadata_},
   };
+  // Older readers ignore the key and older headers do not have it
+  if (!header.graph_stats_.empty()) {
+    j[kGraphStatsKey] = json::parse(header.graph_stats_);
+  }
 }
 
 void
@@ -410,6 +415,9 @@ tsuba::from_json(const json& j, tsuba::RDGPartHeader& header) {
   j.at(kEdgePropertyKey).get_to(header.edge_prop_info_list_);
   j.at(kPartPropertyFilesKey).get_to(header.part_prop_info_list_);
   j.at(kPartProperyMetaKey).get_to(header.metadata_);
+  if (j.contains(kGraphStatsKey)) {
+    header.graph_stats_ = j.at(kGraphStatsKey).dump();
+  }
 }
 
 void
@@ -104,6 +104,11 @@ public:
   const PartitionMetadata& metadata() const { return metadata_; }
   void set_metadata(const PartitionMetadata& metadata) { metadata_ = metadata; }
 
+  const std::string& graph_stats() const { return graph_stats_; }
+  void set_graph_stats(std::string graph_stats) {
+    graph_stats_ = std::move(graph_stats);
+  }
+
   friend void to_json(nlohmann::json& j, const RDGPartHeader& header);
   friend void from_json(const nlohmann::json& j, RDGPartHeader& header);
 
@@ -121,6 +126,9 @@ private:
   PartitionMetadata metadata_;
 
   std::string topology_path_;
+
+  /// JSON document of statistics computed over the graph, or empty
+  std::string graph_stats_;
 };
 
 void to_json(nlohmann::json& j, const RDGPartHeader& header);
@@ -0,0 +1,189 @@
+#include <algorithm>
+#include <cstdint>
+#include <future>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <boost/filesystem.hpp>
+
+#include "CachedStorage.h"
+#include "katana/Logging.h"
+#include "katana/Result.h"
+#include "katana/Uri.h"
+#include "tsuba/Errors.h"
+#include "tsuba/file.h"
+
+namespace fs = boost::filesystem;
+
+namespace {
+
+/// In-memory storage that counts the reads that reach it
+class FakeStorage : public tsuba::FileStorage {
+public:
+  explicit FakeStorage(bool report_version)
+      : FileStorage("fake://"), report_version_(report_version) {}
+
+  /// Replace the contents of uri behind the back of any cache
+  void Rewrite(const std::string& uri, std::vector<uint8_t> data) {
+    files_[uri] = std::move(data);
+    versions_[uri] += 1;
+  }
+
+  uint64_t num_gets() const { return num_gets_; }
+
+  katana::Result<void> Init() override { return katana::ResultSuccess(); }
+  katana::Result<void> Fini() override { return katana::ResultSuccess(); }
+
+  katana::Result<void> Stat(
+      const std::string& uri, tsuba::StatBuf* s_buf) override {
+    auto it = files_.find(uri);
+    if (it == files_.end()) {
+      return tsuba::ErrorCode::NotFound;
+    }
+    s_buf->size = it->second.size();
+    s_buf->version =
+        report_version_ ? std::to_string(versions_.at(uri)) : std::string();
+    return katana::ResultSuccess();
+  }
+
+  katana::Result<void> GetMultiSync(
+      const std::string& uri, uint64_t start, uint64_t size,
+      uint8_t* result_buf) override {
+    ++num_gets_;
+    const std::vector<uint8_t>& data = files_.at(uri);
+    KATANA_LOG_ASSERT(start + size <= data.size());
+    std::copy(data.begin() + start, data.begin() + start + size, result_buf);
+    return katana::ResultSuccess();
+  }
+
+  katana::Result<void> PutMultiSync(
+      const std::string& uri, const uint8_t* data, uint64_t size) override {
+    Rewrite(uri, std::vector<uint8_t>(data, data + size));
+    return katana::ResultSuccess();
+  }
+
+  katana::Result<void> RemoteCopy(
+      const std::string&, const std::string&, uint64_t, uint64_t) override {
+    return tsuba::ErrorCode::NotImplemented;
+  }
+
+  std::future<katana::Result<void>> PutAsync(
+      const std::string& uri, const uint8_t* data, uint64_t size) override {
+    auto res = PutMultiSync(uri, data, size);
+    return std::async(std::launch::deferred, [=]() { return res; });
+  }
+
+  std::future<katana::Result<void>> GetAsync(
+      const std::string& uri, uint64_t start, uint64_t size,
+      uint8_t* result_buf) override {
+    auto res = GetMultiSync(uri, start, size, result_buf);
+    return std::async(std::launch::deferred, [=]() { return res; });
+  }
+
+  std::future<katana::Result<void>> ListAsync(
+      const std::string&, std::vector<std::string>*,
+      std::vector<uint64_t>*) override {
+    return std::async(std::launch::deferred, []() -> katana::Result<void> {
+      return tsuba::ErrorCode::NotImplemented;
+    });
+  }
+
+  katana::Result<void> Delete(
+      const std::string&, const std::unordered_set<std::string>&) override {
+    return tsuba::ErrorCode::NotImplemented;
+  }
+
+private:
+  bool report_version_;
+  uint64_t num_gets_{0};
+  std::map<std::string, std::vector<uint8_t>> files_;
+  std::map<std::string, uint64_t> versions_;
+};
+
+std::vector<uint8_t>
+MakeData(uint64_t size, uint8_t seed) {
+  std::vector<uint8_t> data(size);
+  for (uint64_t i = 0; i < size; ++i) {
+    data[i] = static_cast<uint8_t>(i * 31 + seed);
+  }
+  return data;
+}
+
+std::vector<uint8_t>
+Read(tsuba::CachedStorage* storage, const std::string& uri, uint64_t size) {
+  std::vector<uint8_t> buf(size);
+  KATANA_LOG_ASSERT(storage->GetMultiSync(uri, 0, size, buf.data()));
+  return buf;
+}
+
+void
+TestCache(bool report_version) {
+  auto uri_res = katana::Uri::MakeRand("/tmp/cachedstorage");
+  KATANA_LOG_ASSERT(uri_res);
+  std::string cache_dir = uri_res.value().path();
+
+  FakeStorage fake(report_version);
+  tsuba::CachedStorage storage(
+      &fake, tsuba::CachedStorage::Config{cache_dir, UINT64_C(64) << 20});
+  KATANA_LOG_ASSERT(storage.Init());
+
+  const std::string uri = "fake://bucket/file";
+  // Not a multiple of the block size, so the last block is partial
+  const uint64_t size = 3 * tsuba::CachedStorage::kCacheBlockSize + 12345;
+  fake.Rewrite(uri, MakeData(size, 0));
+
+  tsuba::StatBuf s_buf;
+  KATANA_LOG_ASSERT(storage.Stat(uri, &s_buf));
+  KATANA_LOG_ASSERT(s_buf.size == size);
+
+  // The first read misses and fetches all blocks with one request
+  uint64_t gets = fake.num_gets();
+  KATANA_LOG_ASSERT(Read(&storage, uri, size) == MakeData(size, 0));
+  KATANA_LOG_ASSERT(fake.num_gets() == gets + 1);
+
+  // Later reads, whole or partial, hit
+  KATANA_LOG_ASSERT(Read(&storage, uri, size) == MakeData(size, 0));
+  uint64_t start = tsuba::CachedStorage::kCacheBlockSize - 100;
+  std::vector<uint8_t> part(2 * tsuba::CachedStorage::kCacheBlockSize);
+  KATANA_LOG_ASSERT(
+      storage.GetMultiSync(uri, start, part.size(), part.data()));
+  std::vector<uint8_t> expected = MakeData(size, 0);
+  KATANA_LOG_ASSERT(std::equal(
+      part.begin(), part.end(), expected.begin() + start));
+  KATANA_LOG_ASSERT(fake.num_gets() == gets + 1);
+
+  // A rewrite of the same size is noticed by the next Stat and refetched
+  fake.Rewrite(uri, MakeData(size, 1));
+  KATANA_LOG_ASSERT(storage.Stat(uri, &s_buf));
+  gets = fake.num_gets();
+  KATANA_LOG_ASSERT(Read(&storage, uri, size) == MakeData(size, 1));
+  KATANA_LOG_ASSERT(fake.num_gets() == gets + 1);
+  KATANA_LOG_ASSERT(Read(&storage, uri, size) == MakeData(size, 1));
+  KATANA_LOG_ASSERT(fake.num_gets() == gets + 1);
+
+  // The cache outlives the storage object that filled it
+  KATANA_LOG_ASSERT(storage.Fini());
+  tsuba::CachedStorage reopened(
+      &fake, tsuba::CachedStorage::Config{cache_dir, UINT64_C(64) << 20});
+  KATANA_LOG_ASSERT(reopened.Init());
+  KATANA_LOG_ASSERT(reopened.Stat(uri, &s_buf));
+  gets = fake.num_gets();
+  KATANA_LOG_ASSERT(Read(&reopened, uri, size) == MakeData(size, 1));
+  KATANA_LOG_ASSERT(fake.num_gets() == gets);
+  KATANA_LOG_ASSERT(reopened.Fini());
+
+  fs::remove_all(cache_dir);
+}
+
+}  // namespace
+
+int
+main() {
+  TestCache(true);
+  // Without a version from the storage, the cache falls back on probing the
+  // contents of the file
+  TestCache(false);
+
+  return 0;
+}
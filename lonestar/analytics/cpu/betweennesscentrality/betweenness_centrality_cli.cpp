@@ -50,11 +50,26 @@ static cll::opt<BetweennessCentralityPlan::Algorithm> algo(
         // clEnumValN(BetweennessCentralityPlan::kAsynchronous, "Async", "Asynchronous"),
         clEnumValN(
             BetweennessCentralityPlan::kOuter, "Outer",
-            "Outer parallel algorithm")
+            "Outer parallel algorithm"),
+        clEnumValN(
+            BetweennessCentralityPlan::kSampling, "Sampling",
+            "Approximation by sampling shortest paths")
         // clEnumValN(BetweennessCentralityPlan::kAutoAlgo, "Auto", "Auto: choose among the algorithms automatically")
         ),
     cll::init(BetweennessCentralityPlan::kLevel));
 
+static cll::opt<float> epsilon(
+    "epsilon",
+    cll::desc("Error bound of the Sampling algorithm as a fraction of the "
+              "number of node pairs (default 0.01)"),
+    cll::init(0.01));
+
+static cll::opt<float> delta(
+    "delta",
+    cll::desc("Probability that the Sampling algorithm exceeds its error "
+              "bound (default 0.1)"),
+    cll::init(0.1));
+
 ////////////////////////////////////////////////////////////////////////////////
 
 static const char* name = "Betweenness Centrality";
@@ -77,7 +92,9 @@ main(int argc, char** argv) {
       MakeFileGraph(inputFile, edge_property_name);
 
   BetweennessCentralityPlan plan =
-      BetweennessCentralityPlan::FromAlgorithm(algo);
+      algo == BetweennessCentralityPlan::kSampling
+          ? BetweennessCentralityPlan::Sampling(epsilon, delta)
+          : BetweennessCentralityPlan::FromAlgorithm(algo);
 
   BetweennessCentralitySources sources = kBetweennessCentralityAllNodes;
 
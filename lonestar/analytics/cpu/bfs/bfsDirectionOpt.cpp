@@ -187,16 +187,10 @@ WlToBitset(WL& wl, katana::DynamicBitset& bitset) {
 
 template <typename WL>
 void
-BitsetToWl(const Graph& graph, const katana::DynamicBitset& bitset, WL& wl) {
+BitsetToWl(const katana::DynamicBitset& bitset, WL& wl) {
   wl.clear();
-  katana::do_all(
-      katana::iterate(graph),
-      [&](const GNode& src) {
-        if (bitset.test(src))
-          // pushWrap(wl, src);
-          wl.push(src);
-      },
-      katana::steal(), katana::chunk_size<CHUNK_SIZE>(),
+  bitset.for_each_set_bit(
+      [&](size_t src) { wl.push(static_cast<GNode>(src)); },
       katana::loopname("BitsetToWl"));
 }
 
@@ -296,7 +290,7 @@ syncDOAlgo(
       } while (work_items.reduce() >= old_workItemNum ||
                (work_items.reduce() > numNodes / beta));
 
-      BitsetToWl(graph, front_bitset, *next);
+      BitsetToWl(front_bitset, *next);
       scout_count = 1;
     } else {
       // c_push++;
@@ -46,14 +46,17 @@ static cll::opt<unsigned int> reportNode(
     cll::init(1));
 
 static cll::opt<BfsPlan::Algorithm> algo(
-    "algo", cll::desc("Choose an algorithm (default value SyncTile):"),
+    "algo", cll::desc("Choose an algorithm (default value Automatic):"),
     cll::values(
         clEnumValN(
             BfsPlan::kAsynchronousTile, "AsyncTile", "Asynchronous tiled"),
         clEnumValN(BfsPlan::kAsynchronous, "Async", "Asynchronous"),
         clEnumValN(BfsPlan::kSynchronousTile, "SyncTile", "Synchronous tiled"),
-        clEnumValN(BfsPlan::kSynchronous, "Sync", "Synchronous")),
-    cll::init(BfsPlan::kSynchronousTile));
+        clEnumValN(BfsPlan::kSynchronous, "Sync", "Synchronous"),
+        clEnumValN(
+            BfsPlan::kAutomatic, "Automatic",
+            "Automatic: choose among the algorithms automatically")),
+    cll::init(BfsPlan::kAutomatic));
 
 std::string
 AlgorithmName(BfsPlan::Algorithm algorithm) {
@@ -66,6 +69,8 @@ AlgorithmName(BfsPlan::Algorithm algorithm) {
     return "SyncTile";
   case BfsPlan::kSynchronous:
     return "Sync";
+  case BfsPlan::kAutomatic:
+    return "Automatic";
   default:
     return "Unknown";
   }
@@ -37,7 +37,7 @@ static cll::opt<unsigned int> reportNode(
     cll::init(1));
 
 static cll::opt<ConnectedComponentsPlan::Algorithm> algo(
-    "algo", cll::desc("Choose an algorithm (default value Afforest):"),
+    "algo", cll::desc("Choose an algorithm (default value Automatic):"),
     cll::values(
         clEnumValN(
             ConnectedComponentsPlan::kSerial, "Serial", "Serial algorithm"),
@@ -67,14 +67,17 @@ static cll::opt<ConnectedComponentsPlan::Algorithm> algo(
             "Afforest (edge-wise) sampling algorithm"),
         clEnumValN(
             ConnectedComponentsPlan::kEdgeTiledAfforest, "EdgeTiledAfforest",
-            "Afforest (tiled edge-wise) sampling algorithm")),
-    cll::init(ConnectedComponentsPlan::kAfforest));
+            "Afforest (tiled edge-wise) sampling algorithm"),
+        clEnumValN(
+            ConnectedComponentsPlan::kAutomatic, "Automatic",
+            "Automatic: choose among the algorithms automatically")),
+    cll::init(ConnectedComponentsPlan::kAutomatic));
 
 static cll::opt<uint32_t> edgeTileSize(
     "edgeTileSize",
-    cll::desc("(For Edgetiled algos) Size of edge tiles "
-              "(default 512)"),
-    cll::init(512));
+    cll::desc("(For Edgetiled algos) Size of edge tiles; 0 picks it from "
+              "the degree distribution (default 0)"),
+    cll::init(ConnectedComponentsPlan::kDefaultEdgeTileSize));
 //! parameter for the Vertex Neighbor Sampling step of Afforest algorithm
 static cll::opt<uint32_t> neighborSampleSize(
     "neighborSampleSize",
@@ -91,6 +94,12 @@ static cll::opt<uint32_t> componentSampleFrequency(
               "(default 1024)"),
     cll::init(1024));
 
+static cll::opt<bool> deterministic(
+    "deterministic",
+    cll::desc("Label each component with its smallest node id, so that "
+              "the output is the same on every run (default false)"),
+    cll::init(false));
+
 std::string
 AlgorithmName(ConnectedComponentsPlan::Algorithm algorithm) {
   switch (algorithm) {
@@ -114,6 +123,8 @@ AlgorithmName(ConnectedComponentsPlan::Algorithm algorithm) {
     return "EdgeAfforest";
   case ConnectedComponentsPlan::kEdgeTiledAfforest:
     return "EdgeTiledAfforest";
+  case ConnectedComponentsPlan::kAutomatic:
+    return "Automatic";
   default:
     return "Unknown";
   }
@@ -198,13 +209,20 @@ main(int argc, char** argv) {
         " component sample frequency: ", componentSampleFrequency);
     katana::gInfo("WARNING: Performance may vary due to the parameters");
     plan = ConnectedComponentsPlan::EdgeTiledAfforest(
-        neighborSampleSize, componentSampleFrequency);
+        edgeTileSize, neighborSampleSize, componentSampleFrequency);
+    break;
+  case ConnectedComponentsPlan::kAutomatic:
+    plan = ConnectedComponentsPlan::Automatic();
     break;
   default:
     std::cerr << "Invalid algorithm\n";
     abort();
   }
 
+  if (deterministic) {
+    plan = katana::analytics::Deterministic(plan);
+  }
+
   auto pg_result = ConnectedComponents(pfg.get(), "component", plan);
   if (!pg_result) {
     KATANA_LOG_FATAL(
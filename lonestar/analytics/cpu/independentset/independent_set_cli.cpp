@@ -63,6 +63,11 @@ cll::opt<IndependentSetPlan::Algorithm> algo(
             "edge-tiled prio algo based on Martin's GPU ECL-MIS algorithm")),
     cll::init(IndependentSetPlan::kPriority));
 
+cll::opt<bool> deterministic(
+    "deterministic",
+    cll::desc("Pick the same independent set on every run (default false)"),
+    cll::init(false));
+
 }  // namespace
 
 int
@@ -88,6 +93,9 @@ main(int argc, char** argv) {
             << " edges\n";
 
   IndependentSetPlan plan = IndependentSetPlan::FromAlgorithm(algo);
+  if (deterministic) {
+    plan = katana::analytics::Deterministic(plan);
+  }
 
   if (auto r = IndependentSet(pfg.get(), "indicator", plan); !r) {
     KATANA_LOG_FATAL("Failed to run algorithm: {}", r.error());
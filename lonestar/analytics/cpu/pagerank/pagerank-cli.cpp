@@ -47,8 +47,11 @@ static cll::opt<PagerankPlan::Algorithm> algo(
             "PullTopological"),
         clEnumValN(PagerankPlan::kPullResidual, "PullResidual", "PullResidual"),
         clEnumValN(PagerankPlan::kPushSynchronous, "PushSync", "PushSync"),
-        clEnumValN(PagerankPlan::kPushAsynchronous, "PushAsync", "PushAsync")),
-    cll::init(PagerankPlan::kPushAsynchronous));
+        clEnumValN(PagerankPlan::kPushAsynchronous, "PushAsync", "PushAsync"),
+        clEnumValN(
+            PagerankPlan::kAutomatic, "Automatic",
+            "Automatic: choose among the push algorithms automatically")),
+    cll::init(PagerankPlan::kAutomatic));
 
 //! Flag that forces user to be aware that they should be passing in a
 //! transposed graph.
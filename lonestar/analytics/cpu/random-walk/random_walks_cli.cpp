@@ -0,0 +1,158 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2018, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#include <fstream>
+#include <iostream>
+
+#include "Lonestar/BoilerPlate.h"
+#include "katana/analytics/random_walks/random_walks.h"
+
+using namespace katana::analytics;
+
+const char* name = "RandomWalks";
+const char* desc = "Find paths by random walks on the graph";
+
+namespace cll = llvm::cl;
+
+static cll::opt<std::string> inputFile(
+    cll::Positional, cll::desc("<input file>"), cll::Required);
+
+static cll::opt<std::string> outputFile(
+    "outputFile", cll::desc("File name to output walks (Default: walks.txt)"),
+    cll::init("walks.txt"));
+
+static cll::opt<RandomWalksPlan::Algorithm> algo(
+    "algo", cll::desc("Choose an algorithm:"),
+    cll::values(
+        clEnumValN(
+            RandomWalksPlan::kNode2vec, "Node2vec", "Node2vec random walks"),
+        clEnumValN(
+            RandomWalksPlan::kEdge2vec, "Edge2vec",
+            "Heterogeneous Edge2vec ")),
+    cll::init(RandomWalksPlan::kNode2vec));
+
+static cll::opt<uint32_t> maxIterations(
+    "maxIterations", cll::desc("Number of iterations for Edge2vec algorithm"),
+    cll::init(10));
+
+static cll::opt<uint32_t> walkLength(
+    "walkLength", cll::desc("Length of random walks (Default: 10)"),
+    cll::init(10));
+
+static cll::opt<double> probBack(
+    "probBack", cll::desc("Probability of moving back to parent"),
+    cll::init(1.0));
+
+static cll::opt<double> probForward(
+    "probForward", cll::desc("Probability of moving forward (2-hops)"),
+    cll::init(1.0));
+
+static cll::opt<uint32_t> numWalks(
+    "numWalks", cll::desc("Number of walks per node"), cll::init(1));
+
+static cll::opt<uint32_t> numEdgeTypes(
+    "numEdgeTypes", cll::desc("Number of edge types (only for Edge2Vec)"),
+    cll::init(1));
+
+static cll::opt<uint32_t> maxDegreeForEdgeTables(
+    "maxDegreeForEdgeTables",
+    cll::desc("Precompute Node2vec transition tables for the edges into nodes "
+              "of at most this degree (Default: 32)"),
+    cll::init(32));
+
+void
+PrintWalks(
+    const arrow::LargeListArray& walks, const std::string& output_file) {
+  std::ofstream f(output_file);
+  auto nodes = std::static_pointer_cast<arrow::UInt32Array>(walks.values());
+
+  for (int64_t w = 0; w < walks.length(); ++w) {
+    int64_t begin = walks.value_offset(w);
+    int64_t end = begin + walks.value_length(w);
+    for (int64_t i = begin; i < end; ++i) {
+      f << nodes->Value(i) << " ";
+    }
+    f << std::endl;
+  }
+}
+
+int
+main(int argc, char** argv) {
+  std::unique_ptr<katana::SharedMemSys> G =
+      LonestarStart(argc, argv, name, desc, nullptr, &inputFile);
+
+  katana::StatTimer totalTime("TimerTotal");
+  totalTime.start();
+
+  if (!symmetricGraph) {
+    KATANA_DIE(
+        "This application requires a symmetric graph input;"
+        " please use the -symmetricGraph flag "
+        " to indicate the input is a symmetric graph.");
+  }
+
+  katana::gInfo("Reading from file: ", inputFile, "\n");
+  std::unique_ptr<katana::PropertyFileGraph> pfg =
+      MakeFileGraph(inputFile, edge_property_name);
+
+  katana::gInfo(
+      "Read ", pfg->num_nodes(), " nodes, ", pfg->num_edges(), " edges\n");
+
+  RandomWalksPlan plan;
+  switch (algo) {
+  case RandomWalksPlan::kNode2vec:
+    plan = RandomWalksPlan::Node2vec(
+        walkLength, numWalks, probBack, probForward, maxDegreeForEdgeTables);
+    break;
+  case RandomWalksPlan::kEdge2vec:
+    plan = RandomWalksPlan::Edge2vec(
+        walkLength, numWalks, probBack, probForward, maxIterations,
+        numEdgeTypes);
+    break;
+  default:
+    KATANA_LOG_FATAL("Invalid algorithm");
+  }
+
+  // Walks are unweighted; for Edge2vec the edge property holds the edge types
+  katana::gInfo("Starting random walks...");
+  auto walks_result = RandomWalks(pfg.get(), "", edge_property_name, plan);
+  if (!walks_result) {
+    KATANA_LOG_FATAL(
+        "Failed to generate random walks: {}", walks_result.error());
+  }
+  auto walks = walks_result.value();
+
+  if (!skipVerify) {
+    if (RandomWalksAssertValid(pfg.get(), walks)) {
+      std::cout << "Verification successful.\n";
+    } else {
+      KATANA_LOG_FATAL("verification failed");
+    }
+  }
+
+  if (output) {
+    std::string output_file = outputLocation + "/" + outputFile;
+    katana::gInfo("Writing random walks to a file: ", output_file);
+    PrintWalks(*walks, output_file);
+  }
+
+  totalTime.stop();
+
+  return 0;
+}
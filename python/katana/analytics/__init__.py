@@ -3,19 +3,58 @@ from katana.analytics._betweenness_centrality import (
     BetweennessCentralityPlan,
     BetweennessCentralityStatistics,
 )
+from katana.analytics._clustering import (
+    clustering_assert_valid,
+    leiden_clustering,
+    louvain_clustering,
+    ClusteringStatistics,
+    LeidenClusteringPlan,
+    LouvainClusteringPlan,
+)
 from katana.analytics._connected_components import (
     connected_components,
     connected_components_assert_valid,
+    connected_components_incremental,
+    connected_components_segmented,
     ConnectedComponentsPlan,
     ConnectedComponentsStatistics,
 )
-from katana.analytics._k_core import k_core, k_core_assert_valid, KCorePlan, KCoreStatistics
+from katana.analytics._k_core import (
+    k_core,
+    k_core_assert_valid,
+    k_core_decomposition,
+    k_core_decomposition_assert_valid,
+    KCorePlan,
+    KCoreStatistics,
+)
 from katana.analytics._k_truss import k_truss, k_truss_assert_valid, KTrussPlan, KTrussStatistics
-from katana.analytics._pagerank import pagerank, pagerank_assert_valid, PagerankPlan, PagerankStatistics
-from katana.analytics._triangle_count import triangle_count, TriangleCountPlan
+from katana.analytics._pagerank import (
+    pagerank,
+    pagerank_assert_valid,
+    pagerank_incremental,
+    pagerank_multi_seed,
+    pagerank_personalized,
+    pagerank_personalized_weighted,
+    pagerank_segmented,
+    PagerankPlan,
+    PagerankStatistics,
+)
+from katana.analytics._random_walks import random_walks, random_walks_assert_valid, RandomWalksPlan
+from katana.analytics._triangle_count import (
+    triangle_count,
+    local_triangle_count,
+    TriangleCountPlan,
+)
 from katana.analytics._wrappers import bfs, bfs_assert_valid, BfsPlan, BfsStatistics
 from katana.analytics._wrappers import find_edge_sorted_by_dest, sort_all_edges_by_dest, sort_nodes_by_degree
-from katana.analytics._wrappers import jaccard, jaccard_assert_valid, JaccardPlan, JaccardStatistics
+from katana.analytics._wrappers import (
+    jaccard,
+    jaccard_all_edges,
+    jaccard_top_k,
+    jaccard_assert_valid,
+    JaccardPlan,
+    JaccardStatistics,
+)
 from katana.analytics._independent_set import (
     independent_set,
     independent_set_assert_valid,
@@ -1,6 +1,6 @@
 from libcpp.vector cimport vector
 from libcpp.string cimport string
-from libc.stdint cimport uint32_t
+from libc.stdint cimport uint32_t, uint64_t
 
 from katana.cpp.libstd.boost cimport handle_result_void, handle_result_assert, raise_error_code, std_result
 from katana.cpp.libstd.iostream cimport ostringstream, ostream
@@ -19,8 +19,11 @@ cdef extern from "katana/analytics/betweenness_centrality/betweenness_centrality
         enum Algorithm:
             kOuter "katana::analytics::BetweennessCentralityPlan::kOuter"
             kLevel "katana::analytics::BetweennessCentralityPlan::kLevel"
+            kSampling "katana::analytics::BetweennessCentralityPlan::kSampling"
 
         _BetweennessCentralityPlan.Algorithm algorithm() const
+        float epsilon() const
+        float delta() const
 
         BetweennessCentralityPlan()
 
@@ -29,6 +32,8 @@ cdef extern from "katana/analytics/betweenness_centrality/betweenness_centrality
         @staticmethod
         _BetweennessCentralityPlan Outer()
         @staticmethod
+        _BetweennessCentralityPlan Sampling(float epsilon, float delta)
+        @staticmethod
         _BetweennessCentralityPlan FromAlgorithm(_BetweennessCentralityPlan.Algorithm algo)
 
     BetweennessCentralitySources kBetweennessCentralityAllNodes;
@@ -41,6 +46,8 @@ cdef extern from "katana/analytics/betweenness_centrality/betweenness_centrality
         float max_centrality
         float min_centrality
         float average_centrality
+        float error_bound
+        uint64_t num_samples
 
         void Print(ostream os)
 
@@ -64,6 +71,7 @@ cdef extern from * nogil:
 class _BetweennessCentralityPlanAlgorithm(Enum):
     Outer = _BetweennessCentralityPlan.Algorithm.kOuter
     Level = _BetweennessCentralityPlan.Algorithm.kLevel
+    Sampling = _BetweennessCentralityPlan.Algorithm.kSampling
 
 
 cdef class BetweennessCentralityPlan(Plan):
@@ -85,6 +93,14 @@ cdef class BetweennessCentralityPlan(Plan):
     def algorithm(self) -> _BetweennessCentralityPlanAlgorithm:
         return _BetweennessCentralityPlanAlgorithm(self.underlying_.algorithm())
 
+    @property
+    def epsilon(self) -> float:
+        return self.underlying_.epsilon()
+
+    @property
+    def delta(self) -> float:
+        return self.underlying_.delta()
+
     @staticmethod
     def outer():
         return BetweennessCentralityPlan.make(_BetweennessCentralityPlan.Outer())
@@ -93,6 +109,14 @@ cdef class BetweennessCentralityPlan(Plan):
     def level():
         return BetweennessCentralityPlan.make(_BetweennessCentralityPlan.Level())
 
+    @staticmethod
+    def sampling(float epsilon = 0.01, float delta = 0.1):
+        """
+        Approximate the centrality by sampling shortest paths until, with probability 1 - delta, every node is within
+        epsilon * n * (n - 1) of its exact centrality.
+        """
+        return BetweennessCentralityPlan.make(_BetweennessCentralityPlan.Sampling(epsilon, delta))
+
 
 def betweenness_centrality(PropertyGraph pg, str output_property_name, sources = None,
              BetweennessCentralityPlan plan = BetweennessCentralityPlan()):
@@ -146,6 +170,14 @@ cdef class BetweennessCentralityStatistics:
     def average_centrality(self) -> float:
         return self.underlying.average_centrality
 
+    @property
+    def error_bound(self) -> float:
+        return self.underlying.error_bound
+
+    @property
+    def num_samples(self) -> int:
+        return self.underlying.num_samples
+
     def __str__(self) -> str:
         cdef ostringstream ss
         self.underlying.Print(ss)
@@ -0,0 +1,258 @@
+from libc.stdint cimport uint32_t, uint64_t
+from libcpp.string cimport string
+
+from katana.cpp.libstd.boost cimport handle_result_void, handle_result_assert, raise_error_code, std_result
+from katana.cpp.libstd.iostream cimport ostream, ostringstream
+from katana.cpp.libgalois.graphs.Graph cimport PropertyFileGraph
+from katana.analytics.plan cimport Plan, _Plan
+from katana.property_graph cimport PropertyGraph
+
+from enum import Enum
+
+
+cdef extern from "katana/analytics/clustering/clustering.h" namespace "katana::analytics" nogil:
+    cppclass _LouvainClusteringPlan "katana::analytics::LouvainClusteringPlan" (_Plan):
+        enum Algorithm:
+            kDoAll "katana::analytics::LouvainClusteringPlan::kDoAll"
+
+        _LouvainClusteringPlan.Algorithm algorithm() const
+        double modularity_threshold_per_round() const
+        double modularity_threshold_total() const
+        uint32_t max_iterations() const
+        uint32_t min_graph_size() const
+        double resolution() const
+
+        LouvainClusteringPlan()
+
+        @staticmethod
+        _LouvainClusteringPlan DoAll(
+            double modularity_threshold_per_round, double modularity_threshold_total, uint32_t max_iterations,
+            uint32_t min_graph_size, double resolution)
+
+    cppclass _LeidenClusteringPlan "katana::analytics::LeidenClusteringPlan" (_Plan):
+        enum Algorithm:
+            kDoAll "katana::analytics::LeidenClusteringPlan::kDoAll"
+
+        _LeidenClusteringPlan.Algorithm algorithm() const
+        double modularity_threshold_per_round() const
+        double modularity_threshold_total() const
+        uint32_t max_iterations() const
+        uint32_t min_graph_size() const
+        double resolution() const
+        double randomness() const
+
+        LeidenClusteringPlan()
+
+        @staticmethod
+        _LeidenClusteringPlan DoAll(
+            double modularity_threshold_per_round, double modularity_threshold_total, uint32_t max_iterations,
+            uint32_t min_graph_size, double resolution, double randomness)
+
+    std_result[void] LouvainClustering(PropertyFileGraph* pfg, string edge_weight_property_name, string output_property_name, _LouvainClusteringPlan plan)
+
+    std_result[void] LeidenClustering(PropertyFileGraph* pfg, string edge_weight_property_name, string output_property_name, _LeidenClusteringPlan plan)
+
+    std_result[void] ClusteringAssertValid(PropertyFileGraph* pfg, string property_name)
+
+    cppclass _ClusteringStatistics "katana::analytics::ClusteringStatistics":
+        uint64_t n_clusters
+        uint64_t n_non_trivial_clusters
+        uint64_t largest_cluster_size
+        double largest_cluster_proportion
+        double modularity
+
+        void Print(ostream os)
+
+        @staticmethod
+        std_result[_ClusteringStatistics] Compute(PropertyFileGraph* pfg, string edge_weight_property_name, string property_name)
+
+
+class _LouvainClusteringPlanAlgorithm(Enum):
+    DoAll = _LouvainClusteringPlan.Algorithm.kDoAll
+
+
+cdef class LouvainClusteringPlan(Plan):
+    cdef:
+        _LouvainClusteringPlan underlying_
+
+    cdef _Plan* underlying(self) except NULL:
+        return &self.underlying_
+
+    Algorithm = _LouvainClusteringPlanAlgorithm
+
+    @staticmethod
+    cdef LouvainClusteringPlan make(_LouvainClusteringPlan u):
+        f = <LouvainClusteringPlan>LouvainClusteringPlan.__new__(LouvainClusteringPlan)
+        f.underlying_ = u
+        return f
+
+    @property
+    def algorithm(self) -> LouvainClusteringPlan.Algorithm:
+        return self.underlying_.algorithm()
+
+    @property
+    def modularity_threshold_per_round(self) -> float:
+        return self.underlying_.modularity_threshold_per_round()
+
+    @property
+    def modularity_threshold_total(self) -> float:
+        return self.underlying_.modularity_threshold_total()
+
+    @property
+    def max_iterations(self) -> int:
+        return self.underlying_.max_iterations()
+
+    @property
+    def min_graph_size(self) -> int:
+        return self.underlying_.min_graph_size()
+
+    @property
+    def resolution(self) -> float:
+        return self.underlying_.resolution()
+
+    @staticmethod
+    def do_all(
+        double modularity_threshold_per_round = 0.01, double modularity_threshold_total = 0.01,
+        uint32_t max_iterations = 10, uint32_t min_graph_size = 100, double resolution = 1.0
+    ) -> LouvainClusteringPlan:
+        return LouvainClusteringPlan.make(_LouvainClusteringPlan.DoAll(
+            modularity_threshold_per_round, modularity_threshold_total, max_iterations, min_graph_size, resolution))
+
+
+class _LeidenClusteringPlanAlgorithm(Enum):
+    DoAll = _LeidenClusteringPlan.Algorithm.kDoAll
+
+
+cdef class LeidenClusteringPlan(Plan):
+    cdef:
+        _LeidenClusteringPlan underlying_
+
+    cdef _Plan* underlying(self) except NULL:
+        return &self.underlying_
+
+    Algorithm = _LeidenClusteringPlanAlgorithm
+
+    @staticmethod
+    cdef LeidenClusteringPlan make(_LeidenClusteringPlan u):
+        f = <LeidenClusteringPlan>LeidenClusteringPlan.__new__(LeidenClusteringPlan)
+        f.underlying_ = u
+        return f
+
+    @property
+    def algorithm(self) -> LeidenClusteringPlan.Algorithm:
+        return self.underlying_.algorithm()
+
+    @property
+    def modularity_threshold_per_round(self) -> float:
+        return self.underlying_.modularity_threshold_per_round()
+
+    @property
+    def modularity_threshold_total(self) -> float:
+        return self.underlying_.modularity_threshold_total()
+
+    @property
+    def max_iterations(self) -> int:
+        return self.underlying_.max_iterations()
+
+    @property
+    def min_graph_size(self) -> int:
+        return self.underlying_.min_graph_size()
+
+    @property
+    def resolution(self) -> float:
+        return self.underlying_.resolution()
+
+    @property
+    def randomness(self) -> float:
+        return self.underlying_.randomness()
+
+    @staticmethod
+    def do_all(
+        double modularity_threshold_per_round = 0.01, double modularity_threshold_total = 0.01,
+        uint32_t max_iterations = 10, uint32_t min_graph_size = 100, double resolution = 1.0,
+        double randomness = 0.01
+    ) -> LeidenClusteringPlan:
+        return LeidenClusteringPlan.make(_LeidenClusteringPlan.DoAll(
+            modularity_threshold_per_round, modularity_threshold_total, max_iterations, min_graph_size, resolution,
+            randomness))
+
+
+def louvain_clustering(
+    PropertyGraph pg, str edge_weight_property_name, str output_property_name,
+    LouvainClusteringPlan plan = LouvainClusteringPlan()
+) -> int:
+    """
+    Cluster the nodes of pg into communities with the Louvain method. pg must be symmetric. If
+    edge_weight_property_name is empty every edge has weight 1.
+    """
+    cdef string edge_weight_property_name_str = edge_weight_property_name.encode("utf-8")
+    cdef string output_property_name_str = output_property_name.encode("utf-8")
+    with nogil:
+        v = handle_result_void(LouvainClustering(
+            pg.underlying.get(), edge_weight_property_name_str, output_property_name_str, plan.underlying_))
+    return v
+
+
+def leiden_clustering(
+    PropertyGraph pg, str edge_weight_property_name, str output_property_name,
+    LeidenClusteringPlan plan = LeidenClusteringPlan()
+) -> int:
+    """
+    Cluster the nodes of pg into well-connected communities with the Leiden method. The arguments are as for
+    louvain_clustering.
+    """
+    cdef string edge_weight_property_name_str = edge_weight_property_name.encode("utf-8")
+    cdef string output_property_name_str = output_property_name.encode("utf-8")
+    with nogil:
+        v = handle_result_void(LeidenClustering(
+            pg.underlying.get(), edge_weight_property_name_str, output_property_name_str, plan.underlying_))
+    return v
+
+
+def clustering_assert_valid(PropertyGraph pg, str property_name):
+    cdef string property_name_str = property_name.encode("utf-8")
+    with nogil:
+        handle_result_assert(ClusteringAssertValid(pg.underlying.get(), property_name_str))
+
+
+cdef _ClusteringStatistics handle_result_ClusteringStatistics(std_result[_ClusteringStatistics] res) nogil except *:
+    if not res.has_value():
+        with gil:
+            raise_error_code(res.error())
+    return res.value()
+
+
+cdef class ClusteringStatistics:
+    cdef _ClusteringStatistics underlying
+
+    def __init__(self, PropertyGraph pg, str edge_weight_property_name, str property_name):
+        cdef string edge_weight_property_name_str = edge_weight_property_name.encode("utf-8")
+        cdef string property_name_str = property_name.encode("utf-8")
+        with nogil:
+            self.underlying = handle_result_ClusteringStatistics(_ClusteringStatistics.Compute(
+                pg.underlying.get(), edge_weight_property_name_str, property_name_str))
+
+    @property
+    def n_clusters(self) -> uint64_t:
+        return self.underlying.n_clusters
+
+    @property
+    def n_non_trivial_clusters(self) -> uint64_t:
+        return self.underlying.n_non_trivial_clusters
+
+    @property
+    def largest_cluster_size(self) -> uint64_t:
+        return self.underlying.largest_cluster_size
+
+    @property
+    def largest_cluster_proportion(self) -> float:
+        return self.underlying.largest_cluster_proportion
+
+    @property
+    def modularity(self) -> float:
+        return self.underlying.modularity
+
+    def __str__(self) -> str:
+        cdef ostringstream ss
+        self.underlying.Print(ss)
+        return str(ss.str(), "ascii")
@@ -1,6 +1,11 @@
 from libc.stddef cimport ptrdiff_t
 from libc.stdint cimport uint32_t, uint64_t
+from libcpp.memory cimport shared_ptr, static_pointer_cast
+from libcpp.pair cimport pair
 from libcpp.string cimport string
+from libcpp.vector cimport vector
+
+from pyarrow.lib cimport CArray, CUInt64Array, pyarrow_wrap_array
 
 from katana.analytics.plan cimport Plan, _Plan
 from katana.cpp.libgalois.graphs.Graph cimport PropertyFileGraph
@@ -24,6 +29,7 @@ cdef extern from "katana/analytics/connected_components/connected_components.h"
             kAfforest "katana::analytics::ConnectedComponentsPlan::kAfforest"
             kEdgeAfforest "katana::analytics::ConnectedComponentsPlan::kEdgeAfforest"
             kEdgeTiledAfforest "katana::analytics::ConnectedComponentsPlan::kEdgeTiledAfforest"
+            kAutomatic "katana::analytics::ConnectedComponentsPlan::kAutomatic"
 
         _ConnectedComponentsPlan.Algorithm algorithm() const
         ptrdiff_t edge_tile_size() const
@@ -63,13 +69,24 @@ cdef extern from "katana/analytics/connected_components/connected_components.h"
         _ConnectedComponentsPlan EdgeTiledAfforest(ptrdiff_t edge_tile_size, uint32_t neighbor_sample_size,
                                                    uint32_t component_sample_frequency)
 
+        @staticmethod
+        _ConnectedComponentsPlan Automatic()
+
     ptrdiff_t kDefaultEdgeTileSize "katana::analytics::ConnectedComponentsPlan::kDefaultEdgeTileSize"
     uint32_t kDefaultNeighborSampleSize "katana::analytics::ConnectedComponentsPlan::kDefaultNeighborSampleSize"
     uint32_t kDefaultComponentSampleFrequency "katana::analytics::ConnectedComponentsPlan::kDefaultComponentSampleFrequency"
 
+    _ConnectedComponentsPlan DeterministicConnectedComponentsPlan "katana::analytics::Deterministic"(
+        _ConnectedComponentsPlan plan)
+
     std_result[void] ConnectedComponents(PropertyFileGraph*pfg, string output_property_name,
                                          _ConnectedComponentsPlan plan)
 
+    std_result[void] ConnectedComponentsIncremental(PropertyFileGraph*pfg, string property_name,
+                                                    const vector[pair[uint32_t, uint32_t]]& edge_batch)
+
+    std_result[shared_ptr[CUInt64Array]] ConnectedComponentsSegmented(string rdg_name, uint64_t segment_bytes)
+
     std_result[void] ConnectedComponentsAssertValid(PropertyFileGraph*pfg, string output_property_name)
 
     cppclass _ConnectedComponentsStatistics "katana::analytics::ConnectedComponentsStatistics":
@@ -95,6 +112,7 @@ class _ConnectedComponentsPlanAlgorithm(Enum):
     Afforest = _ConnectedComponentsPlan.Algorithm.kAfforest
     EdgeAfforest = _ConnectedComponentsPlan.Algorithm.kEdgeAfforest
     EdgeTiledAfforest = _ConnectedComponentsPlan.Algorithm.kEdgeTiledAfforest
+    Automatic = _ConnectedComponentsPlan.Algorithm.kAutomatic
 
 
 cdef class ConnectedComponentsPlan(Plan):
@@ -114,7 +132,7 @@ cdef class ConnectedComponentsPlan(Plan):
 
     @property
     def algorithm(self) -> _ConnectedComponentsPlanAlgorithm:
-        return self.underlying_.algorithm()
+        return _ConnectedComponentsPlanAlgorithm(self.underlying_.algorithm())
 
     @property
     def edge_tile_size(self) -> ptrdiff_t:
@@ -128,6 +146,12 @@ cdef class ConnectedComponentsPlan(Plan):
     def component_sample_frequency(self) -> uint32_t:
         return self.underlying_.component_sample_frequency()
 
+    def as_deterministic(self) -> ConnectedComponentsPlan:
+        """
+        A copy of this plan that labels each component with the smallest node id in it.
+        """
+        return ConnectedComponentsPlan.make(DeterministicConnectedComponentsPlan(self.underlying_))
+
     @staticmethod
     def serial() -> ConnectedComponentsPlan:
         return ConnectedComponentsPlan.make(_ConnectedComponentsPlan.Serial())
@@ -165,6 +189,12 @@ cdef class ConnectedComponentsPlan(Plan):
                             uint32_t component_sample_frequency = kDefaultComponentSampleFrequency) -> ConnectedComponentsPlan:
         return ConnectedComponentsPlan.make(_ConnectedComponentsPlan.EdgeTiledAfforest(
             edge_tile_size, neighbor_sample_size, component_sample_frequency))
+    @staticmethod
+    def automatic() -> ConnectedComponentsPlan:
+        """
+        Choose the algorithm from the degrees of the graph and the number of threads when it runs.
+        """
+        return ConnectedComponentsPlan.make(_ConnectedComponentsPlan.Automatic())
 
 def connected_components(PropertyGraph pg, str output_property_name,
                          ConnectedComponentsPlan plan = ConnectedComponentsPlan()) -> int:
@@ -173,6 +203,33 @@ def connected_components(PropertyGraph pg, str output_property_name,
         v = handle_result_void(ConnectedComponents(pg.underlying.get(), output_property_name_str, plan.underlying_))
     return v
 
+def connected_components_incremental(PropertyGraph pg, str property_name, edge_batch):
+    """
+    Update the components in property_name to account for edge_batch, a list of (source, destination) pairs.
+    """
+    cdef string property_name_str = property_name.encode("utf-8")
+    cdef vector[pair[uint32_t, uint32_t]] c_edge_batch = edge_batch
+    with nogil:
+        handle_result_void(ConnectedComponentsIncremental(pg.underlying.get(), property_name_str, c_edge_batch))
+
+cdef shared_ptr[CUInt64Array] handle_result_components(std_result[shared_ptr[CUInt64Array]] res) nogil except *:
+    if not res.has_value():
+        with gil:
+            raise_error_code(res.error())
+    return res.value()
+
+def connected_components_segmented(str rdg_name, uint64_t segment_bytes = 1 << 30):
+    """
+    Compute the components of the graph stored at rdg_name without loading its edges into memory, streaming them in
+    segments of at most segment_bytes. Returns a pyarrow uint64 array with the smallest node id of the component of each
+    node.
+    """
+    cdef string rdg_name_str = rdg_name.encode("utf-8")
+    cdef shared_ptr[CUInt64Array] res
+    with nogil:
+        res = handle_result_components(ConnectedComponentsSegmented(rdg_name_str, segment_bytes))
+    return pyarrow_wrap_array(static_pointer_cast[CArray, CUInt64Array](res))
+
 def connected_components_assert_valid(PropertyGraph pg, str output_property_name):
     cdef string output_property_name_str = output_property_name.encode("utf-8")
     with nogil:
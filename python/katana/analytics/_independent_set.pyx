@@ -36,6 +36,8 @@ cdef extern from "katana/analytics/independent_set/independent_set.h" namespace
         @staticmethod
         _IndependentSetPlan EdgeTiledPriority()
 
+    _IndependentSetPlan DeterministicIndependentSetPlan "katana::analytics::Deterministic"(_IndependentSetPlan plan)
+
     std_result[void] IndependentSet(PropertyFileGraph* pfg, string output_property_name, _IndependentSetPlan plan)
 
     std_result[void] IndependentSetAssertValid(PropertyFileGraph* pfg, string output_property_name)
@@ -75,6 +77,12 @@ cdef class IndependentSetPlan(Plan):
     def algorithm(self) -> _IndependentSetPlanAlgorithm:
         return _IndependentSetPlanAlgorithm(self.underlying_.algorithm())
 
+    def as_deterministic(self):
+        """
+        A copy of this plan that picks the same independent set on every run.
+        """
+        return IndependentSetPlan.make(DeterministicIndependentSetPlan(self.underlying_))
+
     @staticmethod
     def serial():
         return IndependentSetPlan.make(_IndependentSetPlan.Serial())
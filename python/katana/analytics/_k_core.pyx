@@ -1,5 +1,6 @@
 from libc.stdint cimport uint32_t, uint64_t
 from libcpp.string cimport string
+from libcpp.vector cimport vector
 
 from katana.cpp.libstd.boost cimport handle_result_void, handle_result_assert, raise_error_code, std_result
 from katana.cpp.libstd.iostream cimport ostream, ostringstream
@@ -30,14 +31,22 @@ cdef extern from "katana/analytics/k_core/k_core.h" namespace "katana::analytics
 
     std_result[void] KCoreAssertValid(PropertyFileGraph* pfg, uint32_t k_core_number, string output_property_name)
 
+    std_result[void] KCoreDecomposition(PropertyFileGraph* pfg, string output_property_name)
+
+    std_result[void] KCoreDecompositionAssertValid(PropertyFileGraph* pfg, string output_property_name)
+
     cppclass _KCoreStatistics "katana::analytics::KCoreStatistics":
         uint64_t number_of_nodes_in_kcore
+        vector[uint64_t] core_number_histogram
 
         void Print(ostream os)
 
         @staticmethod
         std_result[_KCoreStatistics] Compute(PropertyFileGraph* pfg, uint32_t k_core_number, string output_property_name)
 
+        @staticmethod
+        std_result[_KCoreStatistics] Compute(PropertyFileGraph* pfg, string output_property_name)
+
 
 class _KCorePlanAlgorithm(Enum):
     Synchronous = _KCorePlan.Algorithm.kSynchronous
@@ -84,6 +93,23 @@ def k_core_assert_valid(PropertyGraph pg, uint32_t k_core_number, str output_pro
         handle_result_assert(KCoreAssertValid(pg.underlying.get(), k_core_number, output_property_name_str))
 
 
+def k_core_decomposition(PropertyGraph pg, str output_property_name) -> int:
+    """
+    Compute the core number of every node of pg into output_property_name.
+    pg must be symmetric.
+    """
+    cdef string output_property_name_str = output_property_name.encode("utf-8")
+    with nogil:
+        v = handle_result_void(KCoreDecomposition(pg.underlying.get(), output_property_name_str))
+    return v
+
+
+def k_core_decomposition_assert_valid(PropertyGraph pg, str output_property_name):
+    cdef string output_property_name_str = output_property_name.encode("utf-8")
+    with nogil:
+        handle_result_assert(KCoreDecompositionAssertValid(pg.underlying.get(), output_property_name_str))
+
+
 cdef _KCoreStatistics handle_result_KCoreStatistics(std_result[_KCoreStatistics] res) nogil except *:
     if not res.has_value():
         with gil:
@@ -100,10 +126,26 @@ cdef class KCoreStatistics:
             self.underlying = handle_result_KCoreStatistics(_KCoreStatistics.Compute(
                 pg.underlying.get(), k_core_number, output_property_name_str))
 
+    @staticmethod
+    def decomposition(PropertyGraph pg, str output_property_name) -> KCoreStatistics:
+        """
+        Statistics of the core numbers computed by k_core_decomposition.
+        """
+        cdef string output_property_name_str = output_property_name.encode("utf-8")
+        cdef KCoreStatistics stats = KCoreStatistics.__new__(KCoreStatistics)
+        with nogil:
+            stats.underlying = handle_result_KCoreStatistics(_KCoreStatistics.Compute(
+                pg.underlying.get(), output_property_name_str))
+        return stats
+
     @property
     def number_of_nodes_in_kcore(self) -> uint64_t:
         return self.underlying.number_of_nodes_in_kcore
 
+    @property
+    def core_number_histogram(self):
+        return self.underlying.core_number_histogram
+
     def __str__(self) -> str:
         cdef ostringstream ss
         self.underlying.Print(ss)
@@ -1,4 +1,10 @@
+from libc.stdint cimport uint32_t, uint64_t
+from libcpp.memory cimport shared_ptr, static_pointer_cast
+from libcpp.pair cimport pair
 from libcpp.string cimport string
+from libcpp.vector cimport vector
+
+from pyarrow.lib cimport CArray, CFloatArray, pyarrow_wrap_array
 
 from katana.cpp.libstd.boost cimport handle_result_void, handle_result_assert, raise_error_code, std_result
 from katana.cpp.libstd.iostream cimport ostringstream, ostream
@@ -16,6 +22,8 @@ cdef extern from "katana/analytics/pagerank/pagerank.h" namespace "katana::analy
             kPullResidual "katana::analytics::PagerankPlan::kPullResidual"
             kPushSynchronous "katana::analytics::PagerankPlan::kPushSynchronous"
             kPushAsynchronous "katana::analytics::PagerankPlan::kPushAsynchronous"
+            kPushLocal "katana::analytics::PagerankPlan::kPushLocal"
+            kAutomatic "katana::analytics::PagerankPlan::kAutomatic"
 
         # unsigned int kChunkSize
 
@@ -35,9 +43,27 @@ cdef extern from "katana/analytics/pagerank/pagerank.h" namespace "katana::analy
         _PagerankPlan PushAsynchronous(float tolerance, float alpha)
         @staticmethod
         _PagerankPlan PushSynchronous(float tolerance, unsigned int max_iterations, float alpha)
+        @staticmethod
+        _PagerankPlan PushLocal(float tolerance, float alpha)
+        @staticmethod
+        _PagerankPlan Automatic(float tolerance, unsigned int max_iterations, float alpha)
 
     std_result[void] Pagerank(PropertyFileGraph* pfg, string output_property_name, _PagerankPlan plan)
 
+    std_result[void] PagerankIncremental(PropertyFileGraph* pfg, string property_name,
+                                         const vector[pair[uint32_t, uint32_t]]& edge_batch, _PagerankPlan plan)
+
+    std_result[void] PagerankPersonalized(PropertyFileGraph* pfg, const vector[uint32_t]& seeds,
+                                          string output_property_name, _PagerankPlan plan)
+
+    std_result[void] PagerankPersonalizedWeighted(PropertyFileGraph* pfg, string seed_weight_property_name,
+                                                  string output_property_name, _PagerankPlan plan)
+
+    std_result[void] PagerankMultiSeed(PropertyFileGraph* pfg, const vector[uint32_t]& seeds,
+                                       const vector[string]& output_property_names, _PagerankPlan plan)
+
+    std_result[shared_ptr[CFloatArray]] PagerankSegmented(string rdg_name, _PagerankPlan plan, uint64_t segment_bytes)
+
     std_result[void] PagerankAssertValid(PropertyFileGraph* pfg, string output_property_name)
 
     cppclass _PagerankStatistics "katana::analytics::PagerankStatistics":
@@ -56,6 +82,8 @@ class _PagerankPlanAlgorithm(Enum):
     PullResidual = _PagerankPlan.Algorithm.kPullResidual
     PushSynchronous = _PagerankPlan.Algorithm.kPushSynchronous
     PushAsynchronous = _PagerankPlan.Algorithm.kPushAsynchronous
+    PushLocal = _PagerankPlan.Algorithm.kPushLocal
+    Automatic = _PagerankPlan.Algorithm.kAutomatic
 
 
 cdef class PagerankPlan(Plan):
@@ -109,6 +137,20 @@ cdef class PagerankPlan(Plan):
     def push_synchronous(float tolerance, unsigned int max_iterations, float alpha):
         return PagerankPlan.make(_PagerankPlan.PushSynchronous(tolerance, max_iterations, alpha))
 
+    @staticmethod
+    def push_local(float tolerance = 1.0e-6, float alpha = 0.85):
+        """
+        Local push for personalized pagerank, which only does work around the seeds.
+        """
+        return PagerankPlan.make(_PagerankPlan.PushLocal(tolerance, alpha))
+
+    @staticmethod
+    def automatic(float tolerance = 1.0e-3, unsigned int max_iterations = 1000, float alpha = 0.85):
+        """
+        Choose a push algorithm from the degrees and diameter of the graph when it runs.
+        """
+        return PagerankPlan.make(_PagerankPlan.Automatic(tolerance, max_iterations, alpha))
+
 
 def pagerank(PropertyGraph pg, str output_property_name,
              PagerankPlan plan = PagerankPlan()):
@@ -118,6 +160,78 @@ def pagerank(PropertyGraph pg, str output_property_name,
         handle_result_void(Pagerank(pg.underlying.get(), output_property_name_cstr, plan.underlying_))
 
 
+def pagerank_incremental(PropertyGraph pg, str property_name, edge_batch,
+                         PagerankPlan plan = PagerankPlan()):
+    """
+    Update the ranks in property_name to account for edge_batch, a list of (source, destination) pairs which are
+    already edges of pg.
+    """
+    property_name_bytes = bytes(property_name, "utf-8")
+    property_name_cstr = <string>property_name_bytes
+    cdef vector[pair[uint32_t, uint32_t]] c_edge_batch = edge_batch
+    with nogil:
+        handle_result_void(PagerankIncremental(pg.underlying.get(), property_name_cstr, c_edge_batch, plan.underlying_))
+
+
+def pagerank_personalized(PropertyGraph pg, seeds, str output_property_name,
+                          PagerankPlan plan = PagerankPlan()):
+    """
+    Compute the pagerank of each node personalized to seeds, a list of node ids to which the random surfer teleports.
+    """
+    output_property_name_bytes = bytes(output_property_name, "utf-8")
+    output_property_name_cstr = <string>output_property_name_bytes
+    cdef vector[uint32_t] c_seeds = seeds
+    with nogil:
+        handle_result_void(PagerankPersonalized(pg.underlying.get(), c_seeds, output_property_name_cstr,
+                                                plan.underlying_))
+
+
+def pagerank_personalized_weighted(PropertyGraph pg, str seed_weight_property_name, str output_property_name,
+                                   PagerankPlan plan = PagerankPlan()):
+    """
+    Compute the pagerank of each node personalized to the non-negative float weights in seed_weight_property_name.
+    """
+    seed_weight_property_name_bytes = bytes(seed_weight_property_name, "utf-8")
+    seed_weight_property_name_cstr = <string>seed_weight_property_name_bytes
+    output_property_name_bytes = bytes(output_property_name, "utf-8")
+    output_property_name_cstr = <string>output_property_name_bytes
+    with nogil:
+        handle_result_void(PagerankPersonalizedWeighted(pg.underlying.get(), seed_weight_property_name_cstr,
+                                                        output_property_name_cstr, plan.underlying_))
+
+
+def pagerank_multi_seed(PropertyGraph pg, seeds, output_property_names, PagerankPlan plan = PagerankPlan()):
+    """
+    Compute the pagerank personalized to each of seeds in one pass, storing the ranks for seeds[i] in
+    output_property_names[i].
+    """
+    cdef vector[uint32_t] c_seeds = seeds
+    cdef vector[string] c_output_property_names = [bytes(name, "utf-8") for name in output_property_names]
+    with nogil:
+        handle_result_void(PagerankMultiSeed(pg.underlying.get(), c_seeds, c_output_property_names,
+                                             plan.underlying_))
+
+
+cdef shared_ptr[CFloatArray] handle_result_ranks(std_result[shared_ptr[CFloatArray]] res) nogil except *:
+    if not res.has_value():
+        with gil:
+            raise_error_code(res.error())
+    return res.value()
+
+
+def pagerank_segmented(str rdg_name, PagerankPlan plan = PagerankPlan.push_synchronous(1.0e-3, 1000, 0.85),
+                       uint64_t segment_bytes = 1 << 30):
+    """
+    Compute the Page Rank of the graph stored at rdg_name without loading its edges into memory, streaming them in
+    segments of at most segment_bytes. Returns a pyarrow float array with the rank of each node.
+    """
+    cdef string rdg_name_str = rdg_name.encode("utf-8")
+    cdef shared_ptr[CFloatArray] res
+    with nogil:
+        res = handle_result_ranks(PagerankSegmented(rdg_name_str, plan.underlying_, segment_bytes))
+    return pyarrow_wrap_array(static_pointer_cast[CArray, CFloatArray](res))
+
+
 def pagerank_assert_valid(PropertyGraph pg, str output_property_name):
     output_property_name_bytes = bytes(output_property_name, "utf-8")
     output_property_name_cstr = <string>output_property_name_bytes
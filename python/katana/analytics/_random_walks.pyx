@@ -0,0 +1,149 @@
+from libc.stdint cimport uint32_t
+from libcpp.memory cimport shared_ptr, static_pointer_cast
+from libcpp.string cimport string
+
+from pyarrow.lib cimport CArray, CLargeListArray, pyarrow_unwrap_array, pyarrow_wrap_array
+
+from katana.cpp.libstd.boost cimport handle_result_assert, raise_error_code, std_result
+from katana.cpp.libgalois.graphs.Graph cimport PropertyFileGraph
+from katana.analytics.plan cimport Plan, _Plan
+from katana.property_graph cimport PropertyGraph
+
+from enum import Enum
+
+
+cdef extern from "katana/analytics/random_walks/random_walks.h" namespace "katana::analytics" nogil:
+    cppclass _RandomWalksPlan "katana::analytics::RandomWalksPlan" (_Plan):
+        enum Algorithm:
+            kNode2vec "katana::analytics::RandomWalksPlan::kNode2vec"
+            kEdge2vec "katana::analytics::RandomWalksPlan::kEdge2vec"
+
+        _RandomWalksPlan.Algorithm algorithm() const
+        uint32_t walk_length() const
+        uint32_t number_of_walks() const
+        double backward_probability() const
+        double forward_probability() const
+        uint32_t max_iterations() const
+        uint32_t number_of_edge_types() const
+        uint32_t max_degree_for_edge_tables() const
+
+        RandomWalksPlan()
+
+        @staticmethod
+        _RandomWalksPlan Node2vec(
+            uint32_t walk_length, uint32_t number_of_walks, double backward_probability, double forward_probability,
+            uint32_t max_degree_for_edge_tables)
+        @staticmethod
+        _RandomWalksPlan Edge2vec(
+            uint32_t walk_length, uint32_t number_of_walks, double backward_probability, double forward_probability,
+            uint32_t max_iterations, uint32_t number_of_edge_types)
+
+    std_result[shared_ptr[CLargeListArray]] RandomWalks(
+        PropertyFileGraph* pfg, string edge_weight_property_name, string edge_type_property_name,
+        _RandomWalksPlan plan)
+
+    std_result[void] RandomWalksAssertValid(PropertyFileGraph* pfg, shared_ptr[CLargeListArray] walks)
+
+
+class _RandomWalksPlanAlgorithm(Enum):
+    Node2vec = _RandomWalksPlan.Algorithm.kNode2vec
+    Edge2vec = _RandomWalksPlan.Algorithm.kEdge2vec
+
+
+cdef class RandomWalksPlan(Plan):
+    cdef:
+        _RandomWalksPlan underlying_
+
+    cdef _Plan* underlying(self) except NULL:
+        return &self.underlying_
+
+    Algorithm = _RandomWalksPlanAlgorithm
+
+    @staticmethod
+    cdef RandomWalksPlan make(_RandomWalksPlan u):
+        f = <RandomWalksPlan>RandomWalksPlan.__new__(RandomWalksPlan)
+        f.underlying_ = u
+        return f
+
+    @property
+    def algorithm(self) -> RandomWalksPlan.Algorithm:
+        return self.underlying_.algorithm()
+
+    @property
+    def walk_length(self) -> int:
+        return self.underlying_.walk_length()
+
+    @property
+    def number_of_walks(self) -> int:
+        return self.underlying_.number_of_walks()
+
+    @property
+    def backward_probability(self) -> float:
+        return self.underlying_.backward_probability()
+
+    @property
+    def forward_probability(self) -> float:
+        return self.underlying_.forward_probability()
+
+    @property
+    def max_iterations(self) -> int:
+        return self.underlying_.max_iterations()
+
+    @property
+    def number_of_edge_types(self) -> int:
+        return self.underlying_.number_of_edge_types()
+
+    @property
+    def max_degree_for_edge_tables(self) -> int:
+        return self.underlying_.max_degree_for_edge_tables()
+
+    @staticmethod
+    def node2vec(
+        uint32_t walk_length = 10, uint32_t number_of_walks = 1, double backward_probability = 1.0,
+        double forward_probability = 1.0, uint32_t max_degree_for_edge_tables = 32
+    ) -> RandomWalksPlan:
+        return RandomWalksPlan.make(_RandomWalksPlan.Node2vec(
+            walk_length, number_of_walks, backward_probability, forward_probability, max_degree_for_edge_tables))
+
+    @staticmethod
+    def edge2vec(
+        uint32_t walk_length = 10, uint32_t number_of_walks = 1, double backward_probability = 1.0,
+        double forward_probability = 1.0, uint32_t max_iterations = 10, uint32_t number_of_edge_types = 1
+    ) -> RandomWalksPlan:
+        return RandomWalksPlan.make(_RandomWalksPlan.Edge2vec(
+            walk_length, number_of_walks, backward_probability, forward_probability, max_iterations,
+            number_of_edge_types))
+
+
+cdef shared_ptr[CLargeListArray] handle_result_walks(std_result[shared_ptr[CLargeListArray]] res) nogil except *:
+    if not res.has_value():
+        with gil:
+            raise_error_code(res.error())
+    return res.value()
+
+
+def random_walks(
+    PropertyGraph pg, str edge_weight_property_name = "", str edge_type_property_name = "",
+    RandomWalksPlan plan = RandomWalksPlan()
+):
+    """
+    Generate random walks on pg, which must be symmetric. Returns a pyarrow large list array with the node ids of
+    each walk. If edge_weight_property_name is empty every edge has weight 1. edge_type_property_name is only used by
+    edge2vec plans.
+    """
+    cdef string edge_weight_property_name_str = edge_weight_property_name.encode("utf-8")
+    cdef string edge_type_property_name_str = edge_type_property_name.encode("utf-8")
+    cdef shared_ptr[CLargeListArray] res
+    with nogil:
+        res = handle_result_walks(RandomWalks(
+            pg.underlying.get(), edge_weight_property_name_str, edge_type_property_name_str, plan.underlying_))
+    return pyarrow_wrap_array(static_pointer_cast[CArray, CLargeListArray](res))
+
+
+def random_walks_assert_valid(PropertyGraph pg, walks):
+    cdef shared_ptr[CLargeListArray] walks_array = static_pointer_cast[CLargeListArray, CArray](
+        pyarrow_unwrap_array(walks))
+    if not walks_array:
+        raise TypeError("walks must be a pyarrow array")
+    with nogil:
+        handle_result_assert(RandomWalksAssertValid(pg.underlying.get(), walks_array))
@@ -1,5 +1,6 @@
 from libc.stdint cimport uint64_t
 from libcpp cimport bool
+from libcpp.string cimport string
 
 from katana.cpp.libstd.boost cimport handle_result_void, handle_result_assert, raise_error_code, std_result
 from katana.cpp.libgalois.graphs.Graph cimport PropertyFileGraph
@@ -40,6 +41,9 @@ cdef extern from "katana/analytics/triangle_count/triangle_count.h" namespace "k
 
     std_result[uint64_t] TriangleCount(PropertyFileGraph* pfg, _TriangleCountPlan plan)
 
+    std_result[void] LocalTriangleCount(PropertyFileGraph* pfg, string triangle_count_property_name,
+                                        string clustering_coefficient_property_name, _TriangleCountPlan plan)
+
 
 class _TriangleCountPlanAlgorithm(Enum):
     NodeIteration = _TriangleCountPlan.Algorithm.kNodeIteration
@@ -122,3 +126,17 @@ def triangle_count(PropertyGraph pg,  TriangleCountPlan plan = TriangleCountPlan
     with nogil:
         v = handle_result_int(TriangleCount(pg.underlying.get(), plan.underlying_))
     return v
+
+
+def local_triangle_count(PropertyGraph pg, str triangle_count_property_name,
+                         str clustering_coefficient_property_name,
+                         TriangleCountPlan plan = TriangleCountPlan()):
+    """
+    Store the number of triangles each node is part of and its local clustering coefficient in two new node
+    properties. The graph must be symmetric.
+    """
+    cdef string triangle_count_str = triangle_count_property_name.encode("utf-8")
+    cdef string clustering_coefficient_str = clustering_coefficient_property_name.encode("utf-8")
+    with nogil:
+        handle_result_void(LocalTriangleCount(pg.underlying.get(), triangle_count_str,
+                                              clustering_coefficient_str, plan.underlying_))
@@ -64,6 +64,7 @@ cdef extern from "katana/Analytics.h" namespace "katana::analytics" nogil:
             kAsynchronous "katana::analytics::BfsPlan::kAsynchronous"
             kSynchronousTile "katana::analytics::BfsPlan::kSynchronousTile"
             kSynchronous "katana::analytics::BfsPlan::kSynchronous"
+            kAutomatic "katana::analytics::BfsPlan::kAutomatic"
 
         _BfsPlan.Algorithm algorithm() const
         ptrdiff_t edge_tile_size() const
@@ -84,6 +85,9 @@ cdef extern from "katana/Analytics.h" namespace "katana::analytics" nogil:
         @staticmethod
         _BfsPlan Synchronous()
 
+        @staticmethod
+        _BfsPlan Automatic()
+
         @staticmethod
         _BfsPlan FromAlgorithm(_BfsPlan.Algorithm algo)
 
@@ -114,6 +118,7 @@ class _BfsAlgorithm(Enum):
     Asynchronous = _BfsPlan.Algorithm.kAsynchronous
     SynchronousTile = _BfsPlan.Algorithm.kSynchronousTile
     Synchronous = _BfsPlan.Algorithm.kSynchronous
+    Automatic = _BfsPlan.Algorithm.kAutomatic
 
 
 cdef class BfsPlan(Plan):
@@ -160,6 +165,13 @@ cdef class BfsPlan(Plan):
     def synchronous():
         return BfsPlan.make(_BfsPlan.Synchronous())
 
+    @staticmethod
+    def automatic():
+        """
+        Choose the algorithm and edge tile size from the degrees and diameter of the graph when it runs.
+        """
+        return BfsPlan.make(_BfsPlan.Automatic())
+
     @staticmethod
     def from_algorithm(algorithm):
         return BfsPlan.make(_BfsPlan.FromAlgorithm(int(algorithm)))
@@ -477,7 +489,14 @@ cdef extern from "katana/analytics/jaccard/jaccard.h" namespace "katana::analyti
             kUnsorted "katana::analytics::JaccardPlan::kUnsorted"
             kUnknown "katana::analytics::JaccardPlan::kUnknown"
 
+        enum SimilarityMetric:
+            kJaccard "katana::analytics::JaccardPlan::kJaccard"
+            kCosine "katana::analytics::JaccardPlan::kCosine"
+
         _JaccardPlan.EdgeSorting edge_sorting() const
+        _JaccardPlan.SimilarityMetric similarity_metric() const
+        uint32_t hub_degree() const
+        uint32_t num_hashes() const
 
         _JaccardPlan()
 
@@ -487,9 +506,24 @@ cdef extern from "katana/analytics/jaccard/jaccard.h" namespace "katana::analyti
         @staticmethod
         _JaccardPlan Unsorted()
 
+        @staticmethod
+        _JaccardPlan Cosine(_JaccardPlan.EdgeSorting edge_sorting)
+
+        @staticmethod
+        _JaccardPlan MinHash(_JaccardPlan.SimilarityMetric similarity_metric, uint32_t hub_degree,
+            uint32_t num_hashes)
+
+    uint32_t kJaccardDefaultHubDegree "katana::analytics::JaccardPlan::kDefaultHubDegree"
+    uint32_t kJaccardDefaultNumHashes "katana::analytics::JaccardPlan::kDefaultNumHashes"
+
     std_result[void] Jaccard(PropertyFileGraph* pfg, size_t compare_node,
         string output_property_name, _JaccardPlan plan)
 
+    std_result[void] JaccardAllEdges(PropertyFileGraph* pfg, string output_property_name, _JaccardPlan plan)
+
+    std_result[void] JaccardTopK(PropertyFileGraph* pfg, uint32_t k, string output_nodes_property_name,
+        string output_similarities_property_name, _JaccardPlan plan)
+
     std_result[void] JaccardAssertValid(PropertyFileGraph* pfg, size_t compare_node,
         string output_property_name)
 
@@ -510,6 +544,11 @@ class _JaccardEdgeSorting(Enum):
     kUnknown = _JaccardPlan.EdgeSorting.kUnknown
 
 
+class _JaccardSimilarityMetric(Enum):
+    Jaccard = _JaccardPlan.SimilarityMetric.kJaccard
+    Cosine = _JaccardPlan.SimilarityMetric.kCosine
+
+
 cdef class JaccardPlan(Plan):
     cdef:
         _JaccardPlan underlying_
@@ -518,6 +557,7 @@ cdef class JaccardPlan(Plan):
         return &self.underlying_
 
     EdgeSorting = _JaccardEdgeSorting
+    SimilarityMetric = _JaccardSimilarityMetric
 
     @staticmethod
     cdef JaccardPlan make(_JaccardPlan u):
@@ -533,10 +573,32 @@ cdef class JaccardPlan(Plan):
     def sorted():
         return JaccardPlan.make(_JaccardPlan.Sorted())
 
+    @property
+    def similarity_metric(self) -> _JaccardSimilarityMetric:
+        return _JaccardSimilarityMetric(self.underlying_.similarity_metric())
+
+    @property
+    def hub_degree(self) -> int:
+        return self.underlying_.hub_degree()
+
+    @property
+    def num_hashes(self) -> int:
+        return self.underlying_.num_hashes()
+
     @staticmethod
     def unsorted():
         return JaccardPlan.make(_JaccardPlan.Unsorted())
 
+    @staticmethod
+    def cosine(edge_sorting = _JaccardEdgeSorting.kUnknown):
+        return JaccardPlan.make(_JaccardPlan.Cosine(_JaccardEdgeSorting(edge_sorting).value))
+
+    @staticmethod
+    def min_hash(similarity_metric = _JaccardSimilarityMetric.Jaccard, uint32_t hub_degree = kJaccardDefaultHubDegree,
+                 uint32_t num_hashes = kJaccardDefaultNumHashes):
+        return JaccardPlan.make(_JaccardPlan.MinHash(_JaccardSimilarityMetric(similarity_metric).value, hub_degree,
+                                                     num_hashes))
+
 
 def jaccard(PropertyGraph pg, size_t compare_node, str output_property_name,
             JaccardPlan plan = JaccardPlan()):
@@ -546,6 +608,29 @@ def jaccard(PropertyGraph pg, size_t compare_node, str output_property_name,
         handle_result_void(Jaccard(pg.underlying.get(), compare_node, output_property_name_cstr, plan.underlying_))
 
 
+def jaccard_all_edges(PropertyGraph pg, str output_property_name, JaccardPlan plan = JaccardPlan()):
+    """
+    Store the similarity of the endpoints of every edge in a new edge property.
+    """
+    output_property_name_bytes = bytes(output_property_name, "utf-8")
+    output_property_name_cstr = <string>output_property_name_bytes
+    with nogil:
+        handle_result_void(JaccardAllEdges(pg.underlying.get(), output_property_name_cstr, plan.underlying_))
+
+
+def jaccard_top_k(PropertyGraph pg, uint32_t k, str output_nodes_property_name,
+                  str output_similarities_property_name, JaccardPlan plan = JaccardPlan()):
+    """
+    Store the k most similar nodes among those sharing an out-neighbor with each node (the neighbors of its neighbors
+    on a symmetric graph), and their similarities, in two new node properties of fixed size lists.
+    """
+    cdef string output_nodes_property_name_cstr = bytes(output_nodes_property_name, "utf-8")
+    cdef string output_similarities_property_name_cstr = bytes(output_similarities_property_name, "utf-8")
+    with nogil:
+        handle_result_void(JaccardTopK(pg.underlying.get(), k, output_nodes_property_name_cstr,
+                                       output_similarities_property_name_cstr, plan.underlying_))
+
+
 def jaccard_assert_valid(PropertyGraph pg, size_t compare_node, str output_property_name):
     output_property_name_bytes = bytes(output_property_name, "utf-8")
     output_property_name_cstr = <string>output_property_name_bytes
@@ -6,6 +6,7 @@ cdef extern from "katana/analytics/Plan.h" namespace "katana::analytics" nogil:
 
     cppclass _Plan "katana::analytics::Plan":
         _Architecture architecture() const
+        bint deterministic() const
 
 
 cdef class Plan:
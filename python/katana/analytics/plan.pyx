@@ -13,3 +13,9 @@ cdef class Plan:
 
     def architecture(self) -> Architecture:
         return Architecture(self.underlying().architecture())
+
+    def deterministic(self) -> bool:
+        """
+        Whether the analytic produces the same output on every run, independent of the number of threads.
+        """
+        return self.underlying().deterministic()
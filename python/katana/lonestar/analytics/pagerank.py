@@ -9,7 +9,7 @@ from katana.atomic import (
     GReduceMax,
 )
 from katana.datastructures import LargeArray, AllocationPolicy
-from katana.loops import do_all, do_all_operator
+from katana.loops import do_all, do_all_operator, edge_map, edge_map_operator
 from katana.property_graph import PropertyGraph
 from katana.galois import setActiveThreads
 from katana.timer import StatTimer
@@ -27,12 +27,10 @@ def initialize_residual_operator(rank, nout, delta, residual, nid):
     residual[nid] = INIT_RESIDUAL
 
 
-@do_all_operator()
-def compute_out_deg_operator(graph: PropertyGraph, nout, nid):
+@edge_map_operator()
+def compute_out_deg_operator(nout, src, dst, edge):
     """Operator for computing outdegree of nodes in the Graph"""
-    for ii in graph.edges(nid):
-        dst = graph.get_edge_dst(ii)
-        atomic_add(nout, dst, 1)
+    atomic_add(nout, dst, 1)
 
 
 @do_all_operator()
@@ -48,10 +46,13 @@ def compute_pagerank_pull_delta_operator(rank, nout, delta, residual, tolerance,
 
 
 @do_all_operator()
-def compute_pagerank_pull_residual_operator(graph: PropertyGraph, delta, residual, nid):
+def compute_pagerank_pull_residual_operator(out_indices, out_dests, delta, residual, nid):
     sum = 0
-    for ii in graph.edges(nid):
-        dst = graph.get_edge_dst(ii)
+    begin = np.uint64(0)
+    if nid > 0:
+        begin = out_indices[nid - 1]
+    for ii in range(begin, out_indices[nid]):
+        dst = out_dests[ii]
         if delta[dst] > 0:
             sum += delta[dst]
 
@@ -76,9 +77,7 @@ def pagerank_pull_sync_residual(graph: PropertyGraph, maxIterations, tolerance,
     )
 
     # Compute out-degree for each node
-    do_all(
-        range(num_nodes), compute_out_deg_operator(graph, nout.as_numpy()), steal=True, loop_name="Compute_out_degree",
-    )
+    edge_map(graph, compute_out_deg_operator(nout.as_numpy()), loop_name="Compute_out_degree")
 
     print("Out-degree of 0: ", nout[0])
 
@@ -101,7 +100,9 @@ def pagerank_pull_sync_residual(graph: PropertyGraph, maxIterations, tolerance,
 
         do_all(
             range(num_nodes),
-            compute_pagerank_pull_residual_operator(graph, delta.as_numpy(), residual.as_numpy()),
+            compute_pagerank_pull_residual_operator(
+                graph.out_indices(), graph.out_dests(), delta.as_numpy(), residual.as_numpy()
+            ),
             steal=True,
             loop_name="pagerank",
         )
@@ -3,6 +3,7 @@ from functools import wraps
 import numba
 import numba.core.ccallback
 import numba.types
+import numpy as np
 
 from ._loops import (
     do_all,
@@ -17,6 +18,8 @@ from .numba_support.galois_compiler import OperatorCompiler
 __all__ = [
     "do_all",
     "do_all_operator",
+    "edge_map",
+    "edge_map_operator",
     "for_each",
     "for_each_operator",
     "obim_metric",
@@ -73,6 +76,81 @@ def is_do_all_operator_closure(v):
     return isinstance(v, Closure) and len(v.unbound_argument_types) == 1
 
 
+class EdgeMapOperator:
+    """
+    An operator declared with `edge_map_operator` with its arguments bound. Pass it to `edge_map`.
+    """
+
+    __slots__ = ["_builder", "_args", "__name__"]
+
+    def __init__(self, builder, args, name):
+        self._builder = builder
+        self._args = args
+        self.__name__ = name
+
+    def _closure(self, graph):
+        return self._builder(graph.out_indices(), graph.out_dests(), *self._args)
+
+
+def edge_map_operator(**kws):
+    """
+    >>> @edge_map_operator()
+    ... def f(arg0, ..., argn, src, dst, edge): ...
+
+    Decorator to declare an operator for use with `edge_map`, which calls it for each out edge `edge` from `src` to
+    `dst`. As for `do_all_operator`, arguments other than the edge arguments must be bound by calling the function:
+
+    >>> f(arg0, ..., argn)
+
+    The operator is compiled using numba and inlined into a loop over the CSR arrays of the graph (see
+    `PropertyGraph.out_indices` and `PropertyGraph.out_dests`), so edges are walked without calls into the graph.
+    Edge properties can be read by binding the array from `PropertyGraph.get_edge_property_numpy` and indexing it with
+    `edge`. The restrictions of `do_all_operator` apply.
+    """
+
+    def decorator(f):
+        n_args = f.__code__.co_argcount - 3
+        kernel = numba.njit(inline="always", **kws)(f)
+        bound = "".join(name + ", " for name in f.__code__.co_varnames[:n_args])
+        # Generated so that the kernel is a compile time constant of the loop and gets inlined into it
+        source = f"""
+def {f.__name__}_edges(out_indices, out_dests, {bound}src):
+    begin = np.uint64(0)
+    if src > 0:
+        begin = out_indices[src - 1]
+    for edge in range(begin, out_indices[src]):
+        kernel({bound}src, out_dests[edge], edge)
+"""
+        scope = {"kernel": kernel, "np": np}
+        exec(source, scope)
+        node_operator = numba.jit(nopython=True, pipeline_class=OperatorCompiler, **kws)(scope[f.__name__ + "_edges"])
+        builder = ClosureBuilder(node_operator, n_unbound_arguments=1)
+
+        @wraps(f)
+        def bind(*args):
+            if len(args) != n_args:
+                raise TypeError("{} takes {} bound arguments ({} given)".format(f.__name__, n_args, len(args)))
+            return EdgeMapOperator(builder, args, f.__name__)
+
+        if n_args == 0:
+            return bind()
+        return bind
+
+    return decorator
+
+
+def edge_map(graph, operator: EdgeMapOperator, nodes=None, *, steal=True, loop_name=None):
+    """
+    Call `operator`, declared with `edge_map_operator`, on every out edge of each node in `nodes` (by default all
+    nodes of `graph`) in parallel. The edges of a node are processed by the thread that takes the node.
+    """
+    if not isinstance(operator, EdgeMapOperator):
+        raise TypeError("edge_map requires an operator declared with edge_map_operator")
+    if nodes is None:
+        nodes = range(graph.num_nodes())
+    do_all(nodes, operator._closure(graph), steal=steal, loop_name=loop_name)
+
+
 def for_each_operator(typ=None, nopython=True, **kws):
     """
     >>> @for_each_operator()
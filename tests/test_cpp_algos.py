@@ -6,6 +6,7 @@ from katana import GaloisError
 from katana.analytics import *
 from katana.property_graph import PropertyGraph
 from katana.example_utils import get_input
+from katana.galois import setActiveThreads
 from katana.lonestar.analytics.bfs import verify_bfs
 from katana.lonestar.analytics.sssp import verify_sssp
 
@@ -62,7 +63,8 @@ def test_bfs(property_graph: PropertyGraph):
     property_name = "NewProp"
     start_node = 0
 
-    bfs(property_graph, start_node, property_name)
+    # The expected results are those of the default plan before automatic plans
+    bfs(property_graph, start_node, property_name, BfsPlan.synchronous_tile())
 
     node_schema: Schema = property_graph.node_schema()
     num_node_properties = len(node_schema)
@@ -147,10 +149,77 @@ def test_jaccard_sorted(property_graph: PropertyGraph):
     assert similarities[2812] == approx(0.01428571)
 
 
+def test_jaccard_all_edges(property_graph: PropertyGraph):
+    compare_node = 0
+    jaccard(property_graph, compare_node, "NodeSimilarity")
+    jaccard_all_edges(property_graph, "EdgeSimilarity")
+
+    node_similarities = property_graph.get_node_property("NodeSimilarity").to_numpy()
+    edge_similarities = property_graph.get_edge_property("EdgeSimilarity").to_numpy()
+    assert ((edge_similarities >= 0) & (edge_similarities <= 1)).all()
+    for e in property_graph.edges(compare_node):
+        dst = property_graph.get_edge_dst(e)
+        assert edge_similarities[e] == approx(node_similarities[dst])
+
+    jaccard_all_edges(property_graph, "ApproxEdgeSimilarity", JaccardPlan.min_hash(hub_degree=16))
+    approx_similarities = property_graph.get_edge_property("ApproxEdgeSimilarity").to_numpy()
+    assert ((approx_similarities >= 0) & (approx_similarities <= 1)).all()
+
+    with raises(GaloisError):
+        jaccard_all_edges(property_graph, "NoHashes", JaccardPlan.min_hash(hub_degree=16, num_hashes=0))
+
+
+def test_jaccard_all_edges_min_hash_sinks():
+    # Hubs 0 and 1 point to the sinks 2 to 21, which have no sketch of their own unless the destinations of hub edges
+    # are sketched too; 22 points to both hubs and one sink
+    adjacency = [list(range(2, 22)), [0] + list(range(2, 22))] + [[] for _ in range(2, 22)] + [[0, 1, 2]]
+    indices = np.cumsum([len(dests) for dests in adjacency])
+    graph = PropertyGraph.from_csr(indices, [dest for dests in adjacency for dest in dests])
+
+    jaccard_all_edges(graph, "Exact")
+    jaccard_all_edges(graph, "Estimate", JaccardPlan.min_hash(hub_degree=16, num_hashes=256))
+
+    exact = graph.get_edge_property("Exact").to_numpy()
+    estimate = graph.get_edge_property("Estimate").to_numpy()
+    assert estimate == approx(exact, abs=0.1)
+
+
+def test_jaccard_top_k(property_graph: PropertyGraph):
+    k = 5
+    jaccard_top_k(property_graph, k, "TopNodes", "TopSimilarities")
+    top_nodes = property_graph.get_node_property("TopNodes")
+    top_similarities = property_graph.get_node_property("TopSimilarities")
+
+    # ldbc_003 is directed: the candidates of a node are the nodes sharing an out-neighbor with it, which are exactly
+    # those with a non-zero similarity to it
+    sources = [n for n in range(property_graph.num_nodes()) if len(property_graph.edges(n)) > 0][:NODES_TO_SAMPLE]
+    for i, compare_node in enumerate(sources):
+        property_name = "NodeSimilarity{}".format(i)
+        jaccard(property_graph, compare_node, property_name)
+        node_similarities = property_graph.get_node_property(property_name).to_numpy().copy()
+        node_similarities[compare_node] = 0
+        expected = np.sort(node_similarities[node_similarities > 0])[::-1][:k]
+
+        similarities = top_similarities[compare_node].as_py()
+        nodes = top_nodes[compare_node].as_py()
+        assert len(similarities) == k
+        found = [s for s in similarities if s is not None]
+        assert found == approx(list(expected))
+        for node, similarity in zip(nodes, found):
+            assert node_similarities[node] == approx(similarity)
+
+    jaccard_top_k(property_graph, k, "ApproxTopNodes", "ApproxTopSimilarities", JaccardPlan.min_hash(hub_degree=16))
+    for row in property_graph.get_node_property("ApproxTopSimilarities").to_pylist():
+        found = [s for s in row if s is not None]
+        assert all(0 <= s <= 1 for s in found)
+        assert found == sorted(found, reverse=True)
+
+
 def test_pagerank(property_graph: PropertyGraph):
     property_name = "NewProp"
 
-    pagerank(property_graph, property_name)
+    # The expected ranks are those of the default plan before automatic plans
+    pagerank(property_graph, property_name, PagerankPlan.push_asynchronous(1.0e-3, 0.85))
 
     node_schema: Schema = property_graph.node_schema()
     num_node_properties = len(node_schema)
@@ -166,6 +235,108 @@ def test_pagerank(property_graph: PropertyGraph):
     assert stats.average_rank == approx(0.5205338001251221, abs=0.001)
 
 
+def _with_edges(property_graph: PropertyGraph, added=(), removed=()) -> PropertyGraph:
+    """
+    Return a graph without properties with the topology of property_graph, plus the (source, destination) pairs in
+    added and minus the edge IDs in removed.
+    """
+    indices = property_graph.out_indices()
+    dests = property_graph.out_dests()
+    sources = np.repeat(
+        np.arange(property_graph.num_nodes(), dtype=np.uint32), np.diff(indices, prepend=np.uint64(0)).astype(np.int64)
+    )
+    keep = np.ones(len(dests), dtype=bool)
+    keep[list(removed)] = False
+    added = np.array(added, dtype=np.uint32).reshape(-1, 2)
+    sources = np.concatenate([sources[keep], added[:, 0]])
+    dests = np.concatenate([dests[keep], added[:, 1]])
+    order = np.argsort(sources, kind="stable")
+    new_indices = np.cumsum(np.bincount(sources, minlength=property_graph.num_nodes()))
+    return PropertyGraph.from_csr(new_indices, dests[order])
+
+
+def test_pagerank_incremental(property_graph: PropertyGraph):
+    tolerance = 1.0e-4
+    alpha = 0.85
+    plan = PagerankPlan.push_asynchronous(tolerance, alpha)
+
+    # The batch is the last edge of every 16th node with at least two edges
+    indices = property_graph.out_indices()
+    dests = property_graph.out_dests()
+    degrees = np.diff(indices, prepend=np.uint64(0))
+    sources = [n for n in range(0, property_graph.num_nodes(), 16) if degrees[n] >= 2]
+    removed = [int(indices[n]) - 1 for n in sources]
+    edge_batch = [(n, int(dests[e])) for n, e in zip(sources, removed)]
+    assert edge_batch
+
+    before = _with_edges(property_graph, removed=removed)
+    pagerank(before, "rank", plan)
+    property_graph.add_node_property(table({"rank": before.get_node_property("rank").to_numpy()}))
+
+    pagerank_incremental(property_graph, "rank", edge_batch, plan)
+    pagerank(property_graph, "expected", plan)
+
+    # Both results are within tolerance / (1 - alpha) of the exact ranks, relative to the rank, and the incremental
+    # one also carries the residual left over by the first run
+    ranks = property_graph.get_node_property("rank").to_numpy()
+    expected = property_graph.get_node_property("expected").to_numpy()
+    assert np.allclose(ranks, expected, rtol=4 * tolerance / (1 - alpha), atol=0)
+
+    pagerank_incremental(property_graph, "rank", [], plan)
+    assert np.array_equal(property_graph.get_node_property("rank").to_numpy(), ranks)
+
+    with raises(GaloisError):
+        pagerank_incremental(property_graph, "rank", [(0, property_graph.num_nodes())], plan)
+
+
+def test_pagerank_segmented(property_graph: PropertyGraph):
+    plan = PagerankPlan.push_synchronous(1.0e-3, 1000, 0.85)
+    pagerank(property_graph, "output", plan)
+    expected = property_graph.get_node_property("output").to_numpy()
+
+    # A small segment size streams the topology through many segments
+    for segment_bytes in [1 << 12, 1 << 30]:
+        ranks = pagerank_segmented(get_input("propertygraphs/ldbc_003"), plan, segment_bytes).to_numpy()
+        assert len(ranks) == property_graph.num_nodes()
+        assert np.allclose(ranks, expected, rtol=1e-3, atol=1e-3)
+
+    # Only the synchronous push algorithm streams the topology
+    for other in [PagerankPlan(), PagerankPlan.push_asynchronous(1.0e-3, 0.85)]:
+        with raises(GaloisError):
+            pagerank_segmented(get_input("propertygraphs/ldbc_003"), other)
+
+
+def test_pagerank_personalized(property_graph: PropertyGraph):
+    seeds = [0, 1]
+
+    pagerank_personalized(property_graph, seeds, "Personalized")
+    ranks = property_graph.get_node_property("Personalized").to_numpy()
+    assert ranks.min() >= 0
+    assert ranks.sum() <= 1.0001
+    assert ranks[seeds].min() >= (1 - PagerankPlan().alpha) / len(seeds) - 1e-6
+
+    pagerank_personalized(property_graph, seeds, "Local", PagerankPlan.push_local())
+    local_ranks = property_graph.get_node_property("Local").to_numpy()
+    assert local_ranks[seeds] == approx(ranks[seeds], abs=0.01)
+
+    weights = np.zeros(property_graph.num_nodes(), dtype=np.float32)
+    weights[seeds] = 1
+    property_graph.add_node_property(table({"SeedWeight": weights}))
+    pagerank_personalized_weighted(property_graph, "SeedWeight", "Weighted")
+    weighted_ranks = property_graph.get_node_property("Weighted").to_numpy()
+    assert weighted_ranks == approx(ranks, abs=1e-6)
+
+    pagerank_multi_seed(property_graph, seeds, ["Seed0", "Seed1"])
+    seed0 = property_graph.get_node_property("Seed0").to_numpy()
+    seed1 = property_graph.get_node_property("Seed1").to_numpy()
+    assert (seed0 + seed1) / 2 == approx(ranks, abs=0.01)
+
+    with raises(GaloisError):
+        pagerank_personalized(property_graph, [], "Empty")
+    with raises(GaloisError):
+        pagerank_personalized(property_graph, seeds, "Pull", PagerankPlan.pull_residual(1.0e-3, 100, 0.85))
+
+
 def test_betweenness_centrality_outer(property_graph: PropertyGraph):
     property_name = "NewProp"
 
@@ -200,6 +371,31 @@ def test_betweenness_centrality_level(property_graph: PropertyGraph):
     assert stats.average_centrality == approx(1.3645)
 
 
+def test_betweenness_centrality_sampling(property_graph: PropertyGraph):
+    property_name = "NewProp"
+    num_nodes = property_graph.num_nodes()
+
+    # A small delta keeps the chance that the bound is missed, and the test flakes, negligible
+    betweenness_centrality(property_graph, property_name, None, BetweennessCentralityPlan.sampling(0.05, 0.001))
+
+    stats = BetweennessCentralityStatistics(property_graph, property_name)
+
+    assert stats.num_samples > 0
+    assert 0 < stats.error_bound <= 0.05 * num_nodes * (num_nodes - 1) * 1.0001
+    assert stats.min_centrality >= 0
+
+    betweenness_centrality(property_graph, "Exact", None, BetweennessCentralityPlan.level())
+    assert BetweennessCentralityStatistics(property_graph, "Exact").num_samples == 0
+
+    sampled = property_graph.get_node_property(property_name).to_numpy()
+    exact = property_graph.get_node_property("Exact").to_numpy()
+    # Allow for the float32 rounding of both results
+    assert np.abs(sampled - exact).max() <= stats.error_bound * 1.0001 + 1e-4 * exact.max()
+
+    with raises(GaloisError):
+        betweenness_centrality(property_graph, "Invalid", None, BetweennessCentralityPlan.sampling(0, 0.1))
+
+
 def test_triangle_count():
     property_graph = PropertyGraph(get_input("propertygraphs/rmat15_cleaned_symmetric"))
     original_first_edge_list = [property_graph.get_edge_dst(e) for e in property_graph.edges(0)]
@@ -227,6 +423,20 @@ def test_triangle_count_presorted():
     assert n == 282617
 
 
+def test_local_triangle_count():
+    property_graph = PropertyGraph(get_input("propertygraphs/rmat15_cleaned_symmetric"))
+    original_first_edge_list = [property_graph.get_edge_dst(e) for e in property_graph.edges(0)]
+
+    local_triangle_count(property_graph, "triangles", "clustering")
+
+    triangles = property_graph.get_node_property("triangles").to_numpy()
+    clustering = property_graph.get_node_property("clustering").to_numpy()
+    # Every triangle is counted at each of its three nodes
+    assert triangles.sum() == 3 * 282617
+    assert ((clustering >= 0) & (clustering <= 1)).all()
+    assert [property_graph.get_edge_dst(e) for e in property_graph.edges(0)] == original_first_edge_list
+
+
 def test_independent_set():
     property_graph = PropertyGraph(get_input("propertygraphs/rmat10_symmetric"))
 
@@ -243,6 +453,24 @@ def test_independent_set():
     independent_set_assert_valid(property_graph, "output2")
 
 
+def test_independent_set_deterministic():
+    property_graph = PropertyGraph(get_input("propertygraphs/rmat10_symmetric"))
+
+    plan = IndependentSetPlan.priority().as_deterministic()
+    assert plan.deterministic()
+
+    outputs = []
+    for threads in [1, 4, 16]:
+        setActiveThreads(threads)
+        property_name = "output{}".format(threads)
+        independent_set(property_graph, property_name, plan)
+        independent_set_assert_valid(property_graph, property_name)
+        outputs.append(property_graph.get_node_property(property_name).to_numpy())
+
+    for output in outputs[1:]:
+        assert np.array_equal(outputs[0], output)
+
+
 def test_connected_components():
     property_graph = PropertyGraph(get_input("propertygraphs/rmat10_symmetric"))
 
@@ -258,6 +486,133 @@ def test_connected_components():
     connected_components_assert_valid(property_graph, "output")
 
 
+def test_connected_components_deterministic():
+    property_graph = PropertyGraph(get_input("propertygraphs/rmat10_symmetric"))
+
+    expected = None
+    for i, plan in enumerate([ConnectedComponentsPlan.asynchronous(), ConnectedComponentsPlan.afforest()]):
+        plan = plan.as_deterministic()
+        assert plan.deterministic()
+        property_name = "output{}".format(i)
+        connected_components(property_graph, property_name, plan)
+        connected_components_assert_valid(property_graph, property_name)
+
+        components = property_graph.get_node_property(property_name).to_numpy()
+        # Every component is labeled by its smallest node
+        assert np.all(components <= np.arange(len(components)))
+        if expected is None:
+            expected = components
+        assert np.array_equal(components, expected)
+
+
+def test_automatic_plans():
+    assert BfsPlan().algorithm == BfsPlan.Algorithm.Automatic
+    assert ConnectedComponentsPlan().algorithm == ConnectedComponentsPlan.Algorithm.Automatic
+    assert PagerankPlan().algorithm == PagerankPlan.Algorithm.Automatic
+
+    property_graph = PropertyGraph(get_input("propertygraphs/rmat10_symmetric"))
+
+    # The choice depends on the number of threads
+    for i, threads in enumerate([1, 4]):
+        setActiveThreads(threads)
+        bfs(property_graph, 0, "bfs{}".format(i), BfsPlan.automatic())
+        bfs_assert_valid(property_graph, "bfs{}".format(i))
+
+        connected_components(property_graph, "cc{}".format(i), ConnectedComponentsPlan.automatic().as_deterministic())
+        connected_components_assert_valid(property_graph, "cc{}".format(i))
+        stats = ConnectedComponentsStatistics(property_graph, "cc{}".format(i))
+        assert stats.total_components == 69
+
+        pagerank(property_graph, "rank{}".format(i), PagerankPlan.automatic())
+        pagerank_assert_valid(property_graph, "rank{}".format(i))
+
+    assert np.array_equal(
+        property_graph.get_node_property("cc0").to_numpy(), property_graph.get_node_property("cc1").to_numpy()
+    )
+
+
+def test_connected_components_edge_tiled():
+    property_graph = PropertyGraph(get_input("propertygraphs/rmat10_symmetric"))
+
+    plans = [
+        ConnectedComponentsPlan.edge_tiled_asynchronous(),
+        ConnectedComponentsPlan.edge_tiled_asynchronous(16),
+        ConnectedComponentsPlan.edge_tiled_afforest(),
+    ]
+    for i, plan in enumerate(plans):
+        property_name = "output{}".format(i)
+        connected_components(property_graph, property_name, plan)
+
+        stats = ConnectedComponentsStatistics(property_graph, property_name)
+        assert stats.total_components == 69
+
+        connected_components_assert_valid(property_graph, property_name)
+
+
+def test_connected_components_incremental():
+    property_graph = PropertyGraph(get_input("propertygraphs/rmat10_symmetric"))
+
+    connected_components(property_graph, "output")
+
+    components = property_graph.get_node_property("output").to_numpy()
+    _, representatives = np.unique(components, return_index=True)
+    edge_batch = [(int(a), int(b)) for a, b in zip(representatives[:-1], representatives[1:])]
+
+    connected_components_incremental(property_graph, "output", edge_batch)
+
+    stats = ConnectedComponentsStatistics(property_graph, "output")
+
+    assert stats.total_components == 1
+
+    connected_components_assert_valid(property_graph, "output")
+
+
+def test_connected_components_incremental_matches_recompute():
+    property_graph = PropertyGraph(get_input("propertygraphs/rmat10_symmetric"))
+
+    connected_components(property_graph, "output")
+
+    components = property_graph.get_node_property("output").to_numpy()
+    _, representatives = np.unique(components, return_index=True)
+    # Two edges merge pairs of components and one stays inside a component
+    inside = int(np.flatnonzero(components == components[representatives[0]])[-1])
+    edge_batch = [
+        (int(representatives[0]), int(representatives[1])),
+        (int(representatives[3]), int(representatives[2])),
+        (int(representatives[0]), inside),
+    ]
+
+    connected_components_incremental(property_graph, "output", edge_batch)
+
+    stats = ConnectedComponentsStatistics(property_graph, "output")
+    assert stats.total_components == 69 - 2
+    connected_components_assert_valid(property_graph, "output")
+
+    # Same partition as recomputing on the graph with the batch added
+    expanded = _with_edges(property_graph, added=edge_batch + [(b, a) for a, b in edge_batch])
+    connected_components(expanded, "expected")
+    updated = property_graph.get_node_property("output").to_numpy()
+    expected = expanded.get_node_property("expected").to_numpy()
+    assert len(set(zip(updated, expected))) == len(np.unique(expected)) == 69 - 2
+
+
+def test_connected_components_segmented():
+    property_graph = PropertyGraph(get_input("propertygraphs/rmat10_symmetric"))
+
+    connected_components(property_graph, "output")
+    expected = property_graph.get_node_property("output").to_numpy()
+
+    for segment_bytes in [1 << 12, 1 << 30]:
+        components = connected_components_segmented(
+            get_input("propertygraphs/rmat10_symmetric"), segment_bytes
+        ).to_numpy()
+        assert len(np.unique(components)) == 69
+        # Same partition of the nodes, labeled by the smallest node id
+        assert len(set(zip(components, expected))) == 69
+        assert all(components[components] == components)
+        assert all(components <= np.arange(len(components)))
+
+
 def test_k_core():
     property_graph = PropertyGraph(get_input("propertygraphs/rmat10_symmetric"))
 
@@ -270,6 +625,19 @@ def test_k_core():
     k_core_assert_valid(property_graph, 10, "output")
 
 
+def test_k_core_decomposition():
+    property_graph = PropertyGraph(get_input("propertygraphs/rmat10_symmetric"))
+
+    k_core_decomposition(property_graph, "output")
+
+    stats = KCoreStatistics.decomposition(property_graph, "output")
+
+    assert sum(stats.core_number_histogram) == property_graph.num_nodes()
+    assert sum(stats.core_number_histogram[10:]) == 438
+
+    k_core_decomposition_assert_valid(property_graph, "output")
+
+
 def test_k_truss():
     property_graph = PropertyGraph(get_input("propertygraphs/rmat10_symmetric"))
 
@@ -290,3 +658,148 @@ def test_k_truss_fail():
 
     with raises(GaloisError):
         k_truss(property_graph, 1, "output2")
+
+
+def _ring_of_cliques(num_cliques: int, clique_size: int) -> PropertyGraph:
+    """
+    Return a symmetric graph of num_cliques cliques of clique_size nodes each, where the first node of every clique is
+    connected to the last node of the next one. For few enough cliques the best clustering has one cluster per clique.
+    """
+    num_nodes = num_cliques * clique_size
+    edges = set()
+    for c in range(num_cliques):
+        first = c * clique_size
+        for i in range(first, first + clique_size):
+            for j in range(first, first + clique_size):
+                if i != j:
+                    edges.add((i, j))
+        last_of_next = (c + 1) % num_cliques * clique_size + clique_size - 1
+        edges.add((first, last_of_next))
+        edges.add((last_of_next, first))
+    edges = sorted(edges)
+    indices = np.cumsum(np.bincount([src for src, _ in edges], minlength=num_nodes))
+    return PropertyGraph.from_csr(indices, [dest for _, dest in edges])
+
+
+def _assert_ring_of_cliques_clusters(property_graph: PropertyGraph, property_name: str, clique_size: int):
+    communities = property_graph.get_node_property(property_name).to_pylist()
+    cliques = [communities[first : first + clique_size] for first in range(0, len(communities), clique_size)]
+    assert all(len(set(clique)) == 1 for clique in cliques)
+    assert len({clique[0] for clique in cliques}) == len(cliques)
+    stats = ClusteringStatistics(property_graph, "", property_name)
+    assert stats.n_clusters == len(cliques)
+    # Each clique has clique_size * (clique_size - 1) / 2 edges inside and clique_size * (clique_size - 1) + 2 edge
+    # endpoints out of twice the number of edges
+    num_edges = len(cliques) * (clique_size * (clique_size - 1) // 2 + 1)
+    inside = clique_size * (clique_size - 1) // 2 / num_edges
+    degree = (clique_size * (clique_size - 1) + 2) / (2 * num_edges)
+    assert stats.modularity == approx(len(cliques) * (inside - degree * degree))
+
+
+def _assert_communities_connected(property_graph: PropertyGraph, property_name: str):
+    communities = property_graph.get_node_property(property_name).to_pylist()
+    indices = property_graph.out_indices().tolist()
+    dests = property_graph.out_dests().tolist()
+    # Join the endpoints of every edge inside a community; a community is connected if all of its nodes are then in
+    # the same set
+    parent = list(range(property_graph.num_nodes()))
+
+    def find(n):
+        while parent[n] != n:
+            parent[n] = parent[parent[n]]
+            n = parent[n]
+        return n
+
+    begin = 0
+    for n, end in enumerate(indices):
+        for dest in dests[begin:end]:
+            if communities[dest] == communities[n]:
+                parent[find(dest)] = find(n)
+        begin = end
+    roots = {}
+    for n, community in enumerate(communities):
+        assert roots.setdefault(community, find(n)) == find(n)
+
+
+def test_louvain_clustering():
+    property_graph = PropertyGraph(get_input("propertygraphs/rmat10_symmetric"))
+
+    louvain_clustering(property_graph, "", "output")
+
+    clustering_assert_valid(property_graph, "output")
+
+    stats = ClusteringStatistics(property_graph, "", "output")
+
+    assert 1 <= stats.n_clusters < property_graph.num_nodes()
+    assert stats.modularity > 0
+
+    with raises(GaloisError):
+        louvain_clustering(property_graph, "", "output")
+
+    ring = _ring_of_cliques(4, 5)
+    louvain_clustering(ring, "", "output")
+    _assert_ring_of_cliques_clusters(ring, "output", 5)
+
+
+def test_leiden_clustering():
+    property_graph = PropertyGraph(get_input("propertygraphs/rmat10_symmetric"))
+
+    leiden_clustering(property_graph, "", "output", LeidenClusteringPlan.do_all(randomness=0.001))
+
+    clustering_assert_valid(property_graph, "output")
+
+    stats = ClusteringStatistics(property_graph, "", "output")
+
+    assert 1 <= stats.n_clusters < property_graph.num_nodes()
+    assert stats.modularity > 0
+    _assert_communities_connected(property_graph, "output")
+
+    ring = _ring_of_cliques(4, 5)
+    leiden_clustering(ring, "", "output", LeidenClusteringPlan.do_all(randomness=0.001))
+    _assert_ring_of_cliques_clusters(ring, "output", 5)
+    _assert_communities_connected(ring, "output")
+
+
+def test_random_walks():
+    property_graph = PropertyGraph(get_input("propertygraphs/rmat10_symmetric"))
+
+    walks = random_walks(property_graph, plan=RandomWalksPlan.node2vec(5, 2, 0.5, 2.0))
+
+    assert len(walks) == 2 * property_graph.num_nodes()
+    for w in range(NODES_TO_SAMPLE):
+        assert walks[w].values[0].as_py() == w
+        assert len(walks[w].values) <= 6
+
+    random_walks_assert_valid(property_graph, walks)
+
+    # Without precomputed edge tables every step is drawn by rejection
+    walks = random_walks(property_graph, plan=RandomWalksPlan.node2vec(5, 1, 0.5, 2.0, 0))
+    random_walks_assert_valid(property_graph, walks)
+
+    with raises(GaloisError):
+        random_walks(property_graph, plan=RandomWalksPlan.node2vec(5, 1, 0.0))
+
+
+def test_random_walks_edge2vec():
+    property_graph = PropertyGraph(get_input("propertygraphs/rmat10_symmetric"))
+    dests = property_graph.out_dests()
+    property_graph.add_edge_property(
+        table({"EdgeType": (dests % 3).astype(np.uint32), "Weight": (1 + dests % 2).astype(np.float32)})
+    )
+
+    walks = random_walks(property_graph, "Weight", "EdgeType", RandomWalksPlan.edge2vec(5, 1, 0.5, 2.0, 2, 2))
+
+    assert len(walks) == property_graph.num_nodes()
+    for w in range(NODES_TO_SAMPLE):
+        assert walks[w].values[0].as_py() == w
+        assert len(walks[w].values) <= 6
+
+    random_walks_assert_valid(property_graph, walks)
+
+    # Edge types may not exceed number_of_edge_types
+    with raises(GaloisError):
+        random_walks(property_graph, "Weight", "EdgeType", RandomWalksPlan.edge2vec(5, 1, 0.5, 2.0, 2, 1))
+
+    property_graph.add_edge_property(table({"NegativeWeight": -np.ones(len(dests), dtype=np.float32)}))
+    with raises(GaloisError):
+        random_walks(property_graph, "NegativeWeight", "EdgeType", RandomWalksPlan.edge2vec(5, 1, 0.5, 2.0, 2, 2))
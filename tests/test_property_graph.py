@@ -1,5 +1,6 @@
+import asyncio
 import os
-from tempfile import NamedTemporaryFile
+from tempfile import NamedTemporaryFile, TemporaryDirectory
 
 import numpy as np
 import pyarrow
@@ -8,6 +9,7 @@ import pytest
 from katana.loops import do_all_operator, do_all
 from katana.property_graph import PropertyGraph
 from katana import TsubaError
+from katana.example_utils import get_input
 
 
 def test_load(property_graph):
@@ -144,6 +146,39 @@ def test_load_garbage_file():
         os.unlink(fi.name)
 
 
+def test_load_async():
+    stages = []
+    future = PropertyGraph.load_async(
+        get_input("propertygraphs/ldbc_003"), progress=lambda stage, path: stages.append(stage)
+    )
+    graph = future.result()
+    assert graph.num_nodes() == 29092
+    assert graph.num_edges() == 39283
+    assert stages == ["loading", "loaded"]
+
+
+def test_load_async_asyncio():
+    async def load():
+        return await asyncio.wrap_future(PropertyGraph.load_async(get_input("propertygraphs/ldbc_003")))
+
+    graph = asyncio.run(load())
+    assert graph.num_nodes() == 29092
+
+
+def test_load_async_invalid_path():
+    with pytest.raises(TsubaError):
+        PropertyGraph.load_async("non-existent").result()
+
+
+def test_write_async(property_graph):
+    with TemporaryDirectory() as tmpdir:
+        path = os.path.join(tmpdir, "graph")
+        property_graph.write_async(path, "test_write_async").result()
+        graph = PropertyGraph(path)
+        assert graph.num_nodes() == property_graph.num_nodes()
+        assert graph.num_edges() == property_graph.num_edges()
+
+
 def test_simple_algorithm(property_graph):
     @do_all_operator()
     def func_operator(g, prop, out, nid):
@@ -167,3 +202,79 @@ def test_simple_algorithm(property_graph):
     assert oprop[0].as_py() == 91
     assert oprop[4].as_py() == 239
     assert oprop[-1].as_py() == 0
+
+
+def test_csr_views(property_graph):
+    out_indices = property_graph.out_indices()
+    out_dests = property_graph.out_dests()
+    assert out_indices.dtype == np.uint64
+    assert out_dests.dtype == np.uint32
+    assert len(out_indices) == property_graph.num_nodes()
+    assert len(out_dests) == property_graph.num_edges()
+    assert not out_indices.flags.writeable
+    assert not out_dests.flags.writeable
+
+    assert list(out_dests[out_indices[9] : out_indices[10]]) == [2011, 1422, 1409, 4798, 9483]
+    assert out_indices[-1] == property_graph.num_edges()
+
+
+def test_from_csr():
+    pg = PropertyGraph.from_csr([2, 2, 3], [1, 2, 0])
+    assert pg.num_nodes() == 3
+    assert pg.num_edges() == 3
+    assert [[pg.get_edge_dst(e) for e in pg.edges(n)] for n in pg] == [[1, 2], [], [0]]
+    assert len(pg.node_schema()) == 0
+    assert len(pg.edge_schema()) == 0
+
+    empty = PropertyGraph.from_csr([], [])
+    assert empty.num_nodes() == 0
+    assert empty.num_edges() == 0
+
+
+def test_from_csr_copies(property_graph):
+    out_indices = property_graph.out_indices()
+    out_dests = property_graph.out_dests()
+    copy = PropertyGraph.from_csr(out_indices, out_dests)
+    assert copy.num_nodes() == property_graph.num_nodes()
+    assert np.array_equal(copy.out_indices(), out_indices)
+    assert np.array_equal(copy.out_dests(), out_dests)
+
+
+def test_from_csr_invalid():
+    with pytest.raises(ValueError):
+        PropertyGraph.from_csr([2, 1, 3], [1, 2, 0])
+    with pytest.raises(ValueError):
+        PropertyGraph.from_csr([2, 2, 2], [1, 2, 0])
+    with pytest.raises(ValueError):
+        PropertyGraph.from_csr([2, 2, 3], [1, 2, 3])
+
+
+def test_get_property_numpy(property_graph):
+    t = pyarrow.table(dict(new_prop=range(property_graph.num_edges())))
+    property_graph.add_edge_property(t)
+    prop = property_graph.get_edge_property_numpy("new_prop")
+    assert not prop.flags.writeable
+    assert np.array_equal(prop, np.arange(property_graph.num_edges()))
+
+    t = pyarrow.table(dict(new_prop=np.arange(property_graph.num_nodes(), dtype=np.float32)))
+    property_graph.add_node_property(t)
+    assert property_graph.get_node_property_numpy("new_prop")[10] == 10.0
+
+
+def test_edge_map(property_graph):
+    from katana.atomic import atomic_add
+    from katana.loops import edge_map, edge_map_operator
+
+    @edge_map_operator()
+    def count_in_edges(weights, counts, src, dst, edge):
+        atomic_add(counts, dst, weights[edge])
+
+    g = property_graph
+    weights = np.ones(g.num_edges(), dtype=np.uint64)
+    counts = np.zeros(g.num_nodes(), dtype=np.uint64)
+    edge_map(g, count_in_edges(weights, counts))
+    assert np.array_equal(counts, np.bincount(g.out_dests(), minlength=g.num_nodes()))
+
+    counts[:] = 0
+    edge_map(g, count_in_edges(weights, counts), nodes=range(10, 11))
+    assert counts.sum() == 5
@@ -0,0 +1,48 @@
+# Convert INPUT with graph-convert-external and check that the topology of the
+# RDG it creates is the binary gr that graph-convert -edgelist2gr creates, and
+# that at least MIN_RUNS sorted runs were merged.
+#
+#   cmake -DCONVERT=<graph-convert> -DCONVERT_EXTERNAL=<graph-convert-external>
+#     -DINPUT=<edge list> -DOUTPUT=<output prefix> -DARGS=<options>
+#     -DMIN_RUNS=<runs> -P compare-external.cmake
+
+file(REMOVE_RECURSE ${OUTPUT}.gr ${OUTPUT}.rdg)
+
+execute_process(
+  COMMAND ${CONVERT} -edgelist2gr ${INPUT} ${OUTPUT}.gr
+  RESULT_VARIABLE result
+)
+if(result)
+  message(FATAL_ERROR "graph-convert failed: ${result}")
+endif()
+
+separate_arguments(ARGS)
+execute_process(
+  COMMAND ${CONVERT_EXTERNAL} ${ARGS} ${INPUT} ${OUTPUT}.rdg
+  RESULT_VARIABLE result
+  ERROR_VARIABLE log
+)
+message(STATUS "${log}")
+if(result)
+  message(FATAL_ERROR "graph-convert-external failed: ${result}")
+endif()
+
+string(REGEX MATCHALL "wrote run" runs "${log}")
+list(LENGTH runs num_runs)
+if(num_runs LESS MIN_RUNS)
+  message(FATAL_ERROR "expected at least ${MIN_RUNS} runs, found ${num_runs}")
+endif()
+
+file(GLOB topology ${OUTPUT}.rdg/topology*)
+list(LENGTH topology num_topology)
+if(NOT num_topology EQUAL 1)
+  message(FATAL_ERROR "expected one topology file, found: ${topology}")
+endif()
+
+execute_process(
+  COMMAND ${CMAKE_COMMAND} -E compare_files ${topology} ${OUTPUT}.gr
+  RESULT_VARIABLE result
+)
+if(result)
+  message(FATAL_ERROR "${topology} differs from ${OUTPUT}.gr")
+endif()
@@ -0,0 +1,848 @@
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <limits>
+#include <optional>
+#include <queue>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include <arrow/api.h>
+#include <arrow/io/file.h>
+#include <llvm/Support/CommandLine.h>
+
+#include "katana/ErrorCode.h"
+#include "katana/Galois.h"
+#include "katana/Logging.h"
+#include "katana/ParallelSTL.h"
+#include "katana/Result.h"
+#include "katana/Strings.h"
+#include "tsuba/CSRTopology.h"
+#include "tsuba/RDG.h"
+#include "tsuba/file.h"
+#include "tsuba/tsuba.h"
+
+namespace cll = llvm::cl;
+
+static std::string kCommandLine;
+
+static cll::opt<std::string> inputFilename(
+    cll::Positional, cll::desc("<input edge list>"), cll::Required);
+static cll::opt<std::string> outputFilename(
+    cll::Positional, cll::desc("<output rdg>"), cll::Required);
+static cll::opt<bool> edgeWeights(
+    "edgeWeights",
+    cll::desc("Store the third column as the int64 edge property weight"),
+    cll::init(false));
+static cll::opt<double> memoryLimit(
+    "memoryLimit",
+    cll::desc("Approximate memory budget in MB, may be fractional (default "
+              "4096)"),
+    cll::init(4096));
+static cll::opt<std::string> tmpDir(
+    "tmpDir",
+    cll::desc(
+        "Local directory for sorted runs (default: the system temporary "
+        "directory); needs space for about twice the binary edges"),
+    cll::init(""));
+static cll::opt<unsigned> numThreads(
+    "t", cll::desc("Number of threads (default: all)"), cll::init(0));
+
+namespace {
+
+/// Every kSampleStride-th edge of each run is sampled to pick the source
+/// ranges that are merged in parallel
+constexpr uint64_t kSampleStride = 1 << 16;
+/// Source ranges per thread, so that stealing evens out skewed ranges
+constexpr uint64_t kPartitionsPerThread = 4;
+constexpr uint64_t kMinIOBufferBytes = 1 << 16;
+
+struct Edge {
+  uint32_t src;
+  uint32_t dst;
+};
+
+struct WeightedEdge {
+  uint32_t src;
+  uint32_t dst;
+  int64_t weight;
+};
+
+/// The length of the shortest line that holds a record, such as "0 1\n"
+template <typename Record>
+constexpr uint64_t kMinRecordLineBytes =
+    std::is_same_v<Record, WeightedEdge> ? 6 : 4;
+
+template <typename Record>
+bool
+EdgeLess(const Record& a, const Record& b) {
+  return std::tie(a.src, a.dst) < std::tie(b.src, b.dst);
+}
+
+katana::Result<void>
+PWriteAll(int fd, const void* data, uint64_t size, uint64_t offset) {
+  const auto* bytes = static_cast<const char*>(data);
+  while (size > 0) {
+    ssize_t written = pwrite(fd, bytes, size, offset);
+    if (written < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return katana::ResultErrno();
+    }
+    bytes += written;
+    size -= written;
+    offset += written;
+  }
+  return katana::ResultSuccess();
+}
+
+katana::Result<void>
+PReadAll(int fd, void* data, uint64_t size, uint64_t offset) {
+  auto* bytes = static_cast<char*>(data);
+  while (size > 0) {
+    ssize_t read = pread(fd, bytes, size, offset);
+    if (read < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return katana::ResultErrno();
+    }
+    if (read == 0) {
+      return katana::ErrorCode::InvalidArgument;
+    }
+    bytes += read;
+    size -= read;
+    offset += read;
+  }
+  return katana::ResultSuccess();
+}
+
+/// A file descriptor that is closed on destruction
+class File {
+public:
+  File() = default;
+  File(const File&) = delete;
+  File& operator=(const File&) = delete;
+  File(File&& other) noexcept : fd_(other.fd_) { other.fd_ = -1; }
+  File& operator=(File&& other) noexcept {
+    std::swap(fd_, other.fd_);
+    return *this;
+  }
+  ~File() {
+    if (fd_ >= 0) {
+      close(fd_);
+    }
+  }
+
+  static katana::Result<File> Create(const std::string& path, uint64_t size) {
+    File file;
+    file.fd_ = open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (file.fd_ < 0) {
+      return katana::ResultErrno();
+    }
+    if (ftruncate(file.fd_, size) != 0) {
+      return katana::ResultErrno();
+    }
+    return file;
+  }
+
+  int fd() const { return fd_; }
+
+private:
+  int fd_{-1};
+};
+
+/// Buffered sequential writes of T values to a file starting at an offset
+template <typename T>
+class FileWriter {
+public:
+  FileWriter(int fd, uint64_t offset, size_t buffer_size)
+      : fd_(fd), offset_(offset) {
+    buffer_.reserve(buffer_size);
+  }
+
+  katana::Result<void> Push(const T& value) {
+    buffer_.emplace_back(value);
+    if (buffer_.size() == buffer_.capacity()) {
+      return Flush();
+    }
+    return katana::ResultSuccess();
+  }
+
+  katana::Result<void> Flush() {
+    uint64_t size = buffer_.size() * sizeof(T);
+    if (auto res = PWriteAll(fd_, buffer_.data(), size, offset_); !res) {
+      return res.error();
+    }
+    offset_ += size;
+    buffer_.clear();
+    return katana::ResultSuccess();
+  }
+
+private:
+  int fd_;
+  uint64_t offset_;
+  std::vector<T> buffer_;
+};
+
+/// Buffered reads of the records [begin, end) of a sorted run
+template <typename Record>
+class RunReader {
+public:
+  RunReader(int fd, uint64_t begin, uint64_t end, size_t buffer_size)
+      : fd_(fd), next_(begin), end_(end), buffer_size_(buffer_size) {}
+
+  bool done() const { return pos_ == buffer_.size() && next_ == end_; }
+  const Record& front() const { return buffer_[pos_]; }
+
+  /// Advance to the next record, reading more of the run as needed
+  katana::Result<void> Pop() {
+    ++pos_;
+    return Fill();
+  }
+
+  katana::Result<void> Fill() {
+    if (pos_ < buffer_.size() || next_ == end_) {
+      return katana::ResultSuccess();
+    }
+    uint64_t count = std::min<uint64_t>(buffer_size_, end_ - next_);
+    buffer_.resize(count);
+    pos_ = 0;
+    if (auto res = PReadAll(
+            fd_, buffer_.data(), count * sizeof(Record),
+            next_ * sizeof(Record));
+        !res) {
+      return res.error();
+    }
+    next_ += count;
+    return katana::ResultSuccess();
+  }
+
+private:
+  int fd_;
+  uint64_t next_;
+  uint64_t end_;
+  size_t buffer_size_;
+  std::vector<Record> buffer_;
+  size_t pos_{0};
+};
+
+struct Run {
+  std::string path;
+  File file;
+  uint64_t num_edges;
+};
+
+bool
+IsSeparator(char c) {
+  return c == ' ' || c == '\t' || c == ',' || c == '\r';
+}
+
+const char*
+SkipSeparators(const char* p, const char* end) {
+  while (p != end && IsSeparator(*p)) {
+    ++p;
+  }
+  return p;
+}
+
+/// Parse a decimal integer at p; returns the position after it or nullptr
+/// if there is none
+template <typename T>
+const char*
+ParseInteger(const char* p, const char* end, T* value) {
+  bool negative = false;
+  if (std::is_signed_v<T> && p != end && *p == '-') {
+    negative = true;
+    ++p;
+  }
+  if (p == end || *p < '0' || *p > '9') {
+    return nullptr;
+  }
+  uint64_t v = 0;
+  for (; p != end && *p >= '0' && *p <= '9'; ++p) {
+    if (v > (std::numeric_limits<int64_t>::max() - 9) / 10) {
+      return nullptr;
+    }
+    v = v * 10 + (*p - '0');
+  }
+  *value = negative ? -static_cast<T>(v) : static_cast<T>(v);
+  return p;
+}
+
+enum class LineKind { kEdge, kSkip, kMalformed };
+
+/// Tokenize one line, without its newline, into record
+template <typename Record>
+LineKind
+ParseLine(const char* p, const char* end, Record* record) {
+  p = SkipSeparators(p, end);
+  if (p == end || *p == '#' || *p == '%') {
+    return LineKind::kSkip;
+  }
+
+  uint64_t src = 0;
+  uint64_t dst = 0;
+  p = ParseInteger(p, end, &src);
+  if (p == nullptr) {
+    return LineKind::kMalformed;
+  }
+  p = ParseInteger(SkipSeparators(p, end), end, &dst);
+  if (p == nullptr) {
+    return LineKind::kMalformed;
+  }
+  // Node ids are 32 bits and the number of nodes must fit too
+  constexpr uint64_t kMaxId = std::numeric_limits<uint32_t>::max() - 1;
+  if (src > kMaxId || dst > kMaxId) {
+    return LineKind::kMalformed;
+  }
+  record->src = src;
+  record->dst = dst;
+
+  if constexpr (std::is_same_v<Record, WeightedEdge>) {
+    p = ParseInteger(SkipSeparators(p, end), end, &record->weight);
+    if (p == nullptr) {
+      return LineKind::kMalformed;
+    }
+  }
+  return LineKind::kEdge;
+}
+
+/// Tokenize the complete lines in [begin, end) in parallel into records.
+/// Each thread takes the lines that start in its share of the bytes.
+template <typename Record>
+void
+ParseBlock(
+    const char* begin, const char* end, std::vector<Record>* records,
+    uint64_t* malformed, uint64_t* max_id) {
+  auto line_start = [&](const char* p) {
+    while (p != begin && p != end && p[-1] != '\n') {
+      ++p;
+    }
+    return p;
+  };
+
+  katana::PerThreadStorage<std::vector<Record>> local_records;
+  katana::GAccumulator<uint64_t> malformed_lines;
+  katana::GReduceMax<uint64_t> max_node;
+  katana::on_each([&](unsigned tid, unsigned total) {
+    auto [b, e] = katana::block_range(begin, end, tid, total);
+    const char* p = line_start(b);
+    const char* last = line_start(e);
+    std::vector<Record>& out = *local_records.getLocal();
+    out.clear();
+    while (p < last) {
+      const auto* newline =
+          static_cast<const char*>(std::memchr(p, '\n', last - p));
+      const char* line_end = newline ? newline : last;
+      Record record;
+      switch (ParseLine(p, line_end, &record)) {
+      case LineKind::kEdge:
+        out.emplace_back(record);
+        max_node.update(std::max(record.src, record.dst));
+        break;
+      case LineKind::kMalformed:
+        malformed_lines += 1;
+        break;
+      case LineKind::kSkip:
+        break;
+      }
+      p = newline ? newline + 1 : last;
+    }
+  });
+
+  std::vector<size_t> offsets(katana::getActiveThreads() + 1, 0);
+  for (unsigned i = 0; i < katana::getActiveThreads(); ++i) {
+    offsets[i + 1] = offsets[i] + local_records.getRemote(i)->size();
+  }
+  records->resize(offsets.back());
+  katana::on_each([&](unsigned tid, unsigned) {
+    std::vector<Record>& out = *local_records.getLocal();
+    std::copy(out.begin(), out.end(), records->begin() + offsets[tid]);
+    std::vector<Record>().swap(out);
+  });
+
+  *malformed += malformed_lines.reduce();
+  if (!records->empty()) {
+    *max_id = std::max(*max_id, max_node.reduce());
+  }
+}
+
+/// Read the input in blocks of about block_bytes, and spill each block as a
+/// sorted run in dir. A block only grows past block_bytes to hold a line that
+/// is longer. Every kSampleStride-th source of every run is appended
+/// to samples.
+template <typename Record>
+katana::Result<void>
+WriteSortedRuns(
+    const std::string& input, const std::filesystem::path& dir,
+    uint64_t block_bytes, std::vector<Run>* runs,
+    std::vector<uint32_t>* samples, uint64_t* num_nodes) {
+  std::ifstream in(input, std::ios::binary);
+  if (!in) {
+    KATANA_LOG_ERROR("could not open {}", input);
+    return katana::ErrorCode::InvalidArgument;
+  }
+
+  std::vector<char> text(block_bytes);
+  std::vector<Record> records;
+  uint64_t carry = 0;
+  uint64_t malformed = 0;
+  uint64_t max_id = 0;
+  bool any_edge = false;
+
+  while (in) {
+    in.read(text.data() + carry, text.size() - carry);
+    uint64_t size = carry + in.gcount();
+    const char* begin = text.data();
+    const char* end = begin + size;
+    if (in) {
+      // Only complete lines are parsed; the rest starts the next block
+      const char* last_newline = begin + size;
+      while (last_newline != begin && last_newline[-1] != '\n') {
+        --last_newline;
+      }
+      if (last_newline == begin) {
+        carry = size;
+        text.resize(2 * text.size());
+        continue;
+      }
+      end = last_newline;
+    }
+
+    ParseBlock(begin, end, &records, &malformed, &max_id);
+    any_edge = any_edge || !records.empty();
+
+    carry = begin + size - end;
+    std::memmove(text.data(), end, carry);
+
+    if (records.empty()) {
+      continue;
+    }
+    katana::ParallelSTL::sort(
+        records.begin(), records.end(), EdgeLess<Record>);
+
+    for (uint64_t i = 0; i < records.size(); i += kSampleStride) {
+      samples->emplace_back(records[i].src);
+    }
+
+    std::string path = dir / ("run-" + std::to_string(runs->size()));
+    uint64_t bytes = records.size() * sizeof(Record);
+    auto file_res = File::Create(path, bytes);
+    if (!file_res) {
+      return file_res.error();
+    }
+    if (auto res = PWriteAll(file_res.value().fd(), records.data(), bytes, 0);
+        !res) {
+      return res.error();
+    }
+    runs->emplace_back(
+        Run{path, std::move(file_res.value()), records.size()});
+    fmt::print(stderr, "wrote run {} ({} edges)\n", path, records.size());
+  }
+  if (in.bad()) {
+    return katana::ResultErrno();
+  }
+
+  if (malformed > 0) {
+    KATANA_LOG_WARN("skipped {} malformed lines", malformed);
+  }
+  *num_nodes = any_edge ? max_id + 1 : 0;
+  return katana::ResultSuccess();
+}
+
+/// The position of the first record of run whose source is at least node
+template <typename Record>
+katana::Result<uint64_t>
+RunLowerBound(const Run& run, uint32_t node) {
+  uint64_t lo = 0;
+  uint64_t hi = run.num_edges;
+  while (lo < hi) {
+    uint64_t mid = lo + (hi - lo) / 2;
+    Record record;
+    if (auto res = PReadAll(
+            run.file.fd(), &record, sizeof(record), mid * sizeof(Record));
+        !res) {
+      return res.error();
+    }
+    if (record.src < node) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  }
+  return lo;
+}
+
+struct TopologyOutput {
+  int fd;
+  uint64_t num_nodes;
+  uint64_t dests_offset;
+  /// -1 without edge weights
+  int weights_fd;
+};
+
+/// Merge the edges with sources in [node_begin, node_end) from all runs into
+/// the topology, where they start at edge edge_begin. bounds[r] is the
+/// range of those edges in run r.
+template <typename Record>
+katana::Result<void>
+MergePartition(
+    const std::vector<Run>& runs,
+    const std::vector<std::pair<uint64_t, uint64_t>>& bounds,
+    uint64_t node_begin, uint64_t node_end, uint64_t edge_begin,
+    const TopologyOutput& output, size_t buffer_records) {
+  std::vector<RunReader<Record>> readers;
+  for (size_t r = 0; r < runs.size(); ++r) {
+    readers.emplace_back(
+        runs[r].file.fd(), bounds[r].first, bounds[r].second, buffer_records);
+    if (auto res = readers.back().Fill(); !res) {
+      return res.error();
+    }
+  }
+
+  auto greater = [&](size_t a, size_t b) {
+    return EdgeLess(readers[b].front(), readers[a].front());
+  };
+  std::priority_queue<size_t, std::vector<size_t>, decltype(greater)> heap(
+      greater);
+  for (size_t r = 0; r < readers.size(); ++r) {
+    if (!readers[r].done()) {
+      heap.push(r);
+    }
+  }
+
+  FileWriter<uint64_t> indices(
+      output.fd,
+      sizeof(tsuba::CSRTopologyHeader) + node_begin * sizeof(uint64_t),
+      buffer_records);
+  FileWriter<uint32_t> dests(
+      output.fd, output.dests_offset + edge_begin * sizeof(uint32_t),
+      buffer_records);
+  std::optional<FileWriter<int64_t>> weights;
+  if (output.weights_fd >= 0) {
+    weights.emplace(
+        output.weights_fd, edge_begin * sizeof(int64_t), buffer_records);
+  }
+
+  uint64_t edge = edge_begin;
+  uint64_t next_node = node_begin;
+  while (!heap.empty()) {
+    size_t r = heap.top();
+    heap.pop();
+    const Record& record = readers[r].front();
+
+    // Nodes before src have all their edges merged
+    for (; next_node < record.src; ++next_node) {
+      if (auto res = indices.Push(edge); !res) {
+        return res.error();
+      }
+    }
+    if (auto res = dests.Push(record.dst); !res) {
+      return res.error();
+    }
+    if constexpr (std::is_same_v<Record, WeightedEdge>) {
+      if (auto res = weights->Push(record.weight); !res) {
+        return res.error();
+      }
+    }
+    ++edge;
+
+    if (auto res = readers[r].Pop(); !res) {
+      return res.error();
+    }
+    if (!readers[r].done()) {
+      heap.push(r);
+    }
+  }
+  for (; next_node < node_end; ++next_node) {
+    if (auto res = indices.Push(edge); !res) {
+      return res.error();
+    }
+  }
+
+  if (auto res = indices.Flush(); !res) {
+    return res.error();
+  }
+  if (auto res = dests.Flush(); !res) {
+    return res.error();
+  }
+  if (weights) {
+    return weights->Flush();
+  }
+  return katana::ResultSuccess();
+}
+
+/// Merge the sorted runs into a CSR topology file at topology_path, and the
+/// edge weights, if any, into weights_path
+template <typename Record>
+katana::Result<uint64_t>
+MergeRuns(
+    const std::vector<Run>& runs, std::vector<uint32_t>* samples,
+    uint64_t num_nodes, const std::string& topology_path,
+    const std::string& weights_path, uint64_t memory_bytes) {
+  uint64_t num_edges = 0;
+  for (const Run& run : runs) {
+    num_edges += run.num_edges;
+  }
+
+  // Partition boundaries are source ids at evenly spaced sample quantiles
+  katana::ParallelSTL::sort(samples->begin(), samples->end());
+  uint64_t num_partitions = std::min<uint64_t>(
+      samples->size(), katana::getActiveThreads() * kPartitionsPerThread);
+  num_partitions = std::max<uint64_t>(num_partitions, 1);
+  std::vector<uint64_t> boundaries{0};
+  for (uint64_t p = 1; p < num_partitions; ++p) {
+    uint32_t node = (*samples)[p * samples->size() / num_partitions];
+    if (node > boundaries.back()) {
+      boundaries.emplace_back(node);
+    }
+  }
+  boundaries.emplace_back(num_nodes);
+  num_partitions = boundaries.size() - 1;
+
+  // run_bounds[p][r] is the range of partition p in run r
+  std::vector<std::vector<std::pair<uint64_t, uint64_t>>> run_bounds(
+      num_partitions,
+      std::vector<std::pair<uint64_t, uint64_t>>(runs.size()));
+  std::vector<katana::Result<void>> results(
+      num_partitions, katana::ResultSuccess());
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_partitions * runs.size()),
+      [&](uint64_t i) {
+        uint64_t p = i / runs.size();
+        uint64_t r = i % runs.size();
+        auto begin = RunLowerBound<Record>(runs[r], boundaries[p]);
+        auto end = p + 1 == num_partitions
+                       ? katana::Result<uint64_t>(runs[r].num_edges)
+                       : RunLowerBound<Record>(runs[r], boundaries[p + 1]);
+        if (!begin || !end) {
+          results[p] = !begin ? begin.error() : end.error();
+          return;
+        }
+        run_bounds[p][r] = std::make_pair(begin.value(), end.value());
+      },
+      katana::steal(), katana::no_stats(), katana::loopname("RunBounds"));
+  for (const auto& res : results) {
+    if (!res) {
+      return res.error();
+    }
+  }
+
+  std::vector<uint64_t> partition_edges(num_partitions + 1, 0);
+  for (uint64_t p = 0; p < num_partitions; ++p) {
+    uint64_t count = 0;
+    for (const auto& [begin, end] : run_bounds[p]) {
+      count += end - begin;
+    }
+    partition_edges[p + 1] = partition_edges[p] + count;
+  }
+
+  tsuba::CSRTopologyHeader header{
+      .version = 1,
+      .edge_type_size = 0,
+      .num_nodes = num_nodes,
+      .num_edges = num_edges,
+  };
+  uint64_t dests_offset = sizeof(header) + num_nodes * sizeof(uint64_t);
+  uint64_t topology_size =
+      dests_offset +
+      katana::AlignUp<uint64_t>(num_edges * sizeof(uint32_t));
+
+  auto topology_res = File::Create(topology_path, topology_size);
+  if (!topology_res) {
+    return topology_res.error();
+  }
+  File topology = std::move(topology_res.value());
+  if (auto res = PWriteAll(topology.fd(), &header, sizeof(header), 0); !res) {
+    return res.error();
+  }
+
+  File weights;
+  if constexpr (std::is_same_v<Record, WeightedEdge>) {
+    auto weights_res =
+        File::Create(weights_path, num_edges * sizeof(int64_t));
+    if (!weights_res) {
+      return weights_res.error();
+    }
+    weights = std::move(weights_res.value());
+  }
+
+  TopologyOutput output{
+      .fd = topology.fd(),
+      .num_nodes = num_nodes,
+      .dests_offset = dests_offset,
+      .weights_fd = weights.fd(),
+  };
+  // Each thread has a read buffer per run and three write buffers
+  size_t buffer_records = std::max<uint64_t>(
+      kMinIOBufferBytes / sizeof(Record),
+      memory_bytes / (katana::getActiveThreads() * (runs.size() + 3) *
+                      sizeof(Record)));
+
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_partitions),
+      [&](uint64_t p) {
+        results[p] = MergePartition<Record>(
+            runs, run_bounds[p], boundaries[p], boundaries[p + 1],
+            partition_edges[p], output, buffer_records);
+      },
+      katana::steal(), katana::chunk_size<1>(), katana::no_stats(),
+      katana::loopname("MergeRuns"));
+  for (const auto& res : results) {
+    if (!res) {
+      return res.error();
+    }
+  }
+
+  return topology_size;
+}
+
+/// Store the topology file, and the weights if any, as the RDG output
+katana::Result<void>
+WriteRDG(
+    const std::string& output, const std::string& topology_path,
+    uint64_t topology_size, const std::string& weights_path,
+    uint64_t num_edges) {
+  if (auto res = tsuba::Create(output); !res) {
+    return res.error();
+  }
+  auto handle_res = tsuba::Open(output, tsuba::kReadWrite);
+  if (!handle_res) {
+    return handle_res.error();
+  }
+  tsuba::RDGFile handle(std::move(handle_res.value()));
+
+  katana::Uri top_file_name = tsuba::MakeTopologyFileName(handle);
+  if (auto res = tsuba::FileRemoteCopy(
+          topology_path, top_file_name.string(), 0, topology_size);
+      !res) {
+    return res.error();
+  }
+
+  tsuba::RDG rdg;
+  rdg.set_rdg_dir(tsuba::GetRDGDir(handle));
+  if (auto res = rdg.SetTopologyFile(top_file_name); !res) {
+    return res.error();
+  }
+
+  if (!weights_path.empty()) {
+    // The weights are paged in from the local file as they are written out
+    auto file_res = arrow::io::MemoryMappedFile::Open(
+        weights_path, arrow::io::FileMode::READ);
+    if (!file_res.ok()) {
+      KATANA_LOG_DEBUG("arrow error: {}", file_res.status());
+      return katana::ErrorCode::ArrowError;
+    }
+    auto buffer_res =
+        file_res.ValueOrDie()->ReadAt(0, num_edges * sizeof(int64_t));
+    if (!buffer_res.ok()) {
+      KATANA_LOG_DEBUG("arrow error: {}", buffer_res.status());
+      return katana::ErrorCode::ArrowError;
+    }
+    auto weights = std::make_shared<arrow::Int64Array>(
+        num_edges, buffer_res.ValueOrDie());
+    auto table = arrow::Table::Make(
+        arrow::schema({arrow::field("weight", arrow::int64())}), {weights});
+    if (auto res = rdg.AddEdgeProperties(table); !res) {
+      return res.error();
+    }
+  }
+
+  return rdg.Store(handle, kCommandLine);
+}
+
+/// Convert the input edge list with runs and scratch files in dir:
+///
+///  1. The input is read in blocks that are tokenized in parallel, sorted by
+///     (source, destination) and spilled to dir as sorted runs.
+///  2. The sources are split into ranges at quantiles sampled from the runs,
+///     and each range is k-way merged from all runs in parallel, straight
+///     into its place in the CSR topology file and the weight file.
+///  3. The topology is copied into a new RDG. The weights become the edge
+///     property "weight", paged in from the weight file as it is written.
+template <typename Record>
+katana::Result<void>
+Convert(const std::filesystem::path& dir) {
+  auto memory_bytes = static_cast<uint64_t>(memoryLimit * (1 << 20));
+  // While a run is built, the text block, the per-thread records, which may
+  // have reserved up to twice their size, and the records of the run are all
+  // live. A block holds at most one record per kMinRecordLineBytes.
+  uint64_t block_bytes = std::max<uint64_t>(
+      memory_bytes * kMinRecordLineBytes<Record> /
+          (kMinRecordLineBytes<Record> + 3 * sizeof(Record)),
+      1);
+
+  std::vector<Run> runs;
+  std::vector<uint32_t> samples;
+  uint64_t num_nodes = 0;
+  if (auto res = WriteSortedRuns<Record>(
+          inputFilename, dir, block_bytes, &runs, &samples, &num_nodes);
+      !res) {
+    return res.error();
+  }
+
+  std::string topology_path = dir / "topology";
+  std::string weights_path =
+      std::is_same_v<Record, WeightedEdge> ? dir / "weights" : "";
+  auto size_res = MergeRuns<Record>(
+      runs, &samples, num_nodes, topology_path, weights_path, memory_bytes);
+  if (!size_res) {
+    return size_res.error();
+  }
+
+  uint64_t num_edges = 0;
+  for (Run& run : runs) {
+    num_edges += run.num_edges;
+    // Free the disk space of the runs before the output is copied
+    std::filesystem::remove(run.path);
+  }
+  fmt::print(
+      stderr, "merged {} runs: {} nodes, {} edges\n", runs.size(), num_nodes,
+      num_edges);
+
+  return WriteRDG(
+      outputFilename, topology_path, size_res.value(), weights_path,
+      num_edges);
+}
+
+}  // namespace
+
+int
+main(int argc, char** argv) {
+  kCommandLine = katana::Join(" ", argv, argv + argc);
+  katana::SharedMemSys G;
+  llvm::cl::ParseCommandLineOptions(
+      argc, argv,
+      "Converts text edge lists larger than memory into RDGs by sorting "
+      "them externally\n");
+  unsigned threads = numThreads;
+  katana::setActiveThreads(
+      threads > 0 ? threads : std::numeric_limits<unsigned>::max());
+
+  std::filesystem::path base = tmpDir.empty()
+                                   ? std::filesystem::temp_directory_path()
+                                   : std::filesystem::path(tmpDir.getValue());
+  std::filesystem::path dir =
+      base / ("graph-convert-external-" + std::to_string(getpid()));
+  std::filesystem::create_directories(dir);
+
+  katana::Result<void> res = edgeWeights ? Convert<WeightedEdge>(dir)
+                                         : Convert<Edge>(dir);
+  std::error_code ignored;
+  std::filesystem::remove_all(dir, ignored);
+  if (!res) {
+    KATANA_LOG_FATAL("conversion failed: {}", res.error());
+  }
+
+  return 0;
+}
@@ -0,0 +1,81 @@
+#include <iostream>
+#include <string>
+
+#include <llvm/Support/CommandLine.h>
+
+#include "katana/Galois.h"
+#include "katana/GraphStats.h"
+#include "katana/Logging.h"
+#include "katana/PropertyFileGraph.h"
+#include "katana/Strings.h"
+
+namespace cll = llvm::cl;
+
+static std::string kCommandLine;
+
+static cll::opt<std::string> inputFilename(
+    cll::Positional, cll::desc("<input rdg>"), cll::Required);
+static cll::opt<bool> printJson(
+    "json", cll::desc("Print the statistics as JSON"), cll::init(false));
+static cll::opt<bool> store(
+    "store",
+    cll::desc(
+        "Store the statistics with the graph, so that later loads of it can "
+        "use them without recomputing"),
+    cll::init(false));
+static cll::opt<bool> recompute(
+    "recompute",
+    cll::desc("Recompute the statistics even if the graph has them"),
+    cll::init(false));
+
+int
+main(int argc, char** argv) {
+  kCommandLine = katana::Join(" ", argv, argv + argc);
+  katana::SharedMemSys G;
+  llvm::cl::ParseCommandLineOptions(
+      argc, argv, "Prints degree and property statistics of an RDG\n");
+
+  auto pfg_result = katana::PropertyFileGraph::Make(inputFilename);
+  if (!pfg_result) {
+    KATANA_LOG_FATAL(
+        "failed to load {}: {}", inputFilename.getValue(), pfg_result.error());
+  }
+  std::unique_ptr<katana::PropertyFileGraph> pfg =
+      std::move(pfg_result.value());
+
+  katana::Result<katana::GraphStats> stats_result =
+      katana::ErrorCode::NotFound;
+  if (!recompute) {
+    stats_result = katana::GraphStats::Load(*pfg);
+  }
+  bool computed = !stats_result;
+  if (computed) {
+    stats_result = katana::GraphStats::Compute(*pfg);
+    if (!stats_result) {
+      KATANA_LOG_FATAL("computing statistics: {}", stats_result.error());
+    }
+  }
+  const katana::GraphStats& stats = stats_result.value();
+
+  if (printJson) {
+    auto json_result = stats.ToJson();
+    if (!json_result) {
+      KATANA_LOG_FATAL("dumping statistics: {}", json_result.error());
+    }
+    std::cout << json_result.value() << "\n";
+  } else {
+    stats.Print();
+  }
+
+  if (store && computed) {
+    if (auto res = stats.Store(pfg.get()); !res) {
+      KATANA_LOG_FATAL("storing statistics: {}", res.error());
+    }
+    if (auto res = pfg->Commit(kCommandLine); !res) {
+      KATANA_LOG_FATAL(
+          "committing {}: {}", inputFilename.getValue(), res.error());
+    }
+  }
+
+  return 0;
+}